@@ -88,6 +88,8 @@ class PackageConan(ConanFile):
         tc.variables['COVERAGE_TRACKING'] = False
         tc.variables['CMAKE_CONAN'] = False
         # @+ START USER CMAKE OPTIONS
+        tc.variables['BUILD_BENCHMARKS'] = False
+        tc.variables['ENABLE_AVX2'] = False
         # @- END USER CMAKE OPTIONS
         tc.generate()
 
@@ -107,6 +109,8 @@ class PackageConan(ConanFile):
         self.cpp_info.libs = collect_libs(self)
         self.cpp_info.set_property("cmake_find_mode", "both")
         # @+ START USER DEFINES
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs.append("pthread")
         # @- END USER DEFINES
         self.cpp_info.set_property("cmake_file_name", self.full_name)
         cmake_target_name = self.full_name + "::" + self.full_name
@@ -0,0 +1,148 @@
+#ifndef __STAG_INFORMATION_MODEL_ADAPTIVE_POLLING_HPP
+#define __STAG_INFORMATION_MODEL_ADAPTIVE_POLLING_HPP
+
+#include "DataVariant.hpp"
+#include "Observable.hpp"
+#include "PollingScheduler.hpp"
+#include "Readable.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup Scheduling Element Scheduling
+ * @{
+ */
+
+/**
+ * @brief Bounds and rates of an adaptive polling interval
+ *
+ * A changed value resets the interval to min_interval. After stable_reads
+ * consecutive unchanged values, the interval is multiplied by backoff, up to
+ * max_interval.
+ */
+struct AdaptivePolicy {
+  using Duration = PollingScheduler::Clock::duration;
+
+  Duration min_interval;
+  Duration max_interval;
+  double backoff = 2.0;
+  std::size_t stable_reads = 3;
+};
+
+/**
+ * @brief Read counters of a PolledObservable
+ */
+struct AdaptivePollingStatistics {
+  std::size_t reads = 0;
+  /**
+   * @brief Reads, that returned a value different from the previous one,
+   * compared with compare(const DataVariant&, const DataVariant&)
+   */
+  std::size_t changes = 0;
+  std::size_t failures = 0;
+};
+
+/**
+ * @brief Exposes a Readable element as an Observable, by polling it at an
+ * adaptive interval and notifying observers when the read value changes
+ *
+ * The element is polled only while there are observers. The first read after
+ * polling starts is always dispatched. Read failures are dispatched to the
+ * ExceptionHandler of every observer.
+ *
+ * Create instances with makePolledObservable()
+ */
+class PolledObservable : public Observable,
+                         public std::enable_shared_from_this<PolledObservable> {
+public:
+  ~PolledObservable() override;
+
+  DataType dataType() const override;
+
+  /**
+   * @brief Reads the element directly, see @ref Readable::read()
+   */
+  DataVariant read() const override;
+
+  [[nodiscard]] ObserverPtr subscribe(const ObserveCallback& observe_cb,
+      const ExceptionHandler& handler) override;
+
+  /**
+   * @brief Returns the current polling interval, or std::nullopt if the
+   * element is not polled
+   */
+  std::optional<AdaptivePolicy::Duration> currentInterval() const;
+
+  AdaptivePollingStatistics statistics() const;
+
+private:
+  struct Subscription {
+    ObserveCallback observe;
+    ExceptionHandler handler;
+  };
+  struct SubscriptionToken;
+
+  friend std::shared_ptr<PolledObservable> makePolledObservable(
+      const std::shared_ptr<PollingScheduler>&,
+      const std::string&,
+      const ReadablePtr&,
+      const AdaptivePolicy&);
+
+  PolledObservable(const std::shared_ptr<PollingScheduler>& scheduler,
+      const std::string& device_id,
+      const ReadablePtr& readable,
+      const AdaptivePolicy& policy);
+
+  void unsubscribe(const Subscription* subscription);
+  void handle(const PollResult& result);
+  AdaptivePolicy::Duration adapt(bool changed);
+
+  std::shared_ptr<PollingScheduler> scheduler_;
+  std::string device_id_;
+  ReadablePtr readable_;
+  AdaptivePolicy policy_;
+
+  mutable std::mutex mx_;
+  std::vector<std::shared_ptr<Subscription>> subscriptions_;
+  std::optional<PollingScheduler::PollId> poll_id_;
+  AdaptivePolicy::Duration interval_;
+  std::size_t stable_ = 0;
+  std::optional<DataVariant> last_;
+  AdaptivePollingStatistics statistics_;
+};
+
+using PolledObservablePtr = std::shared_ptr<PolledObservable>;
+
+/**
+ * @brief Creates a PolledObservable, that polls a given element with a given
+ * scheduler
+ *
+ * @throws std::invalid_argument - if
+ *  - scheduler or readable is null
+ *  - min_interval is shorter than the scheduler resolution
+ *  - max_interval is shorter than min_interval
+ *  - backoff is not greater than 1 or stable_reads is 0
+ *
+ * @param scheduler
+ * @param device_id - reads of the same device are coalesced
+ * @param readable
+ * @param policy
+ * @return PolledObservablePtr
+ */
+PolledObservablePtr makePolledObservable(
+    const std::shared_ptr<PollingScheduler>& scheduler,
+    const std::string& device_id,
+    const ReadablePtr& readable,
+    const AdaptivePolicy& policy);
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_ADAPTIVE_POLLING_HPP
@@ -0,0 +1,202 @@
+#ifndef __STAG_INFORMATION_MODEL_AGGREGATION_HPP
+#define __STAG_INFORMATION_MODEL_AGGREGATION_HPP
+
+#include "DataVariant.hpp"
+#include "TimeSeries.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DataTypeModelling Data Type Modelling
+ * @{
+ */
+
+/**
+ * @brief Window aggregate of numeric values
+ *
+ * Integer sums wrap around on overflow. If the aggregated values contain NaN,
+ * the sum and mean are NaN, while min and max are unspecified.
+ *
+ * @tparam T - intmax_t, uintmax_t or double
+ */
+template <typename T> struct Aggregate {
+  using Sum = std::conditional_t<std::is_floating_point_v<T>, double, T>;
+
+  std::size_t count = 0;
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  Sum sum = 0;
+  T last{};
+
+  /**
+   * @brief Returns the arithmetic mean, or NaN if no values were aggregated
+   */
+  double mean() const {
+    if (count == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(sum) / static_cast<double>(count);
+  }
+};
+
+/**
+ * @brief Combines two aggregates, with next aggregating values that follow
+ * the values of result
+ *
+ * @tparam T - intmax_t, uintmax_t or double
+ * @param result - merged into
+ * @param next - aggregate of later values
+ */
+template <typename T>
+void merge(Aggregate<T>& result, const Aggregate<T>& next) {
+  if (next.count == 0) {
+    return;
+  }
+  result.count += next.count;
+  result.min = next.min < result.min ? next.min : result.min;
+  result.max = next.max > result.max ? next.max : result.max;
+  if constexpr (std::is_floating_point_v<T>) {
+    result.sum += next.sum;
+  } else {
+    // unsigned arithmetic wraps around instead of overflowing
+    result.sum = static_cast<T>(
+        static_cast<uint64_t>(result.sum) + static_cast<uint64_t>(next.sum));
+  }
+  result.last = next.last;
+}
+
+/**
+ * @brief Aggregates a contiguous array of values
+ *
+ * Uses AVX2 instructions when the library is built with ENABLE_AVX2 option,
+ * otherwise a scalar kernel with independent accumulators is used, see
+ * aggregationKernel()
+ *
+ * @param values - can be nullptr if count is 0
+ * @param count
+ * @return Aggregate
+ */
+Aggregate<double> aggregate(const double* values, std::size_t count);
+
+Aggregate<intmax_t> aggregate(const intmax_t* values, std::size_t count);
+
+Aggregate<uintmax_t> aggregate(const uintmax_t* values, std::size_t count);
+
+template <typename T>
+Aggregate<T> aggregate(const AlignedVector<T>& values) {
+  return aggregate(values.data(), values.size());
+}
+
+/**
+ * @brief Aggregates the values of TimeSeries segments, see
+ * TimeSeries::segments()
+ *
+ * @tparam T - intmax_t, uintmax_t or double
+ * @param segments
+ * @return Aggregate
+ */
+template <typename T>
+Aggregate<T> aggregate(const std::array<SeriesSegment<T>, 2>& segments) {
+  auto result = aggregate(segments[0].values, segments[0].size);
+  merge(result, aggregate(segments[1].values, segments[1].size));
+  return result;
+}
+
+/**
+ * @brief Returns the name of the instruction set, used by aggregate()
+ * kernels
+ *
+ * @return std::string - either "AVX2" or "Scalar"
+ */
+std::string aggregationKernel();
+
+/**
+ * @brief Native values, gathered from a range of DataVariant values
+ *
+ * @tparam T - gathered DataVariant alternative
+ */
+template <typename T> struct GatheredValues {
+  static constexpr std::size_t MASK_BITS = 64;
+
+  /**
+   * @brief Checks if the input DataVariant at a given position stored T
+   */
+  bool matched(std::size_t position) const {
+    return ((mask[position / MASK_BITS] >> (position % MASK_BITS)) & 1U) != 0;
+  }
+
+  /**
+   * @brief Values of matching input elements, in input order, narrow numeric
+   * values unwrapped from their NarrowValue
+   */
+  AlignedVector<NativeTypeOf_t<T>> values;
+  /**
+   * @brief Bit per input element, set if the element stored T
+   */
+  std::vector<uint64_t> mask;
+  std::size_t mismatched = 0;
+};
+
+/**
+ * @brief Unpacks values of a given DataVariant alternative into a contiguous
+ * array in a single pass, other alternatives are marked in a mask
+ *
+ * Reuses the storage of a given result, so repeated gathers of similarly
+ * sized windows do not allocate
+ *
+ * @tparam T - DataVariant alternative to gather
+ * @param variants - can be nullptr if count is 0
+ * @param count
+ * @param result - overwritten with gathered values
+ */
+template <typename T>
+void gather(
+    const DataVariant* variants, std::size_t count, GatheredValues<T>& result) {
+  constexpr auto bits = GatheredValues<T>::MASK_BITS;
+  result.values.resize(count);
+  result.mask.assign((count + bits - 1) / bits, 0);
+  std::size_t gathered = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (const auto* value = std::get_if<T>(&variants[i])) {
+      result.values[gathered++] = toNative(*value);
+      result.mask[i / bits] |= uint64_t{1} << (i % bits);
+    }
+  }
+  result.values.resize(gathered);
+  result.mismatched = count - gathered;
+}
+
+/**
+ * @brief Unpacks values of a given DataVariant alternative into a new
+ * contiguous array, see gather(const DataVariant*, std::size_t,
+ * GatheredValues<T>&)
+ *
+ * @tparam T - DataVariant alternative to gather
+ * @param variants - can be nullptr if count is 0
+ * @param count
+ * @return GatheredValues<T>
+ */
+template <typename T>
+GatheredValues<T> gather(const DataVariant* variants, std::size_t count) {
+  GatheredValues<T> result;
+  gather(variants, count, result);
+  return result;
+}
+
+template <typename T>
+GatheredValues<T> gather(const std::vector<DataVariant>& variants) {
+  return gather<T>(variants.data(), variants.size());
+}
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_AGGREGATION_HPP
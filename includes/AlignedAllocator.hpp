@@ -0,0 +1,85 @@
+#ifndef __STAG_INFORMATION_MODEL_ALIGNED_ALLOCATOR_HPP_
+#define __STAG_INFORMATION_MODEL_ALIGNED_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DataTypeModelling Data Type Modelling
+ * @{
+ */
+
+/**
+ * @brief Cache line alignment, used for bulk value storage
+ *
+ */
+constexpr std::size_t CACHE_LINE_ALIGNMENT = 64;
+
+/**
+ * @brief Stateless allocator, that aligns every allocation to a given
+ * boundary
+ *
+ * Used to store bulk values in contiguous memory, that can be safely processed
+ * with aligned vector instructions
+ *
+ * @tparam T - allocated type
+ * @tparam Alignment - allocation alignment in bytes, must be a power of 2
+ */
+template <typename T, std::size_t Alignment = CACHE_LINE_ALIGNMENT>
+struct AlignedAllocator {
+  static_assert((Alignment & (Alignment - 1)) == 0,
+      "Alignment must be a power of 2");
+  static_assert(
+      Alignment >= alignof(T), "Alignment must satisfy type alignment");
+
+  using value_type = T;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() noexcept = default;
+
+  template <typename U>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+  T* allocate(std::size_t count) {
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(
+        ::operator new(count * sizeof(T), std::align_val_t{Alignment}));
+  }
+
+  void deallocate(T* pointer, std::size_t /*count*/) noexcept {
+    ::operator delete(pointer, std::align_val_t{Alignment});
+  }
+
+  template <typename U>
+  friend bool operator==(
+      const AlignedAllocator&, const AlignedAllocator<U, Alignment>&) {
+    return true;
+  }
+
+  template <typename U>
+  friend bool operator!=(
+      const AlignedAllocator&, const AlignedAllocator<U, Alignment>&) {
+    return false;
+  }
+};
+
+/**
+ * @brief Contiguous, cache line aligned value storage
+ *
+ * @tparam T - stored value type
+ */
+template <typename T> using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_ALIGNED_ALLOCATOR_HPP_
@@ -0,0 +1,506 @@
+#ifndef __STAG_INFORMATION_MODEL_ARENA_DEVICE_HPP
+#define __STAG_INFORMATION_MODEL_ARENA_DEVICE_HPP
+
+#include "Device.hpp"
+#include "DeviceBuilder.hpp"
+#include "DeviceDefinition.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+namespace detail {
+struct ArenaBranch;
+struct ArenaModel;
+struct ArenaSpec;
+struct ArenaStructure;
+struct ObservableHub;
+} // namespace detail
+
+/**
+ * @brief Reference Device implementation, built by ArenaDeviceBuilder
+ *
+ * All elements of the device are constructed in a single arena buffer in
+ * depth first order. Their links, names, descriptions, DataTypes and
+ * ParameterTypes are kept in a separate immutable structure with a flat
+ * child index table and a single string pool, which devices instantiated
+ * from the same ArenaDeviceTemplate share. Parent and child links are arena
+ * indices. Returned ElementPtr, GroupPtr and element function
+ * pointers share the ownership of the arena, so they do not allocate and
+ * stay valid after the device is destroyed.
+ *
+ * Element ids are built from the device id, followed by a colon and the dot
+ * separated position of the element within its parent groups, for example
+ * "device:1.0" is the first element of the second root group element. The
+ * root group id is "device:". Element lookups parse the position from the id
+ * and do not use a hash table.
+ */
+class ArenaDevice final : public Device {
+public:
+  explicit ArenaDevice(std::shared_ptr<const detail::ArenaModel> model);
+
+  std::string id() const final;
+
+  std::string name() const final;
+
+  std::string description() const final;
+
+  GroupPtr group() const final;
+
+  size_t size() const final;
+
+  ElementPtr element(const std::string& ref_id) const final;
+
+  Expected<ElementPtr> tryElement(const std::string& ref_id) const final;
+
+  void visit(const Group::Visitor& visitor) const final;
+
+  /**
+   * @brief Returns the structural hash, computed once when the device was
+   * placed into its arena
+   */
+  size_t structuralHash() const final;
+
+  /**
+   * @brief Returns the number of all elements, including nested ones and
+   * excluding the root group
+   */
+  std::size_t elementCount() const;
+
+  /**
+   * @brief Returns the number of bytes allocated for this device only, its
+   * element arena, element table and the structural hashes of devices with
+   * write only elements
+   */
+  std::size_t arenaBytes() const;
+
+  /**
+   * @brief Returns the number of bytes allocated for the element structure,
+   * its links, child index table, string pool, ParameterTypes tables and
+   * structural hashes, without the nodes of the ParameterTypes maps
+   *
+   * Devices instantiated from the same ArenaDeviceTemplate share this memory.
+   */
+  std::size_t structureBytes() const;
+
+private:
+  std::shared_ptr<const detail::ArenaModel> model_;
+};
+
+/**
+ * @brief Device model, that instantiates ArenaDevice instances, which share
+ * a single immutable element structure
+ *
+ * The structure is built once from a DeviceDefinition and holds the element
+ * links, names, descriptions, DataTypes, ParameterTypes and structural hashes,
+ * which do not cover the device id. Every instance only allocates its element
+ * arena with the bound callbacks, instances with write only Writable elements
+ * also hash their own structure. Element ids of an instance start with the
+ * instance device id, the id of the definition is not used.
+ *
+ * Thread safe, devices can be instantiated concurrently.
+ */
+class ArenaDeviceTemplate {
+public:
+  /**
+   * @throws InvalidDefinition - if the definition structure is not valid
+   */
+  explicit ArenaDeviceTemplate(DeviceDefinition definition);
+
+  /**
+   * @brief Builds a new device with the structure of this template
+   *
+   * @param device_id - unique id of the new device
+   * @param callbacks - element callbacks, indexed by the callback indices of
+   * the definition
+   * @throws InvalidDefinition - if the callbacks do not match the definition
+   */
+  BuiltDevice instantiate(const std::string& device_id,
+      std::vector<ElementCallbacks> callbacks) const;
+
+  /**
+   * @brief Returns the number of all elements, including nested ones and
+   * excluding the root group
+   */
+  std::size_t elementCount() const;
+
+  /**
+   * @brief Returns the number of bytes of the shared element structure, see
+   * ArenaDevice::structureBytes()
+   */
+  std::size_t structureBytes() const;
+
+private:
+  std::shared_ptr<const detail::ArenaStructure> structure_;
+  /**
+   * @brief Definition rows without their strings and ParameterTypes, used to
+   * check the callbacks of every instance
+   */
+  DeviceDefinition definition_;
+  /**
+   * @brief Definition row of every arena index
+   */
+  std::vector<uint32_t> rows_;
+};
+
+/**
+ * @brief Reference DeviceBuilder implementation, that builds ArenaDevice
+ * instances
+ *
+ * Elements are recorded while building and placed into the arena by
+ * result(). Element callbacks are stored inline within the arena nodes,
+ * callbacks added with the addInline*() methods are not copied. Native
+ * callbacks added with the typed add*<T>() methods are stored as they are
+ * and are not wrapped into DataVariant callbacks. Observable
+ * notifications, returned by addObservable(), are dispatched synchronously on
+ * the calling thread. The IsObservingCallback is
+ * called with true when the first observer subscribes and with false when
+ * the last one unsubscribes.
+ *
+ * Not thread safe, owners serialize access.
+ */
+class ArenaDeviceBuilder final : public DeviceBuilder {
+public:
+  using DeviceBuilder::addObservable;
+  using DeviceBuilder::addReadable;
+  using DeviceBuilder::addWritable;
+
+  ArenaDeviceBuilder();
+
+  ~ArenaDeviceBuilder() override;
+
+  ArenaDeviceBuilder(const ArenaDeviceBuilder&) = delete;
+  ArenaDeviceBuilder& operator=(const ArenaDeviceBuilder&) = delete;
+
+  /**
+   * @throws DeviceBuildInProgress - if a device is already being built
+   */
+  void setDeviceInfo(
+      const std::string& unique_id, const BuildInfo& element_info) final;
+
+  std::string addGroup(const BuildInfo& element_info) final;
+
+  std::string addGroup(
+      const std::string& parent_id, const BuildInfo& element_info) final;
+
+  std::string addReadable(const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb) final;
+
+  std::string addReadable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb) final;
+
+  std::string addWritable(const BuildInfo& element_info,
+      DataType data_type,
+      const WriteCallback& write_cb,
+      const ReadCallback& read_cb = nullptr) final;
+
+  std::string addWritable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      const WriteCallback& write_cb,
+      const ReadCallback& read_cb = nullptr) final;
+
+  std::pair<std::string, NotifyCallback> addObservable(
+      const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb,
+      const IsObservingCallback& observe_cb) final;
+
+  std::pair<std::string, NotifyCallback> addObservable(
+      const std::string& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb,
+      const IsObservingCallback& observe_cb) final;
+
+  std::string addCallable(const BuildInfo& element_info,
+      const ExecuteCallback& execute_cb,
+      const ParameterTypes& parameter_types = {}) final;
+
+  std::string addCallable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      const ExecuteCallback& execute_cb,
+      const ParameterTypes& parameter_types = {}) final;
+
+  std::string addCallable(const BuildInfo& element_info,
+      DataType result_type,
+      const ExecuteCallback& execute_cb,
+      const AsyncExecuteCallback& async_execute_cb,
+      const CancelCallback& cancel_cb,
+      const ParameterTypes& parameter_types = {}) final;
+
+  std::string addCallable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      DataType result_type,
+      const ExecuteCallback& execute_cb,
+      const AsyncExecuteCallback& async_execute_cb,
+      const CancelCallback& cancel_cb,
+      const ParameterTypes& parameter_types = {}) final;
+
+  /**
+   * @brief Stores the native callback within the arena node. The built
+   * element implements TypedReadable<T>, so toTypedReadable() views call the
+   * callback without DataVariant conversions
+   */
+  std::string addTypedReadable(const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyReadCallback& read_cb) final;
+
+  /**
+   * @brief Stores the native callbacks within the arena node. The built
+   * element implements TypedReadable<T> and TypedWritable<T>
+   */
+  std::string addTypedWritable(const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyWriteCallback& write_cb,
+      const AnyReadCallback& read_cb) final;
+
+  /**
+   * @brief Stores the native read callback within the arena node. The built
+   * element implements TypedReadable<T> and TypedObservable<T>, but
+   * notifications are boxed once per dispatch, because typed and DataVariant
+   * observers share a single observer list
+   */
+  std::pair<std::string, AnyNotifyCallback> addTypedObservable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyReadCallback& read_cb,
+      const IsObservingCallback& observe_cb) final;
+
+  std::string addInlineReadable(const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineReadCallback&& read_cb) final;
+
+  std::string addInlineWritable(const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineWriteCallback&& write_cb,
+      InlineReadCallback&& read_cb = nullptr) final;
+
+  std::pair<std::string, InlineNotifyCallback> addInlineObservable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineReadCallback&& read_cb,
+      InlineIsObservingCallback&& observe_cb) final;
+
+  std::string addInlineCallable(const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType result_type,
+      InlineExecuteCallback&& execute_cb,
+      InlineAsyncExecuteCallback&& async_execute_cb = nullptr,
+      InlineCancelCallback&& cancel_cb = nullptr,
+      const ParameterTypes& parameter_types = {}) final;
+
+  /**
+   * @brief Arranges the definition rows without parent lookups or
+   * intermediate element records, copies their strings into the string pool
+   * once and moves the callbacks directly into a new arena
+   *
+   * @throws DeviceBuildInProgress - if a device is already being built
+   * @throws InvalidDefinition - if the definition or its callbacks are
+   * invalid
+   */
+  BuiltDevice build(const DeviceDefinition& definition,
+      std::vector<ElementCallbacks> callbacks) final;
+
+  /**
+   * @brief Places all built elements into a new arena and resets the builder
+   *
+   * @throws DeviceInfoNotSet - if setDeviceInfo() was not called
+   * @throws GroupEmpty - if the root group or any other group is empty
+   *
+   * @return std::unique_ptr<Device> - holds an ArenaDevice
+   */
+  std::unique_ptr<Device> result() final;
+
+  /**
+   * @brief Drops all recorded elements and resets the builder
+   */
+  void abandon() noexcept final;
+
+private:
+  detail::ArenaSpec& spec();
+  uint32_t parentOf(const std::string& parent_id);
+  uint32_t parentOf(const std::optional<std::string>& parent_id);
+  std::pair<std::string, std::weak_ptr<detail::ObservableHub>> addHub(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineReadCallback&& read_cb,
+      InlineIsObservingCallback&& observe_cb);
+
+  std::unique_ptr<detail::ArenaSpec> spec_;
+};
+
+struct BranchInUse : public std::logic_error {
+  explicit BranchInUse(const std::string& branch_id)
+      : std::logic_error("Branch " + branch_id + " is still in use") {}
+};
+
+struct BranchMissing : public std::logic_error {
+  BranchMissing(const std::string& device_id, std::size_t position)
+      : std::logic_error("Device " + device_id + " has no branch at position " +
+            std::to_string(position)) {}
+};
+
+/**
+ * @brief Builds ArenaDevice instances from many threads at once
+ *
+ * Every root group element of the device is a branch, that is built by a
+ * single thread through its own Branch handle. Branches record their
+ * elements without any locking, only claiming a branch takes the builder
+ * lock. The root position of a branch is chosen by the caller, for example
+ * the number of the discovered fieldbus segment, so element ids do not
+ * depend on thread scheduling and stay stable from run to run.
+ *
+ * result() merges the branches in position order into a single arena, once
+ * all Branch handles were destroyed. setDeviceInfo() and result() are not
+ * thread safe and must not run concurrently with any other method.
+ */
+class ConcurrentArenaDeviceBuilder {
+public:
+  using InlineReadCallback = DeviceBuilder::InlineReadCallback;
+  using InlineWriteCallback = DeviceBuilder::InlineWriteCallback;
+  using InlineIsObservingCallback = DeviceBuilder::InlineIsObservingCallback;
+  using InlineNotifyCallback = DeviceBuilder::InlineNotifyCallback;
+  using InlineExecuteCallback = DeviceBuilder::InlineExecuteCallback;
+  using InlineAsyncExecuteCallback = DeviceBuilder::InlineAsyncExecuteCallback;
+  using InlineCancelCallback = DeviceBuilder::InlineCancelCallback;
+
+  /**
+   * @brief Handle of a single branch, owned by the thread that builds it
+   *
+   * Methods behave like the matching DeviceBuilder methods. Elements without
+   * a parent id are added to the branch group. Not thread safe, but handles
+   * of different branches can be used concurrently. Handles must not outlive
+   * their builder.
+   */
+  class Branch {
+  public:
+    Branch(Branch&& other) noexcept;
+    Branch& operator=(Branch&& other) noexcept;
+    Branch(const Branch&) = delete;
+    Branch& operator=(const Branch&) = delete;
+
+    /**
+     * @brief Releases the branch for the final result() merge
+     */
+    ~Branch();
+
+    /**
+     * @brief Returns the id of the branch group
+     */
+    std::string id() const;
+
+    std::string addGroup(const BuildInfo& element_info);
+
+    std::string addGroup(
+        const std::string& parent_id, const BuildInfo& element_info);
+
+    std::string addInlineReadable(const std::optional<std::string>& parent_id,
+        const BuildInfo& element_info,
+        DataType data_type,
+        InlineReadCallback&& read_cb);
+
+    std::string addInlineWritable(const std::optional<std::string>& parent_id,
+        const BuildInfo& element_info,
+        DataType data_type,
+        InlineWriteCallback&& write_cb,
+        InlineReadCallback&& read_cb = nullptr);
+
+    std::pair<std::string, InlineNotifyCallback> addInlineObservable(
+        const std::optional<std::string>& parent_id,
+        const BuildInfo& element_info,
+        DataType data_type,
+        InlineReadCallback&& read_cb,
+        InlineIsObservingCallback&& observe_cb);
+
+    std::string addInlineCallable(const std::optional<std::string>& parent_id,
+        const BuildInfo& element_info,
+        DataType result_type,
+        InlineExecuteCallback&& execute_cb,
+        InlineAsyncExecuteCallback&& async_execute_cb = nullptr,
+        InlineCancelCallback&& cancel_cb = nullptr,
+        const ParameterTypes& parameter_types = {});
+
+  private:
+    friend class ConcurrentArenaDeviceBuilder;
+
+    explicit Branch(detail::ArenaBranch* state);
+
+    detail::ArenaSpec& spec() const;
+
+    uint32_t parentOf(const std::optional<std::string>& parent_id) const;
+
+    detail::ArenaBranch* state_;
+  };
+
+  ConcurrentArenaDeviceBuilder();
+
+  ~ConcurrentArenaDeviceBuilder();
+
+  ConcurrentArenaDeviceBuilder(const ConcurrentArenaDeviceBuilder&) = delete;
+  ConcurrentArenaDeviceBuilder& operator=(
+      const ConcurrentArenaDeviceBuilder&) = delete;
+
+  /**
+   * @throws DeviceBuildInProgress - if a device is already being built
+   */
+  void setDeviceInfo(
+      const std::string& unique_id, const BuildInfo& element_info);
+
+  /**
+   * @brief Claims the root group element at the given position. Thread safe
+   *
+   * Positions may be claimed in any order, result() requires them to be
+   * contiguous from 0.
+   *
+   * @throws DeviceInfoNotSet - if setDeviceInfo() was not called
+   * @throws std::out_of_range - if the position exceeds the number of groups a
+   * single arena can hold
+   * @throws std::invalid_argument - if the position is already claimed
+   */
+  Branch branch(std::size_t position, const BuildInfo& group_info);
+
+  /**
+   * @brief Merges all branches in position order into a new arena and resets
+   * the builder
+   *
+   * @throws DeviceInfoNotSet - if setDeviceInfo() was not called
+   * @throws BranchInUse - if a Branch handle still exists
+   * @throws BranchMissing - if a position below the highest claimed one was
+   * never claimed
+   * @throws GroupEmpty - if no branch was claimed or any group is empty
+   *
+   * @return std::unique_ptr<Device> - holds an ArenaDevice
+   */
+  std::unique_ptr<Device> result();
+
+private:
+  std::mutex mx_;
+  std::unique_ptr<detail::ArenaSpec> spec_;
+  std::map<std::size_t, std::unique_ptr<detail::ArenaBranch>> branches_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_ARENA_DEVICE_HPP
@@ -0,0 +1,211 @@
+#ifndef __STAG_INFORMATION_MODEL_CALL_DEADLINES_HPP
+#define __STAG_INFORMATION_MODEL_CALL_DEADLINES_HPP
+
+#include "Callable.hpp"
+#include "TimerWheel.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup ExecutableModeling Callable Modelling
+ * @{
+ */
+
+/**
+ * @brief Counters and timing of a CallDeadlineManager
+ */
+struct CallDeadlineStatistics {
+  using Duration = std::chrono::nanoseconds;
+
+  std::size_t completed = 0;
+  std::size_t failed = 0;
+  std::size_t canceled = 0;
+  std::size_t timed_out = 0;
+  /**
+   * @brief Delay between a call deadline and the moment it timed out
+   */
+  Duration max_lateness{0};
+  Duration total_lateness{0};
+
+  Duration meanLateness() const {
+    return timed_out == 0 ? Duration{0}
+                          : total_lateness / static_cast<int64_t>(timed_out);
+  }
+};
+
+/**
+ * @brief Tracks the deadlines of pending asynchronous Callable calls on a
+ * single TimerWheel
+ *
+ * Callable implementations create the ResultFuture of every asynchronous call
+ * with track() and resolve it with complete() or fail(). Calls, that are not
+ * resolved before their deadline, are cancelled through their CancelCallback
+ * and their ResultFuture throws CallTimedout. All deadlines are expired by a
+ * single timer thread, so waiting for a result does not need a
+ * std::future::wait_for() per call. The timer thread sleeps until the next
+ * timer wheel event, instead of waking up every resolution tick.
+ *
+ * Calls never time out before their deadline, they may time out up to one
+ * resolution later.
+ *
+ * The manager can also be driven manually by calling expire() without calling
+ * start().
+ *
+ * Pending calls are not stored in a PendingCallRegistry. Calls are tracked
+ * under caller chosen ids, while the registry allocates its own, and every
+ * resolution also cancels the deadline timer, which is guarded by the timer
+ * wheel lock, so sharding the call table would not remove that lock.
+ * Callable implementations, whose calls have no deadlines, should use
+ * PendingCallRegistry instead.
+ */
+class CallDeadlineManager {
+public:
+  using Clock = std::chrono::steady_clock;
+  /**
+   * @brief Called with the call id of a timed out call, on the timer thread.
+   * Exceptions thrown by the callback are ignored
+   */
+  using CancelCallback = std::function<void(uintmax_t)>;
+
+  /**
+   * @throws std::invalid_argument - if resolution is not positive
+   *
+   * @param resolution - timer wheel tick duration
+   */
+  explicit CallDeadlineManager(
+      Clock::duration resolution = std::chrono::milliseconds(1));
+
+  /**
+   * @brief Stops the timer thread, calls that are still pending throw
+   * CallCanceled
+   */
+  ~CallDeadlineManager();
+
+  CallDeadlineManager(const CallDeadlineManager&) = delete;
+  CallDeadlineManager& operator=(const CallDeadlineManager&) = delete;
+
+  /**
+   * @brief Starts tracking a new call
+   *
+   * @throws CallerIDExists - if a call with the same id is still pending
+   * @throws std::invalid_argument - if timeout is negative
+   *
+   * @param call_id
+   * @param name - Callable name, used in exception messages
+   * @param timeout - time from now until the call times out
+   * @param cancel - called once the call times out, can be null
+   * @return ResultFuture
+   */
+  [[nodiscard]] ResultFuture track(uintmax_t call_id,
+      const std::string& name,
+      Clock::duration timeout,
+      const CancelCallback& cancel);
+
+  /**
+   * @brief Resolves a pending call with a result
+   *
+   * @return true - if the call was pending, false if it already timed out or
+   * was resolved
+   */
+  bool complete(uintmax_t call_id, const DataVariant& result);
+
+  /**
+   * @brief Resolves a pending call with an exception
+   *
+   * @return true - if the call was pending
+   */
+  bool fail(uintmax_t call_id, const std::exception_ptr& error);
+
+  /**
+   * @brief Resolves a pending call with CallCanceled, without calling its
+   * CancelCallback. Used by Callable::cancelAsyncCall() implementations
+   *
+   * @return true - if the call was pending
+   */
+  bool cancel(uintmax_t call_id);
+
+  std::size_t pending() const;
+
+  /**
+   * @brief Starts the timer thread
+   */
+  void start();
+
+  /**
+   * @brief Stops the timer thread, pending calls keep their deadlines
+   */
+  void stop();
+
+  /**
+   * @brief Times out all calls, that are due at a given time. Used by the
+   * timer thread and must not be called while the manager is started
+   *
+   * @return std::size_t - number of calls that timed out
+   */
+  std::size_t expire(Clock::time_point now);
+
+  /**
+   * @brief Returns the time of tick 0
+   */
+  Clock::time_point epoch() const { return epoch_; }
+
+  Clock::duration resolution() const { return resolution_; }
+
+  CallDeadlineStatistics statistics() const;
+
+private:
+  struct PendingCall {
+    std::promise<DataVariant> result;
+    std::string name;
+    CancelCallback cancel;
+    TimerWheel::TimerId timer = 0;
+    Clock::time_point deadline;
+  };
+
+  struct TimedOut {
+    uintmax_t call_id;
+    PendingCall call;
+  };
+
+  /**
+   * @brief Removes a pending call and its timer
+   *
+   * @return true - if the call was pending
+   */
+  bool release(uintmax_t call_id, PendingCall& call);
+  uint64_t tickOf(Clock::time_point time, bool round_up) const;
+  Clock::time_point timeOf(uint64_t tick) const;
+  void timerLoop();
+
+  Clock::duration resolution_;
+  Clock::time_point epoch_;
+
+  mutable std::mutex mx_;
+  TimerWheel wheel_;
+  std::unordered_map<uintmax_t, PendingCall> calls_;
+  std::vector<TimerWheel::Expiry> expired_;
+  CallDeadlineStatistics statistics_;
+
+  std::condition_variable changed_;
+  bool running_ = false;
+  // tick the timer thread sleeps until, UINT64_MAX while nothing is pending
+  uint64_t wakeup_ = UINT64_MAX;
+  std::thread timer_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_CALL_DEADLINES_HPP
@@ -2,6 +2,7 @@
 #define __STAG_INFORMATION_MODEL_CALLABLE_HPP
 
 #include "DataVariant.hpp"
+#include "Expected.hpp"
 
 #include <chrono>
 #include <future>
@@ -85,6 +86,12 @@ struct ResultFuture {
   ResultFuture(
       std::shared_ptr<uintmax_t> id, std::future<DataVariant>&& result);
 
+  /**
+   * @brief Creates a result future with a caller id, that is already known,
+   * without allocating shared id storage
+   */
+  ResultFuture(uintmax_t id, std::future<DataVariant>&& result);
+
   ResultFuture(const ResultFuture&) = delete;
 
   ResultFuture(ResultFuture&&) = default;
@@ -107,6 +114,7 @@ struct ResultFuture {
 
 private:
   std::shared_ptr<uintmax_t> id_;
+  uintmax_t fixed_id_ = 0;
   std::future<DataVariant> result_;
 };
 
@@ -121,6 +129,12 @@ using Parameters = std::unordered_map<uintmax_t, std::optional<DataVariant>>;
 struct ParameterType {
   DataType type;
   bool mandatory = false;
+  /**
+   * @brief Allows parameter values of narrower numeric DataTypes, that can be
+   * losslessly converted into the declared type, see isLosslesslyConvertible()
+   *
+   */
+  bool allow_widening = false;
 
   friend bool operator==(const ParameterType& lhs, const ParameterType& rhs);
 
@@ -190,6 +204,25 @@ struct Callable {
   virtual DataVariant call(
       const Parameters& parameters, uintmax_t timeout = 100) const = 0;
 
+  /**
+   * @brief Calls the modeled functionality and waits to return the execution
+   * result without throwing, see @ref Callable::call(uintmax_t)
+   *
+   * Default implementation calls call() and converts thrown exceptions with
+   * toError(). It still throws and unwinds internally on every failure, so it
+   * is no cheaper than call(). Implementations must override it to report
+   * failures without throwing.
+   *
+   * @param parameters
+   * @param timeout - number of miliseconds until a timeout occurs
+   * @return Expected<DataVariant> - holds ErrorCode::Call_Timedout,
+   * ErrorCode::Result_Returning_Not_Supported, one of the parameter error
+   * codes or ErrorCode::Callback_Failed on failure
+   */
+  virtual Expected<DataVariant> tryCall(
+      const Parameters& parameters = Parameters(),
+      uintmax_t timeout = 100) const;
+
   /**
    * @brief Calls the modeled functionality and allocates a future for the
    * execution result
@@ -242,6 +275,9 @@ struct Callable {
  * @throws MandatoryParameterHasNoValue - if given parameter is marked as
  * mandatory, but has no value
  *
+ * If supported parameter type allows widening, narrower parameter values are
+ * stored as the supported parameter type
+ *
  * @param map - target container, if operation succeeded, the given container
  * will be larger by one element
  * @param supported_types - validation container, obtained from
@@ -257,6 +293,20 @@ void addSupportedParameter(Parameters& map,
     const std::optional<DataVariant>& param,
     bool strict_assign = false);
 
+/**
+ * @brief Non-throwing counterpart of addSupportedParameter(), the given
+ * container is not changed on failure
+ *
+ * @return Expected<void> - holds ErrorCode::Parameter_Does_Not_Exist,
+ * ErrorCode::Parameter_Type_Mismatch or
+ * ErrorCode::Mandatory_Parameter_Has_No_Value on failure
+ */
+Expected<void> tryAddSupportedParameter(Parameters& map,
+    const ParameterTypes& supported_types,
+    uintmax_t position,
+    const std::optional<DataVariant>& param,
+    bool strict_assign = false);
+
 /**
  * @brief Checks if a given container has all the mandatory parameters set and
  * if set parameters have correct values
@@ -275,6 +325,16 @@ void addSupportedParameter(Parameters& map,
 void checkParameters(
     const Parameters& input_parameters, const ParameterTypes& supported_types);
 
+/**
+ * @brief Non-throwing counterpart of checkParameters()
+ *
+ * @return Expected<void> - holds ErrorCode::Mandatory_Parameter_Missing,
+ * ErrorCode::Parameter_Type_Mismatch or
+ * ErrorCode::Mandatory_Parameter_Has_No_Value for the first failed parameter
+ */
+Expected<void> tryCheckParameters(
+    const Parameters& input_parameters, const ParameterTypes& supported_types);
+
 Parameters makeDefaultParams(const ParameterTypes& supported_types);
 
 /**
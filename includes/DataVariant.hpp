@@ -1,11 +1,20 @@
 #ifndef __STAG_INFORMATION_MODEL_DATA_VARIANT_HPP_
 #define __STAG_INFORMATION_MODEL_DATA_VARIANT_HPP_
 
+#include "AlignedAllocator.hpp"
+
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -116,33 +125,378 @@ std::string toString(const std::chrono::system_clock::time_point& timepoint,
  * @enum DataType
  * @brief DataType enumeration, specifying the supported data types
  *
+ * @attention Enumerator values are persisted, for example by DeviceSnapshot,
+ * so new enumerators must be appended and existing ones never renumbered
  */
 enum class DataType : uint8_t {
-  Boolean, /*!< bool */
-  Integer, /*!< intmax_t */
-  Unsigned_Integer, /*!< uintmax_t */
-  Double, /*!< double */
-  Timestamp, /*!< Information_Model::Timestamp */
-  Opaque, /*!< std::vector<uint8_t> */
-  String, /*!< std::string */
-  None, /*!< void */
-  Unknown /*!< fallback type */
+  Boolean = 0, /*!< bool */
+  Integer = 1, /*!< intmax_t */
+  Unsigned_Integer = 2, /*!< uintmax_t */
+  Double = 3, /*!< double */
+  Timestamp = 4, /*!< Information_Model::Timestamp */
+  Opaque = 5, /*!< std::vector<uint8_t> */
+  String = 6, /*!< std::string */
+  None = 7, /*!< void */
+  Unknown = 8, /*!< fallback type */
+  Integer_Array = 9, /*!< Information_Model::IntegerArray */
+  Unsigned_Integer_Array = 10, /*!< Information_Model::UnsignedIntegerArray */
+  Double_Array = 11, /*!< Information_Model::DoubleArray */
+  Integer_16 = 12, /*!< Information_Model::Integer16 */
+  Integer_32 = 13, /*!< Information_Model::Integer32 */
+  Unsigned_Integer_16 = 14, /*!< Information_Model::UnsignedInteger16 */
+  Unsigned_Integer_32 = 15, /*!< Information_Model::UnsignedInteger32 */
+  Float = 16, /*!< Information_Model::Float32 */
+  Integer_16_Array = 17 /*!< Information_Model::Integer16Array */
 };
 
 std::string toString(DataType type);
 
 std::string toSanitizedString(DataType type);
 
+/**
+ * @brief Homogeneous array of signed integers, stored in contiguous cache line
+ * aligned memory
+ *
+ */
+using IntegerArray = AlignedVector<intmax_t>;
+
+/**
+ * @brief Homogeneous array of unsigned integers, stored in contiguous cache
+ * line aligned memory
+ *
+ */
+using UnsignedIntegerArray = AlignedVector<uintmax_t>;
+
+/**
+ * @brief Homogeneous array of double floating point values, stored in
+ * contiguous cache line aligned memory
+ *
+ */
+using DoubleArray = AlignedVector<double>;
+
+/**
+ * @brief Homogeneous array of 16 bit signed integers, stored in contiguous
+ * cache line aligned memory without widening each sample
+ *
+ */
+using Integer16Array = AlignedVector<int16_t>;
+
+/**
+ * @brief Narrow numeric value, wrapped into a distinct type
+ *
+ * Plain int, short and float values are not implicitly converted into narrow
+ * values, so they keep selecting the Integer and Double DataVariant
+ * alternatives. Narrow values must be constructed explicitly, for example
+ * DataVariant(Integer16{42})
+ *
+ * @tparam T - native value type
+ */
+template <typename T> struct NarrowValue {
+  using value_type = T;
+
+  T value;
+
+  friend constexpr bool operator==(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value == rhs.value;
+  }
+
+  friend constexpr bool operator!=(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value != rhs.value;
+  }
+
+  friend constexpr bool operator<(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value < rhs.value;
+  }
+
+  friend constexpr bool operator>(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value > rhs.value;
+  }
+
+  friend constexpr bool operator<=(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value <= rhs.value;
+  }
+
+  friend constexpr bool operator>=(NarrowValue lhs, NarrowValue rhs) {
+    return lhs.value >= rhs.value;
+  }
+};
+
+using Integer16 = NarrowValue<int16_t>;
+using Integer32 = NarrowValue<int32_t>;
+using UnsignedInteger16 = NarrowValue<uint16_t>;
+using UnsignedInteger32 = NarrowValue<uint32_t>;
+using Float32 = NarrowValue<float>;
+
+/**
+ * @brief Maps a DataVariant alternative to its native C++ type, which is the
+ * wrapped type for narrow values and the alternative itself otherwise
+ */
+template <typename T> struct NativeTypeOf { using type = T; };
+
+template <typename T> struct NativeTypeOf<NarrowValue<T>> { using type = T; };
+
+template <typename T> using NativeTypeOf_t = typename NativeTypeOf<T>::type;
+
+/**
+ * @brief Returns the native value of a given DataVariant alternative
+ */
+template <typename T>
+constexpr const NativeTypeOf_t<T>& toNative(const T& value) {
+  if constexpr (std::is_same_v<T, NativeTypeOf_t<T>>) {
+    return value;
+  } else {
+    return value.value;
+  }
+}
+
+/**
+ * @brief Creates a DataVariant alternative from its native value
+ *
+ * @tparam T - DataVariant alternative
+ */
+template <typename T> constexpr T fromNative(NativeTypeOf_t<T> value) {
+  if constexpr (std::is_same_v<T, NativeTypeOf_t<T>>) {
+    return value;
+  } else {
+    return T{value};
+  }
+}
+
+/**
+ * @brief Holds a value of any modeled DataType
+ *
+ * Narrow numeric DataTypes are stored as NarrowValue alternatives, so plain
+ * int, short and float values are still stored as DataType::Integer and
+ * DataType::Double
+ */
 using DataVariant = std::variant<bool,
     intmax_t,
     uintmax_t,
     double,
     Timestamp,
     std::vector<uint8_t>,
-    std::string>;
+    std::string,
+    IntegerArray,
+    UnsignedIntegerArray,
+    DoubleArray,
+    Integer16,
+    Integer32,
+    UnsignedInteger16,
+    UnsignedInteger32,
+    Float32,
+    Integer16Array>;
 
 using DataVariantPtr = std::shared_ptr<DataVariant>;
 
+namespace detail {
+/**
+ * @brief DataType of each DataVariant alternative, ordered by variant index
+ *
+ * @attention Must be kept in sync with DataVariant alternative order
+ */
+constexpr DataType variant_data_types[] = {// clang-format off
+    DataType::Boolean,
+    DataType::Integer,
+    DataType::Unsigned_Integer,
+    DataType::Double,
+    DataType::Timestamp,
+    DataType::Opaque,
+    DataType::String,
+    DataType::Integer_Array,
+    DataType::Unsigned_Integer_Array,
+    DataType::Double_Array,
+    DataType::Integer_16,
+    DataType::Integer_32,
+    DataType::Unsigned_Integer_16,
+    DataType::Unsigned_Integer_32,
+    DataType::Float,
+    DataType::Integer_16_Array
+}; // clang-format on
+
+static_assert(std::size(variant_data_types) == std::variant_size_v<DataVariant>,
+    "Every DataVariant alternative must have a DataType");
+
+constexpr std::size_t maxDataTypeValue() {
+  auto result = static_cast<std::size_t>(DataType::Unknown);
+  for (auto type : variant_data_types) {
+    result = std::max(result, static_cast<std::size_t>(type));
+  }
+  return result;
+}
+
+/**
+ * @brief Number of DataType enumerator values, DataTypes are not ordered by
+ * their variant index
+ */
+constexpr std::size_t data_type_count = maxDataTypeValue() + 1;
+
+template <typename T, typename Variant> struct VariantIndex;
+
+template <typename T, typename... Alternatives>
+struct VariantIndex<T, std::variant<Alternatives...>> {
+  static constexpr std::size_t value = []() {
+    constexpr bool matches[] = {std::is_same_v<T, Alternatives>...};
+    for (std::size_t i = 0; i < sizeof...(Alternatives); ++i) {
+      if (matches[i]) {
+        return i;
+      }
+    }
+    return std::variant_npos;
+  }();
+};
+
+struct VariantIndexTable {
+  std::size_t indexes[data_type_count];
+};
+
+constexpr VariantIndexTable makeVariantIndexTable() {
+  VariantIndexTable result{};
+  for (auto& index : result.indexes) {
+    index = std::variant_npos;
+  }
+  for (std::size_t i = 0; i < std::size(variant_data_types); ++i) {
+    result.indexes[static_cast<std::size_t>(variant_data_types[i])] = i;
+  }
+  return result;
+}
+
+constexpr VariantIndexTable variant_indexes = makeVariantIndexTable();
+} // namespace detail
+
+/**
+ * @brief Returns the DataVariant alternative index that stores the given
+ * DataType
+ *
+ * @param type
+ * @return std::size_t - std::variant_npos for DataType::None and
+ * DataType::Unknown
+ */
+constexpr std::size_t variantIndexOf(DataType type) {
+  auto position = static_cast<std::size_t>(type);
+  return position < detail::data_type_count
+      ? detail::variant_indexes.indexes[position]
+      : std::variant_npos;
+}
+
+/**
+ * @brief Returns the DataType, that is stored at a given DataVariant
+ * alternative index
+ *
+ * @param index - obtained from DataVariant::index()
+ * @return DataType - DataType::Unknown for out of range indexes
+ */
+constexpr DataType dataTypeAt(std::size_t index) {
+  return index < std::size(detail::variant_data_types)
+      ? detail::variant_data_types[index]
+      : DataType::Unknown;
+}
+
+/**
+ * @brief Maps a C++ type to its DataVariant alternative index
+ *
+ * @tparam T - one of the DataVariant alternatives
+ */
+template <typename T> struct VariantIndexOf {
+  static constexpr std::size_t value =
+      detail::VariantIndex<T, DataVariant>::value;
+
+  static_assert(
+      value != std::variant_npos, "Type is not stored in DataVariant");
+};
+
+template <typename T>
+constexpr std::size_t VariantIndexOf_v = VariantIndexOf<T>::value;
+
+/**
+ * @brief Maps a C++ type to its DataType
+ *
+ * @tparam T - one of the DataVariant alternatives
+ */
+template <typename T> struct DataTypeOf {
+  static constexpr DataType value = dataTypeAt(VariantIndexOf_v<T>);
+};
+
+template <typename T> constexpr DataType DataTypeOf_v = DataTypeOf<T>::value;
+
+/**
+ * @brief Maps a DataType to the C++ type that is stored in the DataVariant
+ *
+ * @tparam Type - any DataType, except DataType::None and DataType::Unknown
+ */
+template <DataType Type> struct TypeOf {
+  static_assert(variantIndexOf(Type) != std::variant_npos,
+      "DataType has no DataVariant representation");
+
+  using type = std::variant_alternative_t<variantIndexOf(Type), DataVariant>;
+};
+
+template <DataType Type> using TypeOf_t = typename TypeOf<Type>::type;
+
+/**
+ * @brief Compile time DataType and C++ type pair, passed to visitDataType()
+ * visitors
+ *
+ * @tparam Type
+ */
+template <DataType Type> struct DataTypeTag {
+  static constexpr DataType value = Type;
+  using type = TypeOf_t<Type>;
+};
+
+namespace detail {
+template <typename Visitor, std::size_t... Indexes>
+decltype(auto) visitDataType(std::size_t index,
+    Visitor&& visitor,
+    std::index_sequence<Indexes...>) {
+  using Result = std::invoke_result_t<Visitor, DataTypeTag<dataTypeAt(0)>>;
+  using Handler = Result (*)(Visitor&&);
+  static constexpr Handler handlers[] = {[](Visitor&& visit) -> Result {
+    return std::forward<Visitor>(visit)(DataTypeTag<dataTypeAt(Indexes)>{});
+  }...};
+  return handlers[index](std::forward<Visitor>(visitor));
+}
+} // namespace detail
+
+/**
+ * @brief Dispatches a runtime DataType value to a generic visitor, which is
+ * called with a DataTypeTag for that DataType
+ *
+ * Allows to write generic code for every DataVariant alternative without
+ * repeating the type list, for example:
+ * @code
+ * auto size = visitDataType(type, [](auto tag) {
+ *   using T = typename decltype(tag)::type;
+ *   return sizeof(T);
+ * });
+ * @endcode
+ *
+ * @throws std::logic_error - if given DataType is None or Unknown
+ *
+ * @param type
+ * @param visitor - must return the same type for all DataTypeTags
+ * @return decltype(auto) - visitor result
+ */
+template <typename Visitor>
+decltype(auto) visitDataType(DataType type, Visitor&& visitor) {
+  auto index = variantIndexOf(type);
+  if (index == std::variant_npos) {
+    throw std::logic_error(
+        "Can not visit DataType without a DataVariant representation");
+  }
+  return detail::visitDataType(index,
+      std::forward<Visitor>(visitor),
+      std::make_index_sequence<std::variant_size_v<DataVariant>>{});
+}
+
+/**
+ * @brief Returns the size of the stored value in bytes
+ *
+ * For Opaque, String and array types, returns the size of the stored elements,
+ * not the size of the container
+ *
+ * @param variant
+ * @return std::size_t
+ */
 std::size_t size_of(const DataVariant& variant);
 
 std::optional<DataVariant> setVariant(DataType type);
@@ -151,11 +505,186 @@ DataType toDataType(const DataVariant& variant);
 
 bool matchVariantType(const DataVariant& variant, DataType type);
 
+struct ConversionNotSupported : public std::invalid_argument {
+  ConversionNotSupported(DataType from, DataType to)
+      : std::invalid_argument("Can not convert " + toString(from) +
+            " values to " + toString(to)) {}
+};
+
+struct ValueOutOfRange : public std::range_error {
+  ValueOutOfRange(const std::string& value, DataType to)
+      : std::range_error(
+            "Value " + value + " can not be represented as " + toString(to)) {}
+};
+
+namespace detail {
+template <typename T>
+constexpr bool is_numeric = std::is_arithmetic_v<NativeTypeOf_t<T>> &&
+    !std::is_same_v<T, bool>;
+
+template <typename FromAlternative, typename ToAlternative>
+constexpr bool isLossless() {
+  using From = NativeTypeOf_t<FromAlternative>;
+  using To = NativeTypeOf_t<ToAlternative>;
+  if constexpr (!is_numeric<From> || !is_numeric<To>) {
+    return false;
+  } else if constexpr (std::is_floating_point_v<From>) {
+    return std::is_floating_point_v<To> &&
+        std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits &&
+        std::numeric_limits<To>::max_exponent >=
+        std::numeric_limits<From>::max_exponent;
+  } else {
+    // sign bit is not counted in digits, so unsigned types can only be
+    // widened to signed types with more digits
+    return (std::is_floating_point_v<To> || std::is_signed_v<To> ||
+               std::is_unsigned_v<From>) &&
+        std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+  }
+}
+} // namespace detail
+
+/**
+ * @brief Checks if every value of a given DataType can be represented by the
+ * target DataType without losing information
+ *
+ * Only numeric DataTypes (except Boolean) can be widened, for example
+ * Integer_16 to Integer_32, Integer or Double, Unsigned_Integer_16 to
+ * Integer_32 or Float to Double
+ *
+ * @param from
+ * @param to
+ * @return true - if values of from DataType can be losslessly widened, or both
+ * DataTypes are the same numeric DataType
+ */
+bool isLosslesslyConvertible(DataType from, DataType to);
+
+/**
+ * @brief Converts a given numeric value into a wider numeric DataType
+ *
+ * @throws ConversionNotSupported - if given value can not be losslessly
+ * converted into target DataType, see isLosslesslyConvertible()
+ *
+ * @param value
+ * @param target
+ * @return DataVariant - value, stored as target DataType
+ */
+DataVariant widen(const DataVariant& value, DataType target);
+
+/**
+ * @brief Converts a given numeric value into any other numeric DataType, if
+ * the value can be represented by the target DataType
+ *
+ * Integer values must fit within the target type range. Floating point values
+ * can only be converted to integers if they have no fractional part. Floating
+ * point values can be converted to Float, if they fit within the Float range,
+ * though their precision may be reduced.
+ *
+ * @throws ConversionNotSupported - if either the given value or the target
+ * DataType are not numeric
+ * @throws ValueOutOfRange - if given value can not be represented by the
+ * target DataType
+ *
+ * @param value
+ * @param target
+ * @return DataVariant - value, stored as target DataType
+ */
+DataVariant narrow(const DataVariant& value, DataType target);
+
 std::string toString(const DataVariant& variant);
 
 std::string toSanitizedString(const DataVariant& variant);
 
+/**
+ * @brief Hashes a given byte range
+ *
+ * Processes 32 byte blocks in four independent 64 bit lanes, which allows the
+ * CPU to overlap the multiplications of each lane. Results are stable within a
+ * single process run, but are not guaranteed to be stable across library
+ * versions, so they should not be persisted.
+ *
+ * @param data - start of the byte range, can be nullptr if size is 0
+ * @param size - number of bytes to hash
+ * @param seed - initial hash state
+ * @return std::size_t
+ */
+std::size_t hashBytes(
+    const void* data, std::size_t size, std::size_t seed = 0) noexcept;
+
+/**
+ * @brief Hashes a given timestamp
+ *
+ * All timestamp fields are packed into a single 64 bit integer, which is then
+ * mixed, so the timestamp is hashed with a single integer hash
+ *
+ * @param timestamp
+ * @return std::size_t
+ */
+std::size_t hashValue(const Timestamp& timestamp) noexcept;
+
+/**
+ * @brief Hashes a given DataVariant
+ *
+ * The hash depends on the stored alternative and its value, so the same
+ * number stored as different DataTypes results in different hashes. Positive
+ * and negative floating point zeroes, as well as all NaN values hash equally.
+ *
+ * @param variant
+ * @return std::size_t
+ */
+std::size_t hashValue(const DataVariant& variant) noexcept;
+
+/**
+ * @brief Compares two DataVariants with a total ordering
+ *
+ * Values that store different alternatives are ordered by their alternative
+ * index, which follows the DataType declaration order, for example any Boolean
+ * value is less than any Integer value. Values of the same alternative are
+ * ordered as follows:
+ *  - Boolean - false is less than true
+ *  - integer and Timestamp types - by their natural order
+ *  - floating point types - by their natural order, except that positive and
+ * negative zeroes are equal, and NaN values are equal to each other and
+ * greater than any other value
+ *  - Opaque and String - lexicographically by their unsigned bytes
+ *  - arrays - lexicographically by their elements, using the above rules
+ *
+ * Unlike the DataVariant equality operator, NaN values compare equal to
+ * themselves, so this ordering can be used for sorting and ordered containers
+ *
+ * @param lhs
+ * @param rhs
+ * @return int - negative if lhs is ordered before rhs, 0 if both are
+ * equivalent, positive if lhs is ordered after rhs
+ */
+int compare(const DataVariant& lhs, const DataVariant& rhs) noexcept;
+
+/**
+ * @brief Strict weak ordering functor, based on compare(const DataVariant&,
+ * const DataVariant&)
+ *
+ */
+struct DataVariantLess {
+  bool operator()(const DataVariant& lhs, const DataVariant& rhs) const {
+    return compare(lhs, rhs) < 0;
+  }
+};
+
 /** @}*/
 } // namespace Information_Model
 
+namespace std {
+template <> struct hash<Information_Model::Timestamp> {
+  size_t operator()(const Information_Model::Timestamp& value) const noexcept {
+    return Information_Model::hashValue(value);
+  }
+};
+
+template <> struct hash<Information_Model::DataVariant> {
+  size_t operator()(
+      const Information_Model::DataVariant& value) const noexcept {
+    return Information_Model::hashValue(value);
+  }
+};
+} // namespace std
+
 #endif //__STAG_INFORMATION_MODEL_DATA_VARIANT_HPP_
\ No newline at end of file
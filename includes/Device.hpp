@@ -52,6 +52,20 @@ struct Device : virtual public MetaInfo {
    */
   virtual ElementPtr element(const std::string& ref_id) const = 0;
 
+  /**
+   * @brief Searches and returns an Element that matches a given reference id
+   * without throwing
+   *
+   * Default implementation calls element() and converts thrown exceptions
+   * with toError(). It still throws and unwinds internally for every missing
+   * element, so it is no cheaper than element(). Implementations must
+   * override it to report missing elements without throwing.
+   *
+   * @return Expected<ElementPtr> - holds ErrorCode::Element_Not_Found or
+   * ErrorCode::ID_Points_This_Group on failure
+   */
+  virtual Expected<ElementPtr> tryElement(const std::string& ref_id) const;
+
   /**
    * @brief Uses the given Visitor callable, to visit each contained element
    * within the root group in no particular order
@@ -59,6 +73,19 @@ struct Device : virtual public MetaInfo {
    * @param visitor
    */
   virtual void visit(const Group::Visitor& visitor) const = 0;
+
+  /**
+   * @brief Returns the structural hash of the whole device, see
+   * StructuralHash.hpp
+   *
+   * Equals the structural hash of the root group, which has an empty id
+   * relative to the device, so the device id is not covered. Default
+   * implementation recomputes the hash from the structuralHash() of the root
+   * group elements on every call.
+   *
+   * @return std::size_t
+   */
+  virtual std::size_t structuralHash() const;
 };
 
 using DevicePtr = std::shared_ptr<Device>;
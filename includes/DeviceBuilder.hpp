@@ -4,12 +4,17 @@
 #include "Callable.hpp"
 #include "DataVariant.hpp"
 #include "Device.hpp"
+#include "InplaceFunction.hpp"
+#include "NotificationFilter.hpp"
 
 #include <functional>
 #include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace Information_Model {
 /**
@@ -43,10 +48,26 @@ struct DeviceBuildInProgress : public std::logic_error {
   DeviceBuildInProgress() : std::logic_error("Device is already being built") {}
 };
 
+namespace detail {
+template <typename Variant> struct TypedCallbacks;
+
+template <typename... Alternatives>
+struct TypedCallbacks<std::variant<Alternatives...>> {
+  using Read = std::variant<std::function<Alternatives()>...>;
+  using Write = std::variant<std::function<void(const Alternatives&)>...>;
+};
+} // namespace detail
+
+struct DeviceDefinition;
+struct BuiltDevice;
+struct ElementCallbacks;
+
 /**
  * @brief Device Builder interface used by Technology Adapter implementations to
  * build a device within the Information Model
  *
+ * @attention Implementations that override the add*() methods should bring
+ * the typed add*<T>() overloads back into scope with a using declaration
  */
 struct DeviceBuilder {
   /**
@@ -94,6 +115,92 @@ struct DeviceBuilder {
    */
   using IsObservingCallback = std::function<void(bool)>;
 
+  /**
+   * @brief Used by the typed Readable to get the latest native value
+   *
+   */
+  template <typename T> using TypedReadCallback = std::function<T()>;
+
+  /**
+   * @brief Used by the typed Writable to set a user given native value
+   *
+   */
+  template <typename T>
+  using TypedWriteCallback = std::function<void(const T&)>;
+
+  /**
+   * @brief Used by the typed Observable implementer to send native value
+   * notifications to registered observers
+   *
+   */
+  template <typename T>
+  using TypedNotifyCallback = std::function<void(const T&)>;
+
+  /**
+   * @brief Holds a TypedReadCallback for any DataVariant alternative. The held
+   * alternative index matches the DataVariant alternative index
+   *
+   */
+  using AnyReadCallback = detail::TypedCallbacks<DataVariant>::Read;
+
+  /**
+   * @brief Holds a TypedWriteCallback for any DataVariant alternative. The
+   * held alternative index matches the DataVariant alternative index
+   *
+   */
+  using AnyWriteCallback = detail::TypedCallbacks<DataVariant>::Write;
+
+  /**
+   * @brief Holds a TypedNotifyCallback for any DataVariant alternative. The
+   * held alternative index matches the DataVariant alternative index
+   *
+   */
+  using AnyNotifyCallback = detail::TypedCallbacks<DataVariant>::Write;
+
+  /**
+   * @brief Move-only ReadCallback, that stores its target inline without
+   * allocating
+   *
+   */
+  using InlineReadCallback = InplaceFunction<DataVariant()>;
+
+  /**
+   * @brief Move-only WriteCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineWriteCallback = InplaceFunction<void(const DataVariant&)>;
+
+  /**
+   * @brief Move-only ExecuteCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineExecuteCallback = InplaceFunction<void(const Parameters&)>;
+
+  /**
+   * @brief Move-only AsyncExecuteCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineAsyncExecuteCallback =
+      InplaceFunction<ResultFuture(const Parameters&)>;
+
+  /**
+   * @brief Move-only CancelCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineCancelCallback = InplaceFunction<void(uintmax_t)>;
+
+  /**
+   * @brief Move-only NotifyCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineNotifyCallback = InplaceFunction<void(const DataVariant&)>;
+
+  /**
+   * @brief Move-only IsObservingCallback, see @ref InlineReadCallback
+   *
+   */
+  using InlineIsObservingCallback = InplaceFunction<void(bool)>;
+
   virtual ~DeviceBuilder() = default;
 
   /**
@@ -265,6 +372,54 @@ struct DeviceBuilder {
       const ReadCallback& read_cb,
       const IsObservingCallback& observe_cb) = 0;
 
+  /**
+   * @brief Creates an Observable element with source side notification
+   * suppression and adds it to the root Group, see @ref addObservable(const
+   * BuildInfo&, DataType, const ReadCallback&, const IsObservingCallback&)
+   *
+   * The returned NotifyCallback checks every notification with the given
+   * filter and drops the suppressed ones before they are dispatched
+   *
+   * @throws std::invalid_argument - if given NotificationFilterPtr is null
+   *
+   * @param element_info
+   * @param data_type
+   * @param read_cb
+   * @param observe_cb
+   * @param filter - keep a copy to read the suppression counters
+   * @return std::pair<std::string, NotifyCallback>
+   *  - std::string - the ID of the built Observable Element
+   *  - NotifyCallback - callback function to dispatch new value notifications
+   */
+  std::pair<std::string, NotifyCallback> addObservable(
+      const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb,
+      const IsObservingCallback& observe_cb,
+      const NotificationFilterPtr& filter);
+
+  /**
+   * @brief Creates an Observable element with source side notification
+   * suppression and adds it to a given parent Group, see @ref
+   * addObservable(const BuildInfo&, DataType, const ReadCallback&, const
+   * IsObservingCallback&, const NotificationFilterPtr&)
+   *
+   * @param parent_id - result of any addGroup() method call
+   * @param element_info
+   * @param data_type
+   * @param read_cb
+   * @param observe_cb
+   * @param filter - keep a copy to read the suppression counters
+   * @return std::pair<std::string, NotifyCallback>
+   */
+  std::pair<std::string, NotifyCallback> addObservable(
+      const std::string& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      const ReadCallback& read_cb,
+      const IsObservingCallback& observe_cb,
+      const NotificationFilterPtr& filter);
+
   /**
    * @brief Creates a Callable element that returns no value and adds it to the
    * root Group
@@ -356,6 +511,311 @@ struct DeviceBuilder {
       const CancelCallback& cancel_cb,
       const ParameterTypes& parameter_types = {}) = 0;
 
+  /**
+   * @brief Creates a Readable element with a native value callback and adds it
+   * to the root Group, see @ref addReadable(const BuildInfo&, DataType, const
+   * ReadCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param element_info
+   * @param read_cb
+   * @return std::string - the ID of the built Readable Element
+   */
+  template <typename T>
+  std::string addReadable(
+      const BuildInfo& element_info, const TypedReadCallback<T>& read_cb) {
+    return addTypedReadable(std::nullopt, element_info, toAny<T>(read_cb));
+  }
+
+  /**
+   * @brief Creates a Readable element with a native value callback and adds it
+   * to a given parent Group, see @ref addReadable(const std::string&, const
+   * BuildInfo&, DataType, const ReadCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param parent_id - result of any addGroup() method call
+   * @param element_info
+   * @param read_cb
+   * @return std::string - the ID of the built Readable Element
+   */
+  template <typename T>
+  std::string addReadable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      const TypedReadCallback<T>& read_cb) {
+    return addTypedReadable(parent_id, element_info, toAny<T>(read_cb));
+  }
+
+  /**
+   * @brief Creates a Writable element with native value callbacks and adds it
+   * to the root Group, see @ref addWritable(const BuildInfo&, DataType, const
+   * WriteCallback&, const ReadCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param element_info
+   * @param write_cb
+   * @param read_cb
+   * @return std::string - the ID of the built Writable Element
+   */
+  template <typename T>
+  std::string addWritable(const BuildInfo& element_info,
+      const TypedWriteCallback<T>& write_cb,
+      const TypedReadCallback<T>& read_cb = nullptr) {
+    return addTypedWritable(
+        std::nullopt, element_info, toAny<T>(write_cb), toAny<T>(read_cb));
+  }
+
+  /**
+   * @brief Creates a Writable element with native value callbacks and adds it
+   * to a given parent Group, see @ref addWritable(const std::string&, const
+   * BuildInfo&, DataType, const WriteCallback&, const ReadCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param parent_id - result of any addGroup() method call
+   * @param element_info
+   * @param write_cb
+   * @param read_cb
+   * @return std::string - the ID of the built Writable Element
+   */
+  template <typename T>
+  std::string addWritable(const std::string& parent_id,
+      const BuildInfo& element_info,
+      const TypedWriteCallback<T>& write_cb,
+      const TypedReadCallback<T>& read_cb = nullptr) {
+    return addTypedWritable(
+        parent_id, element_info, toAny<T>(write_cb), toAny<T>(read_cb));
+  }
+
+  /**
+   * @brief Creates an Observable element with a native value callback and
+   * adds it to the root Group, see @ref addObservable(const BuildInfo&,
+   * DataType, const ReadCallback&, const IsObservingCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param element_info
+   * @param read_cb
+   * @param observe_cb
+   * @return std::pair<std::string, TypedNotifyCallback<T>>
+   *  - std::string - the ID of the built Observable Element
+   *  - TypedNotifyCallback<T> - callback function to dispatch new native value
+   * notifications
+   */
+  template <typename T>
+  std::pair<std::string, TypedNotifyCallback<T>> addObservable(
+      const BuildInfo& element_info,
+      const TypedReadCallback<T>& read_cb,
+      const IsObservingCallback& observe_cb) {
+    auto [id, notify] = addTypedObservable(
+        std::nullopt, element_info, toAny<T>(read_cb), observe_cb);
+    return {id, std::get<VariantIndexOf_v<T>>(std::move(notify))};
+  }
+
+  /**
+   * @brief Creates an Observable element with a native value callback and
+   * adds it to a given parent Group, see @ref addObservable(const
+   * std::string&, const BuildInfo&, DataType, const ReadCallback&, const
+   * IsObservingCallback&)
+   *
+   * @tparam T - one of the DataVariant alternatives
+   * @param parent_id - result of any addGroup() method call
+   * @param element_info
+   * @param read_cb
+   * @param observe_cb
+   * @return std::pair<std::string, TypedNotifyCallback<T>>
+   *  - std::string - the ID of the built Observable Element
+   *  - TypedNotifyCallback<T> - callback function to dispatch new native value
+   * notifications
+   */
+  template <typename T>
+  std::pair<std::string, TypedNotifyCallback<T>> addObservable(
+      const std::string& parent_id,
+      const BuildInfo& element_info,
+      const TypedReadCallback<T>& read_cb,
+      const IsObservingCallback& observe_cb) {
+    auto [id, notify] = addTypedObservable(
+        parent_id, element_info, toAny<T>(read_cb), observe_cb);
+    return {id, std::get<VariantIndexOf_v<T>>(std::move(notify))};
+  }
+
+  /**
+   * @brief Creates a Readable element from a native value callback
+   *
+   * Default implementation wraps the given callback into a ReadCallback and
+   * calls the matching addReadable() method. Implementations that store
+   * native callbacks should override this method to avoid DataVariant
+   * conversions.
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param read_cb - the held alternative determines the modeled DataType
+   * @return std::string - the ID of the built Readable Element
+   */
+  virtual std::string addTypedReadable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyReadCallback& read_cb);
+
+  /**
+   * @brief Creates a Writable element from native value callbacks, see @ref
+   * addTypedReadable() for default implementation behavior
+   *
+   * @throws std::invalid_argument - if write_cb and read_cb hold different
+   * alternatives
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param write_cb - the held alternative determines the modeled DataType
+   * @param read_cb
+   * @return std::string - the ID of the built Writable Element
+   */
+  virtual std::string addTypedWritable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyWriteCallback& write_cb,
+      const AnyReadCallback& read_cb);
+
+  /**
+   * @brief Creates an Observable element from a native value callback, see
+   * @ref addTypedReadable() for default implementation behavior
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param read_cb - the held alternative determines the modeled DataType
+   * @param observe_cb
+   * @return std::pair<std::string, AnyNotifyCallback>
+   *  - std::string - the ID of the built Observable Element
+   *  - AnyNotifyCallback - callback function to dispatch new native value
+   * notifications, holds the same alternative as read_cb
+   */
+  virtual std::pair<std::string, AnyNotifyCallback> addTypedObservable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      const AnyReadCallback& read_cb,
+      const IsObservingCallback& observe_cb);
+
+  /**
+   * @brief Creates a Readable element from a move-only inline callback
+   *
+   * Default implementation moves the given callback into a shared ReadCallback
+   * and calls the matching addReadable() method. Implementations that store
+   * inline callbacks should override this method to avoid the allocation and
+   * the additional indirection.
+   *
+   * @throws DeviceInfoNotSet - DeviceBuilder::setDeviceInfo() was not called
+   * @throws std::invalid_argument - same as addReadable()
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param data_type
+   * @param read_cb
+   * @return std::string - the ID of the built Readable Element
+   */
+  virtual std::string addInlineReadable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineReadCallback&& read_cb);
+
+  /**
+   * @brief Creates a Writable element from move-only inline callbacks, see
+   * @ref addInlineReadable() for default implementation behavior
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param data_type
+   * @param write_cb
+   * @param read_cb - empty for write-only elements
+   * @return std::string - the ID of the built Writable Element
+   */
+  virtual std::string addInlineWritable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineWriteCallback&& write_cb,
+      InlineReadCallback&& read_cb = nullptr);
+
+  /**
+   * @brief Creates an Observable element from move-only inline callbacks, see
+   * @ref addInlineReadable() for default implementation behavior
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param data_type
+   * @param read_cb
+   * @param observe_cb
+   * @return std::pair<std::string, InlineNotifyCallback>
+   *  - std::string - the ID of the built Observable Element
+   *  - InlineNotifyCallback - callback function to dispatch new value
+   * notifications
+   */
+  virtual std::pair<std::string, InlineNotifyCallback> addInlineObservable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType data_type,
+      InlineReadCallback&& read_cb,
+      InlineIsObservingCallback&& observe_cb);
+
+  /**
+   * @brief Creates a Callable element from move-only inline callbacks, see
+   * @ref addInlineReadable() for default implementation behavior
+   *
+   * Callables with DataType::None as result type and empty asynchronous
+   * execute and cancel callbacks return no value, all other Callables require
+   * all three callbacks
+   *
+   * @param parent_id - result of any addGroup() method call, or std::nullopt
+   * for the root Group
+   * @param element_info
+   * @param result_type
+   * @param execute_cb
+   * @param async_execute_cb
+   * @param cancel_cb
+   * @param parameter_types
+   * @return std::string - the ID of the built Callable Element
+   */
+  virtual std::string addInlineCallable(
+      const std::optional<std::string>& parent_id,
+      const BuildInfo& element_info,
+      DataType result_type,
+      InlineExecuteCallback&& execute_cb,
+      InlineAsyncExecuteCallback&& async_execute_cb = nullptr,
+      InlineCancelCallback&& cancel_cb = nullptr,
+      const ParameterTypes& parameter_types = {});
+
+  /**
+   * @brief Builds a whole device from a flat element table in one call,
+   * declared in DeviceDefinition.hpp
+   *
+   * The default implementation validates the definition with
+   * checkDefinition() and replays it through setDeviceInfo(), addGroup(),
+   * the addInline*() methods and result(). Implementations may override it
+   * to skip the per call parent lookups.
+   *
+   * If any of the replayed calls after setDeviceInfo() throws, the default
+   * implementation calls abandon() before rethrowing the exception, so the
+   * builder is ready for a fresh build. Callbacks that were already moved
+   * into the discarded elements are lost.
+   *
+   * @throws DeviceBuildInProgress - if a device is already being built, the
+   * build in progress is kept in that case
+   * @throws InvalidDefinition - if the definition or its callbacks are
+   * invalid, nothing is built in that case
+   * @throws std::exception - any exception thrown by the replayed calls
+   *
+   * @param definition
+   * @param callbacks - indexed by ElementDefinition::callback, moved into
+   * the built elements
+   * @return BuiltDevice - the built device, element ids and Observable
+   * notify callbacks in definition order
+   */
+  virtual BuiltDevice build(const DeviceDefinition& definition,
+      std::vector<ElementCallbacks> callbacks);
+
   /**
    * @brief Verifies that the device was built correctly and moves the built
    * device instance to the caller, thus reseting the builder for a fresh build
@@ -366,6 +826,42 @@ struct DeviceBuilder {
    * @return std::unique_ptr<Device>
    */
   virtual std::unique_ptr<Device> result() = 0;
+
+  /**
+   * @brief Discards the device that is being built, if any, and resets the
+   * builder for a fresh build
+   *
+   * Called by the default build() implementation when one of its replayed
+   * calls fails. The default implementation does nothing, implementations
+   * that keep build state between calls should override it.
+   */
+  virtual void abandon() noexcept;
+
+private:
+  template <typename T>
+  static AnyReadCallback toAny(const TypedReadCallback<T>& callback) {
+    return AnyReadCallback{std::in_place_index<VariantIndexOf_v<T>>, callback};
+  }
+
+  template <typename T>
+  static AnyWriteCallback toAny(const TypedWriteCallback<T>& callback) {
+    return AnyWriteCallback{
+        std::in_place_index<VariantIndexOf_v<T>>, callback};
+  }
+};
+
+/**
+ * @brief Inline callbacks of a single element, created outside of a
+ * DeviceBuilder call. Only the callbacks, that the matching add*() method
+ * requires, must be set
+ */
+struct ElementCallbacks {
+  DeviceBuilder::InlineReadCallback read;
+  DeviceBuilder::InlineWriteCallback write;
+  DeviceBuilder::InlineIsObservingCallback observe;
+  DeviceBuilder::InlineExecuteCallback execute;
+  DeviceBuilder::InlineAsyncExecuteCallback async_execute;
+  DeviceBuilder::InlineCancelCallback cancel;
 };
 
 using DeviceBuilderPtr = std::shared_ptr<DeviceBuilder>;
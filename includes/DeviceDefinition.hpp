@@ -0,0 +1,149 @@
+#ifndef __STAG_INFORMATION_MODEL_DEVICE_DEFINITION_HPP
+#define __STAG_INFORMATION_MODEL_DEVICE_DEFINITION_HPP
+
+#include "Callable.hpp"
+#include "DataVariant.hpp"
+#include "Device.hpp"
+#include "DeviceBuilder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+/**
+ * @brief ElementDefinition::parent value of root group elements
+ */
+constexpr uint32_t DEFINITION_ROOT = UINT32_MAX;
+
+/**
+ * @brief A single row of a DeviceDefinition element table
+ */
+struct ElementDefinition {
+  /**
+   * @brief Row of the parent Group element, must precede this row.
+   * DEFINITION_ROOT for root group elements
+   */
+  uint32_t parent = DEFINITION_ROOT;
+  BuildInfo info;
+  ElementType type = ElementType::Group;
+  /**
+   * @brief Modeled DataType of Readable, Writable and Observable elements,
+   * result DataType of Callable elements. Ignored for Group elements
+   */
+  DataType data_type = DataType::None;
+  ParameterTypes parameter_types;
+  /**
+   * @brief Position of the element callbacks within the callback table.
+   * Every non Group element uses its own entry, ignored for Group elements
+   */
+  uint32_t callback = 0;
+};
+
+/**
+ * @brief Declarative description of a whole device, built by
+ * DeviceBuilder::build()
+ */
+struct DeviceDefinition {
+  std::string id;
+  BuildInfo info;
+  /**
+   * @brief Elements in build order, parents precede their children
+   */
+  std::vector<ElementDefinition> elements;
+};
+
+/**
+ * @brief Result of DeviceBuilder::build()
+ */
+struct BuiltDevice {
+  std::unique_ptr<Device> device;
+  /**
+   * @brief Element ids, indexed by the definition rows
+   */
+  std::vector<std::string> ids;
+  /**
+   * @brief Notify callbacks of Observable elements, indexed by the
+   * definition rows. Empty for all other elements
+   */
+  std::vector<DeviceBuilder::InlineNotifyCallback> notifiers;
+};
+
+struct InvalidDefinition : public std::invalid_argument {
+  InvalidDefinition(std::size_t row, const std::string& reason)
+      : std::invalid_argument("Element definition " + std::to_string(row) +
+            " is invalid: " + reason) {}
+
+  explicit InvalidDefinition(const std::string& reason)
+      : std::invalid_argument("Device definition is invalid: " + reason) {}
+};
+
+struct DefinitionParseError : public std::runtime_error {
+  DefinitionParseError(
+      std::size_t line, std::size_t column, const std::string& reason)
+      : std::runtime_error("Could not parse device definition at " +
+            std::to_string(line) + ":" + std::to_string(column) + ": " +
+            reason) {}
+};
+
+/**
+ * @brief Validates the structure of a definition, without its callbacks
+ *
+ * Checks parent rows, empty groups and DataTypes.
+ *
+ * @throws InvalidDefinition
+ */
+void checkDefinition(const DeviceDefinition& definition);
+
+/**
+ * @brief Validates a whole definition against its callback table in a
+ * single pass
+ *
+ * Checks parent rows, empty groups, DataTypes, callback indices and that
+ * every element has the callbacks, that the matching DeviceBuilder add*()
+ * method requires.
+ *
+ * @throws InvalidDefinition
+ */
+void checkDefinition(const DeviceDefinition& definition,
+    const std::vector<ElementCallbacks>& callbacks);
+
+/**
+ * @brief Parses a JSON device definition without building a document tree
+ *
+ * Elements are read into the table while the input is streamed. The
+ * expected format is:
+ * @code{.json}
+ * {
+ *   "id": "device", "name": "Device", "description": "",
+ *   "elements": [
+ *     {"name": "Group", "type": "Group"},
+ *     {"parent": 0, "name": "Temperature", "type": "Readable",
+ *      "data_type": "Double", "callback": 0},
+ *     {"name": "Reset", "type": "Callable", "data_type": "None",
+ *      "parameters": [{"position": 1, "type": "Boolean", "mandatory": true}]}
+ *   ]
+ * }
+ * @endcode
+ * Element and DataType names are the enum value names, for example
+ * "Unsigned_Integer". Elements without a parent are root group elements.
+ * Non Group elements without a callback index use the number of preceding
+ * non Group elements as their index. Unknown members are skipped.
+ *
+ * @throws DefinitionParseError - if the input is not a valid definition
+ */
+DeviceDefinition parseDefinition(std::istream& input);
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_DEVICE_DEFINITION_HPP
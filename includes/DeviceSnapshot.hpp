@@ -0,0 +1,146 @@
+#ifndef __STAG_INFORMATION_MODEL_DEVICE_SNAPSHOT_HPP
+#define __STAG_INFORMATION_MODEL_DEVICE_SNAPSHOT_HPP
+
+#include "Device.hpp"
+#include "DeviceBuilder.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+struct SnapshotFormatError : public std::runtime_error {
+  explicit SnapshotFormatError(const std::string& reason)
+      : std::runtime_error("Invalid device snapshot: " + reason) {}
+};
+
+/**
+ * @brief Structure of a single snapshot element, passed to the
+ * CallbackResolver
+ */
+struct SnapshotElement {
+  std::string_view id;
+  ElementType type;
+  /**
+   * @brief Modeled DataType of Readable, Writable and Observable elements,
+   * result DataType of Callable elements
+   */
+  DataType data_type;
+  bool write_only;
+};
+
+/**
+ * @brief Binds the callbacks of a rehydrated element
+ *
+ * Called once per element, when the group, that holds the element, is
+ * accessed for the first time. The NotifyCallback is only set for Observable
+ * elements and stays valid for as long as the element exists.
+ */
+using CallbackResolver = std::function<ElementCallbacks(
+    const SnapshotElement& element, DeviceBuilder::InlineNotifyCallback&&)>;
+
+/**
+ * @brief Serializes the structure of a built device into a snapshot
+ *
+ * Stores ids, names, descriptions, element types, DataTypes and
+ * ParameterTypes of all elements, but no callbacks. Group elements are
+ * stored in breadth first order, so the children of every group are
+ * contiguous.
+ *
+ * @throws std::length_error - if the device holds more than 4 GiB of text
+ * or more than UINT32_MAX elements
+ */
+std::vector<std::byte> writeSnapshot(const Device& device);
+
+/**
+ * @brief Writes the snapshot of a given device into a file
+ *
+ * @throws std::runtime_error - if the file could not be written
+ */
+void saveSnapshot(const Device& device, const std::string& path);
+
+/**
+ * @brief Read only view of a snapshot, created by writeSnapshot()
+ *
+ * A snapshot is a flat, position independent buffer of fixed size records
+ * and a single string pool, that is used in place and never parsed. Element
+ * lookups by id binary search a sorted id index within the buffer. Snapshots
+ * are stored in the native byte order and are not portable between machines
+ * of different endianness.
+ *
+ * Only the header and section sizes are validated when a snapshot is
+ * opened, element records are validated when they are first used.
+ */
+class DeviceSnapshot {
+public:
+  /**
+   * @throws SnapshotFormatError - if the buffer is not a snapshot
+   */
+  explicit DeviceSnapshot(std::vector<std::byte> buffer);
+
+  /**
+   * @brief Uses externally owned snapshot data, for example a memory mapped
+   * region or a shared memory segment
+   *
+   * @throws SnapshotFormatError - if the data is not a snapshot
+   */
+  DeviceSnapshot(std::shared_ptr<const std::byte> data, std::size_t size);
+
+  /**
+   * @brief Memory maps a snapshot file read only. Pages are loaded by the
+   * operating system, when the matching elements are accessed
+   *
+   * @throws std::runtime_error - if the file could not be opened or mapped
+   * @throws SnapshotFormatError - if the file is not a snapshot
+   */
+  static DeviceSnapshot map(const std::string& path);
+
+  std::string deviceId() const;
+
+  /**
+   * @brief Returns the number of all elements, including nested ones and
+   * excluding the root group
+   */
+  std::size_t elementCount() const;
+
+  const std::byte* data() const { return data_.get(); }
+
+  std::size_t size() const { return size_; }
+
+  /**
+   * @brief Creates a Device from the snapshot, without materializing any of
+   * its elements
+   *
+   * Elements of a group are materialized and their callbacks are bound
+   * through the given resolver, when the group is accessed for the first
+   * time. Element lookups materialize only the groups on the path to the
+   * requested element. The returned device shares the ownership of the
+   * snapshot data.
+   *
+   * Exceptions thrown by the resolver and SnapshotFormatError of damaged
+   * records are thrown by the accessing method. The next access continues
+   * with the element, that failed, already materialized elements are not
+   * resolved again.
+   *
+   * @throws std::invalid_argument - if the resolver is empty
+   */
+  std::unique_ptr<Device> rehydrate(CallbackResolver resolver) const;
+
+private:
+  std::shared_ptr<const std::byte> data_;
+  std::size_t size_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_DEVICE_SNAPSHOT_HPP
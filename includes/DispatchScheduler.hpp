@@ -0,0 +1,329 @@
+#ifndef __STAG_INFORMATION_MODEL_DISPATCH_SCHEDULER_HPP
+#define __STAG_INFORMATION_MODEL_DISPATCH_SCHEDULER_HPP
+
+#include "DeviceBuilder.hpp"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup Scheduling Element Scheduling
+ * @{
+ */
+
+/**
+ * @brief Dispatch order of operations on the same device, lower values are
+ * dispatched first
+ */
+enum class DispatchPriority : uint8_t {
+  Critical = 0,
+  High = 1,
+  Normal = 2,
+  Bulk = 3
+};
+
+constexpr std::size_t DISPATCH_PRIORITIES = 4;
+
+std::string toString(DispatchPriority priority);
+
+/**
+ * @brief Limits of operations dispatched to a single device
+ */
+struct DeviceDispatchPolicy {
+  /**
+   * @brief Token bucket refill rate in operations per second, 0 disables
+   * rate limiting
+   */
+  double rate = 0.0;
+  /**
+   * @brief Token bucket capacity, number of operations that can be
+   * dispatched back to back after an idle period
+   */
+  double burst = 1.0;
+  /**
+   * @brief Maximal number of concurrently running operations
+   */
+  std::size_t max_in_flight = 1;
+};
+
+/**
+ * @brief Logarithmic latency histogram
+ *
+ * Bucket 0 counts latencies below 1 us, bucket i counts latencies in
+ * [2^(i-1), 2^i) us, the last bucket also counts all longer latencies
+ */
+class LatencyHistogram {
+public:
+  using Duration = std::chrono::nanoseconds;
+
+  static constexpr std::size_t BUCKETS = 32;
+
+  void record(Duration latency);
+
+  std::size_t count() const { return count_; }
+
+  Duration max() const { return max_; }
+
+  Duration mean() const;
+
+  /**
+   * @brief Returns the upper bound of the bucket, that holds a given quantile
+   *
+   * @param quantile - in the range [0, 1]
+   * @return Duration - 0 if the histogram is empty
+   */
+  Duration percentile(double quantile) const;
+
+  /**
+   * @brief Returns the exclusive upper latency bound of a given bucket
+   */
+  static Duration upperBound(std::size_t bucket);
+
+  const std::array<std::size_t, BUCKETS>& buckets() const { return buckets_; }
+
+private:
+  std::array<std::size_t, BUCKETS> buckets_{};
+  std::size_t count_ = 0;
+  Duration total_{0};
+  Duration max_{0};
+};
+
+struct DispatchSchedulerStopped : public std::logic_error {
+  DispatchSchedulerStopped()
+      : std::logic_error("Dispatch scheduler is not running") {}
+};
+
+struct DispatchStatistics {
+  std::size_t dispatched = 0;
+  std::size_t completed = 0;
+  /**
+   * @brief Operations, that threw an exception, that was not forwarded to a
+   * waiting caller
+   */
+  std::size_t failed = 0;
+  /**
+   * @brief Times a device with queued operations had to wait for a rate limit
+   * token
+   */
+  std::size_t throttled = 0;
+};
+
+/**
+ * @brief Dispatches element callbacks to a shared worker pool, ordered by
+ * priority and limited per device
+ *
+ * Every device has one queue per DispatchPriority. A device is served from
+ * its highest non empty queue, as long as it has less than max_in_flight
+ * running operations and a rate limit token. Devices with work at the same
+ * priority are served round robin, devices with higher priority work are
+ * served first. Throttled devices do not block the workers, they are
+ * revisited once their next token is available.
+ *
+ * The route*() methods wrap DeviceBuilder callbacks, so that every element
+ * access of a device is dispatched through the scheduler. Synchronous
+ * callbacks block their caller until the operation was executed and rethrow
+ * its exceptions. They throw DispatchSchedulerStopped instead of queueing, if
+ * the scheduler was not started or was stopped, because no worker would ever
+ * run the operation. Routed callbacks must not be called from within other
+ * routed callbacks and the scheduler must outlive them.
+ *
+ * Operations, that did not start before stop() is called, are discarded and
+ * their waiting callers receive a std::future_error.
+ */
+class DispatchScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Task = std::function<void()>;
+
+  /**
+   * @throws std::invalid_argument - if workers is 0 or the default policy is
+   * invalid, see setPolicy()
+   */
+  explicit DispatchScheduler(
+      std::size_t workers = std::thread::hardware_concurrency(),
+      const DeviceDispatchPolicy& default_policy = DeviceDispatchPolicy());
+
+  ~DispatchScheduler();
+
+  DispatchScheduler(const DispatchScheduler&) = delete;
+  DispatchScheduler& operator=(const DispatchScheduler&) = delete;
+
+  /**
+   * @brief Sets the limits of a given device, devices without a policy use
+   * the default policy
+   *
+   * @throws std::invalid_argument - if rate is negative, burst is less than 1
+   * or max_in_flight is 0
+   */
+  void setPolicy(
+      const std::string& device_id, const DeviceDispatchPolicy& policy);
+
+  /**
+   * @brief Queues an operation without waiting for it. Exceptions thrown by
+   * the task are counted as failed
+   *
+   * @throws std::invalid_argument - if task is null
+   */
+  void dispatch(
+      const std::string& device_id, DispatchPriority priority, Task task);
+
+  /**
+   * @brief Queues an operation and returns a future of its result
+   */
+  template <typename Function>
+  std::future<std::invoke_result_t<Function>> submit(
+      const std::string& device_id,
+      DispatchPriority priority,
+      Function&& function) {
+    using Result = std::invoke_result_t<Function>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Function>(function));
+    auto result = task->get_future();
+    enqueue(device_id, priority, [task]() { (*task)(); }, false);
+    return result;
+  }
+
+  DeviceBuilder::ReadCallback routeRead(const std::string& device_id,
+      DispatchPriority priority,
+      const DeviceBuilder::ReadCallback& callback);
+
+  DeviceBuilder::WriteCallback routeWrite(const std::string& device_id,
+      DispatchPriority priority,
+      const DeviceBuilder::WriteCallback& callback);
+
+  /**
+   * @brief Returned callback queues the execution without waiting for it
+   */
+  DeviceBuilder::ExecuteCallback routeExecute(const std::string& device_id,
+      DispatchPriority priority,
+      const DeviceBuilder::ExecuteCallback& callback);
+
+  /**
+   * @brief Returned callback waits until the asynchronous call was
+   * dispatched, the result itself is not awaited
+   */
+  DeviceBuilder::AsyncExecuteCallback routeAsyncExecute(
+      const std::string& device_id,
+      DispatchPriority priority,
+      const DeviceBuilder::AsyncExecuteCallback& callback);
+
+  /**
+   * @brief Starts the worker pool
+   */
+  void start();
+
+  /**
+   * @brief Stops the worker pool after the running operations complete,
+   * queued operations are discarded
+   */
+  void stop();
+
+  /**
+   * @brief Returns the number of queued operations, that did not start yet
+   */
+  std::size_t queued() const;
+
+  /**
+   * @brief Returns the time operations of a given priority spent in their
+   * queue before they started
+   */
+  LatencyHistogram queueLatency(DispatchPriority priority) const;
+
+  DispatchStatistics statistics() const;
+
+private:
+  struct Job {
+    Task task;
+    Clock::time_point queued;
+    bool detached;
+  };
+
+  struct Device {
+    DeviceDispatchPolicy policy;
+    double tokens = 0.0;
+    Clock::time_point refilled;
+    std::size_t in_flight = 0;
+    /**
+     * @brief Time at which the next rate limit token becomes available
+     */
+    Clock::time_point wakeup;
+    std::array<std::deque<Job>, DISPATCH_PRIORITIES> lanes;
+    /**
+     * @brief Incremented whenever the device is relisted, older ready and
+     * throttled entries of the device are ignored
+     */
+    uint64_t ticket = 0;
+  };
+
+  struct Entry {
+    Device* device;
+    uint64_t ticket;
+  };
+
+  struct Wakeup {
+    Clock::time_point time;
+    Device* device;
+    uint64_t ticket;
+
+    bool operator>(const Wakeup& other) const { return time > other.time; }
+  };
+
+  /**
+   * @throws DispatchSchedulerStopped - if running_only is set and the
+   * scheduler is not running
+   */
+  void enqueue(const std::string& device_id,
+      DispatchPriority priority,
+      Task task,
+      bool detached,
+      bool running_only = false);
+
+  /**
+   * @brief Queues an operation on a running scheduler and waits for its
+   * result, used by the synchronous routed callbacks
+   */
+  template <typename Function>
+  std::invoke_result_t<Function> await(const std::string& device_id,
+      DispatchPriority priority,
+      Function&& function);
+  Device& deviceOf(const std::string& device_id);
+  void relist(Device& device, Clock::time_point now);
+  bool take(Clock::time_point now, Job& job, Device*& device);
+  void workerLoop();
+
+  std::size_t worker_count_;
+  DeviceDispatchPolicy default_policy_;
+
+  mutable std::mutex mx_;
+  std::unordered_map<std::string, Device> devices_;
+  std::array<std::deque<Entry>, DISPATCH_PRIORITIES> ready_;
+  std::priority_queue<Wakeup, std::vector<Wakeup>, std::greater<>> throttled_;
+  std::array<LatencyHistogram, DISPATCH_PRIORITIES> latency_;
+  DispatchStatistics statistics_;
+  std::size_t queued_ = 0;
+
+  std::condition_variable work_;
+  bool running_ = false;
+  std::vector<std::thread> workers_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_DISPATCH_SCHEDULER_HPP
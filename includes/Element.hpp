@@ -8,6 +8,7 @@
 #include "Readable.hpp"
 #include "Writable.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -54,6 +55,17 @@ struct Element : public virtual MetaInfo {
 
   virtual ElementFunction function() const = 0;
 
+  /**
+   * @brief Returns the structural hash of this element and all of its nested
+   * elements, see StructuralHash.hpp
+   *
+   * Default implementation recomputes the hash of the whole subtree on every
+   * call. Implementations should compute it once, when they are built.
+   *
+   * @return std::size_t
+   */
+  virtual std::size_t structuralHash() const;
+
   friend bool operator==(const ElementPtr& lhs, const ElementPtr& rhs);
 
   friend bool operator!=(const ElementPtr& lhs, const ElementPtr& rhs);
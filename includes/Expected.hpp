@@ -0,0 +1,211 @@
+#ifndef __STAG_INFORMATION_MODEL_EXPECTED_HPP
+#define __STAG_INFORMATION_MODEL_EXPECTED_HPP
+
+#include "DataVariant.hpp"
+
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace Information_Model {
+/**
+ * @addtogroup ErrorHandling Non-throwing Error Handling
+ * @{
+ */
+
+/**
+ * @brief Identifies the exception, that the throwing counterpart of a try*()
+ * method would throw
+ */
+enum class ErrorCode : uint8_t {
+  Element_Not_Found,
+  ID_Points_This_Group,
+  Read_Callback_Unavailable,
+  Non_Readable,
+  Write_Callback_Unavailable,
+  Data_Type_Mismatch,
+  Result_Returning_Not_Supported,
+  Mandatory_Parameter_Has_No_Value,
+  Mandatory_Parameter_Missing,
+  Parameter_Type_Mismatch,
+  Parameter_Does_Not_Exist,
+  Call_Timedout,
+  Call_Canceled,
+  /**
+   * @brief An element callback threw an exception, that is not modeled by
+   * any other ErrorCode
+   */
+  Callback_Failed
+};
+
+std::string toString(ErrorCode code);
+
+/**
+ * @brief Describes a failed operation without formatting its message
+ *
+ * Stores the error code and the values, that the matching exception message
+ * is built from. The message is only formatted when message() is called.
+ */
+class Error {
+public:
+  /**
+   * @param code
+   * @param subject - element id for element errors, Callable name for call
+   * errors
+   * @param position - parameter position or caller id
+   * @param expected - modeled or expected DataType
+   * @param given - requested or given DataType
+   */
+  explicit Error(ErrorCode code,
+      std::string subject = {},
+      uintmax_t position = 0,
+      DataType expected = DataType::None,
+      DataType given = DataType::None);
+
+  /**
+   * @brief Creates an error, that holds an already thrown exception. The
+   * message and raise() use the held exception
+   */
+  Error(ErrorCode code, std::exception_ptr exception);
+
+  ErrorCode code() const { return code_; }
+
+  const std::string& subject() const { return subject_; }
+
+  uintmax_t position() const { return position_; }
+
+  DataType expected() const { return expected_; }
+
+  DataType given() const { return given_; }
+
+  /**
+   * @brief Returns the held exception, null for errors that were not thrown
+   */
+  const std::exception_ptr& exception() const { return exception_; }
+
+  /**
+   * @brief Formats the message of the matching exception
+   */
+  std::string message() const;
+
+  /**
+   * @brief Throws the matching exception
+   */
+  [[noreturn]] void raise() const;
+
+private:
+  ErrorCode code_;
+  DataType expected_;
+  DataType given_;
+  uintmax_t position_;
+  std::string subject_;
+  std::exception_ptr exception_;
+};
+
+/**
+ * @brief Converts a thrown exception into an Error. Exceptions of the
+ * Information Model keep their ErrorCode, all others are reported as
+ * ErrorCode::Callback_Failed
+ *
+ * Used by the default try*() implementations and by implementations, that
+ * call throwing user callbacks
+ */
+Error toError(const std::exception_ptr& exception);
+
+/**
+ * @brief Holds either a value or the Error, that prevented its creation
+ *
+ * @tparam T - value type
+ */
+template <typename T> class [[nodiscard]] Expected {
+public:
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Expected(T value) : state_(std::in_place_index<0>, std::move(value)) {}
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Expected(Error error) : state_(std::in_place_index<1>, std::move(error)) {}
+
+  bool hasValue() const noexcept { return state_.index() == 0; }
+
+  explicit operator bool() const noexcept { return hasValue(); }
+
+  /**
+   * @throws the matching exception of the held Error, see Error::raise()
+   */
+  const T& value() const& {
+    if (!hasValue()) {
+      error().raise();
+    }
+    return *std::get_if<0>(&state_);
+  }
+
+  /**
+   * @throws the matching exception of the held Error, see Error::raise()
+   */
+  T&& value() && {
+    if (!hasValue()) {
+      error().raise();
+    }
+    return std::move(*std::get_if<0>(&state_));
+  }
+
+  template <typename U> T valueOr(U&& fallback) const& {
+    if (hasValue()) {
+      return *std::get_if<0>(&state_);
+    }
+    return static_cast<T>(std::forward<U>(fallback));
+  }
+
+  /**
+   * @attention Must only be called if hasValue() is false
+   */
+  const Error& error() const { return *std::get_if<1>(&state_); }
+
+  const T& operator*() const& { return *std::get_if<0>(&state_); }
+
+  const T* operator->() const { return std::get_if<0>(&state_); }
+
+private:
+  std::variant<T, Error> state_;
+};
+
+/**
+ * @brief Holds the Error of an operation without a result, if it failed
+ */
+template <> class [[nodiscard]] Expected<void> {
+public:
+  Expected() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  Expected(Error error) : error_(std::move(error)) {}
+
+  bool hasValue() const noexcept { return !error_.has_value(); }
+
+  explicit operator bool() const noexcept { return hasValue(); }
+
+  /**
+   * @throws the matching exception of the held Error, see Error::raise()
+   */
+  void value() const {
+    if (error_.has_value()) {
+      error_->raise();
+    }
+  }
+
+  /**
+   * @attention Must only be called if hasValue() is false
+   */
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  const Error& error() const { return *error_; }
+
+private:
+  std::optional<Error> error_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_EXPECTED_HPP
@@ -0,0 +1,174 @@
+#ifndef __STAG_INFORMATION_MODEL_INPLACE_FUNCTION_HPP
+#define __STAG_INFORMATION_MODEL_INPLACE_FUNCTION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+/**
+ * @brief Default inline capacity of InplaceFunction, fits a this pointer and
+ * a couple of ids or a std::function of the used standard library, which
+ * takes 32 bytes with libstdc++ and libc++, but 64 bytes with MSVC
+ */
+constexpr std::size_t INPLACE_FUNCTION_CAPACITY =
+    std::max(4 * sizeof(void*), sizeof(std::function<void()>));
+
+template <typename Signature,
+    std::size_t Capacity = INPLACE_FUNCTION_CAPACITY>
+class InplaceFunction;
+
+/**
+ * @brief Move-only callable wrapper, that stores its target within a fixed
+ * size inline buffer and never allocates
+ *
+ * Targets, that do not fit into Capacity bytes, are rejected at compile time.
+ * Invoking an empty InplaceFunction throws std::bad_function_call, same as
+ * std::function.
+ *
+ * @tparam Result
+ * @tparam Args
+ * @tparam Capacity - inline buffer size in bytes
+ */
+template <typename Result, typename... Args, std::size_t Capacity>
+class InplaceFunction<Result(Args...), Capacity> {
+  template <typename Callable>
+  static constexpr bool IS_TARGET_V =
+      !std::is_same_v<std::decay_t<Callable>, InplaceFunction> &&
+      !std::is_same_v<std::decay_t<Callable>, std::nullptr_t> &&
+      std::is_invocable_r_v<Result, std::decay_t<Callable>&, Args...>;
+
+public:
+  static constexpr std::size_t CAPACITY = Capacity;
+
+  InplaceFunction() noexcept = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  InplaceFunction(std::nullptr_t) noexcept {}
+
+  template <typename Callable,
+      typename = std::enable_if_t<IS_TARGET_V<Callable>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  InplaceFunction(Callable&& callable) {
+    using Target = std::decay_t<Callable>;
+    static_assert(sizeof(Target) <= Capacity,
+        "Callable does not fit into the InplaceFunction capacity");
+    static_assert(alignof(Target) <= alignof(void*),
+        "Callable alignment is not supported");
+    static_assert(std::is_nothrow_move_constructible_v<Target>,
+        "Callable must be nothrow move constructible");
+    if constexpr (std::is_pointer_v<Target> ||
+        std::is_member_pointer_v<Target>) {
+      if (callable == nullptr) {
+        return;
+      }
+    } else if constexpr (std::is_constructible_v<bool, const Target&>) {
+      // empty std::function and similar wrappers stay empty
+      if (!static_cast<bool>(callable)) {
+        return;
+      }
+    }
+    ::new (static_cast<void*>(storage_.data()))
+        Target(std::forward<Callable>(callable));
+    operations_ = &OPERATIONS<Target>;
+  }
+
+  InplaceFunction(InplaceFunction&& other) noexcept
+      : operations_(other.operations_) {
+    if (operations_ != nullptr) {
+      operations_->relocate(other.storage_.data(), storage_.data());
+      other.operations_ = nullptr;
+    }
+  }
+
+  InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.operations_ != nullptr) {
+        other.operations_->relocate(other.storage_.data(), storage_.data());
+        operations_ = std::exchange(other.operations_, nullptr);
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  InplaceFunction(const InplaceFunction&) = delete;
+  InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+  ~InplaceFunction() { reset(); }
+
+  explicit operator bool() const noexcept { return operations_ != nullptr; }
+
+  /**
+   * @throws std::bad_function_call - if empty
+   */
+  Result operator()(Args... args) const {
+    if (operations_ == nullptr) {
+      throw std::bad_function_call();
+    }
+    return operations_->invoke(storage_.data(), std::forward<Args>(args)...);
+  }
+
+private:
+  struct Operations {
+    Result (*invoke)(void*, Args&&...);
+    void (*relocate)(void*, void*) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <typename Target>
+  static Result invokeTarget(void* target, Args&&... args) {
+    if constexpr (std::is_void_v<Result>) {
+      std::invoke(*static_cast<Target*>(target), std::forward<Args>(args)...);
+    } else {
+      return std::invoke(
+          *static_cast<Target*>(target), std::forward<Args>(args)...);
+    }
+  }
+
+  template <typename Target>
+  static void relocateTarget(void* from, void* to) noexcept {
+    auto* source = static_cast<Target*>(from);
+    ::new (to) Target(std::move(*source));
+    source->~Target();
+  }
+
+  template <typename Target> static void destroyTarget(void* target) noexcept {
+    static_cast<Target*>(target)->~Target();
+  }
+
+  template <typename Target>
+  static constexpr Operations OPERATIONS = {&invokeTarget<Target>,
+      &relocateTarget<Target>,
+      &destroyTarget<Target>};
+
+  void reset() noexcept {
+    if (operations_ != nullptr) {
+      operations_->destroy(storage_.data());
+      operations_ = nullptr;
+    }
+  }
+
+  // targets are invoked as non const, same as with std::function
+  alignas(void*) mutable std::array<std::byte, Capacity> storage_;
+  const Operations* operations_ = nullptr;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_INPLACE_FUNCTION_HPP
@@ -0,0 +1,164 @@
+#ifndef __STAG_INFORMATION_MODEL_LIVE_DEVICE_HPP
+#define __STAG_INFORMATION_MODEL_LIVE_DEVICE_HPP
+
+#include "Device.hpp"
+#include "Observable.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+namespace detail {
+struct LiveGroup;
+struct LiveSubscribers;
+} // namespace detail
+
+/**
+ * @brief Structural change of a LiveDevice, published after every update
+ */
+struct StructureChange {
+  /**
+   * @brief Device version, that contains this change
+   */
+  uint64_t version = 0;
+  /**
+   * @brief Ids of all added elements, including nested ones, parents precede
+   * their children
+   */
+  std::vector<std::string> added;
+  /**
+   * @brief Ids of all removed elements, including nested ones, parents
+   * precede their children
+   */
+  std::vector<std::string> removed;
+};
+
+/**
+ * @brief Device, that adds and removes elements while it is in use
+ *
+ * Element ids follow the same positional scheme as ArenaDevice ids, for
+ * example "device:1.0". Positions are never reused within a group, so
+ * removing an element does not change the ids of its siblings. Updates keep
+ * the identity of all untouched elements, ElementPtr and GroupPtr instances
+ * held by consumers stay valid and groups show their new elements.
+ *
+ * Every group publishes an immutable child table. Updates copy the table of
+ * the changed group only and publish it with a single atomic pointer store,
+ * id lookups walk the tables without a device wide index. Readers never wait
+ * for an update to finish and always see either the previous or the new
+ * child table of a group. Updates are serialized.
+ */
+class LiveDevice final : public Device {
+public:
+  using ChangeCallback = std::function<void(const StructureChange&)>;
+
+  /**
+   * @brief Adopts the structure of a built device
+   *
+   * Elements are numbered in Group::asVector() order, so ArenaDevice element
+   * ids stay the same. Element functions are shared with the given device.
+   *
+   * @throws GroupEmpty - if the given device contains an empty group
+   */
+  explicit LiveDevice(const Device& device);
+
+  ~LiveDevice() override;
+
+  LiveDevice(const LiveDevice&) = delete;
+  LiveDevice& operator=(const LiveDevice&) = delete;
+
+  std::string id() const final;
+
+  std::string name() const final;
+
+  std::string description() const final;
+
+  GroupPtr group() const final;
+
+  size_t size() const final;
+
+  ElementPtr element(const std::string& ref_id) const final;
+
+  Expected<ElementPtr> tryElement(const std::string& ref_id) const final;
+
+  void visit(const Group::Visitor& visitor) const final;
+
+  /**
+   * @brief Returns the structural hash, that is updated along the path of
+   * every changed group before the change is published to subscribers
+   *
+   * Readers, that race with an update, may see the hash of a partially
+   * updated path.
+   */
+  size_t structuralHash() const final;
+
+  /**
+   * @brief Returns the number of published updates
+   */
+  uint64_t version() const;
+
+  /**
+   * @brief Adds all root group elements of a module device to the given
+   * group, or to the root group if no parent id is given
+   *
+   * The module is built with any DeviceBuilder, its id is not used. Added
+   * elements get the next free positions of the parent group and share
+   * their element functions with the module.
+   *
+   * @throws std::invalid_argument - if the parent group does not exist
+   * @throws GroupEmpty - if the module contains an empty group
+   */
+  StructureChange add(
+      const std::optional<std::string>& parent_id, const Device& module);
+
+  /**
+   * @brief Removes an element and all of its nested elements
+   *
+   * Removed elements stay valid for as long as consumers hold them.
+   *
+   * @throws ElementNotFound - if the element does not exist
+   * @throws IDPointsThisGroup - if the id is the root group id
+   * @throws GroupEmpty - if the removal would leave its group empty
+   */
+  StructureChange remove(const std::string& ref_id);
+
+  /**
+   * @brief Attaches a callback, that is called with every StructureChange
+   *
+   * Callbacks are called on the updating thread in version order, after the
+   * change was published, and must not update this device.
+   *
+   * @param change_cb - called after every update
+   * @param handler - called when change_cb throws an exception
+   * @return ObserverPtr - the subscription ends when it is destroyed
+   */
+  [[nodiscard]] ObserverPtr subscribe(const ChangeCallback& change_cb,
+      const Observable::ExceptionHandler& handler = nullptr);
+
+private:
+  StructureChange publish(StructureChange&& change);
+
+  std::string id_;
+  std::string name_;
+  std::string description_;
+  std::shared_ptr<detail::LiveGroup> root_;
+  std::mutex update_mx_;
+  std::atomic<uint64_t> version_{0};
+  std::shared_ptr<detail::LiveSubscribers> subscribers_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_LIVE_DEVICE_HPP
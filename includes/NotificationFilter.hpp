@@ -0,0 +1,134 @@
+#ifndef __STAG_INFORMATION_MODEL_NOTIFICATION_FILTER_HPP
+#define __STAG_INFORMATION_MODEL_NOTIFICATION_FILTER_HPP
+
+#include "DataVariant.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup ObservableModeling Observable Metric Modelling
+ * @{
+ */
+
+/**
+ * @brief Configures which Observable notifications are dropped at the source,
+ * before they are dispatched to any observers
+ *
+ * All checks are disabled by default. The first notification is always
+ * dispatched, every other notification is compared against the last
+ * dispatched one.
+ */
+struct SuppressionPolicy {
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @brief Drops notifications that are equal to the last dispatched value
+   *
+   * Scalar values are compared with compare(const DataVariant&, const
+   * DataVariant&). String, Opaque and array values are compared byte by
+   * byte against a copy of the last dispatched payload
+   */
+  bool suppress_unchanged = false;
+  /**
+   * @brief Drops numeric notifications, that differ from the last dispatched
+   * value by no more than this amount. 0 disables the check
+   */
+  double absolute_deadband = 0;
+  /**
+   * @brief Drops numeric notifications, that differ from the last dispatched
+   * value by no more than this percentage of the last dispatched value. 0
+   * disables the check
+   */
+  double percent_deadband = 0;
+  /**
+   * @brief Drops notifications, that arrive sooner than this interval after
+   * the last dispatched one. 0 disables the check
+   */
+  Clock::duration min_interval{0};
+};
+
+/**
+ * @brief Notification counts of a NotificationFilter, each notification is
+ * counted once, for the first check that dropped it
+ */
+struct SuppressionCounters {
+  std::size_t dispatched = 0;
+  std::size_t unchanged = 0;
+  std::size_t deadband = 0;
+  std::size_t interval = 0;
+
+  std::size_t suppressed() const { return unchanged + deadband + interval; }
+};
+
+/**
+ * @brief Applies a SuppressionPolicy to a sequence of notifications
+ *
+ * Checks are safe to call from multiple threads and only allocate, when an
+ * unchanged check has to remember a payload, that is larger than every
+ * previously dispatched one. Built via
+ * DeviceBuilder::addObservable() overloads that take a NotificationFilterPtr,
+ * callers keep the pointer to read the suppression counters
+ */
+class NotificationFilter {
+public:
+  /**
+   * @throws std::invalid_argument - if any of the policy deadbands or the
+   * minimum interval is negative
+   */
+  explicit NotificationFilter(const SuppressionPolicy& policy);
+
+  /**
+   * @brief Checks if a given notification should be dispatched and records it
+   * as the last dispatched value if it should
+   *
+   * @param value
+   * @return true - if value should be dispatched
+   */
+  bool admit(const DataVariant& value);
+
+  bool admit(
+      const DataVariant& value, SuppressionPolicy::Clock::time_point now);
+
+  SuppressionCounters counters() const;
+
+  /**
+   * @brief Forgets the last dispatched value and clears the counters, the next
+   * notification is always dispatched
+   */
+  void reset();
+
+  const SuppressionPolicy& policy() const { return policy_; }
+
+private:
+  bool unchanged(const DataVariant& value) const;
+  bool withinDeadband(const DataVariant& value) const;
+  void remember(const DataVariant& value);
+
+  SuppressionPolicy policy_;
+  mutable std::mutex mx_;
+  SuppressionCounters counters_;
+  std::optional<SuppressionPolicy::Clock::time_point> last_dispatch_;
+  std::size_t last_index_ = 0;
+  /**
+   * @brief Last dispatched scalar value, not used for sequence alternatives
+   */
+  DataVariant last_scalar_;
+  /**
+   * @brief Bytes of the last dispatched sequence value, only kept if
+   * unchanged values are suppressed
+   */
+  std::vector<std::byte> last_payload_;
+};
+
+using NotificationFilterPtr = std::shared_ptr<NotificationFilter>;
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_NOTIFICATION_FILTER_HPP
@@ -74,6 +74,43 @@ struct Observable {
 };
 
 using ObservablePtr = std::shared_ptr<Observable>;
+
+/**
+ * @brief A typed view of an observable metric, that dispatches native values
+ * instead of a DataVariant
+ *
+ * Obtained via toTypedObservable() for Observable elements, that model
+ * DataTypeOf_v<T> values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ */
+template <typename T> struct TypedObservable {
+  using ObserveCallback = std::function<void(const T&)>;
+  using ExceptionHandler = Observable::ExceptionHandler;
+
+  virtual ~TypedObservable() = default;
+
+  /**
+   * @brief Read the latest available metric value, see @ref Observable::read()
+   *
+   * @return T
+   */
+  virtual T read() const = 0;
+
+  /**
+   * @brief Attach a new observer to this source, see @ref
+   * Observable::subscribe()
+   *
+   * @param observe_cb - called when new notification is available
+   * @param handler - called when observe_cb throws an exception
+   * @return ObserverPtr
+   */
+  [[nodiscard]] virtual ObserverPtr subscribe(
+      const ObserveCallback& observe_cb, const ExceptionHandler& handler) = 0;
+};
+
+template <typename T>
+using TypedObservablePtr = std::shared_ptr<TypedObservable<T>>;
 /** @}*/
 } // namespace Information_Model
 
@@ -0,0 +1,132 @@
+#ifndef __STAG_INFORMATION_MODEL_PENDING_CALL_REGISTRY_HPP
+#define __STAG_INFORMATION_MODEL_PENDING_CALL_REGISTRY_HPP
+
+#include "Callable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup ExecutableModeling Callable Modelling
+ * @{
+ */
+
+/**
+ * @brief Stores the result promises of pending asynchronous Callable calls
+ * and allocates their caller ids
+ *
+ * Calls are spread over independently locked shards by a lock-free round
+ * robin counter. A caller id encodes its shard, its slot within the shard and
+ * the slot generation, so completing or cancelling a call is a direct slot
+ * access without hashing. Slots are reused, so apart from the promise state,
+ * registering a call does not allocate once the shards have grown to the
+ * number of concurrently pending calls.
+ *
+ * Callable implementations use emplace() in Callable::asyncCall() and
+ * cancel() in Callable::cancelAsyncCall(), throwing CallerNotFound if it
+ * returns false. Calls with deadlines are tracked by CallDeadlineManager.
+ *
+ * Only the shard selection is lock-free, caller ids are allocated from the
+ * slot free list of the selected shard under its lock.
+ */
+class PendingCallRegistry {
+public:
+  using CallId = uintmax_t;
+
+  /**
+   * @throws std::invalid_argument - if shards is 0
+   *
+   * @param name - Callable name, used in exception messages
+   * @param shards - rounded up to a power of two
+   */
+  explicit PendingCallRegistry(
+      const std::string& name, std::size_t shards = 16);
+
+  /**
+   * @brief Pending calls throw CallCanceled
+   */
+  ~PendingCallRegistry();
+
+  PendingCallRegistry(const PendingCallRegistry&) = delete;
+  PendingCallRegistry& operator=(const PendingCallRegistry&) = delete;
+
+  /**
+   * @brief Registers a new pending call
+   *
+   * @throws std::length_error - if a shard has no more free slots
+   *
+   * @return ResultFuture - with a new caller id
+   */
+  [[nodiscard]] ResultFuture emplace();
+
+  /**
+   * @brief Resolves a pending call with a result
+   *
+   * @return true - if the call was pending
+   */
+  bool complete(CallId id, const DataVariant& result);
+
+  /**
+   * @brief Resolves a pending call with an exception
+   *
+   * @return true - if the call was pending
+   */
+  bool fail(CallId id, const std::exception_ptr& error);
+
+  /**
+   * @brief Resolves a pending call with CallCanceled
+   *
+   * @return true - if the call was pending
+   */
+  bool cancel(CallId id);
+
+  bool contains(CallId id) const;
+
+  /**
+   * @brief Returns the number of pending calls
+   */
+  std::size_t size() const;
+
+  std::size_t shards() const { return shard_count_; }
+
+private:
+  struct Slot {
+    std::optional<std::promise<DataVariant>> result;
+    uint32_t generation = 1;
+  };
+
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  struct alignas(64) Shard {
+    mutable std::mutex mx;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free;
+    std::size_t active = 0;
+  };
+
+  /**
+   * @brief Removes a pending call and moves its promise out
+   *
+   * @return true - if the call was pending
+   */
+  bool release(CallId id, std::promise<DataVariant>& result);
+
+  std::string name_;
+  std::size_t shard_count_;
+  unsigned shard_bits_;
+  std::unique_ptr<Shard[]> shards_;
+  std::atomic<std::size_t> next_{0};
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_PENDING_CALL_REGISTRY_HPP
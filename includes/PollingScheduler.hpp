@@ -0,0 +1,307 @@
+#ifndef __STAG_INFORMATION_MODEL_POLLING_SCHEDULER_HPP
+#define __STAG_INFORMATION_MODEL_POLLING_SCHEDULER_HPP
+
+#include "DataVariant.hpp"
+#include "Readable.hpp"
+#include "TimerWheel.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup Scheduling Element Scheduling
+ * @{
+ */
+
+/**
+ * @brief Result of a single scheduled read
+ */
+struct PollResult {
+  /**
+   * @brief Registration, see PollingScheduler::add()
+   */
+  uint64_t id;
+  /**
+   * @brief Read value, holds no meaningful value if error is set
+   */
+  DataVariant value;
+  /**
+   * @brief Exception, thrown by Readable::read()
+   */
+  std::exception_ptr error;
+};
+
+/**
+ * @brief Reads of the same device, that were due at the same tick and were
+ * executed back to back by a single worker
+ */
+struct PollBatch {
+  using Clock = std::chrono::steady_clock;
+
+  std::string device_id;
+  Clock::time_point deadline;
+  Clock::time_point started;
+  std::vector<PollResult> results;
+};
+
+/**
+ * @brief Counters and timing of a PollingScheduler
+ */
+struct PollingStatistics {
+  using Duration = std::chrono::nanoseconds;
+
+  std::size_t batches = 0;
+  std::size_t reads = 0;
+  std::size_t failures = 0;
+  /**
+   * @brief Reads, that were dispatched in a batch with other reads
+   */
+  std::size_t coalesced = 0;
+  /**
+   * @brief Polls, that were skipped because the previous read of the same
+   * element was still in progress or the scheduler fell behind
+   */
+  std::size_t overruns = 0;
+  /**
+   * @brief Delay between a batch deadline and its execution start
+   */
+  Duration max_jitter{0};
+  Duration total_jitter{0};
+  /**
+   * @brief Delay between a tick and the moment the timer thread processed it
+   */
+  Duration max_drift{0};
+
+  Duration meanJitter() const {
+    return batches == 0 ? Duration{0}
+                        : total_jitter / static_cast<int64_t>(batches);
+  }
+};
+
+struct StopFromSchedulerThread : public std::logic_error {
+  StopFromSchedulerThread()
+      : std::logic_error(
+            "Polling scheduler can not be stopped from its own threads") {}
+};
+
+/**
+ * @brief Polls Readable elements at individual intervals from a single timer
+ * thread and a bounded worker pool
+ *
+ * Registrations are kept on a TimerWheel and the timer thread sleeps until
+ * the next registration is due, so its overhead does not depend on the
+ * number of registered elements or the wheel resolution. Deadlines are
+ * aligned to multiples of the registration interval since the scheduler
+ * epoch, so elements of the same device with the same interval become due at
+ * the same tick and are read as a single PollBatch. Deadlines never drift,
+ * polls that can not start because the previous read of the same element is
+ * still running are skipped and counted as overruns.
+ *
+ * The scheduler can also be driven manually by calling poll() without
+ * calling start(), in which case batches are read on the thread that calls
+ * poll(). A started scheduler with 0 workers reads batches on the timer
+ * thread. Deadlines, that passed while the scheduler was stopped, are moved to
+ * the next aligned deadline by start() and are not counted as overruns.
+ */
+class PollingScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  using PollId = uint64_t;
+  /**
+   * @brief Called with every executed batch, on the worker thread that read
+   * it. Exceptions thrown by the handler are ignored
+   */
+  using BatchHandler = std::function<void(const PollBatch&)>;
+  /**
+   * @brief Called with every result of a single registration, before the
+   * BatchHandler is called. Exceptions thrown by the handler are ignored
+   */
+  using ReadHandler = std::function<void(const PollResult&)>;
+
+  /**
+   * @throws std::invalid_argument - if handler is null or resolution is not
+   * positive
+   *
+   * @param handler
+   * @param workers - number of worker threads, started by start()
+   * @param resolution - timer wheel tick duration
+   */
+  explicit PollingScheduler(const BatchHandler& handler,
+      std::size_t workers = std::thread::hardware_concurrency(),
+      Clock::duration resolution = std::chrono::milliseconds(1));
+
+  ~PollingScheduler();
+
+  PollingScheduler(const PollingScheduler&) = delete;
+  PollingScheduler& operator=(const PollingScheduler&) = delete;
+
+  /**
+   * @brief Schedules periodic reads of a given element
+   *
+   * @throws std::invalid_argument - if readable is null or interval is shorter
+   * than the resolution
+   *
+   * @param device_id - reads of the same device are coalesced
+   * @param readable
+   * @param interval - rounded down to a multiple of the resolution
+   * @return PollId
+   */
+  PollId add(const std::string& device_id,
+      const ReadablePtr& readable,
+      Clock::duration interval);
+
+  /**
+   * @brief Schedules periodic reads of a given element, see @ref add(const
+   * std::string&, const ReadablePtr&, Clock::duration)
+   *
+   * @param device_id - reads of the same device are coalesced
+   * @param readable
+   * @param interval - rounded down to a multiple of the resolution
+   * @param on_read - called with every result of this element, can be null
+   * @return PollId
+   */
+  PollId add(const std::string& device_id,
+      const ReadablePtr& readable,
+      Clock::duration interval,
+      const ReadHandler& on_read);
+
+  /**
+   * @brief Changes the polling interval of a given element. The next poll is
+   * aligned to the new interval
+   *
+   * @throws std::invalid_argument - if interval is shorter than the
+   * resolution
+   *
+   * @return true - if the registration existed
+   */
+  bool setInterval(PollId id, Clock::duration interval);
+
+  /**
+   * @brief Returns the polling interval of a given element, if the
+   * registration exists
+   */
+  std::optional<Clock::duration> interval(PollId id) const;
+
+  /**
+   * @brief Stops polling a given element, an already running read still
+   * completes
+   *
+   * @return true - if the registration existed
+   */
+  bool remove(PollId id);
+
+  std::size_t size() const;
+
+  /**
+   * @brief Starts the timer thread and the worker pool
+   */
+  void start();
+
+  /**
+   * @brief Stops the timer thread and the worker pool, queued batches that
+   * did not start yet are discarded
+   *
+   * @throws StopFromSchedulerThread - if called from a handler, that runs on
+   * the timer thread or a worker thread
+   */
+  void stop();
+
+  /**
+   * @brief Reads all elements, that are due at a given time. Used by the
+   * timer thread and must not be called while the scheduler is started
+   */
+  void poll(Clock::time_point now);
+
+  /**
+   * @brief Returns the time of tick 0
+   */
+  Clock::time_point epoch() const { return epoch_; }
+
+  Clock::duration resolution() const { return resolution_; }
+
+  PollingStatistics statistics() const;
+
+private:
+  struct Registration {
+    uint32_t device = 0;
+    uint32_t generation = 0;
+    ReadablePtr readable;
+    ReadHandler on_read;
+    uint64_t interval = 0;
+    TimerWheel::TimerId timer = 0;
+    uint64_t deadline = 0;
+    bool active = false;
+    bool in_flight = false;
+  };
+
+  struct Read {
+    PollId id;
+    ReadablePtr readable;
+    ReadHandler on_read;
+  };
+
+  struct Task {
+    const std::string* device_id;
+    uint64_t deadline;
+    std::vector<Read> reads;
+  };
+
+  uint64_t ticksOf(Clock::duration interval) const;
+  uint64_t tickOf(Clock::time_point time) const;
+  uint64_t currentTick() const;
+  uint64_t alignedDeadline(uint64_t ticks) const;
+  void wakeTimer(uint64_t deadline);
+  bool onSchedulerThread() const;
+  Clock::time_point timeOf(uint64_t tick) const;
+  bool matches(PollId id) const;
+  void collect(uint64_t tick, std::vector<Task>& tasks);
+  void execute(Task& task);
+  void timerLoop();
+  void workerLoop();
+
+  BatchHandler handler_;
+  std::size_t worker_count_;
+  Clock::duration resolution_;
+  Clock::time_point epoch_;
+
+  mutable std::mutex mx_;
+  TimerWheel wheel_;
+  std::vector<Registration> registrations_;
+  std::vector<uint32_t> free_;
+  std::size_t active_ = 0;
+  std::unordered_map<std::string, uint32_t> device_ids_;
+  std::deque<std::string> devices_;
+  std::vector<TimerWheel::Expiry> expired_;
+  std::vector<std::pair<uint32_t, uint64_t>> due_;
+  PollingStatistics statistics_;
+
+  std::condition_variable work_;
+  std::condition_variable stopped_;
+  /**
+   * @brief Tick, until which the timer thread sleeps
+   */
+  uint64_t wakeup_ = UINT64_MAX;
+  std::deque<Task> queue_;
+  bool running_ = false;
+  std::thread timer_;
+  std::vector<std::thread> workers_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_POLLING_SCHEDULER_HPP
@@ -2,6 +2,7 @@
 #define __STAG_INFORMATION_MODEL_READABLE_HPP
 
 #include "DataVariant.hpp"
+#include "Expected.hpp"
 
 #include <memory>
 #include <stdexcept>
@@ -47,9 +48,50 @@ struct Readable {
    * @return DataVariant
    */
   virtual DataVariant read() const = 0;
+
+  /**
+   * @brief Reads the latest available metric value without throwing
+   *
+   * Default implementation calls read() and converts thrown exceptions with
+   * toError(). It still throws and unwinds internally on every failure, so it
+   * is no cheaper than read(). Implementations must override it to report
+   * failures without throwing.
+   *
+   * @return Expected<DataVariant> - holds ErrorCode::Read_Callback_Unavailable
+   * or ErrorCode::Callback_Failed on failure
+   */
+  virtual Expected<DataVariant> tryRead() const;
 };
 
 using ReadablePtr = std::shared_ptr<Readable>;
+
+/**
+ * @brief A typed view of a readable metric, that returns native values instead
+ * of a DataVariant
+ *
+ * Obtained via toTypedReadable() for Readable, Writable and Observable
+ * elements, that model DataTypeOf_v<T> values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ */
+template <typename T> struct TypedReadable {
+  virtual ~TypedReadable() = default;
+
+  /**
+   * @brief Read the latest available metric value
+   *
+   * @throws NonReadable - if the modeled metric is write-only
+   * @throws ReadCallbackUnavailable - if internal callback does not exist
+   * @throws std::runtime_error - if internal callback encountered an
+   * error. May cause @ref Deregistration
+   *
+   * @return T
+   */
+  virtual T read() const = 0;
+};
+
+template <typename T>
+using TypedReadablePtr = std::shared_ptr<TypedReadable<T>>;
 /** @}*/
 } // namespace Information_Model
 
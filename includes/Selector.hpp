@@ -0,0 +1,136 @@
+#ifndef __STAG_INFORMATION_MODEL_SELECTOR_HPP
+#define __STAG_INFORMATION_MODEL_SELECTOR_HPP
+
+#include "Device.hpp"
+#include "Element.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+struct InvalidSelector : public std::invalid_argument {
+  InvalidSelector(const std::string& pattern, const std::string& reason)
+      : std::invalid_argument(
+            "Selector " + pattern + " is invalid. " + reason) {}
+};
+
+namespace detail {
+/**
+ * @brief Matches a single reference id level
+ *
+ * The level pattern is split into literal pieces at its * wildcards, so a
+ * pattern without wildcards consists of a single piece.
+ */
+struct LevelPattern {
+  std::vector<std::string> pieces;
+  /**
+   * @brief Set for ** levels, which match any number of whole levels
+   */
+  bool any_levels = false;
+
+  bool literal() const noexcept { return !any_levels && pieces.size() == 1; }
+
+  bool matches(std::string_view level) const noexcept;
+};
+} // namespace detail
+
+/**
+ * @brief A reference id pattern, compiled once and used to select elements
+ * of one or many devices
+ *
+ * Patterns follow the reference id naming convention: a device id pattern, a
+ * colon and a dot separated element path pattern, for example
+ * `*:power.phase_*.voltage` or `dev42:**`. Each path level is matched
+ * against the relative reference id of an element within its group, which is
+ * the key of that element in Group::asMap(). Within a level, `*` matches any,
+ * possibly empty, sequence of characters. A level that only consists of `**`
+ * matches any number of levels, including none. The device id pattern is
+ * matched as a single level.
+ *
+ * The element path is compiled into an automaton with one state per path
+ * level, which is run over the element levels with bit masks of active
+ * states. select() only descends into groups, while some state can still
+ * consume the levels below them, and looks literal levels up with
+ * Device::tryElement(), instead of visiting all of their siblings.
+ */
+class Selector {
+public:
+  static constexpr std::size_t MAX_LEVELS = 63;
+
+  /**
+   * @throws InvalidSelector - if the pattern has no colon, an empty device
+   * id pattern or level, a `**` wildcard anywhere but as a whole path level,
+   * or more than MAX_LEVELS path levels
+   */
+  explicit Selector(const std::string& pattern);
+
+  const std::string& pattern() const noexcept { return pattern_; }
+
+  bool matchesDevice(std::string_view device_id) const noexcept;
+
+  /**
+   * @brief Checks if a given element reference id matches this selector
+   *
+   * The root group id, that ends with the colon, never matches.
+   */
+  bool matches(std::string_view ref_id) const noexcept;
+
+  /**
+   * @brief Returns all matching elements of a given device in no particular
+   * order
+   *
+   * @return std::vector<ElementPtr> - empty if the device id does not match
+   */
+  std::vector<ElementPtr> select(const Device& device) const;
+
+  /**
+   * @brief Returns all matching elements of the given devices, grouped by
+   * device in the given device order
+   *
+   * @return std::vector<ElementPtr>
+   */
+  std::vector<ElementPtr> select(const std::vector<DevicePtr>& devices) const;
+
+private:
+  using States = std::uint64_t;
+
+  States step(States states, std::string_view level) const noexcept;
+
+  void selectIn(const Device& device,
+      const GroupPtr& group,
+      const std::string& prefix,
+      States states,
+      std::vector<ElementPtr>& selected) const;
+
+  void selectElement(const Device& device,
+      const ElementPtr& element,
+      const std::string& id,
+      std::string_view level,
+      States states,
+      std::vector<ElementPtr>& selected) const;
+
+  std::string pattern_;
+  detail::LevelPattern device_;
+  std::vector<detail::LevelPattern> levels_;
+  /**
+   * @brief States reachable from each state without consuming a level,
+   * through ** levels, that match no levels
+   */
+  std::vector<States> closures_;
+  States any_levels_ = 0;
+  States literals_ = 0;
+  States accepting_ = 0;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_SELECTOR_HPP
@@ -0,0 +1,203 @@
+#ifndef __STAG_INFORMATION_MODEL_SERIES_COMPRESSION_HPP
+#define __STAG_INFORMATION_MODEL_SERIES_COMPRESSION_HPP
+
+#include "AlignedAllocator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DataTypeModelling Data Type Modelling
+ * @{
+ */
+
+namespace detail {
+/**
+ * @brief Appends bit fields to a word buffer, least significant bit first
+ */
+struct BitWriter {
+  void write(uint64_t value, unsigned count);
+
+  std::size_t bitSize() const { return bits; }
+
+  std::vector<uint64_t> words;
+  std::size_t bits = 0;
+};
+
+/**
+ * @brief Reads bit fields, written by a BitWriter
+ */
+struct BitReader {
+  BitReader(const std::vector<uint64_t>& source, std::size_t position)
+      : words(source.data()), bits(position) {}
+
+  uint64_t read(unsigned count);
+
+  bool readBit() { return read(1) != 0; }
+
+  const uint64_t* words;
+  std::size_t bits;
+};
+
+/**
+ * @brief Gorilla XOR codec for double values
+ *
+ * Each value is XORed with its predecessor, only the meaningful bits of the
+ * result are stored. Repeating values take a single bit.
+ */
+struct XorDoubleCodec {
+  using Value = double;
+
+  struct State {
+    uint64_t previous = 0;
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    bool first = true;
+    bool has_window = false;
+  };
+
+  static void encode(BitWriter& writer, State& state, double value);
+
+  static double decode(BitReader& reader, State& state);
+};
+
+/**
+ * @brief Delta-of-delta codec for timestamps in microseconds
+ *
+ * Stores the change between consecutive sampling intervals, so periodically
+ * sampled timestamps take a single bit
+ */
+struct DeltaOfDeltaCodec {
+  using Value = int64_t;
+
+  struct State {
+    uint64_t previous = 0;
+    uint64_t previous_delta = 0;
+    bool first = true;
+  };
+
+  static void encode(BitWriter& writer, State& state, int64_t value);
+
+  static int64_t decode(BitReader& reader, State& state);
+};
+
+/**
+ * @brief Zigzag varint codec for integer values
+ *
+ * Stores the difference to the previous value as a zigzag encoded variable
+ * length integer, so slowly changing values take a single byte
+ */
+struct ZigZagVarintCodec {
+  using Value = intmax_t;
+
+  struct State {
+    uint64_t previous = 0;
+  };
+
+  static void encode(BitWriter& writer, State& state, intmax_t value);
+
+  static intmax_t decode(BitReader& reader, State& state);
+};
+} // namespace detail
+
+/**
+ * @brief Append only, block compressed value series
+ *
+ * Values are encoded into independent blocks of a fixed number of values, so
+ * any value can be decoded by only decoding its block
+ *
+ * @tparam Codec - one of XorDoubleCodec, DeltaOfDeltaCodec or
+ * ZigZagVarintCodec
+ */
+template <typename Codec> class CompressedSeries {
+public:
+  using Value = typename Codec::Value;
+
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024;
+
+  /**
+   * @brief Construct a new empty series
+   *
+   * @throws std::invalid_argument - if block_size is 0
+   *
+   * @param block_size - number of values per independently decodable block
+   */
+  explicit CompressedSeries(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  void append(Value value);
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  std::size_t blockSize() const { return block_size_; }
+
+  std::size_t blockCount() const { return block_offsets_.size(); }
+
+  /**
+   * @brief Returns the number of bytes used by the encoded values and the
+   * block directory
+   */
+  std::size_t compressedSize() const;
+
+  /**
+   * @brief Decodes a single value
+   *
+   * @throws std::out_of_range - if index is not less than size()
+   */
+  Value at(std::size_t index) const;
+
+  /**
+   * @brief Decodes a range of values into a given native array
+   *
+   * Decoding starts at the block, that contains the first value
+   *
+   * @param first - index of the first decoded value
+   * @param count - maximum number of decoded values
+   * @param output - must have space for count values
+   * @return std::size_t - number of decoded values, can be less than count if
+   * the series ends earlier
+   */
+  std::size_t decode(std::size_t first, std::size_t count, Value* output) const;
+
+  /**
+   * @brief Decodes all values into a new native array
+   */
+  AlignedVector<Value> decodeAll() const;
+
+  void clear();
+
+private:
+  std::size_t block_size_;
+  std::size_t size_ = 0;
+  detail::BitWriter writer_;
+  typename Codec::State state_;
+  std::vector<std::size_t> block_offsets_;
+};
+
+/**
+ * @brief Gorilla XOR compressed Double values
+ */
+using CompressedDoubles = CompressedSeries<detail::XorDoubleCodec>;
+
+/**
+ * @brief Delta-of-delta compressed timestamps, as microseconds since the UNIX
+ * epoch, see toEpochMicroseconds()
+ */
+using CompressedTimestamps = CompressedSeries<detail::DeltaOfDeltaCodec>;
+
+/**
+ * @brief Zigzag varint compressed Integer values
+ */
+using CompressedIntegers = CompressedSeries<detail::ZigZagVarintCodec>;
+
+extern template class CompressedSeries<detail::XorDoubleCodec>;
+extern template class CompressedSeries<detail::DeltaOfDeltaCodec>;
+extern template class CompressedSeries<detail::ZigZagVarintCodec>;
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_SERIES_COMPRESSION_HPP
@@ -0,0 +1,196 @@
+#ifndef __STAG_INFORMATION_MODEL_STREAM_OPERATORS_HPP
+#define __STAG_INFORMATION_MODEL_STREAM_OPERATORS_HPP
+
+#include "DataVariant.hpp"
+#include "Observable.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Information_Model {
+/**
+ * @addtogroup ObservableModeling Observable Metric Modelling
+ * @{
+ */
+
+/**
+ * @brief Numeric value, flowing through a StreamPipeline
+ *
+ */
+struct StreamSample {
+  /**
+   * @brief Arrival time in microseconds since the UNIX epoch
+   */
+  int64_t time;
+  double value;
+};
+
+/**
+ * @brief Aggregation, calculated over window operator samples
+ *
+ */
+enum class WindowAggregate { Count, Sum, Mean, Min, Max, Last };
+
+namespace detail {
+struct StreamNode;
+struct PipelineState;
+} // namespace detail
+
+/**
+ * @brief A derived stream of a StreamPipeline
+ *
+ * Each operator call creates a new derived stream, that processes the output
+ * of this stream. Multiple streams can be derived from the same stream, in
+ * which case the shared operators run once per sample.
+ *
+ * All operators run in constant (amortized) time per sample, window
+ * aggregates are updated incrementally instead of being recomputed over the
+ * whole window.
+ *
+ * Operators stay in the pipeline while a Stream handle or a subscription
+ * refers to them or to any stream derived from them. Once the last one is
+ * destroyed, they are detached and stop processing samples.
+ */
+class Stream {
+public:
+  using Transform = std::function<double(double)>;
+  using Predicate = std::function<bool(const StreamSample&)>;
+  using SampleCallback = std::function<void(const StreamSample&)>;
+
+  Stream(const Stream& other);
+  Stream(Stream&& other) noexcept;
+  Stream& operator=(const Stream& other);
+  Stream& operator=(Stream&& other) noexcept;
+  ~Stream();
+
+  /**
+   * @brief Transforms every sample value
+   */
+  Stream map(const Transform& transform) const;
+
+  /**
+   * @brief Forwards only the samples, that satisfy a given predicate
+   */
+  Stream filter(const Predicate& predicate) const;
+
+  /**
+   * @brief Forwards a sample only if its value differs from the last
+   * forwarded value by more than a given threshold. The first sample is always
+   * forwarded
+   *
+   * @throws std::invalid_argument - if threshold is negative
+   */
+  Stream deadband(double threshold) const;
+
+  /**
+   * @brief Limits the rate of change of forwarded values, values that change
+   * faster are clamped
+   *
+   * @throws std::invalid_argument - if max_change_per_second is negative
+   */
+  Stream rateLimit(double max_change_per_second) const;
+
+  /**
+   * @brief Forwards a single aggregate for every consecutive group of size
+   * samples, timestamped with the last sample of the group
+   *
+   * @throws std::invalid_argument - if size is 0
+   */
+  Stream tumblingWindow(std::size_t size, WindowAggregate aggregate) const;
+
+  /**
+   * @brief Forwards an aggregate of the last size samples for every sample.
+   * Until size samples are received, all received samples are aggregated
+   *
+   * @throws std::invalid_argument - if size is 0
+   */
+  Stream slidingWindow(std::size_t size, WindowAggregate aggregate) const;
+
+  /**
+   * @brief Forwards an aggregate of all samples, received within the given
+   * duration up to and including the current sample, for every sample
+   *
+   * @throws std::invalid_argument - if duration is not positive
+   */
+  Stream timeWindow(
+      std::chrono::microseconds duration, WindowAggregate aggregate) const;
+
+  /**
+   * @brief Attach a callback to this stream
+   *
+   * @param callback - called with every sample of this stream
+   * @return ObserverPtr - callback is detached when this observer is destroyed
+   */
+  [[nodiscard]] ObserverPtr subscribe(const SampleCallback& callback) const;
+
+private:
+  friend class StreamPipeline;
+
+  Stream(std::shared_ptr<detail::PipelineState> state,
+      std::shared_ptr<detail::StreamNode> node);
+
+  Stream then(const std::shared_ptr<detail::StreamNode>& node) const;
+
+  void release() noexcept;
+
+  std::shared_ptr<detail::PipelineState> state_;
+  std::shared_ptr<detail::StreamNode> node_;
+};
+
+/**
+ * @brief Composes numeric stream operators over a single upstream
+ * subscription
+ *
+ * Numeric DataVariant values are converted to double precision values, before
+ * they enter the pipeline. Samples are processed sequentially, so operators do
+ * not need to be thread safe.
+ */
+class StreamPipeline {
+public:
+  StreamPipeline();
+
+  /**
+   * @brief Returns the stream of all samples, that enter this pipeline
+   */
+  Stream source() const;
+
+  /**
+   * @brief Subscribes this pipeline to a given observable
+   *
+   * Every notification is delivered once, regardless of the number of derived
+   * streams
+   *
+   * @param observable
+   * @param handler - called if a notification can not be converted, or an
+   * operator or subscriber throws
+   * @return ObserverPtr - upstream subscription
+   */
+  [[nodiscard]] ObserverPtr attach(const ObservablePtr& observable,
+      const Observable::ExceptionHandler& handler);
+
+  /**
+   * @brief Pushes a new value into this pipeline, timestamped with the
+   * current system time
+   *
+   * @throws ConversionNotSupported - if value is not numeric
+   */
+  void push(const DataVariant& value);
+
+  void push(const StreamSample& sample);
+
+  /**
+   * @brief Returns the number of samples, that entered this pipeline
+   */
+  std::size_t sampleCount() const;
+
+private:
+  std::shared_ptr<detail::PipelineState> state_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_STREAM_OPERATORS_HPP
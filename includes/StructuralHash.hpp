@@ -0,0 +1,112 @@
+#ifndef __STAG_INFORMATION_MODEL_STRUCTURAL_HASH_HPP
+#define __STAG_INFORMATION_MODEL_STRUCTURAL_HASH_HPP
+
+#include "Callable.hpp"
+#include "DataVariant.hpp"
+#include "Device.hpp"
+#include "Element.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DeviceModeling Device Modelling
+ * @{
+ */
+
+/**
+ * @brief Hashes the structure of a single element, without its nested
+ * elements
+ *
+ * Covers the id relative to the device, name, description, ElementType,
+ * modeled or result DataType, the write only state of Writable elements and
+ * the ParameterTypes of Callable elements. Parameter order does not matter.
+ * The device id is not covered, so devices with the same structure have
+ * equal hashes, regardless of their ids.
+ *
+ * Structural hashes are built with hashBytes(), so they are equal across
+ * processes and machines of the same byte order, that use the same library
+ * version.
+ *
+ * @param id - element id, the device id and the following colon are skipped
+ * @param data_type - DataType::None for Group elements
+ * @return std::size_t
+ */
+std::size_t ownStructureHash(std::string_view id,
+    std::string_view name,
+    std::string_view description,
+    ElementType type,
+    DataType data_type,
+    bool write_only,
+    const ParameterTypes& parameter_types);
+
+/**
+ * @brief Hashes the structure of a given element, without its nested
+ * elements
+ *
+ * @return std::size_t
+ */
+std::size_t ownStructureHash(const Element& element);
+
+/**
+ * @brief Adds the structural hash of the next nested element of a group to
+ * the hash of that group
+ *
+ * The structural hash of a group starts with its ownStructureHash() and
+ * combines the structural hashes of its elements in Group::asVector() order,
+ * so equal subtrees result in equal hashes, regardless of the Device
+ * implementation.
+ *
+ * @return std::size_t
+ */
+std::size_t combineStructureHash(
+    std::size_t group_hash, std::size_t element_hash) noexcept;
+
+/**
+ * @brief Differences between the structures of two devices
+ */
+struct StructureDiff {
+  /**
+   * @brief Ids of elements, that only exist in the compared device. Nested
+   * elements of added groups are not listed
+   */
+  std::vector<std::string> added;
+  /**
+   * @brief Ids of elements, that only exist in the base device. Nested
+   * elements of removed groups are not listed
+   */
+  std::vector<std::string> removed;
+  /**
+   * @brief Ids of elements, that exist in both devices, but whose own
+   * structure differs. The root group id is listed, if the device name or
+   * description differs
+   */
+  std::vector<std::string> changed;
+
+  bool empty() const noexcept {
+    return added.empty() && removed.empty() && changed.empty();
+  }
+};
+
+/**
+ * @brief Finds all differing elements of two devices
+ *
+ * Elements are matched by their ids relative to their devices, so devices
+ * with different ids can be compared. Subtrees with equal structuralHash()
+ * are skipped without visiting their elements, so equal devices are compared
+ * in constant time and the cost of unequal devices grows with the sizes of
+ * the groups on the paths to the differences, not with the device size.
+ *
+ * @param base - device to compare against
+ * @param compared - device to compare
+ * @return StructureDiff - empty if both devices have the same structure
+ */
+StructureDiff diffStructure(const Device& base, const Device& compared);
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_STRUCTURAL_HASH_HPP
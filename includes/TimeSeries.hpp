@@ -0,0 +1,485 @@
+#ifndef __STAG_INFORMATION_MODEL_TIME_SERIES_HPP
+#define __STAG_INFORMATION_MODEL_TIME_SERIES_HPP
+
+#include "DataVariant.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup DataTypeModelling Data Type Modelling
+ * @{
+ */
+
+/**
+ * @brief Converts a given timestamp into microseconds since the UNIX epoch
+ *
+ * @throws std::invalid_argument - if given timestamp store nonsensical values,
+ * see @ref verifyTimestamp() documentation for exact checks
+ *
+ * @param timestamp
+ * @return int64_t
+ */
+int64_t toEpochMicroseconds(const Timestamp& timestamp);
+
+/**
+ * @brief Converts microseconds since the UNIX epoch into a timestamp
+ *
+ * @param microseconds
+ * @return Timestamp
+ */
+Timestamp fromEpochMicroseconds(int64_t microseconds);
+
+/**
+ * @brief Non owning view of an Opaque sample, stored in a TimeSeries
+ *
+ */
+struct OpaqueView {
+  const uint8_t* data;
+  std::size_t size;
+};
+
+/**
+ * @brief Sample value type, passed to TimeSeries iteration callbacks
+ *
+ * Numeric and Boolean samples are passed as their native type, with narrow
+ * numeric samples unwrapped from their NarrowValue, Timestamp
+ * samples as microseconds since the UNIX epoch, String samples as
+ * std::string_view and Opaque samples as OpaqueView. Views are only valid until
+ * the next modification of the TimeSeries.
+ *
+ * @tparam T - DataVariant alternative
+ */
+template <typename T> struct SampleView { using type = T; };
+
+template <typename T> struct SampleView<NarrowValue<T>> { using type = T; };
+
+template <> struct SampleView<Timestamp> { using type = int64_t; };
+
+template <> struct SampleView<std::string> { using type = std::string_view; };
+
+template <> struct SampleView<std::vector<uint8_t>> {
+  using type = OpaqueView;
+};
+
+template <typename T> using SampleView_t = typename SampleView<T>::type;
+
+/**
+ * @brief Contiguous part of a TimeSeries, with matching time and value
+ * columns
+ *
+ * @tparam T - native value type, as defined by SampleView_t
+ */
+template <typename T> struct SeriesSegment {
+  const int64_t* times;
+  const T* values;
+  std::size_t size;
+};
+
+namespace detail {
+template <typename T>
+constexpr bool is_fixed_width_sample =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
+struct SeriesColumn {
+  virtual ~SeriesColumn() = default;
+
+  virtual void set(std::size_t slot, const DataVariant& value) = 0;
+
+  virtual void release(std::size_t /*slot*/) {}
+
+  virtual DataVariant get(std::size_t slot) const = 0;
+
+  virtual std::size_t memoryUsage() const = 0;
+
+  virtual void clear() {}
+};
+
+/**
+ * @brief Stores numeric and Timestamp samples in a native array
+ */
+template <typename T, typename Storage = SampleView_t<T>>
+struct FixedColumn final : public SeriesColumn {
+  explicit FixedColumn(std::size_t capacity) : values(capacity) {}
+
+  void set(std::size_t slot, const DataVariant& value) final {
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      values[slot] = toEpochMicroseconds(std::get<T>(value));
+    } else {
+      values[slot] = toNative(std::get<T>(value));
+    }
+  }
+
+  DataVariant get(std::size_t slot) const final {
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      return fromEpochMicroseconds(values[slot]);
+    } else {
+      return fromNative<T>(values[slot]);
+    }
+  }
+
+  std::size_t memoryUsage() const final {
+    return values.capacity() * sizeof(Storage);
+  }
+
+  AlignedVector<Storage> values;
+};
+
+/**
+ * @brief Stores Boolean samples as a bit set
+ */
+struct BitColumn final : public SeriesColumn {
+  static constexpr std::size_t WORD_BITS = 64;
+
+  explicit BitColumn(std::size_t capacity)
+      : words((capacity + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+  void set(std::size_t slot, bool value) {
+    auto mask = uint64_t{1} << (slot % WORD_BITS);
+    auto& word = words[slot / WORD_BITS];
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  bool test(std::size_t slot) const {
+    return ((words[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1U) != 0;
+  }
+
+  void set(std::size_t slot, const DataVariant& value) final {
+    set(slot, std::get<bool>(value));
+  }
+
+  DataVariant get(std::size_t slot) const final { return test(slot); }
+
+  std::size_t memoryUsage() const final {
+    return words.capacity() * sizeof(uint64_t);
+  }
+
+  std::vector<uint64_t> words;
+};
+
+/**
+ * @brief Stores String and Opaque samples in a shared byte arena
+ *
+ * Samples are evicted in insertion order, so the arena is used as a byte
+ * queue. Each slot stores the absolute stream position of its bytes, the
+ * consumed front of the arena is dropped once it outgrows the live part.
+ */
+template <typename T> struct BytesColumn final : public SeriesColumn {
+  explicit BytesColumn(std::size_t capacity)
+      : offsets(capacity), lengths(capacity) {}
+
+  void set(std::size_t slot, const char* data, std::size_t size) {
+    offsets[slot] = base + arena.size();
+    lengths[slot] = size;
+    arena.insert(arena.end(), data, data + size);
+  }
+
+  void set(std::size_t slot, const DataVariant& value) final {
+    const auto& bytes = std::get<T>(value);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    set(slot, reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+
+  void release(std::size_t slot) final {
+    auto consumed = offsets[slot] + lengths[slot] - base;
+    constexpr std::size_t min_compaction = 4096;
+    if (consumed >= min_compaction && consumed * 2 >= arena.size()) {
+      arena.erase(arena.begin(),
+          arena.begin() + static_cast<std::ptrdiff_t>(consumed));
+      base += consumed;
+    }
+  }
+
+  const char* data(std::size_t slot) const {
+    return arena.data() + (offsets[slot] - base);
+  }
+
+  SampleView_t<T> view(std::size_t slot) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      return std::string_view(data(slot), lengths[slot]);
+    } else {
+      return OpaqueView{
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          reinterpret_cast<const uint8_t*>(data(slot)),
+          lengths[slot]};
+    }
+  }
+
+  DataVariant get(std::size_t slot) const final {
+    return T(data(slot), data(slot) + lengths[slot]);
+  }
+
+  std::size_t memoryUsage() const final {
+    return arena.capacity() + offsets.capacity() * sizeof(uint64_t) +
+        lengths.capacity() * sizeof(std::size_t);
+  }
+
+  void clear() final {
+    base += arena.size();
+    arena.clear();
+  }
+
+  std::vector<char> arena;
+  std::vector<uint64_t> offsets;
+  std::vector<std::size_t> lengths;
+  uint64_t base = 0;
+};
+
+template <typename T> struct SeriesColumnOf { using type = FixedColumn<T>; };
+
+template <> struct SeriesColumnOf<bool> { using type = BitColumn; };
+
+template <> struct SeriesColumnOf<std::string> {
+  using type = BytesColumn<std::string>;
+};
+
+template <> struct SeriesColumnOf<std::vector<uint8_t>> {
+  using type = BytesColumn<std::vector<uint8_t>>;
+};
+} // namespace detail
+
+/**
+ * @brief Fixed capacity, time ordered ring buffer of samples of a single
+ * DataType
+ *
+ * Sample timestamps are packed into a column of microseconds since the UNIX
+ * epoch, next to a column of native values. Numeric values are stored in
+ * native arrays, Boolean values as bits and String or Opaque values in a
+ * shared byte arena. When the buffer is full, appending a new sample evicts
+ * the oldest one.
+ *
+ * Samples can be iterated and sliced by time without creating DataVariant
+ * values, see forEach() and segments().
+ *
+ * @attention Array DataTypes are not supported. This class is not thread safe.
+ */
+class TimeSeries {
+public:
+  static constexpr int64_t MIN_TIME = std::numeric_limits<int64_t>::min();
+  static constexpr int64_t MAX_TIME = std::numeric_limits<int64_t>::max();
+
+  /**
+   * @brief Construct a new TimeSeries for a given DataType
+   *
+   * @throws std::invalid_argument - if capacity is 0 or data type is an array
+   * @throws std::logic_error - if data type is None or Unknown
+   *
+   * @param type - sample DataType
+   * @param capacity - maximum number of retained samples
+   */
+  TimeSeries(DataType type, std::size_t capacity);
+
+  TimeSeries(const TimeSeries&) = delete;
+  TimeSeries(TimeSeries&&) = default;
+  TimeSeries& operator=(const TimeSeries&) = delete;
+  TimeSeries& operator=(TimeSeries&&) = default;
+  ~TimeSeries() = default;
+
+  DataType dataType() const { return type_; }
+
+  std::size_t capacity() const { return capacity_; }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief Appends a new sample
+   *
+   * Values of a narrower numeric DataType are widened to the series DataType,
+   * see isLosslesslyConvertible()
+   *
+   * @throws std::invalid_argument - if time is older than the newest sample
+   * @throws ConversionNotSupported - if given value can not be stored as
+   * series DataType
+   *
+   * @param time - microseconds since the UNIX epoch
+   * @param value
+   */
+  void append(int64_t time, const DataVariant& value);
+
+  void append(const Timestamp& time, const DataVariant& value);
+
+  /**
+   * @brief Appends a new sample without creating a DataVariant
+   *
+   * @throws std::invalid_argument - if time is older than the newest sample
+   * @throws ConversionNotSupported - if T does not match the series DataType
+   *
+   * @tparam T - DataVariant alternative of the series DataType
+   * @param time - microseconds since the UNIX epoch
+   * @param value
+   */
+  template <typename T> void append(int64_t time, const T& value) {
+    checkType<T>();
+    auto& column = columnOf<T>();
+    if constexpr (std::is_same_v<T, Timestamp>) {
+      // converted first, so an invalid timestamp does not reserve a slot
+      auto converted = toEpochMicroseconds(value);
+      column.values[reserveSlot(time)] = converted;
+    } else if constexpr (std::is_same_v<T, std::string> ||
+        std::is_same_v<T, std::vector<uint8_t>>) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      auto* bytes = reinterpret_cast<const char*>(value.data());
+      column.set(reserveSlot(time), bytes, value.size());
+    } else if constexpr (std::is_same_v<T, bool>) {
+      column.set(reserveSlot(time), value);
+    } else {
+      column.values[reserveSlot(time)] = toNative(value);
+    }
+  }
+
+  /**
+   * @brief Returns the time of the sample at a given position, with 0 being
+   * the oldest retained sample
+   *
+   * @throws std::out_of_range - if index is not less than size()
+   */
+  int64_t timeAt(std::size_t index) const;
+
+  /**
+   * @brief Returns the sample value at a given position, with 0 being the
+   * oldest retained sample
+   *
+   * @throws std::out_of_range - if index is not less than size()
+   */
+  DataVariant valueAt(std::size_t index) const;
+
+  /**
+   * @brief Returns the position of the first sample, that is not older than
+   * given time
+   *
+   * @param time - microseconds since the UNIX epoch
+   * @return std::size_t - size() if all samples are older than time
+   */
+  std::size_t lowerBound(int64_t time) const;
+
+  /**
+   * @brief Calls a given visitor with every sample within [from, to) time
+   * range, from oldest to newest
+   *
+   * @throws ConversionNotSupported - if T does not match the series DataType
+   *
+   * @tparam T - DataVariant alternative of the series DataType
+   * @tparam Visitor - callable with (int64_t time, SampleView_t<T> value)
+   * signature
+   * @param visitor
+   * @param from - inclusive start time in microseconds since the UNIX epoch
+   * @param to - exclusive end time in microseconds since the UNIX epoch
+   */
+  template <typename T, typename Visitor>
+  void forEach(
+      Visitor&& visitor, int64_t from = MIN_TIME, int64_t to = MAX_TIME) const {
+    checkType<T>();
+    const auto& column = columnOf<T>();
+    auto [begin, end] = range(from, to);
+    for (auto index = begin; index < end; ++index) {
+      auto slot = slotOf(index);
+      if constexpr (std::is_same_v<T, bool>) {
+        visitor(times_[slot], column.test(slot));
+      } else if constexpr (detail::is_fixed_width_sample<SampleView_t<T>>) {
+        visitor(times_[slot], column.values[slot]);
+      } else {
+        visitor(times_[slot], column.view(slot));
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the contiguous column parts of samples within [from, to)
+   * time range, oldest part first
+   *
+   * Since samples are stored in a ring buffer, a range is split into at most
+   * two segments. Unused segments have a size of 0.
+   *
+   * @throws ConversionNotSupported - if T does not match the series DataType
+   *
+   * @tparam T - numeric or Timestamp DataVariant alternative of the series
+   * DataType
+   * @param from - inclusive start time in microseconds since the UNIX epoch
+   * @param to - exclusive end time in microseconds since the UNIX epoch
+   * @return std::array<SeriesSegment<SampleView_t<T>>, 2>
+   */
+  template <typename T>
+  std::array<SeriesSegment<SampleView_t<T>>, 2> segments(
+      int64_t from = MIN_TIME, int64_t to = MAX_TIME) const {
+    static_assert(detail::is_fixed_width_sample<SampleView_t<T>>,
+        "Only numeric and Timestamp samples are stored contiguously");
+    checkType<T>();
+    const auto& column = columnOf<T>();
+    std::array<SeriesSegment<SampleView_t<T>>, 2> result{};
+    auto [begin, end] = range(from, to);
+    if (begin == end) {
+      return result;
+    }
+    auto first = slotOf(begin);
+    auto count = end - begin;
+    auto first_size = std::min(count, capacity_ - first);
+    result[0] = {
+        times_.data() + first, column.values.data() + first, first_size};
+    result[1] = {times_.data(), column.values.data(), count - first_size};
+    return result;
+  }
+
+  /**
+   * @brief Removes all samples, that are older than given time
+   *
+   * @param time - microseconds since the UNIX epoch
+   */
+  void evictBefore(int64_t time);
+
+  void clear();
+
+  /**
+   * @brief Returns the number of heap bytes, used for sample storage
+   */
+  std::size_t memoryUsage() const;
+
+private:
+  template <typename T> void checkType() const {
+    if (DataTypeOf_v<T> != type_) {
+      throw ConversionNotSupported(DataTypeOf_v<T>, type_);
+    }
+  }
+
+  template <typename T> auto& columnOf() const {
+    using Column = typename detail::SeriesColumnOf<T>::type;
+    // type is checked by checkType()
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+    return static_cast<Column&>(*column_);
+  }
+
+  std::size_t slotOf(std::size_t index) const {
+    auto slot = head_ + index;
+    return slot >= capacity_ ? slot - capacity_ : slot;
+  }
+
+  std::pair<std::size_t, std::size_t> range(int64_t from, int64_t to) const;
+
+  std::size_t reserveSlot(int64_t time);
+
+  void evictOldest();
+
+  DataType type_;
+  std::size_t capacity_;
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+  AlignedVector<int64_t> times_;
+  std::unique_ptr<detail::SeriesColumn> column_;
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_TIME_SERIES_HPP
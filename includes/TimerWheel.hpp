@@ -0,0 +1,132 @@
+#ifndef __STAG_INFORMATION_MODEL_TIMER_WHEEL_HPP
+#define __STAG_INFORMATION_MODEL_TIMER_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Information_Model {
+/**
+ * @addtogroup Scheduling Element Scheduling
+ * @{
+ */
+
+/**
+ * @brief Hierarchical timing wheel, that tracks timers in integer ticks
+ *
+ * Timers are kept in 6 levels of 64 slots, each level covering 64 times the
+ * span of the level below it. Scheduling and cancelling a timer takes
+ * constant time. Advancing the wheel looks up the next occupied slot of each
+ * level in a bitmap, so it takes constant time per tick with a due or
+ * cascaded timer, regardless of the number of pending timers or skipped empty
+ * ticks. Timers further than 2^36 ticks away are parked on the top level and
+ * re-examined at the start of every top level rotation.
+ *
+ * Not thread safe, owners serialize access.
+ */
+class TimerWheel {
+public:
+  using TimerId = uint64_t;
+
+  static constexpr std::size_t SLOT_BITS = 6;
+  static constexpr std::size_t SLOTS = std::size_t{1} << SLOT_BITS;
+  static constexpr std::size_t LEVELS = 6;
+
+  /**
+   * @brief A timer, that expired during advance()
+   */
+  struct Expiry {
+    TimerId id;
+    /**
+     * @brief User value, given to schedule()
+     */
+    uint64_t key;
+    /**
+     * @brief Requested deadline, may be earlier than the tick at which the
+     * timer expired, if it was scheduled in the past
+     */
+    uint64_t deadline;
+  };
+
+  explicit TimerWheel(uint64_t start_tick = 0);
+
+  /**
+   * @brief Adds a new timer
+   *
+   * @param deadline - tick at which the timer expires, deadlines that are not
+   * after now() expire on the next advance()
+   * @param key - user value, returned with the Expiry
+   * @return TimerId - unique among all timers of this wheel
+   */
+  TimerId schedule(uint64_t deadline, uint64_t key);
+
+  /**
+   * @brief Removes a pending timer
+   *
+   * @param id
+   * @return true - if the timer was pending, false if it already expired or
+   * was cancelled
+   */
+  bool cancel(TimerId id);
+
+  /**
+   * @brief Moves the wheel forward and collects the expired timers
+   *
+   * @param tick - new current tick, does nothing if tick is not after now()
+   * @param expired - expired timers are appended in deadline order
+   * @return std::size_t - number of expired timers
+   */
+  std::size_t advance(uint64_t tick, std::vector<Expiry>& expired);
+
+  uint64_t now() const { return now_; }
+
+  /**
+   * @brief Returns the first tick after now(), at which a timer expires or
+   * has to be cascaded, so owners can sleep until then
+   *
+   * @return uint64_t - UINT64_MAX if no timers are pending
+   */
+  uint64_t nextEvent() const;
+
+  /**
+   * @brief Returns the number of pending timers
+   */
+  std::size_t size() const { return count_; }
+
+  bool empty() const { return count_ == 0; }
+
+private:
+  static constexpr uint32_t NIL = UINT32_MAX;
+
+  struct Node {
+    uint64_t deadline = 0;
+    uint64_t key = 0;
+    uint32_t previous = NIL;
+    uint32_t next = NIL;
+    uint32_t generation = 0;
+    /**
+     * @brief level * SLOTS + slot, or NIL if the node is free
+     */
+    uint32_t slot = NIL;
+  };
+
+  void place(uint32_t index, uint64_t earliest);
+  void link(uint32_t index, uint32_t slot);
+  void unlink(uint32_t index);
+  void release(uint32_t index);
+  void cascade(std::size_t level, std::size_t slot);
+  void expire(std::size_t slot, std::vector<Expiry>& expired);
+
+  uint64_t now_;
+  std::size_t count_ = 0;
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> free_;
+  std::array<uint32_t, LEVELS * SLOTS> heads_;
+  std::array<uint64_t, LEVELS> occupied_{};
+};
+
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_TIMER_WHEEL_HPP
@@ -0,0 +1,207 @@
+#ifndef __STAG_INFORMATION_MODEL_TYPED_ELEMENT_HPP
+#define __STAG_INFORMATION_MODEL_TYPED_ELEMENT_HPP
+
+#include "DataVariant.hpp"
+#include "Element.hpp"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+namespace Information_Model {
+/**
+ * @addtogroup ElementModeling Device Element Modelling
+ * @{
+ */
+struct ElementTypeMismatch : public std::invalid_argument {
+  ElementTypeMismatch(const std::string& ref_id, ElementType type)
+      : std::invalid_argument("Element " + ref_id + " is a " +
+            toString(type) + " and can not be used for the requested view") {}
+};
+
+struct DataTypeMismatch : public std::invalid_argument {
+  DataTypeMismatch(
+      const std::string& ref_id, DataType modeled, DataType requested)
+      : std::invalid_argument("Element " + ref_id + " models " +
+            toString(modeled) + " values, not " + toString(requested)) {}
+};
+
+namespace detail {
+template <typename T>
+void checkTypedAccess(const ElementPtr& element, DataType modeled) {
+  if (modeled != DataTypeOf_v<T>) {
+    throw DataTypeMismatch(element->id(), modeled, DataTypeOf_v<T>);
+  }
+}
+
+/**
+ * @brief Returns a native typed implementation, if the element or its
+ * function provides one
+ */
+template <template <typename> class Typed, typename T, typename Function>
+std::shared_ptr<Typed<T>> findNative(
+    const ElementPtr& element, const std::shared_ptr<Function>& function) {
+  if (auto native = std::dynamic_pointer_cast<Typed<T>>(function)) {
+    return native;
+  }
+  return std::dynamic_pointer_cast<Typed<T>>(element);
+}
+
+template <typename T, typename Source>
+struct UnboxingReadable final : public TypedReadable<T> {
+  explicit UnboxingReadable(std::shared_ptr<Source> source)
+      : source_(std::move(source)) {}
+
+  T read() const final { return std::get<T>(source_->read()); }
+
+private:
+  std::shared_ptr<Source> source_;
+};
+
+template <typename T> struct UnboxingWritable final : public TypedWritable<T> {
+  explicit UnboxingWritable(WritablePtr source) : source_(std::move(source)) {}
+
+  T read() const final { return std::get<T>(source_->read()); }
+
+  bool isWriteOnly() const final { return source_->isWriteOnly(); }
+
+  void write(const T& value) const final { source_->write(DataVariant(value)); }
+
+private:
+  WritablePtr source_;
+};
+
+template <typename T>
+struct UnboxingObservable final : public TypedObservable<T> {
+  using ObserveCallback = typename TypedObservable<T>::ObserveCallback;
+  using ExceptionHandler = typename TypedObservable<T>::ExceptionHandler;
+
+  explicit UnboxingObservable(ObservablePtr source)
+      : source_(std::move(source)) {}
+
+  T read() const final { return std::get<T>(source_->read()); }
+
+  ObserverPtr subscribe(const ObserveCallback& observe_cb,
+      const ExceptionHandler& handler) final {
+    return source_->subscribe(
+        [observe_cb](const std::shared_ptr<DataVariant>& value) {
+          observe_cb(std::get<T>(*value));
+        },
+        handler);
+  }
+
+private:
+  ObservablePtr source_;
+};
+} // namespace detail
+
+/**
+ * @brief Creates a typed view of a given Readable, Writable or Observable
+ * element
+ *
+ * If the element implementation also implements TypedReadable<T>, either on
+ * the Element itself or on its function, that implementation is returned
+ * instead and no DataVariant conversions take place. Otherwise, the view
+ * unpacks the DataVariant values returned by the element.
+ *
+ * Intended to be called once per element and reused for every read
+ *
+ * @throws ElementTypeMismatch - if given element is a Group or a Callable
+ * @throws DataTypeMismatch - if given element does not model DataTypeOf_v<T>
+ * values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ * @param element
+ * @return TypedReadablePtr<T>
+ */
+template <typename T>
+TypedReadablePtr<T> toTypedReadable(const ElementPtr& element) {
+  switch (element->type()) {
+  case ElementType::Readable: {
+    auto readable = std::get<ReadablePtr>(element->function());
+    detail::checkTypedAccess<T>(element, readable->dataType());
+    if (auto native = detail::findNative<TypedReadable, T>(element, readable)) {
+      return native;
+    }
+    return std::make_shared<detail::UnboxingReadable<T, Readable>>(readable);
+  }
+  case ElementType::Writable: {
+    auto writable = std::get<WritablePtr>(element->function());
+    detail::checkTypedAccess<T>(element, writable->dataType());
+    if (auto native = detail::findNative<TypedReadable, T>(element, writable)) {
+      return native;
+    }
+    return std::make_shared<detail::UnboxingReadable<T, Writable>>(writable);
+  }
+  case ElementType::Observable: {
+    auto observable = std::get<ObservablePtr>(element->function());
+    detail::checkTypedAccess<T>(element, observable->dataType());
+    if (auto native =
+            detail::findNative<TypedReadable, T>(element, observable)) {
+      return native;
+    }
+    return std::make_shared<detail::UnboxingReadable<T, Observable>>(
+        observable);
+  }
+  default: {
+    throw ElementTypeMismatch(element->id(), element->type());
+  }
+  }
+}
+
+/**
+ * @brief Creates a typed view of a given Writable element, see
+ * toTypedReadable() for native implementation lookup
+ *
+ * @throws ElementTypeMismatch - if given element is not a Writable
+ * @throws DataTypeMismatch - if given element does not model DataTypeOf_v<T>
+ * values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ * @param element
+ * @return TypedWritablePtr<T>
+ */
+template <typename T>
+TypedWritablePtr<T> toTypedWritable(const ElementPtr& element) {
+  if (element->type() != ElementType::Writable) {
+    throw ElementTypeMismatch(element->id(), element->type());
+  }
+  auto writable = std::get<WritablePtr>(element->function());
+  detail::checkTypedAccess<T>(element, writable->dataType());
+  if (auto native = detail::findNative<TypedWritable, T>(element, writable)) {
+    return native;
+  }
+  return std::make_shared<detail::UnboxingWritable<T>>(writable);
+}
+
+/**
+ * @brief Creates a typed view of a given Observable element, see
+ * toTypedReadable() for native implementation lookup
+ *
+ * @throws ElementTypeMismatch - if given element is not an Observable
+ * @throws DataTypeMismatch - if given element does not model DataTypeOf_v<T>
+ * values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ * @param element
+ * @return TypedObservablePtr<T>
+ */
+template <typename T>
+TypedObservablePtr<T> toTypedObservable(const ElementPtr& element) {
+  if (element->type() != ElementType::Observable) {
+    throw ElementTypeMismatch(element->id(), element->type());
+  }
+  auto observable = std::get<ObservablePtr>(element->function());
+  detail::checkTypedAccess<T>(element, observable->dataType());
+  if (auto native =
+          detail::findNative<TypedObservable, T>(element, observable)) {
+    return native;
+  }
+  return std::make_shared<detail::UnboxingObservable<T>>(observable);
+}
+/** @}*/
+} // namespace Information_Model
+
+#endif //__STAG_INFORMATION_MODEL_TYPED_ELEMENT_HPP
@@ -1,6 +1,9 @@
 #ifndef __STAG_INFORMATION_MODEL_WRITEABLE_HPP
 #define __STAG_INFORMATION_MODEL_WRITEABLE_HPP
 
+#include "DataVariant.hpp"
+#include "Expected.hpp"
+
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -68,9 +71,72 @@ struct Writable {
    *
    */
   virtual void write(const DataVariant&) const = 0;
+
+  /**
+   * @brief Reads the latest available metric value without throwing, see
+   * @ref Readable::tryRead() for default implementation behavior
+   *
+   * Default implementation still throws internally on failure and must be
+   * overridden to avoid the exception cost.
+   *
+   * @return Expected<DataVariant> - holds ErrorCode::Non_Readable,
+   * ErrorCode::Read_Callback_Unavailable or ErrorCode::Callback_Failed on
+   * failure
+   */
+  virtual Expected<DataVariant> tryRead() const;
+
+  /**
+   * @brief Writes the given DataVariant without throwing, see @ref
+   * Readable::tryRead() for default implementation behavior
+   *
+   * Default implementation calls write() and still throws internally on
+   * failure, so it must be overridden to avoid the exception cost.
+   *
+   * @return Expected<void> - holds ErrorCode::Data_Type_Mismatch,
+   * ErrorCode::Write_Callback_Unavailable or ErrorCode::Callback_Failed on
+   * failure
+   */
+  virtual Expected<void> tryWrite(const DataVariant& value) const;
 };
 
 using WritablePtr = std::shared_ptr<Writable>;
+
+/**
+ * @brief A typed view of a writable metric, that reads and writes native
+ * values instead of a DataVariant
+ *
+ * Obtained via toTypedWritable() for Writable elements, that model
+ * DataTypeOf_v<T> values
+ *
+ * @tparam T - one of the DataVariant alternatives
+ */
+template <typename T> struct TypedWritable {
+  virtual ~TypedWritable() = default;
+
+  /**
+   * @brief Read the latest available metric value, see @ref Writable::read()
+   *
+   * @return T
+   */
+  virtual T read() const = 0;
+
+  /**
+   * @brief Checks if the modeled metric does not supports value reading
+   *
+   * @return bool
+   */
+  virtual bool isWriteOnly() const = 0;
+
+  /**
+   * @brief Writes the given native value as a metric value to the modeled
+   * sensor/actor system, see @ref Writable::write()
+   *
+   */
+  virtual void write(const T&) const = 0;
+};
+
+template <typename T>
+using TypedWritablePtr = std::shared_ptr<TypedWritable<T>>;
 /** @}*/
 } // namespace Information_Model
 
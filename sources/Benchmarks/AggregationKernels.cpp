@@ -0,0 +1,109 @@
+#include "Aggregation.hpp"
+#include "BenchmarkUtils.hpp"
+#include "DataVariant.hpp"
+
+#include <Variant_Visitor/Visitor.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Compares per value DataVariant visiting with gathered native
+ * aggregation kernels
+ *
+ * Build the library once with and once without ENABLE_AVX2 option to compare
+ * the scalar and AVX2 kernels
+ *
+ * Usage: AggregationKernels [sample_count]
+ */
+namespace {
+constexpr size_t DEFAULT_SAMPLE_COUNT = 4'000'000;
+constexpr size_t REPETITIONS = 10;
+
+template <typename Run> double measure(Run run) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < REPETITIONS; ++i) {
+    doNotOptimize(run());
+  }
+  return stopwatch.elapsedMs() / REPETITIONS;
+}
+
+void printThroughput(const string& name, double elapsed_ms, size_t samples) {
+  printResult(name,
+      static_cast<double>(samples) / elapsed_ms / 1000.0, // NOLINT
+      "M samples/s");
+}
+
+double visitEach(const vector<DataVariant>& variants) {
+  double sum = 0;
+  double min = numeric_limits<double>::max();
+  double max = numeric_limits<double>::lowest();
+  for (const auto& variant : variants) {
+    Variant_Visitor::match(
+        variant,
+        [&](double value) {
+          sum += value;
+          min = value < min ? value : min;
+          max = value > max ? value : max;
+        },
+        [](const auto&) {});
+  }
+  return sum + min + max;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto samples = countArgument(argc, argv, 1, DEFAULT_SAMPLE_COUNT);
+  cout << "Aggregating " << samples << " samples with "
+       << aggregationKernel() << " kernels" << endl;
+
+  vector<DataVariant> variants;
+  variants.reserve(samples);
+  DoubleArray doubles;
+  IntegerArray integers;
+  UnsignedIntegerArray unsigned_integers;
+  for (size_t i = 0; i < samples; ++i) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    auto value = static_cast<double>(i % 1000) * 0.25;
+    variants.emplace_back(i % 100 == 0 ? DataVariant(true) : value);
+    doubles.push_back(value);
+    integers.push_back(static_cast<intmax_t>(i % 2000) - 1000);
+    unsigned_integers.push_back(i % 5000);
+    // NOLINTEND(readability-magic-numbers)
+  }
+
+  printHeader("DataVariant stream, 1% mismatched types");
+  printThroughput("match() per value",
+      measure([&]() { return visitEach(variants); }),
+      samples);
+  GatheredValues<double> gathered;
+  printThroughput("gather + aggregate",
+      measure([&]() {
+        gather(variants.data(), variants.size(), gathered);
+        return aggregate(gathered.values).sum;
+      }),
+      samples);
+  printThroughput("gather only",
+      measure([&]() {
+        gather(variants.data(), variants.size(), gathered);
+        return gathered.values.size();
+      }),
+      samples);
+
+  printHeader("Native arrays");
+  printThroughput("Double", measure([&]() { return aggregate(doubles).sum; }),
+      samples);
+  printThroughput("Integer",
+      measure([&]() { return aggregate(integers).sum; }),
+      samples);
+  printThroughput("Unsigned_Integer",
+      measure([&]() { return aggregate(unsigned_integers).sum; }),
+      samples);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,232 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures build time, heap usage per element, recursive traversal
+ * and element lookup of ArenaDevice instances against a shared_ptr per
+ * element tree with a device wide id hash map, as Device implementations
+ * commonly build it
+ *
+ * Devices consist of groups with GROUP_SIZE Integer readables each
+ *
+ * Usage: ArenaDevice [max_elements]
+ */
+namespace {
+constexpr size_t DEFAULT_MAX_ELEMENTS = 100'000;
+constexpr size_t GROUP_SIZE = 100;
+constexpr size_t LOOKUP_REPEATS = 4;
+
+struct NaiveReadable : public Readable {
+  explicit NaiveReadable(DeviceBuilder::ReadCallback read)
+      : read_(move(read)) {}
+
+  DataType dataType() const final { return DataType::Integer; }
+
+  DataVariant read() const final { return read_(); }
+
+private:
+  DeviceBuilder::ReadCallback read_;
+};
+
+struct NaiveElement : public Element {
+  NaiveElement(
+      string id, string name, ElementType type, ElementFunction function)
+      : id_(move(id)), name_(move(name)), type_(type),
+        function_(move(function)) {}
+
+  string id() const final { return id_; }
+
+  string name() const final { return name_; }
+
+  string description() const final { return string(); }
+
+  ElementType type() const final { return type_; }
+
+  ElementFunction function() const final { return function_; }
+
+private:
+  string id_;
+  string name_;
+  ElementType type_;
+  ElementFunction function_;
+};
+
+struct NaiveGroup : public Group {
+  size_t size() const final { return elements.size(); }
+
+  unordered_map<string, ElementPtr> asMap() const final {
+    unordered_map<string, ElementPtr> result;
+    for (const auto& element : elements) {
+      result.emplace(element->id(), element);
+    }
+    return result;
+  }
+
+  vector<ElementPtr> asVector() const final { return elements; }
+
+  ElementPtr element(const string& ref_id) const final {
+    for (const auto& element : elements) {
+      if (element->id() == ref_id) {
+        return element;
+      }
+    }
+    throw ElementNotFound(ref_id);
+  }
+
+  void visit(const Visitor& visitor) const final {
+    for (const auto& element : elements) {
+      visitor(element);
+    }
+  }
+
+  vector<ElementPtr> elements;
+};
+
+struct NaiveDevice {
+  shared_ptr<NaiveGroup> root = make_shared<NaiveGroup>();
+  unordered_map<string, ElementPtr> index;
+};
+
+DataVariant readValue() { return DataVariant(intmax_t{1}); }
+
+/**
+ * @brief Returns the ids of all readables, both devices use the same ids
+ */
+vector<string> readableIds(size_t elements) {
+  vector<string> ids;
+  ids.reserve(elements);
+  for (size_t i = 0; i < elements; ++i) {
+    ids.push_back("dev:" + to_string(i / GROUP_SIZE) + "." +
+        to_string(i % GROUP_SIZE));
+  }
+  return ids;
+}
+
+unique_ptr<Device> buildArena(size_t elements) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark", "Arena device"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id = builder.addGroup(BuildInfo{"Group " + to_string(i)});
+    }
+    builder.addReadable(group_id,
+        BuildInfo{"Readable " + to_string(i), "Benchmark readable"},
+        DataType::Integer,
+        &readValue);
+  }
+  return builder.result();
+}
+
+void buildNaive(NaiveDevice& device, size_t elements) {
+  shared_ptr<NaiveGroup> group;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group = make_shared<NaiveGroup>();
+      auto group_id = "dev:" + to_string(i / GROUP_SIZE);
+      auto element = make_shared<NaiveElement>(group_id,
+          "Group " + to_string(i),
+          ElementType::Group,
+          ElementFunction(group));
+      device.root->elements.push_back(element);
+      device.index.emplace(group_id, element);
+    }
+    auto id = "dev:" + to_string(i / GROUP_SIZE) + "." +
+        to_string(i % GROUP_SIZE);
+    auto element = make_shared<NaiveElement>(id,
+        "Readable " + to_string(i),
+        ElementType::Readable,
+        ElementFunction(make_shared<NaiveReadable>(&readValue)));
+    group->elements.push_back(element);
+    device.index.emplace(move(id), move(element));
+  }
+}
+
+void traverse(const Group& group, intmax_t& sum) {
+  group.visit([&sum](const ElementPtr& element) {
+    auto function = element->function();
+    if (holds_alternative<GroupPtr>(function)) {
+      traverse(*get<GroupPtr>(function), sum);
+    } else if (holds_alternative<ReadablePtr>(function)) {
+      sum += get<intmax_t>(get<ReadablePtr>(function)->read());
+    }
+  });
+}
+
+template <typename Lookup>
+double lookupNs(const vector<string>& ids, Lookup&& lookup) {
+  Stopwatch stopwatch;
+  for (size_t repeat = 0; repeat < LOOKUP_REPEATS; ++repeat) {
+    for (const auto& id : ids) {
+      doNotOptimize(lookup(id));
+    }
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(ids.size()) /
+      LOOKUP_REPEATS;
+}
+
+void measure(size_t elements) {
+  printHeader(to_string(elements) + " elements");
+  auto per_element = static_cast<double>(elements);
+  auto ids = readableIds(elements);
+  {
+    auto before = liveBytes();
+    Stopwatch stopwatch;
+    auto device = buildArena(elements);
+    printResult("arena build", stopwatch.elapsedMs(), "ms");
+    printResult("arena heap per element",
+        static_cast<double>(liveBytes() - before) / per_element,
+        "B");
+    intmax_t sum = 0;
+    stopwatch.restart();
+    traverse(*device->group(), sum);
+    doNotOptimize(sum);
+    printResult("arena traversal", stopwatch.elapsedNs() / per_element, "ns");
+    printResult("arena lookup",
+        lookupNs(ids, [&device](const string& id) {
+          return device->element(id).get();
+        }),
+        "ns");
+  }
+  {
+    auto before = liveBytes();
+    Stopwatch stopwatch;
+    NaiveDevice device;
+    buildNaive(device, elements);
+    printResult("shared_ptr tree build", stopwatch.elapsedMs(), "ms");
+    printResult("shared_ptr tree heap per element",
+        static_cast<double>(liveBytes() - before) / per_element,
+        "B");
+    intmax_t sum = 0;
+    stopwatch.restart();
+    traverse(*device.root, sum);
+    doNotOptimize(sum);
+    printResult(
+        "shared_ptr tree traversal", stopwatch.elapsedNs() / per_element, "ns");
+    printResult("shared_ptr tree lookup",
+        lookupNs(ids, [&device](const string& id) {
+          return device.index.at(id).get();
+        }),
+        "ns");
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto max_elements = countArgument(argc, argv, 1, DEFAULT_MAX_ELEMENTS);
+  cout << GROUP_SIZE << " readables per group" << endl;
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (size_t elements = 1'000; elements <= max_elements; elements *= 10) {
+    measure(elements);
+  }
+  return EXIT_SUCCESS;
+}
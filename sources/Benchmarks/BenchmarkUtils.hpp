@@ -0,0 +1,167 @@
+#ifndef __STAG_INFORMATION_MODEL_BENCHMARK_UTILS_HPP
+#define __STAG_INFORMATION_MODEL_BENCHMARK_UTILS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+
+/**
+ * @brief Helpers shared by the benchmark executables
+ *
+ * @attention This header replaces the global allocation functions to track
+ * heap usage, so it must only be included by a single translation unit of a
+ * given executable
+ */
+namespace Information_Model::benchmark {
+
+struct AllocationCounters {
+  std::atomic<std::size_t> live_bytes{0};
+  std::atomic<std::size_t> allocations{0};
+};
+
+inline AllocationCounters& counters() {
+  static AllocationCounters instance;
+  return instance;
+}
+
+/**
+ * @brief Returns the number of currently allocated heap bytes
+ */
+inline std::size_t liveBytes() { return counters().live_bytes.load(); }
+
+/**
+ * @brief Returns the number of heap allocations since program start
+ */
+inline std::size_t allocationCount() { return counters().allocations.load(); }
+
+/**
+ * @brief Prevents the optimizer from removing otherwise unused results
+ */
+template <typename T> void doNotOptimize(const T& value) {
+  // NOLINTNEXTLINE(hicpp-no-assembler)
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Stopwatch {
+  using Clock = std::chrono::steady_clock;
+
+  Stopwatch() : start_(Clock::now()) {}
+
+  double elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start_)
+        .count();
+  }
+
+  double elapsedNs() const {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start_)
+        .count();
+  }
+
+  void restart() { start_ = Clock::now(); }
+
+private:
+  Clock::time_point start_;
+};
+
+/**
+ * @brief Parses an optional positive count argument, used to scale the
+ * benchmark workload
+ */
+inline std::size_t countArgument(
+    int argc, char** argv, int position, std::size_t fallback) {
+  if (argc > position) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return std::stoull(argv[position]);
+  }
+  return fallback;
+}
+
+inline void printHeader(const std::string& title) {
+  std::cout << "\n== " << title << " ==" << std::endl;
+}
+
+inline void printResult(
+    const std::string& name, double value, const std::string& unit) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  std::cout << std::left << std::setw(48) << name << std::right
+            << std::setw(14) << std::fixed << std::setprecision(2) << value
+            << " " << unit << std::endl;
+  // NOLINTEND(readability-magic-numbers)
+}
+
+inline double toMiB(std::size_t bytes) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+namespace detail {
+struct AllocationHeader {
+  void* raw;
+  std::size_t size;
+};
+
+inline void* allocate(std::size_t size, std::size_t alignment) {
+  if (alignment < alignof(std::max_align_t)) {
+    alignment = alignof(std::max_align_t);
+  }
+  auto* raw = std::malloc(size + alignment + sizeof(AllocationHeader));
+  if (raw == nullptr) {
+    throw std::bad_alloc();
+  }
+  auto start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(AllocationHeader);
+  auto aligned = (start + alignment - 1) & ~(alignment - 1);
+  auto* header = reinterpret_cast<AllocationHeader*>(
+      aligned - sizeof(AllocationHeader));
+  header->raw = raw;
+  header->size = size;
+  counters().live_bytes += size;
+  ++counters().allocations;
+  return reinterpret_cast<void*>(aligned);
+}
+
+inline void deallocate(void* pointer) noexcept {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto* header = reinterpret_cast<AllocationHeader*>(
+      reinterpret_cast<std::uintptr_t>(pointer) - sizeof(AllocationHeader));
+  counters().live_bytes -= header->size;
+  std::free(header->raw);
+}
+} // namespace detail
+} // namespace Information_Model::benchmark
+
+// NOLINTBEGIN(misc-new-delete-overloads)
+void* operator new(std::size_t size) {
+  return Information_Model::benchmark::detail::allocate(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return Information_Model::benchmark::detail::allocate(
+      size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+  Information_Model::benchmark::detail::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  Information_Model::benchmark::detail::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+  Information_Model::benchmark::detail::deallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  Information_Model::benchmark::detail::deallocate(pointer);
+}
+// NOLINTEND(misc-new-delete-overloads)
+
+#endif //__STAG_INFORMATION_MODEL_BENCHMARK_UTILS_HPP
@@ -0,0 +1,166 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "DeviceDefinition.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures ArenaDevice build time with one DeviceBuilder call per
+ * element against a single DeviceBuilder::build() call with a prepared
+ * element table, and the throughput of the streaming JSON definition parser
+ *
+ * Devices consist of groups with GROUP_SIZE Integer readables each
+ *
+ * Usage: BulkBuild [elements] [repeats]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 100'000;
+constexpr size_t DEFAULT_REPEATS = 5;
+constexpr size_t GROUP_SIZE = 100;
+
+struct Adapter {
+  DataVariant read(uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(address + offset));
+  }
+
+  uintmax_t offset = 1;
+};
+
+string channelName(size_t element) { return "Channel " + to_string(element); }
+
+const string DESCRIPTION = "Measured value of a single input channel";
+
+unique_ptr<Device> incremental(const Adapter* adapter, size_t elements) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id = builder.addGroup(BuildInfo{"Group " + to_string(i)});
+    }
+    uintmax_t address = i;
+    builder.addInlineReadable(group_id,
+        BuildInfo{channelName(i), DESCRIPTION},
+        DataType::Integer,
+        [adapter, address]() { return adapter->read(address); });
+  }
+  return builder.result();
+}
+
+DeviceDefinition definitionOf(size_t elements) {
+  DeviceDefinition definition{"dev", BuildInfo{"Benchmark"}, {}};
+  definition.elements.reserve(elements + elements / GROUP_SIZE + 1);
+  uint32_t group = 0;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group = static_cast<uint32_t>(definition.elements.size());
+      ElementDefinition element;
+      element.info.name = "Group " + to_string(i);
+      definition.elements.push_back(move(element));
+    }
+    ElementDefinition element;
+    element.parent = group;
+    element.info = BuildInfo{channelName(i), DESCRIPTION};
+    element.type = ElementType::Readable;
+    element.data_type = DataType::Integer;
+    element.callback = static_cast<uint32_t>(i);
+    definition.elements.push_back(move(element));
+  }
+  return definition;
+}
+
+vector<ElementCallbacks> callbacksOf(const Adapter* adapter, size_t elements) {
+  vector<ElementCallbacks> callbacks(elements);
+  for (size_t i = 0; i < elements; ++i) {
+    uintmax_t address = i;
+    callbacks[i].read = [adapter, address]() {
+      return adapter->read(address);
+    };
+  }
+  return callbacks;
+}
+
+string jsonOf(const DeviceDefinition& definition) {
+  ostringstream json;
+  json << R"({"id": ")" << definition.id << R"(", "name": ")"
+       << definition.info.name << R"(", "elements": [)";
+  for (size_t row = 0; row < definition.elements.size(); ++row) {
+    const auto& element = definition.elements[row];
+    json << (row == 0 ? "\n" : ",\n") << R"(  {"name": ")" << element.info.name
+         << '"';
+    if (element.type == ElementType::Group) {
+      json << R"(, "type": "Group"})";
+      continue;
+    }
+    json << R"(, "description": ")" << element.info.description
+         << R"(", "parent": )" << element.parent
+         << R"(, "type": "Readable", "data_type": "Integer", "callback": )"
+         << element.callback << '}';
+  }
+  json << "\n]}\n";
+  return json.str();
+}
+
+template <typename Build>
+void measure(const string& name, size_t repeats, Build&& build) {
+  double total = 0;
+  for (size_t repeat = 0; repeat < repeats; ++repeat) {
+    Stopwatch stopwatch;
+    auto device = build();
+    total += stopwatch.elapsedMs();
+    doNotOptimize(device);
+  }
+  printResult(name, total / static_cast<double>(repeats), "ms");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto repeats = countArgument(argc, argv, 2, DEFAULT_REPEATS);
+  cout << elements << " elements, " << repeats << " repeats" << endl;
+  Adapter adapter;
+  const auto* source = &adapter;
+
+  printHeader("ArenaDevice build");
+  measure("one call per element",
+      repeats,
+      [source, elements]() { return incremental(source, elements); });
+  measure("element table", repeats, [elements]() {
+    return definitionOf(elements).elements.size();
+  });
+  measure("element table and build()", repeats, [source, elements]() {
+    ArenaDeviceBuilder builder;
+    return builder
+        .build(definitionOf(elements), callbacksOf(source, elements))
+        .device;
+  });
+
+  printHeader("JSON definition");
+  auto json = jsonOf(definitionOf(elements));
+  printResult("size", toMiB(json.size()), "MiB");
+  Stopwatch stopwatch;
+  for (size_t repeat = 0; repeat < repeats; ++repeat) {
+    istringstream input(json);
+    doNotOptimize(parseDefinition(input));
+  }
+  auto parse_ms = stopwatch.elapsedMs() / static_cast<double>(repeats);
+  printResult("parse", parse_ms, "ms");
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  printResult(
+      "parse throughput", toMiB(json.size()) / parse_ms * 1000, "MiB/s");
+  measure("parse and build()", repeats, [source, elements, &json]() {
+    istringstream input(json);
+    ArenaDeviceBuilder builder;
+    return builder
+        .build(parseDefinition(input), callbacksOf(source, elements))
+        .device;
+  });
+  return EXIT_SUCCESS;
+}
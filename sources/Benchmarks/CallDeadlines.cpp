@@ -0,0 +1,95 @@
+#include "BenchmarkUtils.hpp"
+#include "CallDeadlines.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures CallDeadlineManager overhead and timeout accuracy for a
+ * growing number of pending calls
+ *
+ * Every second call is completed right after it was tracked, the rest time
+ * out between 300 and 500 ms later on the timer thread
+ *
+ * Usage: CallDeadlines [max_calls]
+ */
+namespace {
+constexpr size_t DEFAULT_MAX_CALLS = 100'000;
+constexpr int64_t MIN_TIMEOUT_MS = 300;
+constexpr size_t TIMEOUT_SPREAD_MS = 200;
+
+double cpuMs() {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return 1000.0 * static_cast<double>(clock()) / CLOCKS_PER_SEC;
+}
+
+double toMs(CallDeadlineStatistics::Duration duration) {
+  return chrono::duration<double, milli>(duration).count();
+}
+
+void measure(size_t calls) {
+  CallDeadlineManager manager;
+  manager.start();
+  vector<ResultFuture> results;
+  results.reserve(calls);
+
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < calls; ++i) {
+    auto timeout = chrono::milliseconds(
+        MIN_TIMEOUT_MS + static_cast<int64_t>(i % TIMEOUT_SPREAD_MS));
+    results.push_back(manager.track(i, "call", timeout, [](uintmax_t) {}));
+  }
+  auto track_ns = stopwatch.elapsedNs() / static_cast<double>(calls);
+  stopwatch.restart();
+  for (size_t i = 0; i < calls; i += 2) {
+    manager.complete(i, DataVariant(true));
+  }
+  auto complete_ns =
+      stopwatch.elapsedNs() / static_cast<double>((calls + 1) / 2);
+
+  auto cpu_start = cpuMs();
+  stopwatch.restart();
+  while (manager.pending() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(5));
+  }
+  auto wall_ms = stopwatch.elapsedMs();
+  auto cpu_ms = cpuMs() - cpu_start;
+  manager.stop();
+
+  auto statistics = manager.statistics();
+  printResult("track", track_ns, "ns/call");
+  printResult("complete", complete_ns, "ns/call");
+  printResult("timed out calls",
+      static_cast<double>(statistics.timed_out),
+      "calls");
+  printResult("mean lateness", toMs(statistics.meanLateness()), "ms");
+  printResult("max lateness", toMs(statistics.max_lateness), "ms");
+  printResult("expiry phase wall time", wall_ms, "ms");
+  printResult("expiry phase cpu time", cpu_ms, "ms");
+  printResult("cpu per timed out call",
+      cpu_ms * 1e6 / static_cast<double>(statistics.timed_out),
+      "ns/call");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto max_calls = countArgument(argc, argv, 1, DEFAULT_MAX_CALLS);
+  cout << "Single timer thread with 1 ms resolution, no thread per call"
+       << endl;
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (size_t calls : {size_t{10'000}, size_t{50'000}, size_t{100'000}}) {
+    if (calls > max_calls) {
+      break;
+    }
+    printHeader(to_string(calls) + " pending calls");
+    measure(calls);
+  }
+  return EXIT_SUCCESS;
+}
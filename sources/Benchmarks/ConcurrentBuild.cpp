@@ -0,0 +1,159 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures ConcurrentArenaDeviceBuilder build time with 1, 4 and 16
+ * discovery threads against a single ArenaDeviceBuilder
+ *
+ * The device consists of SEGMENTS root groups, one per discovered fieldbus
+ * segment, with groups of GROUP_SIZE Integer readables each. Threads claim
+ * the next undiscovered segment until none are left.
+ *
+ * Usage: ConcurrentBuild [elements] [repeats]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 100'000;
+constexpr size_t DEFAULT_REPEATS = 5;
+constexpr size_t SEGMENTS = 64;
+constexpr size_t GROUP_SIZE = 100;
+constexpr size_t THREAD_COUNTS[] = {1, 4, 16};
+
+struct Adapter {
+  DataVariant read(uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(address + offset));
+  }
+
+  uintmax_t offset = 1;
+};
+
+const string DESCRIPTION = "Measured value of a single input channel";
+
+/**
+ * @brief Adds all elements of a single segment. The Builder is either an
+ * ArenaDeviceBuilder or a ConcurrentArenaDeviceBuilder::Branch
+ */
+template <typename Builder>
+void discover(Builder& builder,
+    const optional<string>& segment_id,
+    const Adapter* adapter,
+    size_t first,
+    size_t last) {
+  string group_id;
+  for (auto i = first; i < last; ++i) {
+    if ((i - first) % GROUP_SIZE == 0) {
+      group_id = segment_id.has_value()
+          ? builder.addGroup(*segment_id, BuildInfo{"Group " + to_string(i)})
+          : builder.addGroup(BuildInfo{"Group " + to_string(i)});
+    }
+    uintmax_t address = i;
+    builder.addInlineReadable(group_id,
+        BuildInfo{"Channel " + to_string(i), DESCRIPTION},
+        DataType::Integer,
+        [adapter, address]() { return adapter->read(address); });
+  }
+}
+
+size_t segmentStart(size_t segment, size_t elements) {
+  return segment * elements / SEGMENTS;
+}
+
+unique_ptr<Device> serial(const Adapter* adapter, size_t elements) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  for (size_t segment = 0; segment < SEGMENTS; ++segment) {
+    auto segment_id =
+        builder.addGroup(BuildInfo{"Segment " + to_string(segment)});
+    discover(builder,
+        segment_id,
+        adapter,
+        segmentStart(segment, elements),
+        segmentStart(segment + 1, elements));
+  }
+  return builder.result();
+}
+
+struct Timings {
+  double discovery_ms = 0;
+  double merge_ms = 0;
+};
+
+Timings concurrent(const Adapter* adapter, size_t elements, size_t threads) {
+  Stopwatch stopwatch;
+  ConcurrentArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  atomic<size_t> next_segment{0};
+  vector<thread> workers;
+  workers.reserve(threads);
+  for (size_t worker = 0; worker < threads; ++worker) {
+    workers.emplace_back([&builder, &next_segment, adapter, elements]() {
+      for (auto segment = next_segment++; segment < SEGMENTS;
+           segment = next_segment++) {
+        auto branch = builder.branch(
+            segment, BuildInfo{"Segment " + to_string(segment)});
+        discover(branch,
+            nullopt,
+            adapter,
+            segmentStart(segment, elements),
+            segmentStart(segment + 1, elements));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  Timings timings;
+  timings.discovery_ms = stopwatch.elapsedMs();
+  stopwatch.restart();
+  auto device = builder.result();
+  timings.merge_ms = stopwatch.elapsedMs();
+  doNotOptimize(device);
+  return timings;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto repeats = countArgument(argc, argv, 2, DEFAULT_REPEATS);
+  cout << elements << " elements in " << SEGMENTS << " segments, " << repeats
+       << " repeats, " << thread::hardware_concurrency() << " hardware threads"
+       << endl;
+  Adapter adapter;
+
+  printHeader("ArenaDeviceBuilder");
+  double serial_ms = 0;
+  for (size_t repeat = 0; repeat < repeats; ++repeat) {
+    Stopwatch stopwatch;
+    auto device = serial(&adapter, elements);
+    serial_ms += stopwatch.elapsedMs();
+    doNotOptimize(device);
+  }
+  printResult("build", serial_ms / static_cast<double>(repeats), "ms");
+
+  for (auto threads : THREAD_COUNTS) {
+    printHeader(
+        "ConcurrentArenaDeviceBuilder, " + to_string(threads) + " threads");
+    Timings total;
+    for (size_t repeat = 0; repeat < repeats; ++repeat) {
+      auto timings = concurrent(&adapter, elements, threads);
+      total.discovery_ms += timings.discovery_ms;
+      total.merge_ms += timings.merge_ms;
+    }
+    auto count = static_cast<double>(repeats);
+    printResult("discovery", total.discovery_ms / count, "ms");
+    printResult("merge", total.merge_ms / count, "ms");
+    printResult(
+        "build", (total.discovery_ms + total.merge_ms) / count, "ms");
+  }
+  return EXIT_SUCCESS;
+}
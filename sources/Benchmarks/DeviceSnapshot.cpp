@@ -0,0 +1,164 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "DeviceSnapshot.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures cold start time of many devices, rehydrated from memory
+ * mapped snapshot files, against replaying the DeviceBuilder calls of a
+ * technology adapter
+ *
+ * Devices consist of groups with GROUP_SIZE elements each, every fourth
+ * element is Writable, the others are Readable. Cold start ends once every
+ * device is available and one element of every device was looked up.
+ *
+ * Usage: DeviceSnapshot [devices] [elements_per_device]
+ */
+namespace {
+constexpr size_t DEFAULT_DEVICES = 500;
+constexpr size_t DEFAULT_ELEMENTS = 5'000;
+constexpr size_t GROUP_SIZE = 100;
+constexpr size_t WRITABLE_STRIDE = 4;
+
+struct Adapter {
+  DataVariant read(uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(address + offset));
+  }
+
+  void write(uintmax_t address, const DataVariant& value) const {
+    doNotOptimize(address);
+    doNotOptimize(value);
+  }
+
+  uintmax_t offset = 1;
+};
+
+unique_ptr<Device> replay(
+    const Adapter* adapter, size_t device, size_t elements) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("device" + to_string(device),
+      BuildInfo{"Device " + to_string(device), "Benchmark device"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id = builder.addGroup(BuildInfo{"Group " + to_string(i)});
+    }
+    BuildInfo info{"Channel " + to_string(i), "Measured value of channel"};
+    uintmax_t address = i;
+    if (i % WRITABLE_STRIDE == 0) {
+      builder.addInlineWritable(group_id,
+          info,
+          DataType::Integer,
+          [adapter, address](const DataVariant& value) {
+            adapter->write(address, value);
+          },
+          [adapter, address]() { return adapter->read(address); });
+    } else {
+      builder.addInlineReadable(group_id,
+          info,
+          DataType::Integer,
+          [adapter, address]() { return adapter->read(address); });
+    }
+  }
+  return builder.result();
+}
+
+/**
+ * @brief Binds the callbacks of rehydrated elements, the adapter address is
+ * recovered from the element position within the device
+ */
+CallbackResolver resolver(const Adapter* adapter) {
+  return [adapter](const SnapshotElement& element,
+             DeviceBuilder::InlineNotifyCallback&&) {
+    auto colon = element.id.find(':');
+    auto dot = element.id.find('.');
+    auto group = stoull(string(element.id.substr(colon + 1, dot - colon - 1)));
+    auto address =
+        group * GROUP_SIZE + stoull(string(element.id.substr(dot + 1)));
+    ElementCallbacks callbacks;
+    callbacks.read = [adapter, address]() { return adapter->read(address); };
+    if (element.type == ElementType::Writable) {
+      callbacks.write = [adapter, address](const DataVariant& value) {
+        adapter->write(address, value);
+      };
+    }
+    return callbacks;
+  };
+}
+
+size_t materializeAll(const Device& device) {
+  size_t count = 0;
+  device.visit([&count](const ElementPtr& group) {
+    count += get<GroupPtr>(group->function())->asVector().size();
+  });
+  return count;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto devices = countArgument(argc, argv, 1, DEFAULT_DEVICES);
+  auto elements = countArgument(argc, argv, 2, DEFAULT_ELEMENTS);
+  cout << devices << " devices, " << elements << " elements per device"
+       << endl;
+  Adapter adapter;
+  auto directory = filesystem::temp_directory_path() /
+      ("DeviceSnapshot_benchmark_" + to_string(devices));
+  filesystem::create_directories(directory);
+  auto lookup_id = [](size_t device) {
+    return "device" + to_string(device) + ":0.1";
+  };
+
+  printHeader("builder replay");
+  vector<string> paths;
+  size_t snapshot_bytes = 0;
+  {
+    Stopwatch stopwatch;
+    vector<unique_ptr<Device>> built;
+    built.reserve(devices);
+    for (size_t device = 0; device < devices; ++device) {
+      built.push_back(replay(&adapter, device, elements));
+      doNotOptimize(built.back()->element(lookup_id(device)));
+    }
+    printResult("cold start", stopwatch.elapsedMs(), "ms");
+    stopwatch.restart();
+    for (size_t device = 0; device < devices; ++device) {
+      paths.push_back(
+          (directory / ("device" + to_string(device) + ".snapshot")).string());
+      saveSnapshot(*built[device], paths.back());
+      snapshot_bytes += filesystem::file_size(paths.back());
+    }
+    printResult("snapshot writing", stopwatch.elapsedMs(), "ms");
+    printResult("snapshot size", toMiB(snapshot_bytes), "MiB");
+  }
+
+  printHeader("snapshot rehydration");
+  {
+    Stopwatch stopwatch;
+    vector<unique_ptr<Device>> rehydrated;
+    rehydrated.reserve(devices);
+    for (size_t device = 0; device < devices; ++device) {
+      auto snapshot = DeviceSnapshot::map(paths[device]);
+      rehydrated.push_back(snapshot.rehydrate(resolver(&adapter)));
+      doNotOptimize(rehydrated.back()->element(lookup_id(device)));
+    }
+    printResult("cold start", stopwatch.elapsedMs(), "ms");
+    stopwatch.restart();
+    size_t materialized = 0;
+    for (const auto& device : rehydrated) {
+      materialized += materializeAll(*device);
+    }
+    doNotOptimize(materialized);
+    printResult("materialization of all elements", stopwatch.elapsedMs(), "ms");
+  }
+
+  filesystem::remove_all(directory);
+  return EXIT_SUCCESS;
+}
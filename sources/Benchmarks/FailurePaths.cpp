@@ -0,0 +1,131 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "Expected.hpp"
+
+#include <string>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures the throughput of routine failures reported by exceptions
+ * against their non-throwing try*() counterparts on an ArenaDevice, together
+ * with the successful lookup and the lazy message formatting for reference
+ *
+ * Usage: FailurePaths [iterations]
+ */
+namespace {
+constexpr size_t DEFAULT_ITERATIONS = 200'000;
+
+template <typename Operation>
+void measure(const string& name, size_t iterations, Operation&& operation) {
+  size_t failures = 0;
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < iterations; ++i) {
+    if (!operation()) {
+      ++failures;
+    }
+  }
+  doNotOptimize(failures);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  auto rate = static_cast<double>(iterations) / stopwatch.elapsedMs() / 1000;
+  printResult(name, rate, "M ops/s");
+}
+
+template <typename Operation> bool throws(Operation&& operation) {
+  try {
+    operation();
+    return true;
+  } catch (const exception&) {
+    return false;
+  }
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto iterations = countArgument(argc, argv, 1, DEFAULT_ITERATIONS);
+  cout << iterations << " iterations" << endl;
+
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("device", BuildInfo{"Benchmark"});
+  auto group_id = builder.addGroup(BuildInfo{"Group"});
+  auto writable_id = builder.addWritable(group_id,
+      BuildInfo{"Writable"},
+      DataType::Integer,
+      [](const DataVariant&) {});
+  auto callable_id = builder.addCallable(group_id,
+      BuildInfo{"Callable"},
+      [](const Parameters&) {},
+      ParameterTypes{{1, ParameterType{DataType::Integer, true}}});
+  auto device = builder.result();
+  auto writable = get<WritablePtr>(device->element(writable_id)->function());
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  auto supported = callable->parameterTypes();
+  const string missing_id = "device:0.7";
+  const DataVariant wrong_value(string("wrong type"));
+  const Parameters wrong_parameters{{1, DataVariant(true)}};
+
+  printHeader("Device::element()");
+  measure("found", iterations, [&]() {
+    return device->tryElement(writable_id).hasValue();
+  });
+  measure("not found, exception", iterations, [&]() {
+    return throws([&]() { doNotOptimize(device->element(missing_id)); });
+  });
+  measure("not found, Expected", iterations, [&]() {
+    return device->tryElement(missing_id).hasValue();
+  });
+  measure("not found, Expected with message", iterations, [&]() {
+    auto result = device->tryElement(missing_id);
+    doNotOptimize(result.error().message());
+    return result.hasValue();
+  });
+
+  printHeader("Writable::write()");
+  measure("type mismatch, exception", iterations, [&]() {
+    return throws([&]() { writable->write(wrong_value); });
+  });
+  measure("type mismatch, Expected", iterations, [&]() {
+    return writable->tryWrite(wrong_value).hasValue();
+  });
+
+  printHeader("Writable::read()");
+  measure("write only, exception", iterations, [&]() {
+    return throws([&]() { doNotOptimize(writable->read()); });
+  });
+  measure("write only, Expected", iterations, [&]() {
+    return writable->tryRead().hasValue();
+  });
+
+  printHeader("Callable::call()");
+  measure("result not supported, exception", iterations, [&]() {
+    return throws([&]() { doNotOptimize(callable->call()); });
+  });
+  measure("result not supported, Expected", iterations, [&]() {
+    return callable->tryCall().hasValue();
+  });
+
+  printHeader("checkParameters()");
+  measure("type mismatch, exception", iterations, [&]() {
+    return throws([&]() { checkParameters(wrong_parameters, supported); });
+  });
+  measure("type mismatch, Expected", iterations, [&]() {
+    return tryCheckParameters(wrong_parameters, supported).hasValue();
+  });
+
+  printHeader("addSupportedParameter()");
+  measure("type mismatch, exception", iterations, [&]() {
+    Parameters parameters;
+    return throws([&]() {
+      addSupportedParameter(parameters, supported, 1, DataVariant(true));
+    });
+  });
+  measure("type mismatch, Expected", iterations, [&]() {
+    Parameters parameters;
+    return tryAddSupportedParameter(
+        parameters, supported, 1, DataVariant(true))
+        .hasValue();
+  });
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures the heap usage and build time of a fleet of devices, that
+ * share a single device model, built one by one with
+ * ArenaDeviceBuilder::build() against instantiating them from a single
+ * ArenaDeviceTemplate
+ *
+ * The model consists of groups with GROUP_SIZE elements each, that cycle
+ * through Readable, Writable, Observable and Callable elements. Every
+ * element callback captures the adapter and the element address.
+ *
+ * Usage: FleetTemplates [elements] [instances]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 5'000;
+constexpr size_t DEFAULT_INSTANCES = 2'000;
+constexpr size_t GROUP_SIZE = 50;
+
+struct Adapter {
+  DataVariant read(uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(address + offset));
+  }
+
+  void write(uintmax_t address, const DataVariant& value) const {
+    doNotOptimize(address);
+    doNotOptimize(value);
+  }
+
+  uintmax_t offset = 1;
+};
+
+DeviceDefinition fleetModel(size_t elements) {
+  DeviceDefinition definition;
+  definition.id = "model";
+  definition.info = BuildInfo{"Fleet model", "Device model of the fleet"};
+  uint32_t group = 0;
+  uint32_t callback = 0;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group = static_cast<uint32_t>(definition.elements.size());
+      definition.elements.push_back(ElementDefinition{DEFINITION_ROOT,
+          BuildInfo{"Zone " + to_string(i / GROUP_SIZE),
+              "Sensors and actuators of zone " + to_string(i / GROUP_SIZE)},
+          ElementType::Group,
+          DataType::None,
+          {},
+          0});
+    }
+    ElementDefinition element{group,
+        BuildInfo{"Channel " + to_string(i),
+            "Process value of channel " + to_string(i)},
+        ElementType::Readable,
+        DataType::Integer,
+        {},
+        callback++};
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    switch (i % 4) {
+    case 1:
+      element.type = ElementType::Writable;
+      break;
+    case 2:
+      element.type = ElementType::Observable;
+      break;
+    case 3:
+      element.type = ElementType::Callable;
+      element.data_type = DataType::None;
+      element.parameter_types =
+          ParameterTypes{{1, ParameterType{DataType::Integer, true}},
+              {2, ParameterType{DataType::Boolean}}};
+      break;
+    default:
+      break;
+    }
+    definition.elements.push_back(move(element));
+  }
+  return definition;
+}
+
+vector<ElementCallbacks> bindCallbacks(
+    const DeviceDefinition& definition, const Adapter* adapter) {
+  vector<ElementCallbacks> callbacks;
+  callbacks.reserve(definition.elements.size());
+  for (const auto& element : definition.elements) {
+    if (element.type == ElementType::Group) {
+      continue;
+    }
+    uintmax_t address = element.callback;
+    ElementCallbacks bound;
+    switch (element.type) {
+    case ElementType::Writable:
+      bound.write = [adapter, address](const DataVariant& value) {
+        adapter->write(address, value);
+      };
+      [[fallthrough]];
+    case ElementType::Readable:
+      bound.read = [adapter, address]() { return adapter->read(address); };
+      break;
+    case ElementType::Observable:
+      bound.read = [adapter, address]() { return adapter->read(address); };
+      bound.observe = [](bool) {};
+      break;
+    default:
+      bound.execute = [adapter, address](const Parameters& parameters) {
+        adapter->write(address, parameters.at(1).value());
+      };
+      break;
+    }
+    callbacks.push_back(move(bound));
+  }
+  return callbacks;
+}
+/**
+ * @brief Builds a whole fleet, prints its build time and heap usage and
+ * returns the heap usage
+ */
+template <typename Build>
+size_t measureFleet(size_t instances, size_t elements, Build&& build) {
+  vector<unique_ptr<Device>> fleet;
+  fleet.reserve(instances);
+  auto before = liveBytes();
+  Stopwatch stopwatch;
+  for (size_t instance = 0; instance < instances; ++instance) {
+    fleet.push_back(build(instance));
+  }
+  auto build_ms = stopwatch.elapsedMs();
+  auto used = liveBytes() - before;
+  printResult("build time", build_ms, "ms");
+  printResult("fleet heap", toMiB(used), "MiB");
+  printResult("per instance",
+      static_cast<double>(used) / static_cast<double>(instances),
+      "B");
+  printResult("per element",
+      static_cast<double>(used) / static_cast<double>(instances * elements),
+      "B");
+  return used;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto instances = countArgument(argc, argv, 2, DEFAULT_INSTANCES);
+  cout << instances << " instances of a " << elements << " element model"
+       << endl;
+  Adapter adapter;
+  auto model = fleetModel(elements);
+
+  printHeader("separate builds");
+  auto used = measureFleet(instances, elements, [&](size_t instance) {
+    auto definition = model;
+    definition.id = "device" + to_string(instance);
+    ArenaDeviceBuilder builder;
+    return builder.build(move(definition), bindCallbacks(model, &adapter))
+        .device;
+  });
+
+  printHeader("template instances");
+  auto before = liveBytes();
+  ArenaDeviceTemplate fleet_template(model);
+  auto template_bytes = liveBytes() - before;
+  printResult("shared template", toMiB(template_bytes), "MiB");
+  auto shared_used = measureFleet(instances, elements, [&](size_t instance) {
+    return fleet_template
+        .instantiate(
+            "device" + to_string(instance), bindCallbacks(model, &adapter))
+        .device;
+  });
+  printResult("heap reduction",
+      static_cast<double>(used) /
+          static_cast<double>(shared_used + template_bytes),
+      "x");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+#include "BenchmarkUtils.hpp"
+#include "DataVariant.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures DataVariant hash throughput on large Opaque values and
+ * compares it with the standard library string hash
+ *
+ * Usage: HashThroughput [total_megabytes]
+ */
+namespace {
+constexpr size_t DEFAULT_TOTAL_MB = 1024;
+constexpr size_t MB = 1024 * 1024;
+
+template <typename Hasher>
+double throughput(size_t value_size, size_t total_bytes, Hasher hasher) {
+  auto repetitions = total_bytes / value_size + 1;
+  Stopwatch stopwatch;
+  size_t combined = 0;
+  for (size_t i = 0; i < repetitions; ++i) {
+    combined ^= hasher();
+  }
+  doNotOptimize(combined);
+  auto seconds = stopwatch.elapsedMs() / 1000.0; // NOLINT
+  return static_cast<double>(value_size * repetitions) /
+      static_cast<double>(MB) / seconds;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto total_bytes = countArgument(argc, argv, 1, DEFAULT_TOTAL_MB) * MB;
+
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (size_t value_size : {64UL, 1024UL, 64 * 1024UL, 16 * MB}) {
+    vector<uint8_t> bytes(value_size);
+    for (size_t i = 0; i < value_size; ++i) {
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    DataVariant opaque = bytes;
+    string_view view(reinterpret_cast<const char*>(bytes.data()), value_size);
+
+    printHeader("Opaque value of " + to_string(value_size) + " bytes");
+    printResult("hash<DataVariant>",
+        throughput(value_size,
+            total_bytes,
+            [&opaque]() { return hash<DataVariant>{}(opaque); }),
+        "MiB/s");
+    printResult("hash<string_view>",
+        throughput(value_size,
+            total_bytes,
+            [&view]() { return hash<string_view>{}(view); }),
+        "MiB/s");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures construction time, heap usage per element and invocation
+ * cost of inline read callbacks against std::function, for a typical
+ * technology adapter capture of a this pointer and two ids, which exceeds the
+ * std::function small buffer
+ *
+ * Also compares heap usage per element of ArenaDevice instances built with
+ * std::function and inline callbacks
+ *
+ * Usage: InlineCallbacks [elements] [invocation_rounds]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 100'000;
+constexpr size_t DEFAULT_ROUNDS = 20;
+constexpr size_t GROUP_SIZE = 100;
+
+struct Adapter {
+  DataVariant read(uintmax_t device, uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(device + address + offset));
+  }
+
+  uintmax_t offset = 1;
+};
+
+template <typename Callback>
+vector<Callback> makeCallbacks(const Adapter* adapter, size_t elements) {
+  vector<Callback> callbacks;
+  callbacks.reserve(elements);
+  for (size_t i = 0; i < elements; ++i) {
+    uintmax_t device = i / GROUP_SIZE;
+    uintmax_t address = i % GROUP_SIZE;
+    callbacks.emplace_back([adapter, device, address]() {
+      return adapter->read(device, address);
+    });
+  }
+  return callbacks;
+}
+
+template <typename Callback>
+void measureCallbacks(const string& name,
+    const Adapter& adapter,
+    size_t elements,
+    size_t rounds) {
+  auto per_element = static_cast<double>(elements);
+  auto before = liveBytes();
+  auto allocations = allocationCount();
+  Stopwatch stopwatch;
+  auto callbacks = makeCallbacks<Callback>(&adapter, elements);
+  printResult(name + " construction", stopwatch.elapsedMs(), "ms");
+  printResult(name + " heap per element",
+      static_cast<double>(liveBytes() - before) / per_element,
+      "B");
+  printResult(name + " allocations per element",
+      static_cast<double>(allocationCount() - allocations) / per_element,
+      "");
+  intmax_t sum = 0;
+  stopwatch.restart();
+  for (size_t round = 0; round < rounds; ++round) {
+    for (const auto& callback : callbacks) {
+      sum += get<intmax_t>(callback());
+    }
+  }
+  doNotOptimize(sum);
+  printResult(name + " invocation",
+      stopwatch.elapsedNs() / per_element / static_cast<double>(rounds),
+      "ns");
+}
+
+template <typename Add>
+void measureDevice(const string& name, size_t elements, Add&& add) {
+  auto before = liveBytes();
+  Stopwatch stopwatch;
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id = builder.addGroup(BuildInfo{});
+    }
+    add(builder, group_id, i / GROUP_SIZE, i % GROUP_SIZE);
+  }
+  auto device = builder.result();
+  printResult(name + " build", stopwatch.elapsedMs(), "ms");
+  printResult(name + " heap per element",
+      static_cast<double>(liveBytes() - before) /
+          static_cast<double>(elements),
+      "B");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto rounds = countArgument(argc, argv, 2, DEFAULT_ROUNDS);
+  cout << elements << " elements, " << rounds << " invocation rounds" << endl;
+  Adapter adapter;
+
+  printHeader("read callbacks");
+  measureCallbacks<DeviceBuilder::ReadCallback>(
+      "std::function", adapter, elements, rounds);
+  measureCallbacks<DeviceBuilder::InlineReadCallback>(
+      "InplaceFunction", adapter, elements, rounds);
+
+  printHeader("ArenaDevice");
+  const auto* source = &adapter;
+  measureDevice("std::function callbacks",
+      elements,
+      [source](ArenaDeviceBuilder& builder,
+          const string& group_id,
+          uintmax_t device,
+          uintmax_t address) {
+        builder.addReadable(group_id,
+            BuildInfo{},
+            DataType::Integer,
+            [source, device, address]() {
+              return source->read(device, address);
+            });
+      });
+  measureDevice("inline callbacks",
+      elements,
+      [source](ArenaDeviceBuilder& builder,
+          const string& group_id,
+          uintmax_t device,
+          uintmax_t address) {
+        builder.addInlineReadable(group_id,
+            BuildInfo{},
+            DataType::Integer,
+            [source, device, address]() {
+              return source->read(device, address);
+            });
+      });
+  return EXIT_SUCCESS;
+}
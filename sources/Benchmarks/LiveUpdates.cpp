@@ -0,0 +1,114 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "LiveDevice.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures hot plugging a module into a LiveDevice against rebuilding
+ * the whole device, and element lookups of both devices
+ *
+ * Devices consist of slot groups with GROUP_SIZE Integer readables each, a
+ * module is a single slot.
+ *
+ * Usage: LiveUpdates [elements] [updates]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 100'000;
+constexpr size_t DEFAULT_UPDATES = 1'000;
+constexpr size_t GROUP_SIZE = 100;
+constexpr size_t LOOKUPS = 1'000'000;
+
+struct Adapter {
+  DataVariant read(uintmax_t address) const {
+    return DataVariant(static_cast<intmax_t>(address + offset));
+  }
+
+  uintmax_t offset = 1;
+};
+
+void addSlot(ArenaDeviceBuilder& builder, const Adapter* adapter, size_t slot) {
+  auto group_id = builder.addGroup(BuildInfo{"Slot " + to_string(slot)});
+  for (size_t i = 0; i < GROUP_SIZE; ++i) {
+    uintmax_t address = slot * GROUP_SIZE + i;
+    builder.addInlineReadable(group_id,
+        BuildInfo{"Channel " + to_string(i)},
+        DataType::Integer,
+        [adapter, address]() { return adapter->read(address); });
+  }
+}
+
+unique_ptr<Device> buildDevice(const Adapter* adapter, size_t slots) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  for (size_t slot = 0; slot < slots; ++slot) {
+    addSlot(builder, adapter, slot);
+  }
+  return builder.result();
+}
+
+unique_ptr<Device> buildModule(const Adapter* adapter, size_t slot) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("module", BuildInfo{"Module"});
+  addSlot(builder, adapter, slot);
+  return builder.result();
+}
+
+double lookupNs(const Device& device, const vector<string>& ids) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < LOOKUPS; ++i) {
+    doNotOptimize(device.element(ids[i % ids.size()]));
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(LOOKUPS);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto updates = countArgument(argc, argv, 2, DEFAULT_UPDATES);
+  auto slots = elements / GROUP_SIZE;
+  cout << slots << " slots with " << GROUP_SIZE << " elements, " << updates
+       << " updates" << endl;
+  Adapter adapter;
+
+  printHeader("module hot plug");
+  Stopwatch stopwatch;
+  auto rebuilt = buildDevice(&adapter, slots + 1);
+  printResult("full rebuild", stopwatch.elapsedMs(), "ms");
+  LiveDevice live(*buildDevice(&adapter, slots));
+  auto modules = vector<unique_ptr<Device>>();
+  modules.reserve(updates);
+  for (size_t update = 0; update < updates; ++update) {
+    modules.push_back(buildModule(&adapter, slots + update));
+  }
+  stopwatch.restart();
+  vector<string> added;
+  for (const auto& module : modules) {
+    added.push_back(live.add(nullopt, *module).added.front());
+  }
+  auto add_ns = stopwatch.elapsedNs() / static_cast<double>(updates);
+  printResult("LiveDevice::add()", add_ns / 1000, "us");
+  stopwatch.restart();
+  for (const auto& id : added) {
+    live.remove(id);
+  }
+  auto remove_ns = stopwatch.elapsedNs() / static_cast<double>(updates);
+  printResult("LiveDevice::remove()", remove_ns / 1000, "us");
+
+  printHeader("element lookup");
+  vector<string> ids;
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (size_t i = 0; i < elements; i += 97) {
+    ids.push_back("dev:" + to_string(i / GROUP_SIZE) + "." +
+        to_string(i % GROUP_SIZE));
+  }
+  printResult("ArenaDevice", lookupNs(*rebuilt, ids), "ns");
+  printResult("LiveDevice", lookupNs(live, ids), "ns");
+  return EXIT_SUCCESS;
+}
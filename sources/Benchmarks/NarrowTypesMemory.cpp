@@ -0,0 +1,106 @@
+#include "BenchmarkUtils.hpp"
+#include "DataVariant.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures the memory footprint of a 10M sample in-memory history,
+ * recorded with the wide and narrow DataTypes
+ *
+ * Usage: NarrowTypesMemory [sample_count]
+ */
+namespace {
+constexpr size_t DEFAULT_SAMPLE_COUNT = 10'000'000;
+
+template <typename History, typename Fill, typename Scan>
+void measure(const string& name, size_t samples, Fill fill, Scan scan) {
+  auto baseline = liveBytes();
+  Stopwatch stopwatch;
+  History history;
+  history.reserve(samples);
+  for (size_t i = 0; i < samples; ++i) {
+    fill(history, i);
+  }
+  auto fill_ms = stopwatch.elapsedMs();
+  auto used = liveBytes() - baseline;
+
+  stopwatch.restart();
+  double sum = 0;
+  for (const auto& sample : history) {
+    sum += scan(sample);
+  }
+  doNotOptimize(sum);
+  auto scan_ms = stopwatch.elapsedMs();
+
+  printHeader(name);
+  printResult("heap usage", toMiB(used), "MiB");
+  printResult("bytes per sample",
+      static_cast<double>(used) / static_cast<double>(samples),
+      "B");
+  printResult("fill time", fill_ms, "ms");
+  printResult("scan time", scan_ms, "ms");
+}
+
+// NOLINTBEGIN(readability-magic-numbers)
+intmax_t sampleValue(size_t i) {
+  return static_cast<intmax_t>(i % 2000) - 1000;
+}
+
+double sampleReading(size_t i) {
+  return static_cast<double>(i % 1000) * 0.25;
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace
+
+int main(int argc, char** argv) {
+  auto samples = countArgument(argc, argv, 1, DEFAULT_SAMPLE_COUNT);
+  cout << "Recording " << samples << " samples per history" << endl;
+
+  measure<vector<DataVariant>>(
+      "DataVariant history, Integer samples",
+      samples,
+      [](auto& history, size_t i) { history.emplace_back(sampleValue(i)); },
+      [](const DataVariant& sample) {
+        return static_cast<double>(get<intmax_t>(sample));
+      });
+  measure<vector<DataVariant>>(
+      "DataVariant history, Integer_16 samples",
+      samples,
+      [](auto& history, size_t i) {
+        history.emplace_back(Integer16{static_cast<int16_t>(sampleValue(i))});
+      },
+      [](const DataVariant& sample) {
+        return static_cast<double>(get<Integer16>(sample).value);
+      });
+  measure<IntegerArray>(
+      "Integer_Array history",
+      samples,
+      [](auto& history, size_t i) { history.push_back(sampleValue(i)); },
+      [](intmax_t sample) { return static_cast<double>(sample); });
+  measure<Integer16Array>(
+      "Integer_16_Array history",
+      samples,
+      [](auto& history, size_t i) {
+        history.push_back(static_cast<int16_t>(sampleValue(i)));
+      },
+      [](int16_t sample) { return static_cast<double>(sample); });
+  measure<DoubleArray>(
+      "Double_Array history",
+      samples,
+      [](auto& history, size_t i) { history.push_back(sampleReading(i)); },
+      [](double sample) { return sample; });
+  measure<AlignedVector<float>>(
+      "Float native history",
+      samples,
+      [](auto& history, size_t i) {
+        history.push_back(static_cast<float>(sampleReading(i)));
+      },
+      [](float sample) { return static_cast<double>(sample); });
+  return EXIT_SUCCESS;
+}
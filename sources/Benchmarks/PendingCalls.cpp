@@ -0,0 +1,131 @@
+#include "BenchmarkUtils.hpp"
+#include "PendingCallRegistry.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures multi-threaded asynchronous call registration, completion
+ * and cancellation throughput of the PendingCallRegistry against a single
+ * mutex protected hash map with shared caller ids, as Callable
+ * implementations commonly build it
+ *
+ * Every thread keeps a window of pending calls, completing every second call
+ * and cancelling the rest
+ *
+ * Usage: PendingCalls [calls_per_thread] [max_threads]
+ */
+namespace {
+constexpr size_t DEFAULT_CALLS = 200'000;
+constexpr size_t WINDOW = 64;
+
+struct GlobalTable {
+  ResultFuture emplace() {
+    promise<DataVariant> result;
+    auto future = result.get_future();
+    lock_guard lock(mx);
+    auto id = make_shared<uintmax_t>(next++);
+    calls.emplace(*id, move(result));
+    return ResultFuture(id, move(future));
+  }
+
+  bool complete(uintmax_t id, const DataVariant& value) {
+    promise<DataVariant> result;
+    {
+      lock_guard lock(mx);
+      auto it = calls.find(id);
+      if (it == calls.end()) {
+        return false;
+      }
+      result = move(it->second);
+      calls.erase(it);
+    }
+    result.set_value(value);
+    return true;
+  }
+
+  bool cancel(uintmax_t id) {
+    promise<DataVariant> result;
+    {
+      lock_guard lock(mx);
+      auto it = calls.find(id);
+      if (it == calls.end()) {
+        return false;
+      }
+      result = move(it->second);
+      calls.erase(it);
+    }
+    result.set_exception(make_exception_ptr(CallCanceled(id, "table")));
+    return true;
+  }
+
+  mutex mx;
+  uintmax_t next = 0;
+  unordered_map<uintmax_t, promise<DataVariant>> calls;
+};
+
+template <typename Registry>
+void runCalls(Registry& registry, size_t calls) {
+  vector<ResultFuture> window;
+  window.reserve(WINDOW);
+  for (size_t i = 0; i < calls; ++i) {
+    window.push_back(registry.emplace());
+    if (window.size() == WINDOW) {
+      for (size_t call = 0; call < window.size(); ++call) {
+        if (call % 2 == 0) {
+          registry.complete(window[call].id(), DataVariant(true));
+        } else {
+          registry.cancel(window[call].id());
+        }
+      }
+      window.clear();
+    }
+  }
+  for (auto& result : window) {
+    registry.complete(result.id(), DataVariant(true));
+  }
+}
+
+template <typename Registry>
+double measure(Registry& registry, size_t threads, size_t calls) {
+  Stopwatch stopwatch;
+  vector<thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(
+        [&registry, calls]() { runCalls(registry, calls); });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return static_cast<double>(threads * calls) / stopwatch.elapsedMs() / 1000;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto calls = countArgument(argc, argv, 1, DEFAULT_CALLS);
+  auto max_threads = countArgument(
+      argc, argv, 2, max<size_t>(thread::hardware_concurrency(), 1));
+  cout << calls << " calls per thread, " << WINDOW << " pending per thread"
+       << endl;
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    printHeader(to_string(threads) + " threads");
+    PendingCallRegistry registry("benchmark");
+    printResult("sharded registry",
+        measure(registry, threads, calls),
+        "M calls/s");
+    GlobalTable table;
+    printResult("global hash map", measure(table, threads, calls), "M calls/s");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include "BenchmarkUtils.hpp"
+#include "PollingScheduler.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures PollingScheduler overhead per tick and per read for a
+ * growing number of registered elements and compares the idle tick overhead
+ * with scanning every registration on each tick
+ *
+ * Reads are executed inline, so only the scheduling overhead is measured
+ *
+ * Usage: PollingScheduler [max_elements]
+ */
+namespace {
+constexpr size_t DEFAULT_MAX_ELEMENTS = 100'000;
+constexpr size_t DEVICE_SIZE = 100;
+constexpr uint64_t TICKS = 20'000;
+
+struct ConstantReadable : public Readable {
+  DataType dataType() const final { return DataType::Integer; }
+
+  DataVariant read() const final { return DataVariant((intmax_t)1); }
+};
+
+chrono::milliseconds intervalOf(size_t element) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  constexpr int64_t intervals[] = {10, 50, 100, 250, 1000, 5000};
+  return chrono::milliseconds(intervals[(element / DEVICE_SIZE) % 6]);
+}
+
+struct Result {
+  double tick_ns;
+  size_t reads;
+};
+
+Result measureScheduler(size_t elements, bool idle) {
+  size_t reads = 0;
+  PollingScheduler scheduler(
+      [&reads](const PollBatch& batch) { reads += batch.results.size(); }, 0);
+  auto readable = make_shared<ConstantReadable>();
+  for (size_t i = 0; i < elements; ++i) {
+    scheduler.add("device:" + to_string(i / DEVICE_SIZE),
+        readable,
+        idle ? chrono::hours(1) : intervalOf(i));
+  }
+  Stopwatch stopwatch;
+  for (uint64_t tick = 1; tick <= TICKS; ++tick) {
+    scheduler.poll(scheduler.epoch() + chrono::milliseconds(tick));
+  }
+  return Result{stopwatch.elapsedNs() / TICKS, reads};
+}
+
+double measureScan(size_t elements) {
+  constexpr uint64_t hour = 3'600'000;
+  vector<uint64_t> deadlines(elements, hour);
+  vector<uint64_t> intervals(elements, hour);
+  ConstantReadable readable;
+  Stopwatch stopwatch;
+  for (uint64_t tick = 1; tick <= TICKS; ++tick) {
+    for (size_t i = 0; i < elements; ++i) {
+      if (deadlines[i] <= tick) {
+        deadlines[i] += intervals[i];
+        doNotOptimize(readable.read());
+      }
+    }
+  }
+  return stopwatch.elapsedNs() / TICKS;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto max_elements = countArgument(argc, argv, 1, DEFAULT_MAX_ELEMENTS);
+  cout << "Advancing " << TICKS << " ticks of 1 ms" << endl;
+
+  for (size_t elements = 1000; elements <= max_elements; elements *= 10) {
+    printHeader(to_string(elements) + " elements");
+    auto idle = measureScheduler(elements, true);
+    printResult("timer wheel, idle tick", idle.tick_ns, "ns/tick");
+    auto loaded = measureScheduler(elements, false);
+    printResult("timer wheel, loaded tick", loaded.tick_ns, "ns/tick");
+    printResult("timer wheel, per read",
+        loaded.tick_ns * TICKS / static_cast<double>(loaded.reads),
+        "ns/read");
+    printResult("linear scan, idle tick", measureScan(elements), "ns/tick");
+  }
+  return EXIT_SUCCESS;
+}
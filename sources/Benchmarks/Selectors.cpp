@@ -0,0 +1,133 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "Selector.hpp"
+
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures selecting elements of a device fleet by reference id
+ * patterns with a compiled Selector, against matching an equivalent regular
+ * expression with every id found by walking the Group::asMap() keys of every
+ * device
+ *
+ * Devices consist of groups with GROUP_SIZE Integer readables each.
+ *
+ * Usage: Selectors [devices] [elements] [repetitions]
+ */
+namespace {
+constexpr size_t DEFAULT_DEVICES = 200;
+constexpr size_t DEFAULT_ELEMENTS = 2'000;
+constexpr size_t DEFAULT_REPETITIONS = 5;
+constexpr size_t GROUP_SIZE = 50;
+
+struct Query {
+  string selector;
+  string regex;
+};
+
+const vector<Query> QUERIES = {{"device7:**", R"(device7:.+)"},
+    {"*:3.*", R"([^:]*:3\.[^.]*)"},
+    {"*:*.5", R"([^:]*:[^.]*\.5)"},
+    {"*:**.7", R"([^:]*:(.*\.)?7)"},
+    {"device7:3.5", R"(device7:3\.5)"}};
+
+DevicePtr buildDevice(const string& device_id, size_t elements) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo(device_id, BuildInfo{"Benchmark"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id =
+          builder.addGroup(BuildInfo{"Group " + to_string(i / GROUP_SIZE)});
+    }
+    builder.addInlineReadable(group_id,
+        BuildInfo{"Channel " + to_string(i)},
+        DataType::Integer,
+        [i]() { return DataVariant(static_cast<intmax_t>(i)); });
+  }
+  return builder.result();
+}
+
+void scanGroup(const GroupPtr& group,
+    const string& prefix,
+    const regex& pattern,
+    vector<ElementPtr>& selected) {
+  for (const auto& [key, element] : group->asMap()) {
+    auto id = prefix + key;
+    if (regex_match(id, pattern)) {
+      selected.push_back(element);
+    }
+    if (element->type() == ElementType::Group) {
+      scanGroup(get<GroupPtr>(element->function()),
+          id + ".",
+          pattern,
+          selected);
+    }
+  }
+}
+
+vector<ElementPtr> scanFleet(
+    const vector<DevicePtr>& fleet, const regex& pattern) {
+  vector<ElementPtr> selected;
+  for (const auto& device : fleet) {
+    scanGroup(device->group(), device->id() + ":", pattern, selected);
+  }
+  return selected;
+}
+
+template <typename Select>
+double averageUs(size_t repetitions, size_t& matches, Select&& select) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < repetitions; ++i) {
+    auto selected = select();
+    matches = selected.size();
+    doNotOptimize(selected);
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(repetitions) / 1000;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto devices = countArgument(argc, argv, 1, DEFAULT_DEVICES);
+  auto elements = countArgument(argc, argv, 2, DEFAULT_ELEMENTS);
+  auto repetitions = countArgument(argc, argv, 3, DEFAULT_REPETITIONS);
+  cout << devices << " devices with " << elements << " elements in groups of "
+       << GROUP_SIZE << ", " << repetitions << " repetitions" << endl;
+
+  vector<DevicePtr> fleet;
+  fleet.reserve(devices);
+  for (size_t i = 0; i < devices; ++i) {
+    fleet.push_back(buildDevice("device" + to_string(i), elements));
+  }
+
+  for (const auto& query : QUERIES) {
+    printHeader(query.selector);
+    size_t scanned = 0;
+    regex pattern(query.regex, regex::optimize);
+    printResult("asMap() regex scan",
+        averageUs(repetitions,
+            scanned,
+            [&fleet, &pattern]() { return scanFleet(fleet, pattern); }),
+        "us");
+    size_t selected = 0;
+    Selector selector(query.selector);
+    printResult("Selector::select()",
+        averageUs(repetitions,
+            selected,
+            [&fleet, &selector]() { return selector.select(fleet); }),
+        "us");
+    printResult("matches", static_cast<double>(selected), "elements");
+    if (scanned != selected) {
+      cerr << "Regex scan matched " << scanned << " elements" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
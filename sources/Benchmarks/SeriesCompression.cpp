@@ -0,0 +1,92 @@
+#include "BenchmarkUtils.hpp"
+#include "SeriesCompression.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures compression ratio and decode throughput of the series
+ * codecs on synthetic sensor traces
+ *
+ * Usage: SeriesCompression [sample_count]
+ */
+namespace {
+constexpr size_t DEFAULT_SAMPLE_COUNT = 1'000'000;
+constexpr size_t DECODE_REPETITIONS = 10;
+
+template <typename Series, typename Generator>
+void measure(const string& name, size_t samples, Generator generate) {
+  Series series;
+  for (size_t i = 0; i < samples; ++i) {
+    series.append(generate(i));
+  }
+  auto raw_size = samples * sizeof(typename Series::Value);
+
+  AlignedVector<typename Series::Value> decoded(samples);
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < DECODE_REPETITIONS; ++i) {
+    series.decode(0, samples, decoded.data());
+    doNotOptimize(decoded.back());
+  }
+  auto decode_ms = stopwatch.elapsedMs() / DECODE_REPETITIONS;
+
+  printHeader(name);
+  printResult("compressed size", toMiB(series.compressedSize()), "MiB");
+  printResult("bits per sample",
+      static_cast<double>(series.compressedSize() * 8) / // NOLINT
+          static_cast<double>(samples),
+      "bit");
+  printResult("compression ratio",
+      static_cast<double>(raw_size) /
+          static_cast<double>(series.compressedSize()),
+      "x");
+  printResult("decode throughput",
+      static_cast<double>(samples) / decode_ms / 1000.0, // NOLINT
+      "M samples/s");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto samples = countArgument(argc, argv, 1, DEFAULT_SAMPLE_COUNT);
+  cout << "Encoding " << samples << " samples per trace" << endl;
+
+  // NOLINTBEGIN(readability-magic-numbers)
+  mt19937_64 random(42);
+  normal_distribution<double> noise(0.0, 0.05);
+  uniform_int_distribution<int64_t> jitter(-500, 500);
+
+  measure<CompressedTimestamps>(
+      "1 s periodic timestamps", samples, [](size_t i) {
+        return int64_t{1757614163000000} + static_cast<int64_t>(i) * 1000000;
+      });
+  measure<CompressedTimestamps>(
+      "1 s timestamps with jitter", samples, [&](size_t i) {
+        return int64_t{1757614163000000} + static_cast<int64_t>(i) * 1000000 +
+            jitter(random);
+      });
+  measure<CompressedDoubles>(
+      "temperature, 0.1 resolution", samples, [&](size_t i) {
+        auto value = 21.0 + sin(static_cast<double>(i) * 1e-4) * 3.0 +
+            noise(random);
+        return round(value * 10.0) / 10.0;
+      });
+  measure<CompressedDoubles>("raw noisy readings", samples, [&](size_t i) {
+    return 21.0 + sin(static_cast<double>(i) * 1e-4) * 3.0 + noise(random);
+  });
+  measure<CompressedIntegers>("event counter", samples, [&](size_t i) {
+    return static_cast<intmax_t>(i + i / 3);
+  });
+  measure<CompressedIntegers>("ADC readings", samples, [&](size_t i) {
+    auto value = 2048.0 + sin(static_cast<double>(i) * 1e-3) * 1000.0 +
+        noise(random) * 100.0;
+    return static_cast<intmax_t>(value);
+  });
+  // NOLINTEND(readability-magic-numbers)
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+#include "ArenaDevice.hpp"
+#include "BenchmarkUtils.hpp"
+#include "StructuralHash.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Measures comparing two equal and two slightly different devices
+ * element by element with operator==, against comparing their structural
+ * hashes and finding the differences with diffStructure()
+ *
+ * Devices consist of groups with GROUP_SIZE Integer readables each. The
+ * changed device renames a single element.
+ *
+ * Usage: StructuralHash [elements] [repetitions]
+ */
+namespace {
+constexpr size_t DEFAULT_ELEMENTS = 100'000;
+constexpr size_t DEFAULT_REPETITIONS = 10;
+constexpr size_t GROUP_SIZE = 100;
+constexpr size_t HASH_COMPARISONS = 1'000'000;
+
+unique_ptr<Device> buildDevice(size_t elements, size_t renamed) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Benchmark"});
+  string group_id;
+  for (size_t i = 0; i < elements; ++i) {
+    if (i % GROUP_SIZE == 0) {
+      group_id =
+          builder.addGroup(BuildInfo{"Group " + to_string(i / GROUP_SIZE)});
+    }
+    auto name = "Channel " + to_string(i) + (i == renamed ? " renamed" : "");
+    builder.addInlineReadable(group_id,
+        BuildInfo{move(name)},
+        DataType::Integer,
+        [i]() { return DataVariant(static_cast<intmax_t>(i)); });
+  }
+  return builder.result();
+}
+
+bool equalGroups(const GroupPtr& lhs, const GroupPtr& rhs) {
+  auto lhs_elements = lhs->asVector();
+  auto rhs_elements = rhs->asVector();
+  if (lhs_elements.size() != rhs_elements.size()) {
+    return false;
+  }
+  bool equal = true;
+  // visits every element, as a consumer collecting the differences would
+  for (size_t i = 0; i < lhs_elements.size(); ++i) {
+    equal &= lhs_elements[i] == rhs_elements[i];
+    if (lhs_elements[i]->type() == ElementType::Group &&
+        rhs_elements[i]->type() == ElementType::Group) {
+      equal &= equalGroups(get<GroupPtr>(lhs_elements[i]->function()),
+          get<GroupPtr>(rhs_elements[i]->function()));
+    }
+  }
+  return equal;
+}
+
+double elementwiseUs(const Device& lhs, const Device& rhs, size_t repetitions) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < repetitions; ++i) {
+    doNotOptimize(equalGroups(lhs.group(), rhs.group()));
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(repetitions) / 1000;
+}
+
+double hashNs(const Device& lhs, const Device& rhs) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < HASH_COMPARISONS; ++i) {
+    doNotOptimize(lhs.structuralHash() == rhs.structuralHash());
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(HASH_COMPARISONS);
+}
+
+double diffUs(const Device& lhs, const Device& rhs, size_t repetitions) {
+  Stopwatch stopwatch;
+  for (size_t i = 0; i < repetitions; ++i) {
+    doNotOptimize(diffStructure(lhs, rhs));
+  }
+  return stopwatch.elapsedNs() / static_cast<double>(repetitions) / 1000;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto elements = countArgument(argc, argv, 1, DEFAULT_ELEMENTS);
+  auto repetitions = countArgument(argc, argv, 2, DEFAULT_REPETITIONS);
+  cout << elements << " elements in groups of " << GROUP_SIZE << ", "
+       << repetitions << " repetitions" << endl;
+
+  printHeader("build");
+  Stopwatch stopwatch;
+  auto device = buildDevice(elements, elements);
+  printResult("ArenaDevice with hashes", stopwatch.elapsedMs(), "ms");
+  auto same = buildDevice(elements, elements);
+  auto changed = buildDevice(elements, elements / 2);
+
+  printHeader("equal devices");
+  printResult("element wise operator==",
+      elementwiseUs(*device, *same, repetitions),
+      "us");
+  printResult("structuralHash() compare", hashNs(*device, *same), "ns");
+  printResult("diffStructure()", diffUs(*device, *same, repetitions), "us");
+
+  printHeader("one renamed element");
+  printResult("element wise operator==",
+      elementwiseUs(*device, *changed, repetitions),
+      "us");
+  printResult("structuralHash() compare", hashNs(*device, *changed), "ns");
+  printResult("diffStructure()", diffUs(*device, *changed, repetitions), "us");
+  return EXIT_SUCCESS;
+}
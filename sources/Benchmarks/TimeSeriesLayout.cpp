@@ -0,0 +1,113 @@
+#include "BenchmarkUtils.hpp"
+#include "DataVariant.hpp"
+#include "TimeSeries.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+using namespace std;
+using namespace Information_Model;
+using namespace Information_Model::benchmark;
+
+/**
+ * @brief Compares memory usage and scan throughput of a naive sample history
+ * with the columnar TimeSeries
+ *
+ * Usage: TimeSeriesLayout [sample_count]
+ */
+namespace {
+constexpr size_t DEFAULT_SAMPLE_COUNT = 1'000'000;
+constexpr int64_t SAMPLE_PERIOD = 1000;
+
+double sampleReading(size_t i) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  return static_cast<double>(i % 1000) * 0.25;
+}
+
+void printScan(double elapsed_ms, size_t samples) {
+  printResult("scan time", elapsed_ms, "ms");
+  printResult("scan throughput",
+      static_cast<double>(samples) / elapsed_ms / 1000.0, // NOLINT
+      "M samples/s");
+}
+
+void naiveHistory(size_t samples) {
+  auto baseline = liveBytes();
+  deque<pair<Timestamp, DataVariant>> history;
+  auto now = makeTimestamp();
+  for (size_t i = 0; i < samples; ++i) {
+    history.emplace_back(now, sampleReading(i));
+  }
+  auto used = liveBytes() - baseline;
+
+  Stopwatch stopwatch;
+  double sum = 0;
+  for (const auto& [time, value] : history) {
+    sum += get<double>(value);
+  }
+  doNotOptimize(sum);
+  auto scan_ms = stopwatch.elapsedMs();
+
+  printHeader("deque<pair<Timestamp, DataVariant>>");
+  printResult("heap usage", toMiB(used), "MiB");
+  printResult("bytes per sample",
+      static_cast<double>(used) / static_cast<double>(samples),
+      "B");
+  printScan(scan_ms, samples);
+}
+
+void columnarHistory(size_t samples) {
+  auto baseline = liveBytes();
+  TimeSeries history(DataType::Double, samples);
+  auto start = toEpochMicroseconds(makeTimestamp());
+  for (size_t i = 0; i < samples; ++i) {
+    history.append<double>(
+        start + static_cast<int64_t>(i) * SAMPLE_PERIOD, sampleReading(i));
+  }
+  auto used = liveBytes() - baseline;
+
+  Stopwatch stopwatch;
+  double sum = 0;
+  for (const auto& segment : history.segments<double>()) {
+    for (size_t i = 0; i < segment.size; ++i) {
+      sum += segment.values[i];
+    }
+  }
+  doNotOptimize(sum);
+  auto scan_ms = stopwatch.elapsedMs();
+
+  stopwatch.restart();
+  double visited = 0;
+  history.forEach<double>(
+      [&visited](int64_t, double value) { visited += value; });
+  doNotOptimize(visited);
+  auto visit_ms = stopwatch.elapsedMs();
+
+  stopwatch.restart();
+  auto middle = start + static_cast<int64_t>(samples / 2) * SAMPLE_PERIOD;
+  size_t sliced = 0;
+  history.forEach<double>(
+      [&sliced](int64_t, double) { ++sliced; }, middle, middle + 60'000'000);
+  doNotOptimize(sliced);
+  auto slice_ms = stopwatch.elapsedMs();
+
+  printHeader("TimeSeries, Double column");
+  printResult("heap usage", toMiB(used), "MiB");
+  printResult("bytes per sample",
+      static_cast<double>(used) / static_cast<double>(samples),
+      "B");
+  printScan(scan_ms, samples);
+  printResult("forEach time", visit_ms, "ms");
+  printResult("1 minute slice time", slice_ms, "ms");
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  auto samples = countArgument(argc, argv, 1, DEFAULT_SAMPLE_COUNT);
+  cout << "Recording " << samples << " samples per history" << endl;
+
+  naiveHistory(samples);
+  columnarHistory(samples);
+  return EXIT_SUCCESS;
+}
@@ -38,6 +38,19 @@ int main() {
   // You can get the exact DataType of the stored variant value
   auto data_type = toDataType(variant_value);
 
+  // You can map between C++ types and DataTypes at compile time
+  static_assert(DataTypeOf_v<double> == DataType::Double);
+  static_assert(is_same_v<TypeOf_t<DataType::String>, string>);
+
+  // Or dispatch a runtime DataType value to generic code, without listing
+  // every supported type
+  auto native_size = visitDataType(data_type, [](auto tag) {
+    using NativeType = typename decltype(tag)::type;
+    return sizeof(NativeType);
+  });
+  cout << "Native type of " << toString(data_type) << " takes " << native_size
+       << " bytes" << endl;
+
   // You can convert any DataType into a human readable string
   cout << "Stored data variant is of " << toString(data_type) << " type"
        << endl;
@@ -67,6 +80,41 @@ int main() {
       },
       [](const string& value) {
         cout << "matched to a string " << value << endl;
+      },
+      [](const IntegerArray& values) {
+        cout << "matched to an int array of " << values.size() << " values"
+             << endl;
+      },
+      [](const UnsignedIntegerArray& values) {
+        cout << "matched to an uint array of " << values.size() << " values"
+             << endl;
+      },
+      [](const DoubleArray& values) {
+        // array values are stored in contiguous memory, so you can pass them
+        // directly to any bulk processing functions
+        cout << "matched to a double array of " << values.size()
+             << " values, starting at " << values.data() << endl;
+      },
+      // narrow numeric values are wrapped, so they never match the wide
+      // integer or double overloads by accident
+      [](Integer16 value) {
+        cout << "matched to an int16 " << value.value << endl;
+      },
+      [](Integer32 value) {
+        cout << "matched to an int32 " << value.value << endl;
+      },
+      [](UnsignedInteger16 value) {
+        cout << "matched to an uint16 " << value.value << endl;
+      },
+      [](UnsignedInteger32 value) {
+        cout << "matched to an uint32 " << value.value << endl;
+      },
+      [](Float32 value) {
+        cout << "matched to a float " << value.value << endl;
+      },
+      [](const Integer16Array& values) {
+        cout << "matched to an int16 array of " << values.size() << " values"
+             << endl;
       });
 
   // If you only need to cover certain data types, you can use auto keyword as a
@@ -92,6 +140,20 @@ int main() {
   cout << "Stored variant value as a sanitized string is: "
        << toSanitizedString(variant_value) << endl;
 
+  // You can losslessly widen narrow numeric values, for example to store them
+  // as the widest type of their kind
+  auto register_value = DataVariant(Integer16{-1200});
+  auto wide_value = widen(register_value, DataType::Integer);
+  cout << "Widened " << toString(toDataType(register_value)) << " value to "
+       << toString(toDataType(wide_value)) << endl;
+
+  try {
+    // Or narrow them back, if the value fits into the narrow type
+    narrow(wide_value, DataType::Unsigned_Integer_16);
+  } catch (const ValueOutOfRange& ex) {
+    cout << "Could not narrow the value: " << ex.what() << endl;
+  }
+
   // You can generate a timestamp of a current value
   auto current_time = makeTimestamp();
 
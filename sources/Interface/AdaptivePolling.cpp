@@ -0,0 +1,184 @@
+#include "AdaptivePolling.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+struct PolledObservable::SubscriptionToken final : public Observer {
+  SubscriptionToken(
+      weak_ptr<PolledObservable> owner, const Subscription* subscription)
+      : owner_(move(owner)), subscription_(subscription) {}
+
+  ~SubscriptionToken() override {
+    if (auto owner = owner_.lock()) {
+      owner->unsubscribe(subscription_);
+    }
+  }
+
+private:
+  weak_ptr<PolledObservable> owner_;
+  const Subscription* subscription_;
+};
+
+PolledObservable::PolledObservable(
+    const shared_ptr<PollingScheduler>& scheduler,
+    const string& device_id,
+    const ReadablePtr& readable,
+    const AdaptivePolicy& policy)
+    : scheduler_(scheduler), device_id_(device_id), readable_(readable),
+      policy_(policy), interval_(policy.min_interval) {}
+
+PolledObservable::~PolledObservable() {
+  if (poll_id_.has_value()) {
+    scheduler_->remove(*poll_id_);
+  }
+}
+
+DataType PolledObservable::dataType() const { return readable_->dataType(); }
+
+DataVariant PolledObservable::read() const { return readable_->read(); }
+
+ObserverPtr PolledObservable::subscribe(
+    const ObserveCallback& observe_cb, const ExceptionHandler& handler) {
+  if (!observe_cb) {
+    throw invalid_argument("Observe callback can not be null");
+  }
+  auto subscription =
+      make_shared<Subscription>(Subscription{observe_cb, handler});
+  lock_guard lock(mx_);
+  subscriptions_.push_back(subscription);
+  if (!poll_id_.has_value()) {
+    interval_ = policy_.min_interval;
+    stable_ = 0;
+    last_.reset();
+    weak_ptr<PolledObservable> weak_this = weak_from_this();
+    poll_id_ = scheduler_->add(device_id_,
+        readable_,
+        interval_,
+        [weak_this](const PollResult& result) {
+          if (auto self = weak_this.lock()) {
+            self->handle(result);
+          }
+        });
+  }
+  return make_shared<SubscriptionToken>(weak_from_this(), subscription.get());
+}
+
+optional<AdaptivePolicy::Duration> PolledObservable::currentInterval() const {
+  lock_guard lock(mx_);
+  if (!poll_id_.has_value()) {
+    return nullopt;
+  }
+  return interval_;
+}
+
+AdaptivePollingStatistics PolledObservable::statistics() const {
+  lock_guard lock(mx_);
+  return statistics_;
+}
+
+void PolledObservable::unsubscribe(const Subscription* subscription) {
+  lock_guard lock(mx_);
+  subscriptions_.erase(remove_if(subscriptions_.begin(),
+                           subscriptions_.end(),
+                           [subscription](const auto& stored) {
+                             return stored.get() == subscription;
+                           }),
+      subscriptions_.end());
+  if (subscriptions_.empty() && poll_id_.has_value()) {
+    scheduler_->remove(*poll_id_);
+    poll_id_.reset();
+  }
+}
+
+void PolledObservable::handle(const PollResult& result) {
+  vector<shared_ptr<Subscription>> targets;
+  shared_ptr<DataVariant> value;
+  {
+    lock_guard lock(mx_);
+    if (!poll_id_.has_value() || result.id != *poll_id_) {
+      // late result of a stopped registration
+      return;
+    }
+    ++statistics_.reads;
+    if (result.error) {
+      ++statistics_.failures;
+      targets = subscriptions_;
+    } else {
+      auto changed = !last_.has_value() || compare(*last_, result.value) != 0;
+      if (changed) {
+        if (last_.has_value()) {
+          ++statistics_.changes;
+        }
+        last_ = result.value;
+        value = make_shared<DataVariant>(result.value);
+        targets = subscriptions_;
+      }
+      auto interval = adapt(changed);
+      if (interval != interval_) {
+        interval_ = interval;
+        scheduler_->setInterval(*poll_id_, interval_);
+      }
+    }
+  }
+  // observers are called without holding the lock, so they can subscribe
+  // and unsubscribe
+  for (const auto& target : targets) {
+    if (result.error) {
+      if (target->handler) {
+        target->handler(result.error);
+      }
+      continue;
+    }
+    try {
+      target->observe(value);
+    } catch (...) {
+      if (target->handler) {
+        target->handler(current_exception());
+      }
+    }
+  }
+}
+
+AdaptivePolicy::Duration PolledObservable::adapt(bool changed) {
+  if (changed) {
+    stable_ = 0;
+    return policy_.min_interval;
+  }
+  if (++stable_ < policy_.stable_reads) {
+    return interval_;
+  }
+  stable_ = 0;
+  using Rep = AdaptivePolicy::Duration::rep;
+  auto grown = AdaptivePolicy::Duration(static_cast<Rep>(
+      static_cast<double>(interval_.count()) * policy_.backoff));
+  return min(grown, policy_.max_interval);
+}
+
+PolledObservablePtr makePolledObservable(
+    const shared_ptr<PollingScheduler>& scheduler,
+    const string& device_id,
+    const ReadablePtr& readable,
+    const AdaptivePolicy& policy) {
+  if (!scheduler || !readable) {
+    throw invalid_argument("Scheduler and readable can not be null");
+  }
+  if (policy.min_interval < scheduler->resolution()) {
+    throw invalid_argument(
+        "Minimal interval can not be shorter than the scheduler resolution");
+  }
+  if (policy.max_interval < policy.min_interval) {
+    throw invalid_argument(
+        "Maximal interval can not be shorter than the minimal interval");
+  }
+  if (policy.backoff <= 1.0 || policy.stable_reads == 0) {
+    throw invalid_argument(
+        "Backoff must be greater than 1 and stable reads can not be 0");
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  return PolledObservablePtr(
+      new PolledObservable(scheduler, device_id, readable, policy));
+}
+} // namespace Information_Model
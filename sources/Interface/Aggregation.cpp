@@ -0,0 +1,180 @@
+#include "Aggregation.hpp"
+
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+constexpr size_t LANES = 4;
+
+/**
+ * @brief Aggregates values with independent accumulators, so consecutive
+ * iterations do not depend on each other
+ */
+template <typename T>
+Aggregate<T> aggregateScalar(const T* values, size_t count) {
+  Aggregate<T> result;
+  if (count == 0) {
+    return result;
+  }
+  // integer sums use unsigned arithmetic, so they wrap around on overflow
+  using Sum = conditional_t<is_floating_point_v<T>, double, uint64_t>;
+  array<T, LANES> minimums;
+  array<T, LANES> maximums;
+  array<Sum, LANES> sums{};
+  minimums.fill(result.min);
+  maximums.fill(result.max);
+  size_t i = 0;
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  for (; i + LANES <= count; i += LANES) {
+    for (size_t lane = 0; lane < LANES; ++lane) {
+      auto value = values[i + lane];
+      minimums[lane] = value < minimums[lane] ? value : minimums[lane];
+      maximums[lane] = value > maximums[lane] ? value : maximums[lane];
+      sums[lane] += static_cast<Sum>(value);
+    }
+  }
+  for (; i < count; ++i) {
+    auto value = values[i];
+    minimums[0] = value < minimums[0] ? value : minimums[0];
+    maximums[0] = value > maximums[0] ? value : maximums[0];
+    sums[0] += static_cast<Sum>(value);
+  }
+  result.last = values[count - 1];
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  result.count = count;
+  result.min = *min_element(minimums.begin(), minimums.end());
+  result.max = *max_element(maximums.begin(), maximums.end());
+  result.sum = static_cast<T>((sums[0] + sums[1]) + (sums[2] + sums[3]));
+  return result;
+}
+
+#if defined(__AVX2__)
+Aggregate<double> aggregateAVX2(const double* values, size_t count) {
+  constexpr size_t step = 2 * LANES;
+  if (count < step) {
+    return aggregateScalar(values, count);
+  }
+  Aggregate<double> result;
+  auto minimums = _mm256_set1_pd(result.min);
+  auto maximums = _mm256_set1_pd(result.max);
+  auto sums_low = _mm256_setzero_pd();
+  auto sums_high = _mm256_setzero_pd();
+  size_t i = 0;
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  for (; i + step <= count; i += step) {
+    auto low = _mm256_loadu_pd(values + i);
+    auto high = _mm256_loadu_pd(values + i + LANES);
+    minimums = _mm256_min_pd(minimums, _mm256_min_pd(low, high));
+    maximums = _mm256_max_pd(maximums, _mm256_max_pd(low, high));
+    sums_low = _mm256_add_pd(sums_low, low);
+    sums_high = _mm256_add_pd(sums_high, high);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  alignas(32) array<double, LANES> lanes_min;
+  alignas(32) array<double, LANES> lanes_max;
+  alignas(32) array<double, LANES> lanes_sum;
+  _mm256_store_pd(lanes_min.data(), minimums);
+  _mm256_store_pd(lanes_max.data(), maximums);
+  _mm256_store_pd(lanes_sum.data(), _mm256_add_pd(sums_low, sums_high));
+  result.count = i;
+  result.min = *min_element(lanes_min.begin(), lanes_min.end());
+  result.max = *max_element(lanes_max.begin(), lanes_max.end());
+  result.sum = (lanes_sum[0] + lanes_sum[1]) + (lanes_sum[2] + lanes_sum[3]);
+  result.last = values[i - 1]; // NOLINT
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  merge(result, aggregateScalar(values + i, count - i));
+  return result;
+}
+
+/**
+ * @brief AVX2 has no 64 bit integer min/max instructions, so they are built
+ * from signed comparisons. Unsigned values are compared with flipped sign bits
+ */
+template <typename T>
+Aggregate<T> aggregateAVX2(const T* values, size_t count) {
+  if (count < LANES) {
+    return aggregateScalar(values, count);
+  }
+  constexpr bool is_unsigned = is_unsigned_v<T>;
+  const auto bias = _mm256_set1_epi64x(
+      is_unsigned ? numeric_limits<int64_t>::min() : int64_t{0});
+  Aggregate<T> result;
+  auto minimums = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(result.min)), bias);
+  auto maximums = _mm256_xor_si256(
+      _mm256_set1_epi64x(static_cast<int64_t>(result.max)), bias);
+  auto sums = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    auto raw = _mm256_loadu_si256(
+        // NOLINTNEXTLINE
+        reinterpret_cast<const __m256i*>(values + i));
+    auto biased = _mm256_xor_si256(raw, bias);
+    minimums = _mm256_blendv_epi8(
+        minimums, biased, _mm256_cmpgt_epi64(minimums, biased));
+    maximums = _mm256_blendv_epi8(
+        maximums, biased, _mm256_cmpgt_epi64(biased, maximums));
+    sums = _mm256_add_epi64(sums, raw);
+  }
+  alignas(32) array<T, LANES> lanes_min;
+  alignas(32) array<T, LANES> lanes_max;
+  alignas(32) array<T, LANES> lanes_sum;
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_min.data()),
+      _mm256_xor_si256(minimums, bias));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_max.data()),
+      _mm256_xor_si256(maximums, bias));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lanes_sum.data()), sums);
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+  result.count = i;
+  result.min = *min_element(lanes_min.begin(), lanes_min.end());
+  result.max = *max_element(lanes_max.begin(), lanes_max.end());
+  // sums wrap around, same as in the scalar kernel
+  uint64_t sum = 0;
+  for (auto lane : lanes_sum) {
+    sum += static_cast<uint64_t>(lane);
+  }
+  result.sum = static_cast<T>(sum);
+  result.last = values[i - 1]; // NOLINT
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  merge(result, aggregateScalar(values + i, count - i));
+  return result;
+}
+#endif
+
+template <typename T>
+Aggregate<T> aggregateValues(const T* values, size_t count) {
+#if defined(__AVX2__)
+  return aggregateAVX2(values, count);
+#else
+  return aggregateScalar(values, count);
+#endif
+}
+} // namespace
+
+Aggregate<double> aggregate(const double* values, size_t count) {
+  return aggregateValues(values, count);
+}
+
+Aggregate<intmax_t> aggregate(const intmax_t* values, size_t count) {
+  return aggregateValues(values, count);
+}
+
+Aggregate<uintmax_t> aggregate(const uintmax_t* values, size_t count) {
+  return aggregateValues(values, count);
+}
+
+string aggregationKernel() {
+#if defined(__AVX2__)
+  return "AVX2";
+#else
+  return "Scalar";
+#endif
+}
+} // namespace Information_Model
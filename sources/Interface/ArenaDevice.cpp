@@ -0,0 +1,1938 @@
+#include "ArenaDevice.hpp"
+#include "ObservableHub.hpp"
+#include "StructuralHash.hpp"
+#include "TypedElement.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace Information_Model {
+using namespace std;
+
+namespace detail {
+constexpr uint32_t NO_PARENT = UINT32_MAX;
+constexpr uint32_t NOT_FOUND = UINT32_MAX;
+constexpr size_t NODE_ALIGNMENT = alignof(max_align_t);
+
+/**
+ * @brief Position of a string within the model string pool
+ */
+struct Text {
+  uint32_t offset = 0;
+  uint32_t length = 0;
+};
+
+struct NodeLinks {
+  ElementType type;
+  DataType data_type;
+  uint32_t index;
+  uint32_t parent;
+  uint32_t first_child;
+  uint32_t child_count;
+  /**
+   * @brief Position within the ParameterTypes table, 0 points to an empty
+   * table for all elements but Callables
+   */
+  uint32_t parameters;
+  /**
+   * @brief Element id without the device id and the following colon
+   */
+  Text id;
+  Text name;
+  Text description;
+};
+
+/**
+ * @brief Immutable element structure of an ArenaDevice
+ *
+ * Holds everything but the device id and the element callbacks. Devices
+ * instantiated from the same ArenaDeviceTemplate share a single structure.
+ */
+struct ArenaStructure {
+  string toString(Text text) const { return string(view(text)); }
+
+  string_view view(Text text) const {
+    return string_view(text_.data() + text.offset, text.length);
+  }
+
+  string text_;
+  vector<uint32_t> children_;
+  vector<NodeLinks> links_;
+  vector<ParameterTypes> parameter_types_;
+  /**
+   * @brief Structural hashes of all elements, indexed by their arena index.
+   * Writable elements are hashed as readable, devices with write only
+   * elements hash their own structure
+   */
+  vector<size_t> hashes_;
+};
+
+/**
+ * @brief Element recorded by the builder, before it is placed into the arena
+ */
+struct ArenaSpec {
+  struct Entry {
+    ElementType type = ElementType::Group;
+    uint32_t parent = NO_PARENT;
+    uint32_t children = 0;
+    string id;
+    string name;
+    string description;
+    DataType data_type = DataType::None;
+    DeviceBuilder::InlineReadCallback read;
+    DeviceBuilder::InlineWriteCallback write;
+    shared_ptr<ObservableHub> hub;
+    DeviceBuilder::InlineExecuteCallback execute;
+    DeviceBuilder::InlineAsyncExecuteCallback async_execute;
+    DeviceBuilder::InlineCancelCallback cancel;
+    /**
+     * @brief Native value callbacks, set by the addTyped*() methods instead
+     * of read and write. Their held alternative matches data_type
+     */
+    optional<DeviceBuilder::AnyReadCallback> typed_read;
+    optional<DeviceBuilder::AnyWriteCallback> typed_write;
+    ParameterTypes parameter_types;
+
+    bool isTyped() const {
+      return typed_read.has_value() || typed_write.has_value();
+    }
+
+    bool isWriteOnly() const {
+      if (typed_read.has_value()) {
+        return visit([](const auto& read) { return !read; }, *typed_read);
+      }
+      return !read;
+    }
+  };
+
+  string device_id;
+  BuildInfo device_info;
+  vector<Entry> entries;
+  unordered_map<string, uint32_t> groups;
+};
+
+/**
+ * @brief Elements of a single ConcurrentArenaDeviceBuilder branch. Entry 0 is
+ * the branch group, entries are rebased onto the device root when merged
+ */
+struct ArenaBranch {
+  string id;
+  ArenaSpec spec;
+  atomic<bool> in_use{true};
+};
+
+struct ArenaNode;
+struct ArenaGroup;
+
+struct ArenaModel : public enable_shared_from_this<ArenaModel> {
+  ArenaModel() = default;
+  ArenaModel(const ArenaModel&) = delete;
+  ArenaModel& operator=(const ArenaModel&) = delete;
+  ~ArenaModel();
+
+  string toString(Text text) const { return structure_->toString(text); }
+
+  string_view view(Text text) const { return structure_->view(text); }
+
+  /**
+   * @brief Returns the full element id, starting with the device id
+   */
+  string id(const NodeLinks& links) const;
+
+  const NodeLinks& links(uint32_t index) const {
+    return structure_->links_[index];
+  }
+
+  const ParameterTypes& parameterTypes(const NodeLinks& links) const {
+    return structure_->parameter_types_[links.parameters];
+  }
+
+  ArenaGroup* root() const;
+
+  uint32_t child(const NodeLinks& group, uint32_t position) const {
+    return structure_->children_[group.first_child + position];
+  }
+
+  /**
+   * @brief Returns the arena index of a given element id
+   *
+   * @return uint32_t - NOT_FOUND if the id does not point to an element
+   */
+  uint32_t resolve(const string& ref_id) const noexcept;
+
+  ElementPtr element(uint32_t index) const;
+
+  /**
+   * @brief Shares the ownership of an already locked owner, used when
+   * returning many elements at once
+   */
+  ElementPtr element(
+      const shared_ptr<const ArenaModel>& owner, uint32_t index) const;
+
+  template <typename T> shared_ptr<T> share(T* node) const {
+    return shared_ptr<T>(shared_from_this(), node);
+  }
+
+  size_t hash(uint32_t index) const {
+    return write_only_hashes_.empty() ? structure_->hashes_[index]
+                                      : write_only_hashes_[index];
+  }
+
+  string device_id_;
+  shared_ptr<const ArenaStructure> structure_;
+  unique_ptr<byte[]> arena_;
+  size_t arena_size_ = 0;
+  vector<ArenaNode*> nodes_;
+  /**
+   * @brief Structural hashes of all elements, only set if some Writable
+   * element is write only, see ArenaStructure::hashes_
+   */
+  vector<size_t> write_only_hashes_;
+};
+
+struct ArenaNode : public Element {
+  ArenaNode(const ArenaModel* model, const NodeLinks& links)
+      : model_(model), links_(links) {}
+
+  string id() const final { return model_->id(links_); }
+
+  string name() const final { return model_->toString(links_.name); }
+
+  string description() const final {
+    return model_->toString(links_.description);
+  }
+
+  ElementType type() const final { return links_.type; }
+
+  size_t structuralHash() const final { return model_->hash(links_.index); }
+
+protected:
+  const ArenaModel* model_;
+  const NodeLinks& links_;
+};
+
+struct ArenaGroup final : public ArenaNode, public Group {
+  using ArenaNode::ArenaNode;
+
+  ElementFunction function() const final {
+    return model_->share<Group>(const_cast<ArenaGroup*>(this));
+  }
+
+  size_t size() const final { return links_.child_count; }
+
+  unordered_map<string, ElementPtr> asMap() const final {
+    // root children ids have no separator after the group id
+    auto prefix = links_.id.length + (links_.parent == NO_PARENT ? 0 : 1);
+    auto owner = model_->shared_from_this();
+    unordered_map<string, ElementPtr> result;
+    result.reserve(links_.child_count);
+    for (uint32_t position = 0; position < links_.child_count; ++position) {
+      auto index = model_->child(links_, position);
+      auto id = model_->view(model_->links(index).id);
+      result.emplace(string(id.substr(prefix)), model_->element(owner, index));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Elements are returned in the order they were built, which is the
+   * numeric order of their positions
+   */
+  vector<ElementPtr> asVector() const final {
+    auto owner = model_->shared_from_this();
+    vector<ElementPtr> result;
+    result.reserve(links_.child_count);
+    for (uint32_t position = 0; position < links_.child_count; ++position) {
+      result.push_back(
+          model_->element(owner, model_->child(links_, position)));
+    }
+    return result;
+  }
+
+  ElementPtr element(const string& ref_id) const final {
+    return tryElement(ref_id).value();
+  }
+
+  Expected<ElementPtr> tryElement(const string& ref_id) const {
+    auto index = model_->resolve(ref_id);
+    if (index == links_.index) {
+      return Error(ErrorCode::ID_Points_This_Group, ref_id);
+    }
+    if (index != NOT_FOUND) {
+      for (auto parent = model_->links(index).parent; parent != NO_PARENT;
+           parent = model_->links(parent).parent) {
+        if (parent == links_.index) {
+          return model_->element(index);
+        }
+      }
+    }
+    return Error(ErrorCode::Element_Not_Found, ref_id);
+  }
+
+  void visit(const Visitor& visitor) const final {
+    auto owner = model_->shared_from_this();
+    for (uint32_t position = 0; position < links_.child_count; ++position) {
+      visitor(model_->element(owner, model_->child(links_, position)));
+    }
+  }
+};
+
+struct ArenaReadable final : public ArenaNode, public Readable {
+  ArenaReadable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links), read_(move(entry.read)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Readable>(const_cast<ArenaReadable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  DataVariant read() const final { return read_(); }
+
+  Expected<DataVariant> tryRead() const final {
+    try {
+      return read_();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+};
+
+struct ArenaWritable final : public ArenaNode, public Writable {
+  ArenaWritable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links), read_(move(entry.read)),
+        write_(move(entry.write)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Writable>(const_cast<ArenaWritable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  DataVariant read() const final {
+    if (!read_) {
+      throw NonReadable();
+    }
+    return read_();
+  }
+
+  bool isWriteOnly() const final { return !read_; }
+
+  void write(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != links_.data_type) {
+      throw DataTypeMismatch(id(), links_.data_type, value_type);
+    }
+    write_(value);
+  }
+
+  Expected<DataVariant> tryRead() const final {
+    if (!read_) {
+      return Error(ErrorCode::Non_Readable);
+    }
+    try {
+      return read_();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+  Expected<void> tryWrite(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != links_.data_type) {
+      return Error(ErrorCode::Data_Type_Mismatch,
+          id(),
+          0,
+          links_.data_type,
+          value_type);
+    }
+    try {
+      write_(value);
+      return {};
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+  DeviceBuilder::InlineWriteCallback write_;
+};
+
+struct ArenaObservable final : public ArenaNode, public Observable {
+  ArenaObservable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links), read_(move(entry.read)),
+        hub_(move(entry.hub)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Observable>(const_cast<ArenaObservable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  DataVariant read() const final { return read_(); }
+
+  ObserverPtr subscribe(const ObserveCallback& observe_cb,
+      const ExceptionHandler& handler) final {
+    return hub_->subscribe(observe_cb, handler);
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+  shared_ptr<ObservableHub> hub_;
+};
+
+struct ArenaCallable final : public ArenaNode, public Callable {
+  ArenaCallable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links), execute_(move(entry.execute)),
+        async_execute_(move(entry.async_execute)),
+        cancel_(move(entry.cancel)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Callable>(const_cast<ArenaCallable*>(this));
+  }
+
+  void execute(const Parameters& parameters) const final {
+    checkParameters(parameters, model_->parameterTypes(links_));
+    execute_(parameters);
+  }
+
+  DataVariant call(uintmax_t timeout) const final {
+    return call(Parameters(), timeout);
+  }
+
+  DataVariant call(
+      const Parameters& parameters, uintmax_t timeout) const final {
+    return tryCall(parameters, timeout).value();
+  }
+
+  Expected<DataVariant> tryCall(
+      const Parameters& parameters, uintmax_t timeout) const final {
+    if (!async_execute_) {
+      return Error(ErrorCode::Result_Returning_Not_Supported);
+    }
+    auto checked =
+        tryCheckParameters(parameters, model_->parameterTypes(links_));
+    if (!checked) {
+      return checked.error();
+    }
+    try {
+      auto result = async_execute_(parameters);
+      auto wait = chrono::milliseconds(static_cast<chrono::milliseconds::rep>(
+          min<uintmax_t>(timeout, INT32_MAX)));
+      if (result.waitFor(wait) != future_status::ready) {
+        cancel_(result.id());
+        return Error(ErrorCode::Call_Timedout, name());
+      }
+      return result.get();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+  ResultFuture asyncCall(const Parameters& parameters) const final {
+    if (!async_execute_) {
+      throw ResultReturningNotSupported();
+    }
+    checkParameters(parameters, model_->parameterTypes(links_));
+    return async_execute_(parameters);
+  }
+
+  void cancelAsyncCall(uintmax_t call_id) const final {
+    if (!cancel_) {
+      throw ResultReturningNotSupported();
+    }
+    cancel_(call_id);
+  }
+
+  DataType resultType() const final { return links_.data_type; }
+
+  ParameterTypes parameterTypes() const final {
+    return model_->parameterTypes(links_);
+  }
+
+private:
+  DeviceBuilder::InlineExecuteCallback execute_;
+  DeviceBuilder::InlineAsyncExecuteCallback async_execute_;
+  DeviceBuilder::InlineCancelCallback cancel_;
+};
+
+/**
+ * @brief Forwards the DataVariant read() of a given element interface, so a
+ * node can also implement a typed read() with a different result type
+ */
+template <typename Interface> struct BoxedRead : public Interface {
+  DataVariant read() const final { return readBoxed(); }
+
+protected:
+  virtual DataVariant readBoxed() const = 0;
+};
+
+/**
+ * @brief Forwards the native read() of a given typed interface, see
+ * BoxedRead
+ */
+template <template <typename> class Typed, typename T>
+struct NativeRead : public Typed<T> {
+  T read() const final { return readNative(); }
+
+protected:
+  virtual T readNative() const = 0;
+};
+
+/**
+ * @brief Readable, built from a native value callback. Implements
+ * TypedReadable<T>, so typed views call the callback without boxing
+ */
+template <typename T>
+struct ArenaTypedReadable final : public ArenaNode,
+                                  public BoxedRead<Readable>,
+                                  public NativeRead<TypedReadable, T> {
+  ArenaTypedReadable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links),
+        read_(get<VariantIndexOf_v<T>>(move(*entry.typed_read))) {}
+
+  ElementFunction function() const final {
+    return model_->share<Readable>(const_cast<ArenaTypedReadable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  Expected<DataVariant> tryRead() const final {
+    try {
+      return DataVariant(read_());
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+protected:
+  DataVariant readBoxed() const final { return DataVariant(read_()); }
+
+  T readNative() const final { return read_(); }
+
+private:
+  DeviceBuilder::TypedReadCallback<T> read_;
+};
+
+/**
+ * @brief Writable, built from native value callbacks, see ArenaTypedReadable
+ */
+template <typename T>
+struct ArenaTypedWritable final : public ArenaNode,
+                                  public BoxedRead<Writable>,
+                                  public NativeRead<TypedReadable, T>,
+                                  public NativeRead<TypedWritable, T> {
+  ArenaTypedWritable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links),
+        read_(get<VariantIndexOf_v<T>>(move(*entry.typed_read))),
+        write_(get<VariantIndexOf_v<T>>(move(*entry.typed_write))) {}
+
+  ElementFunction function() const final {
+    return model_->share<Writable>(const_cast<ArenaTypedWritable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  bool isWriteOnly() const final { return !read_; }
+
+  void write(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != links_.data_type) {
+      throw DataTypeMismatch(id(), links_.data_type, value_type);
+    }
+    write_(get<T>(value));
+  }
+
+  void write(const T& value) const final { write_(value); }
+
+  Expected<DataVariant> tryRead() const final {
+    if (!read_) {
+      return Error(ErrorCode::Non_Readable);
+    }
+    try {
+      return DataVariant(read_());
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+  Expected<void> tryWrite(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != links_.data_type) {
+      return Error(ErrorCode::Data_Type_Mismatch,
+          id(),
+          0,
+          links_.data_type,
+          value_type);
+    }
+    try {
+      write_(get<T>(value));
+      return {};
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+protected:
+  DataVariant readBoxed() const final { return DataVariant(readNative()); }
+
+  T readNative() const final {
+    if (!read_) {
+      throw NonReadable();
+    }
+    return read_();
+  }
+
+private:
+  DeviceBuilder::TypedReadCallback<T> read_;
+  DeviceBuilder::TypedWriteCallback<T> write_;
+};
+
+/**
+ * @brief Observable, built from a native value callback, see
+ * ArenaTypedReadable
+ *
+ * Notifications are boxed once per dispatch, because the observer list is
+ * shared with DataVariant observers. Typed observers unpack them.
+ */
+template <typename T>
+struct ArenaTypedObservable final : public ArenaNode,
+                                    public BoxedRead<Observable>,
+                                    public NativeRead<TypedReadable, T>,
+                                    public NativeRead<TypedObservable, T> {
+  using TypedObserveCallback = typename TypedObservable<T>::ObserveCallback;
+
+  ArenaTypedObservable(const ArenaModel* model,
+      const NodeLinks& links,
+      ArenaSpec::Entry&& entry)
+      : ArenaNode(model, links),
+        read_(get<VariantIndexOf_v<T>>(move(*entry.typed_read))),
+        hub_(move(entry.hub)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Observable>(const_cast<ArenaTypedObservable*>(this));
+  }
+
+  DataType dataType() const final { return links_.data_type; }
+
+  ObserverPtr subscribe(const Observable::ObserveCallback& observe_cb,
+      const Observable::ExceptionHandler& handler) final {
+    return hub_->subscribe(observe_cb, handler);
+  }
+
+  ObserverPtr subscribe(const TypedObserveCallback& observe_cb,
+      const Observable::ExceptionHandler& handler) final {
+    return hub_->subscribe(
+        [observe_cb](const shared_ptr<DataVariant>& value) {
+          observe_cb(get<T>(*value));
+        },
+        handler);
+  }
+
+protected:
+  DataVariant readBoxed() const final { return DataVariant(read_()); }
+
+  T readNative() const final { return read_(); }
+
+private:
+  DeviceBuilder::TypedReadCallback<T> read_;
+  shared_ptr<ObservableHub> hub_;
+};
+
+ArenaModel::~ArenaModel() {
+  for (auto it = nodes_.rbegin(); it != nodes_.rend(); ++it) {
+    (*it)->~ArenaNode();
+  }
+}
+
+string ArenaModel::id(const NodeLinks& links) const {
+  auto suffix = view(links.id);
+  string result;
+  result.reserve(device_id_.size() + 1 + suffix.size());
+  result.append(device_id_).append(1, ':').append(suffix);
+  return result;
+}
+
+ArenaGroup* ArenaModel::root() const {
+  return static_cast<ArenaGroup*>(nodes_.front());
+}
+
+uint32_t ArenaModel::resolve(const string& ref_id) const noexcept {
+  auto prefix = device_id_.size();
+  if (ref_id.size() <= prefix || ref_id.compare(0, prefix, device_id_) != 0 ||
+      ref_id[prefix] != ':') {
+    return NOT_FOUND;
+  }
+  uint32_t current = 0;
+  auto position = prefix + 1;
+  while (position < ref_id.size()) {
+    uint64_t child = 0;
+    auto first = position;
+    while (position < ref_id.size() && ref_id[position] >= '0' &&
+        ref_id[position] <= '9') {
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      child = child * 10 + static_cast<uint64_t>(ref_id[position] - '0');
+      if (child > UINT32_MAX) {
+        return NOT_FOUND;
+      }
+      ++position;
+    }
+    auto digits = position - first;
+    const auto& group = links(current);
+    if (digits == 0 || (digits > 1 && ref_id[first] == '0') ||
+        group.type != ElementType::Group || child >= group.child_count) {
+      return NOT_FOUND;
+    }
+    current = this->child(group, static_cast<uint32_t>(child));
+    if (position < ref_id.size()) {
+      if (ref_id[position] != '.' || position + 1 == ref_id.size()) {
+        return NOT_FOUND;
+      }
+      ++position;
+    }
+  }
+  return current;
+}
+
+ElementPtr ArenaModel::element(uint32_t index) const {
+  return share<Element>(nodes_[index]);
+}
+
+ElementPtr ArenaModel::element(
+    const shared_ptr<const ArenaModel>& owner, uint32_t index) const {
+  return ElementPtr(owner, nodes_[index]);
+}
+
+namespace {
+template <typename Node> size_t nodeSize() {
+  static_assert(alignof(Node) <= NODE_ALIGNMENT);
+  return (sizeof(Node) + NODE_ALIGNMENT - 1) & ~(NODE_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Returns the largest size of a node and its typed variants for every
+ * DataVariant alternative, so typed nodes fit into the same arena slots
+ */
+template <typename Node, template <typename> class Typed, size_t... Indexes>
+size_t nodeSize(index_sequence<Indexes...>) {
+  return max({nodeSize<Node>(),
+      nodeSize<Typed<variant_alternative_t<Indexes, DataVariant>>>()...});
+}
+
+template <typename Node, template <typename> class Typed> size_t nodeSize() {
+  static const size_t size = nodeSize<Node, Typed>(
+      make_index_sequence<variant_size_v<DataVariant>>{});
+  return size;
+}
+
+size_t nodeSize(ElementType type) {
+  switch (type) {
+  case ElementType::Group:
+    return nodeSize<ArenaGroup>();
+  case ElementType::Readable:
+    return nodeSize<ArenaReadable, ArenaTypedReadable>();
+  case ElementType::Writable:
+    return nodeSize<ArenaWritable, ArenaTypedWritable>();
+  case ElementType::Observable:
+    return nodeSize<ArenaObservable, ArenaTypedObservable>();
+  case ElementType::Callable:
+    return nodeSize<ArenaCallable>();
+  default:
+    throw logic_error("Could not decode ElementType enum value");
+  }
+}
+
+ArenaNode* constructTyped(void* address,
+    const ArenaModel* model,
+    const NodeLinks& links,
+    ArenaSpec::Entry&& entry) {
+  return visitDataType(links.data_type, [&](auto tag) -> ArenaNode* {
+    using Native = typename decltype(tag)::type;
+    switch (links.type) {
+    case ElementType::Readable:
+      return new (address)
+          ArenaTypedReadable<Native>(model, links, move(entry));
+    case ElementType::Writable:
+      return new (address)
+          ArenaTypedWritable<Native>(model, links, move(entry));
+    case ElementType::Observable:
+      return new (address)
+          ArenaTypedObservable<Native>(model, links, move(entry));
+    default:
+      throw logic_error("Only metric elements can hold native callbacks");
+    }
+  });
+}
+
+ArenaNode* construct(void* address,
+    const ArenaModel* model,
+    const NodeLinks& links,
+    ArenaSpec::Entry&& entry) {
+  if (entry.isTyped()) {
+    return constructTyped(address, model, links, move(entry));
+  }
+  switch (links.type) {
+  case ElementType::Group:
+    return new (address) ArenaGroup(model, links);
+  case ElementType::Readable:
+    return new (address) ArenaReadable(model, links, move(entry));
+  case ElementType::Writable:
+    return new (address) ArenaWritable(model, links, move(entry));
+  case ElementType::Observable:
+    return new (address) ArenaObservable(model, links, move(entry));
+  case ElementType::Callable:
+    return new (address) ArenaCallable(model, links, move(entry));
+  default:
+    throw logic_error("Could not decode ElementType enum value");
+  }
+}
+
+Text append(string& pool, string_view value) {
+  if (pool.size() + value.size() > UINT32_MAX) {
+    throw length_error("Device string pool exceeds 4 GiB");
+  }
+  Text text{static_cast<uint32_t>(pool.size()),
+      static_cast<uint32_t>(value.size())};
+  pool += value;
+  return text;
+}
+
+/**
+ * @brief Structure of recorded entries, together with the entry index of
+ * every arena index
+ */
+struct Arrangement {
+  shared_ptr<ArenaStructure> structure;
+  vector<uint32_t> order;
+};
+
+/**
+ * @brief Depth first order of entries, that only know their parent entry
+ */
+struct Ordering {
+  /**
+   * @brief Children of every entry in build order, as ranges of one index
+   * table. Children of entry i are built_children[offsets[i], offsets[i + 1])
+   */
+  vector<uint32_t> offsets;
+  vector<uint32_t> built_children;
+  vector<uint32_t> arena_index;
+  vector<uint32_t> order;
+};
+
+/**
+ * @param parent_of - returns the parent entry of a given entry above 0, entry
+ * 0 is the root group
+ */
+template <typename ParentOf>
+Ordering orderEntries(uint32_t count, ParentOf&& parent_of) {
+  Ordering ordering;
+  auto& offsets = ordering.offsets;
+  offsets.assign(count + 1, 0);
+  for (uint32_t index = 1; index < count; ++index) {
+    ++offsets[parent_of(index) + 1];
+  }
+  for (uint32_t index = 0; index < count; ++index) {
+    offsets[index + 1] += offsets[index];
+  }
+  auto& built_children = ordering.built_children;
+  built_children.resize(count > 0 ? count - 1 : 0);
+  auto fill = offsets;
+  for (uint32_t index = 1; index < count; ++index) {
+    built_children[fill[parent_of(index)]++] = index;
+  }
+  // depth first order keeps every subtree contiguous in the arena
+  auto& order = ordering.order;
+  order.reserve(count);
+  ordering.arena_index.assign(count, NO_PARENT);
+  vector<uint32_t> stack{0};
+  while (!stack.empty()) {
+    auto index = stack.back();
+    stack.pop_back();
+    ordering.arena_index[index] = static_cast<uint32_t>(order.size());
+    order.push_back(index);
+    for (auto child = offsets[index + 1]; child > offsets[index]; --child) {
+      stack.push_back(built_children[child - 1]);
+    }
+  }
+  return ordering;
+}
+
+/**
+ * @brief Computes the structural hashes of all elements of a given
+ * structure, indexed by their arena index
+ *
+ * @param write_only - returns if the Writable element at a given arena index
+ * is write only
+ */
+template <typename WriteOnly>
+vector<size_t> hashStructure(
+    const ArenaStructure& structure, WriteOnly&& write_only) {
+  const auto& links = structure.links_;
+  auto count = static_cast<uint32_t>(links.size());
+  vector<size_t> hashes(count);
+  for (uint32_t index = 0; index < count; ++index) {
+    const auto& node = links[index];
+    // ids are stored relative to the device, as they are hashed
+    hashes[index] = ownStructureHash(structure.view(node.id),
+        structure.view(node.name),
+        structure.view(node.description),
+        node.type,
+        node.data_type,
+        node.type == ElementType::Writable && write_only(index),
+        structure.parameter_types_[node.parameters]);
+  }
+  // nested elements follow their groups in depth first order, so walking
+  // backwards combines every subtree hash before its group hash
+  for (auto index = count; index > 0; --index) {
+    const auto& node = links[index - 1];
+    auto& hash = hashes[index - 1];
+    for (uint32_t position = 0; position < node.child_count; ++position) {
+      hash = combineStructureHash(
+          hash, hashes[structure.children_[node.first_child + position]]);
+    }
+  }
+  return hashes;
+}
+
+/**
+ * @brief Moves the strings and ParameterTypes of all entries into a new
+ * structure, the entry callbacks are kept
+ */
+Arrangement arrange(ArenaSpec& spec) {
+  auto& entries = spec.entries;
+  auto count = static_cast<uint32_t>(entries.size());
+  auto ordering = orderEntries(
+      count, [&entries](uint32_t index) { return entries[index].parent; });
+  const auto& offsets = ordering.offsets;
+  const auto& built_children = ordering.built_children;
+  const auto& arena_index = ordering.arena_index;
+  Arrangement arrangement{make_shared<ArenaStructure>(), move(ordering.order)};
+  const auto& order = arrangement.order;
+
+  auto& structure = *arrangement.structure;
+  // ids are stored without the device id and the following colon
+  auto prefix = spec.device_id.size() + 1;
+  size_t text_size = 0;
+  size_t callables = 0;
+  for (const auto& entry : entries) {
+    text_size += entry.id.size() - prefix + entry.name.size() +
+        entry.description.size();
+    callables += entry.type == ElementType::Callable ? 1 : 0;
+  }
+  structure.text_.reserve(text_size);
+  structure.children_.reserve(built_children.size());
+  structure.links_.reserve(count);
+  structure.parameter_types_.reserve(callables + 1);
+  structure.parameter_types_.emplace_back();
+  for (auto index : order) {
+    auto& entry = entries[index];
+    uint32_t parameters = 0;
+    if (entry.type == ElementType::Callable) {
+      parameters = static_cast<uint32_t>(structure.parameter_types_.size());
+      structure.parameter_types_.push_back(move(entry.parameter_types));
+    }
+    structure.links_.push_back(NodeLinks{entry.type,
+        entry.data_type,
+        arena_index[index],
+        entry.parent == NO_PARENT ? NO_PARENT : arena_index[entry.parent],
+        static_cast<uint32_t>(structure.children_.size()),
+        entry.children,
+        parameters,
+        append(structure.text_, string_view(entry.id).substr(prefix)),
+        append(structure.text_, entry.name),
+        append(structure.text_, entry.description)});
+    for (auto child = offsets[index]; child < offsets[index + 1]; ++child) {
+      structure.children_.push_back(arena_index[built_children[child]]);
+    }
+  }
+  structure.hashes_ =
+      hashStructure(structure, [](uint32_t /*index*/) { return false; });
+  return arrangement;
+}
+
+/**
+ * @brief Builds the structure of a checked definition directly from its rows
+ *
+ * Entry indices are the definition rows shifted by one, because entry 0 is
+ * the root group. Strings are copied into the string pool once and element
+ * ids are generated in place, no intermediate entries are recorded.
+ */
+Arrangement arrangeDefinition(const DeviceDefinition& definition) {
+  const auto& elements = definition.elements;
+  auto count = static_cast<uint32_t>(elements.size() + 1);
+  auto ordering = orderEntries(count, [&elements](uint32_t index) {
+    auto parent = elements[index - 1].parent;
+    return parent == DEFINITION_ROOT ? 0 : parent + 1;
+  });
+  const auto& offsets = ordering.offsets;
+  const auto& built_children = ordering.built_children;
+  const auto& arena_index = ordering.arena_index;
+  Arrangement arrangement{make_shared<ArenaStructure>(), move(ordering.order)};
+  const auto& order = arrangement.order;
+
+  auto& structure = *arrangement.structure;
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  constexpr size_t ID_SIZE_HINT = 8;
+  size_t text_size = definition.info.name.size() +
+      definition.info.description.size() + count * ID_SIZE_HINT;
+  size_t callables = 0;
+  for (const auto& element : elements) {
+    text_size += element.info.name.size() + element.info.description.size();
+    callables += element.type == ElementType::Callable ? 1 : 0;
+  }
+  structure.text_.reserve(text_size);
+  structure.children_.reserve(built_children.size());
+  structure.links_.reserve(count);
+  structure.parameter_types_.reserve(callables + 1);
+  structure.parameter_types_.emplace_back();
+  // ids are stored without the device id and the following colon, children
+  // of the root group have no separator
+  vector<Text> ids(count, Text{0, 0});
+  string id;
+  for (auto index : order) {
+    const auto& info = index == 0 ? definition.info : elements[index - 1].info;
+    auto type = index == 0 ? ElementType::Group : elements[index - 1].type;
+    uint32_t parameters = 0;
+    if (type == ElementType::Callable) {
+      parameters = static_cast<uint32_t>(structure.parameter_types_.size());
+      structure.parameter_types_.push_back(
+          elements[index - 1].parameter_types);
+    }
+    auto first_child = offsets[index];
+    auto child_count = offsets[index + 1] - first_child;
+    id.assign(structure.view(ids[index]));
+    if (index != 0) {
+      id += '.';
+    }
+    auto prefix = id.size();
+    for (uint32_t position = 0; position < child_count; ++position) {
+      id.resize(prefix);
+      id += to_string(position);
+      ids[built_children[first_child + position]] =
+          append(structure.text_, id);
+    }
+    auto parent = index == 0 ? DEFINITION_ROOT : elements[index - 1].parent;
+    structure.links_.push_back(NodeLinks{type,
+        index == 0 ? DataType::None : elements[index - 1].data_type,
+        arena_index[index],
+        index == 0 ? NO_PARENT
+                   : arena_index[parent == DEFINITION_ROOT ? 0 : parent + 1],
+        static_cast<uint32_t>(structure.children_.size()),
+        child_count,
+        parameters,
+        ids[index],
+        append(structure.text_, info.name),
+        append(structure.text_, info.description)});
+    for (auto child = first_child; child < offsets[index + 1]; ++child) {
+      structure.children_.push_back(arena_index[built_children[child]]);
+    }
+  }
+  structure.hashes_ =
+      hashStructure(structure, [](uint32_t /*index*/) { return false; });
+  return arrangement;
+}
+
+/**
+ * @brief Constructs the elements of a new device with a given structure
+ *
+ * @param entry_of - returns the entry with the callbacks of a given arena
+ * index, called once for every arena index in increasing order
+ */
+template <typename EntryOf>
+shared_ptr<ArenaModel> populate(shared_ptr<const ArenaStructure> structure,
+    string device_id,
+    EntryOf&& entry_of) {
+  auto model = make_shared<ArenaModel>();
+  model->device_id_ = move(device_id);
+  model->structure_ = move(structure);
+  const auto& links = model->structure_->links_;
+  auto count = static_cast<uint32_t>(links.size());
+  size_t arena_size = 0;
+  for (const auto& node : links) {
+    arena_size += nodeSize(node.type);
+  }
+  model->nodes_.reserve(count);
+  model->arena_ = make_unique<byte[]>(arena_size);
+  model->arena_size_ = arena_size;
+
+  vector<bool> write_only;
+  size_t offset = 0;
+  for (uint32_t index = 0; index < count; ++index) {
+    const auto& node = links[index];
+    ArenaSpec::Entry entry = entry_of(index);
+    if (node.type == ElementType::Writable && entry.isWriteOnly()) {
+      write_only.resize(count, false);
+      write_only[index] = true;
+    }
+    model->nodes_.push_back(construct(
+        model->arena_.get() + offset, model.get(), node, move(entry)));
+    offset += nodeSize(node.type);
+  }
+  if (!write_only.empty()) {
+    model->write_only_hashes_ = hashStructure(*model->structure_,
+        [&write_only](uint32_t index) { return write_only[index]; });
+  }
+  return model;
+}
+
+size_t structureBytes(const ArenaStructure& structure) {
+  return structure.text_.capacity() +
+      structure.children_.capacity() * sizeof(uint32_t) +
+      structure.links_.capacity() * sizeof(NodeLinks) +
+      structure.parameter_types_.capacity() * sizeof(ParameterTypes) +
+      structure.hashes_.capacity() * sizeof(size_t);
+}
+
+shared_ptr<ArenaModel> place(ArenaSpec&& spec) {
+  auto arrangement = arrange(spec);
+  const auto& order = arrangement.order;
+  return populate(move(arrangement.structure),
+      move(spec.device_id),
+      [&entries = spec.entries, &order](uint32_t index) {
+        return move(entries[order[index]]);
+      });
+}
+
+void checkDataType(DataType data_type) {
+  if (data_type == DataType::None || data_type == DataType::Unknown) {
+    throw invalid_argument(
+        "Element data type can not be " + toString(data_type));
+  }
+}
+
+template <typename Callback>
+void checkCallback(const Callback& callback, const string& name) {
+  if (!callback) {
+    throw invalid_argument(name + " callback can not be null");
+  }
+}
+
+template <typename... Callbacks>
+void checkCallback(const variant<Callbacks...>& callback, const string& name) {
+  visit([&name](const auto& held) { checkCallback(held, name); }, callback);
+}
+
+/**
+ * @brief Records a new element and returns its id
+ */
+string record(ArenaSpec& spec,
+    uint32_t parent,
+    BuildInfo element_info,
+    ArenaSpec::Entry&& entry) {
+  if (spec.entries.size() >= NO_PARENT) {
+    throw length_error("Device can not hold more elements");
+  }
+  auto& parent_entry = spec.entries[parent];
+  // root children have no separator after the root group id
+  auto separator = parent_entry.id.back() == ':' ? "" : ".";
+  entry.id = parent_entry.id + separator + to_string(parent_entry.children++);
+  entry.parent = parent;
+  entry.name = move(element_info.name);
+  entry.description = move(element_info.description);
+  spec.entries.push_back(move(entry));
+  return spec.entries.back().id;
+}
+
+string recordGroup(ArenaSpec& spec, uint32_t parent, BuildInfo element_info) {
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Group;
+  auto id = record(spec, parent, move(element_info), move(entry));
+  spec.groups.emplace(id, static_cast<uint32_t>(spec.entries.size() - 1));
+  return id;
+}
+
+uint32_t groupIndex(const ArenaSpec& spec, const string& group_id) {
+  auto it = spec.groups.find(group_id);
+  if (it == spec.groups.end()) {
+    throw invalid_argument("Group " + group_id + " does not exist");
+  }
+  return it->second;
+}
+
+ArenaSpec::Entry readableEntry(
+    DataType data_type, DeviceBuilder::InlineReadCallback&& read_cb) {
+  checkDataType(data_type);
+  checkCallback(read_cb, "Read");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Readable;
+  entry.data_type = data_type;
+  entry.read = move(read_cb);
+  return entry;
+}
+
+ArenaSpec::Entry writableEntry(DataType data_type,
+    DeviceBuilder::InlineWriteCallback&& write_cb,
+    DeviceBuilder::InlineReadCallback&& read_cb) {
+  checkDataType(data_type);
+  checkCallback(write_cb, "Write");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Writable;
+  entry.data_type = data_type;
+  entry.write = move(write_cb);
+  entry.read = move(read_cb);
+  return entry;
+}
+
+ArenaSpec::Entry observableEntry(DataType data_type,
+    DeviceBuilder::InlineReadCallback&& read_cb,
+    DeviceBuilder::InlineIsObservingCallback&& observe_cb) {
+  checkDataType(data_type);
+  checkCallback(read_cb, "Read");
+  checkCallback(observe_cb, "Is observing");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Observable;
+  entry.data_type = data_type;
+  entry.read = move(read_cb);
+  entry.hub = make_shared<ObservableHub>(move(observe_cb));
+  return entry;
+}
+
+ArenaSpec::Entry callableEntry(DataType result_type,
+    DeviceBuilder::InlineExecuteCallback&& execute_cb,
+    DeviceBuilder::InlineAsyncExecuteCallback&& async_execute_cb,
+    DeviceBuilder::InlineCancelCallback&& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  checkCallback(execute_cb, "Execute");
+  if (result_type != DataType::None || async_execute_cb || cancel_cb) {
+    checkDataType(result_type);
+    checkCallback(async_execute_cb, "Async execute");
+    checkCallback(cancel_cb, "Cancel");
+  }
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Callable;
+  entry.data_type = result_type;
+  entry.execute = move(execute_cb);
+  entry.async_execute = move(async_execute_cb);
+  entry.cancel = move(cancel_cb);
+  entry.parameter_types = parameter_types;
+  return entry;
+}
+
+ArenaSpec::Entry typedReadableEntry(
+    const DeviceBuilder::AnyReadCallback& read_cb) {
+  checkCallback(read_cb, "Read");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Readable;
+  entry.data_type = dataTypeAt(read_cb.index());
+  entry.typed_read = read_cb;
+  return entry;
+}
+
+ArenaSpec::Entry typedWritableEntry(
+    const DeviceBuilder::AnyWriteCallback& write_cb,
+    const DeviceBuilder::AnyReadCallback& read_cb) {
+  if (write_cb.index() != read_cb.index()) {
+    throw invalid_argument(
+        "Write and read callbacks must use the same native value type");
+  }
+  checkCallback(write_cb, "Write");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Writable;
+  entry.data_type = dataTypeAt(write_cb.index());
+  entry.typed_write = write_cb;
+  entry.typed_read = read_cb;
+  return entry;
+}
+
+ArenaSpec::Entry typedObservableEntry(
+    const DeviceBuilder::AnyReadCallback& read_cb,
+    const DeviceBuilder::IsObservingCallback& observe_cb) {
+  checkCallback(read_cb, "Read");
+  checkCallback(observe_cb, "Is observing");
+  ArenaSpec::Entry entry;
+  entry.type = ElementType::Observable;
+  entry.data_type = dataTypeAt(read_cb.index());
+  entry.typed_read = read_cb;
+  entry.hub = make_shared<ObservableHub>(
+      DeviceBuilder::InlineIsObservingCallback(observe_cb));
+  return entry;
+}
+
+/**
+ * @brief Moves checked element callbacks into an entry
+ *
+ * @return DeviceBuilder::InlineNotifyCallback - set for Observable entries
+ */
+DeviceBuilder::InlineNotifyCallback bindCallbacks(
+    ArenaSpec::Entry& entry, ElementCallbacks&& callbacks) {
+  entry.read = move(callbacks.read);
+  entry.write = move(callbacks.write);
+  entry.execute = move(callbacks.execute);
+  entry.async_execute = move(callbacks.async_execute);
+  entry.cancel = move(callbacks.cancel);
+  if (entry.type != ElementType::Observable) {
+    return nullptr;
+  }
+  entry.hub = make_shared<ObservableHub>(move(callbacks.observe));
+  return Notifier{entry.hub};
+}
+
+/**
+ * @brief Constructs the elements of a new device from checked definition rows
+ * and their callbacks
+ *
+ * @param row_of - returns the definition row of a given arena index above 0
+ */
+template <typename RowOf>
+BuiltDevice instantiateRows(shared_ptr<const ArenaStructure> structure,
+    const string& device_id,
+    const vector<ElementDefinition>& elements,
+    vector<ElementCallbacks>& callbacks,
+    RowOf&& row_of) {
+  BuiltDevice built;
+  built.notifiers.resize(elements.size());
+  const auto& links = structure->links_;
+  auto model = populate(move(structure),
+      device_id,
+      [&links, &elements, &callbacks, &built, &row_of](uint32_t index) {
+        const auto& node = links[index];
+        ArenaSpec::Entry entry;
+        entry.type = node.type;
+        entry.data_type = node.data_type;
+        if (node.type != ElementType::Group) {
+          auto row = row_of(index);
+          built.notifiers[row] = bindCallbacks(
+              entry, move(callbacks[elements[row].callback]));
+        }
+        return entry;
+      });
+  built.ids.resize(elements.size());
+  for (uint32_t index = 1; index < links.size(); ++index) {
+    built.ids[row_of(index)] = model->id(model->links(index));
+  }
+  built.device = make_unique<ArenaDevice>(move(model));
+  return built;
+}
+} // namespace
+} // namespace detail
+
+ArenaDevice::ArenaDevice(shared_ptr<const detail::ArenaModel> model)
+    : model_(move(model)) {}
+
+string ArenaDevice::id() const { return model_->device_id_; }
+
+string ArenaDevice::name() const {
+  return model_->toString(model_->links(0).name);
+}
+
+string ArenaDevice::description() const {
+  return model_->toString(model_->links(0).description);
+}
+
+GroupPtr ArenaDevice::group() const {
+  return model_->share<Group>(model_->root());
+}
+
+size_t ArenaDevice::size() const { return model_->root()->size(); }
+
+ElementPtr ArenaDevice::element(const string& ref_id) const {
+  return model_->root()->element(ref_id);
+}
+
+Expected<ElementPtr> ArenaDevice::tryElement(const string& ref_id) const {
+  return model_->root()->tryElement(ref_id);
+}
+
+void ArenaDevice::visit(const Group::Visitor& visitor) const {
+  model_->root()->visit(visitor);
+}
+
+size_t ArenaDevice::structuralHash() const {
+  return model_->root()->structuralHash();
+}
+
+size_t ArenaDevice::elementCount() const { return model_->nodes_.size() - 1; }
+
+size_t ArenaDevice::arenaBytes() const {
+  return model_->arena_size_ +
+      model_->nodes_.capacity() * sizeof(detail::ArenaNode*) +
+      model_->write_only_hashes_.capacity() * sizeof(size_t);
+}
+
+size_t ArenaDevice::structureBytes() const {
+  return detail::structureBytes(*model_->structure_);
+}
+
+ArenaDeviceTemplate::ArenaDeviceTemplate(DeviceDefinition definition) {
+  checkDefinition(definition);
+  auto arrangement = detail::arrangeDefinition(definition);
+  structure_ = move(arrangement.structure);
+  rows_.reserve(arrangement.order.size());
+  for (auto entry : arrangement.order) {
+    rows_.push_back(entry == 0 ? DEFINITION_ROOT : entry - 1);
+  }
+  // instances only need the rows to check their callbacks
+  definition_ = move(definition);
+  definition_.id = string();
+  definition_.info = BuildInfo{};
+  for (auto& element : definition_.elements) {
+    element.info = BuildInfo{};
+    element.parameter_types = ParameterTypes{};
+  }
+}
+
+BuiltDevice ArenaDeviceTemplate::instantiate(
+    const string& device_id, vector<ElementCallbacks> callbacks) const {
+  checkDefinition(definition_, callbacks);
+  return detail::instantiateRows(structure_,
+      device_id,
+      definition_.elements,
+      callbacks,
+      [this](uint32_t index) { return rows_[index]; });
+}
+
+size_t ArenaDeviceTemplate::elementCount() const {
+  return structure_->links_.size() - 1;
+}
+
+size_t ArenaDeviceTemplate::structureBytes() const {
+  return detail::structureBytes(*structure_);
+}
+
+ArenaDeviceBuilder::ArenaDeviceBuilder() = default;
+
+ArenaDeviceBuilder::~ArenaDeviceBuilder() = default;
+
+void ArenaDeviceBuilder::setDeviceInfo(
+    const string& unique_id, const BuildInfo& element_info) {
+  if (spec_) {
+    throw DeviceBuildInProgress();
+  }
+  spec_ = make_unique<detail::ArenaSpec>();
+  spec_->device_id = unique_id;
+  spec_->device_info = element_info;
+  detail::ArenaSpec::Entry root;
+  root.id = unique_id + ":";
+  root.name = element_info.name;
+  root.description = element_info.description;
+  spec_->entries.push_back(move(root));
+  spec_->groups.emplace(spec_->entries.front().id, 0);
+}
+
+string ArenaDeviceBuilder::addGroup(const BuildInfo& element_info) {
+  return addGroup(spec().entries.front().id, element_info);
+}
+
+string ArenaDeviceBuilder::addGroup(
+    const string& parent_id, const BuildInfo& element_info) {
+  auto parent = parentOf(parent_id);
+  return detail::recordGroup(*spec_, parent, element_info);
+}
+
+string ArenaDeviceBuilder::addReadable(const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb) {
+  return addInlineReadable(
+      nullopt, element_info, data_type, InlineReadCallback(read_cb));
+}
+
+string ArenaDeviceBuilder::addReadable(const string& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb) {
+  return addInlineReadable(
+      parent_id, element_info, data_type, InlineReadCallback(read_cb));
+}
+
+string ArenaDeviceBuilder::addWritable(const BuildInfo& element_info,
+    DataType data_type,
+    const WriteCallback& write_cb,
+    const ReadCallback& read_cb) {
+  return addInlineWritable(nullopt,
+      element_info,
+      data_type,
+      InlineWriteCallback(write_cb),
+      InlineReadCallback(read_cb));
+}
+
+string ArenaDeviceBuilder::addWritable(const string& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    const WriteCallback& write_cb,
+    const ReadCallback& read_cb) {
+  return addInlineWritable(parent_id,
+      element_info,
+      data_type,
+      InlineWriteCallback(write_cb),
+      InlineReadCallback(read_cb));
+}
+
+pair<string, DeviceBuilder::NotifyCallback> ArenaDeviceBuilder::addObservable(
+    const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb,
+    const IsObservingCallback& observe_cb) {
+  auto [id, hub] = addHub(nullopt,
+      element_info,
+      data_type,
+      InlineReadCallback(read_cb),
+      InlineIsObservingCallback(observe_cb));
+  return {id, detail::Notifier{hub}};
+}
+
+pair<string, DeviceBuilder::NotifyCallback> ArenaDeviceBuilder::addObservable(
+    const string& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb,
+    const IsObservingCallback& observe_cb) {
+  auto [id, hub] = addHub(parent_id,
+      element_info,
+      data_type,
+      InlineReadCallback(read_cb),
+      InlineIsObservingCallback(observe_cb));
+  return {id, detail::Notifier{hub}};
+}
+
+string ArenaDeviceBuilder::addCallable(const BuildInfo& element_info,
+    const ExecuteCallback& execute_cb,
+    const ParameterTypes& parameter_types) {
+  return addInlineCallable(nullopt,
+      element_info,
+      DataType::None,
+      InlineExecuteCallback(execute_cb),
+      nullptr,
+      nullptr,
+      parameter_types);
+}
+
+string ArenaDeviceBuilder::addCallable(const string& parent_id,
+    const BuildInfo& element_info,
+    const ExecuteCallback& execute_cb,
+    const ParameterTypes& parameter_types) {
+  return addInlineCallable(parent_id,
+      element_info,
+      DataType::None,
+      InlineExecuteCallback(execute_cb),
+      nullptr,
+      nullptr,
+      parameter_types);
+}
+
+string ArenaDeviceBuilder::addCallable(const BuildInfo& element_info,
+    DataType result_type,
+    const ExecuteCallback& execute_cb,
+    const AsyncExecuteCallback& async_execute_cb,
+    const CancelCallback& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  detail::checkDataType(result_type);
+  return addInlineCallable(nullopt,
+      element_info,
+      result_type,
+      InlineExecuteCallback(execute_cb),
+      InlineAsyncExecuteCallback(async_execute_cb),
+      InlineCancelCallback(cancel_cb),
+      parameter_types);
+}
+
+string ArenaDeviceBuilder::addCallable(const string& parent_id,
+    const BuildInfo& element_info,
+    DataType result_type,
+    const ExecuteCallback& execute_cb,
+    const AsyncExecuteCallback& async_execute_cb,
+    const CancelCallback& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  detail::checkDataType(result_type);
+  return addInlineCallable(parent_id,
+      element_info,
+      result_type,
+      InlineExecuteCallback(execute_cb),
+      InlineAsyncExecuteCallback(async_execute_cb),
+      InlineCancelCallback(cancel_cb),
+      parameter_types);
+}
+
+string ArenaDeviceBuilder::addTypedReadable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyReadCallback& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(
+      *spec_, parent, element_info, detail::typedReadableEntry(read_cb));
+}
+
+string ArenaDeviceBuilder::addTypedWritable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyWriteCallback& write_cb,
+    const AnyReadCallback& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(*spec_,
+      parent,
+      element_info,
+      detail::typedWritableEntry(write_cb, read_cb));
+}
+
+pair<string, DeviceBuilder::AnyNotifyCallback>
+ArenaDeviceBuilder::addTypedObservable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyReadCallback& read_cb,
+    const IsObservingCallback& observe_cb) {
+  auto parent = parentOf(parent_id);
+  auto entry = detail::typedObservableEntry(read_cb, observe_cb);
+  detail::Notifier notifier{entry.hub};
+  auto notify = visitDataType(entry.data_type, [&notifier](auto tag) {
+    using Native = typename decltype(tag)::type;
+    return AnyNotifyCallback{in_place_index<VariantIndexOf_v<Native>>,
+        [notifier](const Native& value) { notifier(DataVariant(value)); }};
+  });
+  auto id = detail::record(*spec_, parent, element_info, move(entry));
+  return {id, move(notify)};
+}
+
+string ArenaDeviceBuilder::addInlineReadable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(*spec_,
+      parent,
+      element_info,
+      detail::readableEntry(data_type, move(read_cb)));
+}
+
+string ArenaDeviceBuilder::addInlineWritable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineWriteCallback&& write_cb,
+    InlineReadCallback&& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(*spec_,
+      parent,
+      element_info,
+      detail::writableEntry(data_type, move(write_cb), move(read_cb)));
+}
+
+pair<string, DeviceBuilder::InlineNotifyCallback>
+ArenaDeviceBuilder::addInlineObservable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb,
+    InlineIsObservingCallback&& observe_cb) {
+  auto [id, hub] = addHub(
+      parent_id, element_info, data_type, move(read_cb), move(observe_cb));
+  return {id, detail::Notifier{hub}};
+}
+
+string ArenaDeviceBuilder::addInlineCallable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType result_type,
+    InlineExecuteCallback&& execute_cb,
+    InlineAsyncExecuteCallback&& async_execute_cb,
+    InlineCancelCallback&& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  auto parent = parentOf(parent_id);
+  return detail::record(*spec_,
+      parent,
+      element_info,
+      detail::callableEntry(result_type,
+          move(execute_cb),
+          move(async_execute_cb),
+          move(cancel_cb),
+          parameter_types));
+}
+
+BuiltDevice ArenaDeviceBuilder::build(
+    const DeviceDefinition& definition, vector<ElementCallbacks> callbacks) {
+  if (spec_) {
+    throw DeviceBuildInProgress();
+  }
+  checkDefinition(definition, callbacks);
+  auto arrangement = detail::arrangeDefinition(definition);
+  const auto& order = arrangement.order;
+  return detail::instantiateRows(move(arrangement.structure),
+      definition.id,
+      definition.elements,
+      callbacks,
+      [&order](uint32_t index) { return order[index] - 1; });
+}
+
+unique_ptr<Device> ArenaDeviceBuilder::result() {
+  auto& spec = this->spec();
+  for (const auto& entry : spec.entries) {
+    if (entry.type == ElementType::Group && entry.children == 0) {
+      if (entry.parent == detail::NO_PARENT) {
+        throw GroupEmpty(spec.device_id);
+      }
+      throw GroupEmpty(spec.device_id, entry.id);
+    }
+  }
+  auto model = detail::place(move(spec));
+  spec_.reset();
+  return make_unique<ArenaDevice>(move(model));
+}
+
+void ArenaDeviceBuilder::abandon() noexcept { spec_.reset(); }
+
+detail::ArenaSpec& ArenaDeviceBuilder::spec() {
+  if (!spec_) {
+    throw DeviceInfoNotSet();
+  }
+  return *spec_;
+}
+
+pair<string, weak_ptr<detail::ObservableHub>> ArenaDeviceBuilder::addHub(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb,
+    InlineIsObservingCallback&& observe_cb) {
+  auto parent = parentOf(parent_id);
+  auto entry =
+      detail::observableEntry(data_type, move(read_cb), move(observe_cb));
+  weak_ptr<detail::ObservableHub> hub = entry.hub;
+  return {detail::record(*spec_, parent, element_info, move(entry)), hub};
+}
+
+uint32_t ArenaDeviceBuilder::parentOf(const optional<string>& parent_id) {
+  if (!parent_id.has_value()) {
+    spec();
+    return 0;
+  }
+  return parentOf(*parent_id);
+}
+
+uint32_t ArenaDeviceBuilder::parentOf(const string& parent_id) {
+  return detail::groupIndex(spec(), parent_id);
+}
+
+ConcurrentArenaDeviceBuilder::Branch::Branch(detail::ArenaBranch* state)
+    : state_(state) {}
+
+ConcurrentArenaDeviceBuilder::Branch::Branch(Branch&& other) noexcept
+    : state_(exchange(other.state_, nullptr)) {}
+
+ConcurrentArenaDeviceBuilder::Branch&
+ConcurrentArenaDeviceBuilder::Branch::operator=(Branch&& other) noexcept {
+  if (this != &other) {
+    if (state_ != nullptr) {
+      state_->in_use.store(false, memory_order_release);
+    }
+    state_ = exchange(other.state_, nullptr);
+  }
+  return *this;
+}
+
+ConcurrentArenaDeviceBuilder::Branch::~Branch() {
+  if (state_ != nullptr) {
+    // publishes all recorded entries to result()
+    state_->in_use.store(false, memory_order_release);
+  }
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::id() const {
+  spec();
+  return state_->id;
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::addGroup(
+    const BuildInfo& element_info) {
+  return detail::recordGroup(spec(), 0, element_info);
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::addGroup(
+    const string& parent_id, const BuildInfo& element_info) {
+  auto parent = parentOf(parent_id);
+  return detail::recordGroup(spec(), parent, element_info);
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::addInlineReadable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(spec(),
+      parent,
+      element_info,
+      detail::readableEntry(data_type, move(read_cb)));
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::addInlineWritable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineWriteCallback&& write_cb,
+    InlineReadCallback&& read_cb) {
+  auto parent = parentOf(parent_id);
+  return detail::record(spec(),
+      parent,
+      element_info,
+      detail::writableEntry(data_type, move(write_cb), move(read_cb)));
+}
+
+pair<string, DeviceBuilder::InlineNotifyCallback>
+ConcurrentArenaDeviceBuilder::Branch::addInlineObservable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb,
+    InlineIsObservingCallback&& observe_cb) {
+  auto parent = parentOf(parent_id);
+  auto entry =
+      detail::observableEntry(data_type, move(read_cb), move(observe_cb));
+  weak_ptr<detail::ObservableHub> hub = entry.hub;
+  auto id = detail::record(spec(), parent, element_info, move(entry));
+  return {id, detail::Notifier{hub}};
+}
+
+string ConcurrentArenaDeviceBuilder::Branch::addInlineCallable(
+    const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType result_type,
+    InlineExecuteCallback&& execute_cb,
+    InlineAsyncExecuteCallback&& async_execute_cb,
+    InlineCancelCallback&& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  auto parent = parentOf(parent_id);
+  return detail::record(spec(),
+      parent,
+      element_info,
+      detail::callableEntry(result_type,
+          move(execute_cb),
+          move(async_execute_cb),
+          move(cancel_cb),
+          parameter_types));
+}
+
+detail::ArenaSpec& ConcurrentArenaDeviceBuilder::Branch::spec() const {
+  if (state_ == nullptr) {
+    throw logic_error("Branch handle was moved from");
+  }
+  return state_->spec;
+}
+
+uint32_t ConcurrentArenaDeviceBuilder::Branch::parentOf(
+    const optional<string>& parent_id) const {
+  if (!parent_id.has_value()) {
+    spec();
+    return 0;
+  }
+  return detail::groupIndex(spec(), *parent_id);
+}
+
+ConcurrentArenaDeviceBuilder::ConcurrentArenaDeviceBuilder() = default;
+
+ConcurrentArenaDeviceBuilder::~ConcurrentArenaDeviceBuilder() = default;
+
+void ConcurrentArenaDeviceBuilder::setDeviceInfo(
+    const string& unique_id, const BuildInfo& element_info) {
+  lock_guard lock(mx_);
+  if (spec_) {
+    throw DeviceBuildInProgress();
+  }
+  spec_ = make_unique<detail::ArenaSpec>();
+  spec_->device_id = unique_id;
+  spec_->device_info = element_info;
+  detail::ArenaSpec::Entry root;
+  root.id = unique_id + ":";
+  root.name = element_info.name;
+  root.description = element_info.description;
+  spec_->entries.push_back(move(root));
+}
+
+ConcurrentArenaDeviceBuilder::Branch ConcurrentArenaDeviceBuilder::branch(
+    size_t position, const BuildInfo& group_info) {
+  lock_guard lock(mx_);
+  if (!spec_) {
+    throw DeviceInfoNotSet();
+  }
+  // the root and one group per position below this one must fit the arena
+  if (position > detail::NO_PARENT - 2) {
+    throw out_of_range("Branch position " + to_string(position) +
+        " exceeds the device capacity");
+  }
+  if (branches_.count(position) != 0) {
+    throw invalid_argument(
+        "Branch " + to_string(position) + " is already claimed");
+  }
+  auto state = make_unique<detail::ArenaBranch>();
+  state->id = spec_->entries.front().id + to_string(position);
+  detail::ArenaSpec::Entry group;
+  group.id = state->id;
+  group.name = group_info.name;
+  group.description = group_info.description;
+  state->spec.entries.push_back(move(group));
+  state->spec.groups.emplace(state->id, 0);
+  auto* claimed = state.get();
+  branches_.emplace(position, move(state));
+  return Branch(claimed);
+}
+
+unique_ptr<Device> ConcurrentArenaDeviceBuilder::result() {
+  lock_guard lock(mx_);
+  if (!spec_) {
+    throw DeviceInfoNotSet();
+  }
+  auto& spec = *spec_;
+  if (branches_.empty()) {
+    throw GroupEmpty(spec.device_id);
+  }
+  size_t count = spec.entries.size();
+  size_t expected = 0;
+  for (const auto& [position, branch] : branches_) {
+    if (position != expected) {
+      throw BranchMissing(spec.device_id, expected);
+    }
+    ++expected;
+    if (branch->in_use.load(memory_order_acquire)) {
+      throw BranchInUse(branch->id);
+    }
+    for (const auto& entry : branch->spec.entries) {
+      if (entry.type == ElementType::Group && entry.children == 0) {
+        throw GroupEmpty(spec.device_id, entry.id);
+      }
+    }
+    count += branch->spec.entries.size();
+  }
+  if (count > detail::NO_PARENT) {
+    throw length_error("Device can not hold more elements");
+  }
+  // branches are appended in position order, so the merge does not depend
+  // on the order in which they were built
+  spec.entries.reserve(count);
+  spec.entries.front().children = static_cast<uint32_t>(branches_.size());
+  for (auto& claimed : branches_) {
+    auto& branch = claimed.second;
+    auto offset = static_cast<uint32_t>(spec.entries.size());
+    for (auto& entry : branch->spec.entries) {
+      entry.parent =
+          entry.parent == detail::NO_PARENT ? 0 : entry.parent + offset;
+      spec.entries.push_back(move(entry));
+    }
+  }
+  auto model = detail::place(move(spec));
+  spec_.reset();
+  branches_.clear();
+  return make_unique<ArenaDevice>(move(model));
+}
+} // namespace Information_Model
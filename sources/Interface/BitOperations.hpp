@@ -0,0 +1,48 @@
+#ifndef __STAG_INFORMATION_MODEL_BIT_OPERATIONS_HPP
+#define __STAG_INFORMATION_MODEL_BIT_OPERATIONS_HPP
+
+#include <cstdint>
+
+namespace Information_Model::detail {
+/**
+ * @brief Counts the zero bits below the lowest set bit, returns 64 for 0
+ *
+ * Uses the compiler intrinsic on GCC and Clang and a portable loop elsewhere,
+ * so the reference implementations also build with MSVC.
+ */
+inline unsigned trailingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return value == 0 ? 64U : static_cast<unsigned>(__builtin_ctzll(value));
+#else
+  unsigned count = 0;
+  for (auto mask = uint64_t{1}; mask != 0 && (value & mask) == 0;
+       mask <<= 1U) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief Counts the zero bits above the highest set bit, returns 64 for 0
+ */
+inline unsigned leadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return value == 0 ? 64U : static_cast<unsigned>(__builtin_clzll(value));
+#else
+  unsigned count = 0;
+  for (auto mask = uint64_t{1} << 63U; mask != 0 && (value & mask) == 0;
+       mask >>= 1U) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief Number of bits needed to represent the given value, 0 for 0
+ */
+inline unsigned bitWidth(uint64_t value) { return 64U - leadingZeros(value); }
+} // namespace Information_Model::detail
+
+#endif //__STAG_INFORMATION_MODEL_BIT_OPERATIONS_HPP
@@ -0,0 +1,223 @@
+#include "CallDeadlines.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+CallDeadlineManager::CallDeadlineManager(Clock::duration resolution)
+    : resolution_(resolution), epoch_(Clock::now()) {
+  if (resolution_.count() <= 0) {
+    throw invalid_argument("Deadline resolution must be positive");
+  }
+}
+
+CallDeadlineManager::~CallDeadlineManager() {
+  stop();
+  unordered_map<uintmax_t, PendingCall> calls;
+  {
+    lock_guard lock(mx_);
+    calls.swap(calls_);
+  }
+  for (auto& [call_id, call] : calls) {
+    call.result.set_exception(
+        make_exception_ptr(CallCanceled(call_id, call.name)));
+  }
+}
+
+ResultFuture CallDeadlineManager::track(uintmax_t call_id,
+    const string& name,
+    Clock::duration timeout,
+    const CancelCallback& cancel) {
+  if (timeout.count() < 0) {
+    throw invalid_argument("Call timeout can not be negative");
+  }
+  auto deadline = Clock::now() + timeout;
+  // rounded up, so calls never time out before their deadline
+  auto tick = tickOf(deadline, true);
+
+  PendingCall call;
+  auto result = call.result.get_future();
+  call.name = name;
+  call.cancel = cancel;
+  call.deadline = deadline;
+  bool earlier = false;
+  {
+    lock_guard lock(mx_);
+    if (calls_.find(call_id) != calls_.end()) {
+      throw CallerIDExists(call_id, name);
+    }
+    call.timer = wheel_.schedule(tick, static_cast<uint64_t>(call_id));
+    calls_.emplace(call_id, move(call));
+    // only deadlines before the current wake up interrupt the timer thread
+    earlier = running_ && tick < wakeup_;
+    if (earlier) {
+      wakeup_ = tick;
+    }
+  }
+  if (earlier) {
+    changed_.notify_all();
+  }
+  return ResultFuture(call_id, move(result));
+}
+
+bool CallDeadlineManager::complete(
+    uintmax_t call_id, const DataVariant& result) {
+  PendingCall call;
+  {
+    lock_guard lock(mx_);
+    if (!release(call_id, call)) {
+      return false;
+    }
+    ++statistics_.completed;
+  }
+  call.result.set_value(result);
+  return true;
+}
+
+bool CallDeadlineManager::fail(uintmax_t call_id, const exception_ptr& error) {
+  PendingCall call;
+  {
+    lock_guard lock(mx_);
+    if (!release(call_id, call)) {
+      return false;
+    }
+    ++statistics_.failed;
+  }
+  call.result.set_exception(error);
+  return true;
+}
+
+bool CallDeadlineManager::cancel(uintmax_t call_id) {
+  PendingCall call;
+  {
+    lock_guard lock(mx_);
+    if (!release(call_id, call)) {
+      return false;
+    }
+    ++statistics_.canceled;
+  }
+  call.result.set_exception(
+      make_exception_ptr(CallCanceled(call_id, call.name)));
+  return true;
+}
+
+size_t CallDeadlineManager::pending() const {
+  lock_guard lock(mx_);
+  return calls_.size();
+}
+
+void CallDeadlineManager::start() {
+  lock_guard lock(mx_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  timer_ = thread(&CallDeadlineManager::timerLoop, this);
+}
+
+void CallDeadlineManager::stop() {
+  {
+    lock_guard lock(mx_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  changed_.notify_all();
+  timer_.join();
+}
+
+size_t CallDeadlineManager::expire(Clock::time_point now) {
+  vector<TimedOut> timed_out;
+  {
+    lock_guard lock(mx_);
+    expired_.clear();
+    wheel_.advance(tickOf(now, false), expired_);
+    for (const auto& expiry : expired_) {
+      auto it = calls_.find(static_cast<uintmax_t>(expiry.key));
+      if (it == calls_.end() || it->second.timer != expiry.id) {
+        continue;
+      }
+      using Duration = CallDeadlineStatistics::Duration;
+      auto lateness = max(
+          chrono::duration_cast<Duration>(now - it->second.deadline),
+          Duration{0});
+      ++statistics_.timed_out;
+      statistics_.total_lateness += lateness;
+      statistics_.max_lateness = max(statistics_.max_lateness, lateness);
+      timed_out.push_back(TimedOut{it->first, move(it->second)});
+      calls_.erase(it);
+    }
+  }
+  for (auto& [call_id, call] : timed_out) {
+    // the request is cancelled before the caller is woken up
+    if (call.cancel) {
+      try {
+        call.cancel(call_id);
+      } catch (...) {
+        // cancellation failures must not stop the timer thread
+      }
+    }
+    call.result.set_exception(make_exception_ptr(CallTimedout(call.name)));
+  }
+  return timed_out.size();
+}
+
+CallDeadlineStatistics CallDeadlineManager::statistics() const {
+  lock_guard lock(mx_);
+  return statistics_;
+}
+
+bool CallDeadlineManager::release(uintmax_t call_id, PendingCall& call) {
+  auto it = calls_.find(call_id);
+  if (it == calls_.end()) {
+    return false;
+  }
+  wheel_.cancel(it->second.timer);
+  call = move(it->second);
+  calls_.erase(it);
+  return true;
+}
+
+uint64_t CallDeadlineManager::tickOf(
+    Clock::time_point time, bool round_up) const {
+  if (time <= epoch_) {
+    return 0;
+  }
+  auto elapsed = time - epoch_;
+  auto tick = static_cast<uint64_t>(elapsed / resolution_);
+  if (round_up && elapsed % resolution_ != Clock::duration::zero()) {
+    ++tick;
+  }
+  return tick;
+}
+
+CallDeadlineManager::Clock::time_point CallDeadlineManager::timeOf(
+    uint64_t tick) const {
+  return epoch_ + resolution_ * static_cast<Clock::rep>(tick);
+}
+
+void CallDeadlineManager::timerLoop() {
+  unique_lock lock(mx_);
+  while (running_) {
+    // sleeps until the next timer is due, track() cuts the sleep short for
+    // earlier deadlines
+    auto wakeup = wheel_.nextEvent();
+    wakeup_ = wakeup;
+    auto woken = [this, wakeup]() { return !running_ || wakeup_ != wakeup; };
+    if (wakeup == UINT64_MAX) {
+      // no wake ups while there is nothing to time out
+      changed_.wait(lock, woken);
+      continue;
+    }
+    if (changed_.wait_until(lock, timeOf(wakeup), woken)) {
+      continue;
+    }
+    lock.unlock();
+    expire(Clock::now());
+    lock.lock();
+  }
+}
+} // namespace Information_Model
@@ -9,66 +9,117 @@ ResultFuture::ResultFuture(
     shared_ptr<uintmax_t> id, future<DataVariant>&& result)
     : id_(move(id)), result_(move(result)) {}
 
+ResultFuture::ResultFuture(uintmax_t id, future<DataVariant>&& result)
+    : fixed_id_(id), result_(move(result)) {}
+
 DataVariant ResultFuture::get() {
   auto result = result_.get();
   return result;
 }
 
-uintmax_t ResultFuture::id() const { return *id_; }
+uintmax_t ResultFuture::id() const { return id_ ? *id_ : fixed_id_; }
 
 bool operator==(const ParameterType& lhs, const ParameterType& rhs) {
-  return lhs.mandatory == rhs.mandatory && lhs.type == rhs.type;
+  return lhs.mandatory == rhs.mandatory && lhs.type == rhs.type &&
+      lhs.allow_widening == rhs.allow_widening;
 }
 
 bool operator!=(const ParameterType& lhs, const ParameterType& rhs) {
   return !(lhs == rhs);
 }
 
-void checkParameter(uintmax_t position,
+namespace {
+/**
+ * @return Expected<bool> - true if given parameter value must be widened to
+ * the expected type
+ */
+Expected<bool> checkParameter(uintmax_t position,
     const optional<DataVariant>& given,
     const ParameterType& expected) {
   if (const auto& given_value = given) {
     auto given_type = toDataType(*given_value);
     if (given_type != expected.type) {
-      throw ParameterTypeMismatch(position, expected.type, given_type);
+      if (expected.allow_widening &&
+          isLosslesslyConvertible(given_type, expected.type)) {
+        return true;
+      }
+      return Error(ErrorCode::Parameter_Type_Mismatch,
+          {},
+          position,
+          expected.type,
+          given_type);
     }
   } else if (expected.mandatory) {
-    throw MandatoryParameterHasNoValue(position, expected.type);
+    return Error(ErrorCode::Mandatory_Parameter_Has_No_Value,
+        {},
+        position,
+        expected.type);
   }
+  return false;
 }
+} // namespace
 
 void addSupportedParameter(Parameters& map,
     const ParameterTypes& supported_types,
     uintmax_t position,
     const optional<DataVariant>& parameter,
     bool strict_assign) {
+  tryAddSupportedParameter(
+      map, supported_types, position, parameter, strict_assign)
+      .value();
+}
+
+Expected<void> tryAddSupportedParameter(Parameters& map,
+    const ParameterTypes& supported_types,
+    uintmax_t position,
+    const optional<DataVariant>& parameter,
+    bool strict_assign) {
   auto it = supported_types.find(position);
   if (it == supported_types.end()) {
-    throw ParameterDoesNotExist(position);
+    return Error(ErrorCode::Parameter_Does_Not_Exist, {}, position);
   }
 
-  checkParameter(position, parameter, it->second);
+  auto widening = checkParameter(position, parameter, it->second);
+  if (!widening) {
+    return widening.error();
+  }
+  auto value = parameter;
+  if (*widening) {
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    value = widen(*parameter, it->second.type);
+  }
 
   if (strict_assign) {
-    map.insert_or_assign(position, parameter);
+    map.insert_or_assign(position, move(value));
   } else {
-    map.try_emplace(position, parameter);
+    map.try_emplace(position, move(value));
   }
+  return {};
 }
 
 void checkParameters(
     const Parameters& input_parameters, const ParameterTypes& supported_types) {
+  tryCheckParameters(input_parameters, supported_types).value();
+}
+
+Expected<void> tryCheckParameters(
+    const Parameters& input_parameters, const ParameterTypes& supported_types) {
   for (const auto& [pos, expected] : supported_types) {
 
     auto it = input_parameters.find(pos);
     if (it == input_parameters.end() && expected.mandatory) {
-      throw MandatoryParameterMissing(pos, expected.type);
+      return Error(
+          ErrorCode::Mandatory_Parameter_Missing, {}, pos, expected.type);
     }
 
     if (it != input_parameters.end()) {
-      checkParameter(pos, it->second, expected);
+      auto checked = checkParameter(pos, it->second, expected);
+      if (!checked) {
+        return checked.error();
+      }
     }
   }
+  return {};
 }
 
 Parameters makeDefaultParams(const ParameterTypes& supported_types) {
@@ -100,7 +151,8 @@ string toString(const ParameterTypes& supported_types) {
     auto parameter = supported_types.at(position);
     result += "{" + to_string(position) + "," +
         toSanitizedString(parameter.type) +
-        (parameter.mandatory ? ",mandatory" : ",optional") + "},";
+        (parameter.mandatory ? ",mandatory" : ",optional") +
+        (parameter.allow_widening ? ",widening" : "") + "},";
   }
   result.pop_back(); // pop last , character
   return result += "}";
@@ -153,6 +153,24 @@ string toString(DataType type) {
     return "Opaque Byte Array";
   case DataType::String:
     return "String";
+  case DataType::Integer_Array:
+    return "Signed Integer Array";
+  case DataType::Unsigned_Integer_Array:
+    return "Unsigned Integer Array";
+  case DataType::Double_Array:
+    return "Double Floating Point Array";
+  case DataType::Integer_16:
+    return "Signed 16 Bit Integer";
+  case DataType::Integer_32:
+    return "Signed 32 Bit Integer";
+  case DataType::Unsigned_Integer_16:
+    return "Unsigned 16 Bit Integer";
+  case DataType::Unsigned_Integer_32:
+    return "Unsigned 32 Bit Integer";
+  case DataType::Float:
+    return "Single Floating Point";
+  case DataType::Integer_16_Array:
+    return "Signed 16 Bit Integer Array";
   case DataType::None:
     return "None";
   case DataType::Unknown:
@@ -170,12 +188,65 @@ string toSanitizedString(DataType type) {
   return not_sanitized;
 }
 
+namespace {
+template <typename T> size_t arraySize(const AlignedVector<T>& values) {
+  return values.size() * sizeof(T);
+}
+
+string toSanitizedString(double value) {
+  string result;
+  if (value < 0) {
+    auto abs_value = std::abs(value);
+    result = "Neg" + to_string(abs_value);
+  } else {
+    result = to_string(value);
+  }
+  replace(result.begin(), result.end(), '.', 'P');
+  return result;
+}
+
+template <typename T, typename Converter>
+string arrayToString(const AlignedVector<T>& values,
+    const string& separator,
+    Converter&& converter) {
+  string result;
+  for (const auto& value : values) {
+    if (!result.empty()) {
+      result += separator;
+    }
+    result += converter(value);
+  }
+  return result;
+}
+
+template <typename T> string toString(const AlignedVector<T>& values) {
+  return "[" +
+      arrayToString(
+          values, ", ", [](const T& value) { return to_string(value); }) +
+      "]";
+}
+
+template <typename T>
+string toSanitizedString(const AlignedVector<T>& values) {
+  if (values.empty()) {
+    return "NullArray";
+  }
+  return arrayToString(values, "_", [](const T& value) {
+    return toSanitizedString(DataVariant(value));
+  });
+}
+} // namespace
+
 size_t size_of(const DataVariant& variant) {
   return Variant_Visitor::match(
       variant,
       [](const auto& value) { return sizeof(value); },
       [](const vector<uint8_t>& value) { return value.size(); },
-      [](const string& value) { return value.size(); });
+      [](const string& value) { return value.size(); },
+      [](const IntegerArray& value) { return arraySize(value); },
+      [](const UnsignedIntegerArray& value) { return arraySize(value); },
+      [](const DoubleArray& value) { return arraySize(value); },
+      [](const Integer16Array& value) { return arraySize(value); });
 }
 
 optional<DataVariant> setVariant(DataType type) {
@@ -194,6 +265,24 @@ optional<DataVariant> setVariant(DataType type) {
     return DataVariant(vector<uint8_t>{});
   case DataType::String:
     return DataVariant(string{});
+  case DataType::Integer_Array:
+    return DataVariant(IntegerArray{});
+  case DataType::Unsigned_Integer_Array:
+    return DataVariant(UnsignedIntegerArray{});
+  case DataType::Double_Array:
+    return DataVariant(DoubleArray{});
+  case DataType::Integer_16:
+    return DataVariant(Integer16{1});
+  case DataType::Integer_32:
+    return DataVariant(Integer32{1});
+  case DataType::Unsigned_Integer_16:
+    return DataVariant(UnsignedInteger16{(uint16_t)-1});
+  case DataType::Unsigned_Integer_32:
+    return DataVariant(UnsignedInteger32{(uint32_t)-1});
+  case DataType::Float:
+    return DataVariant(Float32{0.1F}); // NOLINT(readability-magic-numbers)
+  case DataType::Integer_16_Array:
+    return DataVariant(Integer16Array{});
   case DataType::None:
     return nullopt;
   case DataType::Unknown:
@@ -204,34 +293,112 @@ optional<DataVariant> setVariant(DataType type) {
 }
 
 DataType toDataType(const DataVariant& variant) {
-  if (holds_alternative<bool>(variant)) {
-    return DataType::Boolean;
-  } else if (holds_alternative<intmax_t>(variant)) {
-    return DataType::Integer;
-  } else if (holds_alternative<uintmax_t>(variant)) {
-    return DataType::Unsigned_Integer;
-  } else if (holds_alternative<double>(variant)) {
-    return DataType::Double;
-  } else if (holds_alternative<Timestamp>(variant)) {
-    return DataType::Timestamp;
-  } else if (holds_alternative<vector<uint8_t>>(variant)) {
-    return DataType::Opaque;
-  } else if (holds_alternative<string>(variant)) {
-    return DataType::String;
+  // valueless variants return variant_npos, which is mapped to Unknown
+  return dataTypeAt(variant.index());
+}
+
+bool matchVariantType(const DataVariant& variant, DataType type) {
+  auto index = variantIndexOf(type);
+  return index != variant_npos && variant.index() == index;
+}
+
+namespace {
+template <typename From, typename To> bool fitsInto(From value) {
+  if constexpr (is_floating_point_v<To>) {
+    if constexpr (is_floating_point_v<From>) {
+      return !isfinite(value) ||
+          (value >= static_cast<From>(numeric_limits<To>::lowest()) &&
+              value <= static_cast<From>(numeric_limits<To>::max()));
+    } else {
+      return true;
+    }
+  } else if constexpr (is_floating_point_v<From>) {
+    // 2^digits is exactly representable, while the max value might not be
+    const auto upper_bound = ldexp(From{1}, numeric_limits<To>::digits);
+    return isfinite(value) && trunc(value) == value &&
+        value >= static_cast<From>(numeric_limits<To>::lowest()) &&
+        value < upper_bound;
+  } else if constexpr (is_signed_v<From> == is_signed_v<To>) {
+    return value >= numeric_limits<To>::lowest() &&
+        value <= numeric_limits<To>::max();
+  } else if constexpr (is_signed_v<From>) {
+    return value >= 0 &&
+        static_cast<make_unsigned_t<From>>(value) <= numeric_limits<To>::max();
   } else {
-    return DataType::Unknown;
+    return value <= static_cast<make_unsigned_t<To>>(numeric_limits<To>::max());
   }
 }
 
-bool matchVariantType(const DataVariant& variant, DataType type) {
-  return toDataType(variant) == type;
+template <typename Converter>
+DataVariant convert(
+    const DataVariant& value, DataType target, Converter&& converter) {
+  auto source = toDataType(value);
+  if (variantIndexOf(target) == variant_npos) {
+    throw ConversionNotSupported(source, target);
+  }
+  return visit(
+      [&](const auto& given) {
+        return visitDataType(target, [&](auto tag) -> DataVariant {
+          using To = typename decltype(tag)::type;
+          return converter(given, To{});
+        });
+      },
+      value);
+}
+} // namespace
+
+bool isLosslesslyConvertible(DataType from, DataType to) {
+  if (variantIndexOf(from) == variant_npos ||
+      variantIndexOf(to) == variant_npos) {
+    return false;
+  }
+  return visitDataType(from, [to](auto from_tag) {
+    return visitDataType(to, [](auto to_tag) {
+      return detail::isLossless<typename decltype(from_tag)::type,
+          typename decltype(to_tag)::type>();
+    });
+  });
+}
+
+DataVariant widen(const DataVariant& value, DataType target) {
+  auto source = toDataType(value);
+  return convert(value, target, [&](const auto& given, auto to) {
+    using From = decay_t<decltype(given)>;
+    using To = decltype(to);
+    if constexpr (detail::isLossless<From, To>()) {
+      return DataVariant(
+          fromNative<To>(static_cast<NativeTypeOf_t<To>>(toNative(given))));
+    } else {
+      throw ConversionNotSupported(source, target);
+      return DataVariant();
+    }
+  });
+}
+
+DataVariant narrow(const DataVariant& value, DataType target) {
+  auto source = toDataType(value);
+  return convert(value, target, [&](const auto& given, auto to) {
+    using From = decay_t<decltype(given)>;
+    using To = decltype(to);
+    if constexpr (detail::is_numeric<From> && detail::is_numeric<To>) {
+      using Native = NativeTypeOf_t<To>;
+      if (!fitsInto<NativeTypeOf_t<From>, Native>(toNative(given))) {
+        throw ValueOutOfRange(toString(value), target);
+      }
+      return DataVariant(
+          fromNative<To>(static_cast<Native>(toNative(given))));
+    } else {
+      throw ConversionNotSupported(source, target);
+      return DataVariant();
+    }
+  });
 }
 
 string toString(const DataVariant& variant) {
   return Variant_Visitor::match(
       variant,
       [](bool value) -> string { return (value ? "True" : "False"); },
-      [](auto value) -> string { return to_string(value); },
+      [](auto value) -> string { return to_string(toNative(value)); },
       [](const Timestamp& value) -> string { return toString(value); },
       [](const vector<uint8_t>& value) -> string {
         stringstream ss;
@@ -241,25 +408,23 @@ string toString(const DataVariant& variant) {
         }
         return ss.str();
       },
-      [](const string& value) -> string { return value; });
+      [](const string& value) -> string { return value; },
+      [](const IntegerArray& value) -> string { return toString(value); },
+      [](const UnsignedIntegerArray& value) -> string {
+        return toString(value);
+      },
+      [](const DoubleArray& value) -> string { return toString(value); },
+      [](const Integer16Array& value) -> string { return toString(value); });
 }
 
 string toSanitizedString(const DataVariant& variant) {
   return Variant_Visitor::match(
       variant,
       [](bool value) -> string { return (value ? "True" : "False"); },
-      [](double value) -> string {
-        string result;
-        if (value < 0) {
-          auto abs_value = std::abs(value);
-          result = "Neg" + to_string(abs_value);
-        } else {
-          result = to_string(value);
-        }
-        replace(result.begin(), result.end(), '.', 'P');
-        return result;
-      },
-      [](auto value) -> string {
+      [](double value) -> string { return toSanitizedString(value); },
+      [](Float32 value) -> string { return toSanitizedString(value.value); },
+      [](auto narrow_or_integer) -> string {
+        auto value = toNative(narrow_or_integer);
         string result;
         if (value < 0) {
           // avoid ambiguous abs()
@@ -294,6 +459,18 @@ string toSanitizedString(const DataVariant& variant) {
         } else {
           return value;
         }
+      },
+      [](const IntegerArray& value) -> string {
+        return toSanitizedString(value);
+      },
+      [](const UnsignedIntegerArray& value) -> string {
+        return toSanitizedString(value);
+      },
+      [](const DoubleArray& value) -> string {
+        return toSanitizedString(value);
+      },
+      [](const Integer16Array& value) -> string {
+        return toSanitizedString(value);
       });
 }
 } // namespace Information_Model
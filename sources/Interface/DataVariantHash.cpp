@@ -0,0 +1,237 @@
+#include "DataVariant.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+// NOLINTBEGIN(readability-magic-numbers)
+constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+constexpr uint64_t rotateLeft(uint64_t value, unsigned bits) {
+  return (value << bits) | (value >> (64U - bits));
+}
+
+/**
+ * @brief Avalanches all bits of a given value, based on the MurmurHash3
+ * finalizer
+ */
+constexpr uint64_t mix(uint64_t value) {
+  value ^= value >> 33U;
+  value *= 0xFF51AFD7ED558CCDULL;
+  value ^= value >> 33U;
+  value *= 0xC4CEB9FE1A85EC53ULL;
+  value ^= value >> 33U;
+  return value;
+}
+
+constexpr uint64_t hashRound(uint64_t lane, uint64_t input) {
+  lane += input * PRIME_2;
+  lane = rotateLeft(lane, 31U);
+  return lane * PRIME_1;
+}
+
+constexpr uint64_t mergeLane(uint64_t hash, uint64_t lane) {
+  hash ^= hashRound(0, lane);
+  return hash * PRIME_1 + PRIME_4;
+}
+
+template <typename T> T load(const uint8_t* data) {
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+/**
+ * @tparam LoadWord - returns the 64 bit word at a given address, so callers
+ * can normalize values while they are fed into the lanes
+ */
+template <typename LoadWord>
+uint64_t hashBytes64(
+    const uint8_t* data, size_t size, uint64_t seed, LoadWord&& load_word) {
+  const uint8_t* end = data + size;
+  uint64_t hash;
+  if (size >= 32) {
+    // four independent lanes, so the multiplications do not wait on each other
+    uint64_t lanes[4] = {seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed,
+        seed - PRIME_1};
+    const uint8_t* block_end = end - 32;
+    do {
+      lanes[0] = hashRound(lanes[0], load_word(data));
+      lanes[1] = hashRound(lanes[1], load_word(data + 8));
+      lanes[2] = hashRound(lanes[2], load_word(data + 16));
+      lanes[3] = hashRound(lanes[3], load_word(data + 24));
+      data += 32;
+    } while (data <= block_end);
+
+    hash = rotateLeft(lanes[0], 1U) + rotateLeft(lanes[1], 7U) +
+        rotateLeft(lanes[2], 12U) + rotateLeft(lanes[3], 18U);
+    for (auto lane : lanes) {
+      hash = mergeLane(hash, lane);
+    }
+  } else {
+    hash = seed + PRIME_5;
+  }
+  hash += static_cast<uint64_t>(size);
+
+  for (; data + 8 <= end; data += 8) {
+    hash ^= hashRound(0, load_word(data));
+    hash = rotateLeft(hash, 27U) * PRIME_1 + PRIME_4;
+  }
+  if (data + 4 <= end) {
+    hash ^= static_cast<uint64_t>(load<uint32_t>(data)) * PRIME_1;
+    hash = rotateLeft(hash, 23U) * PRIME_2 + PRIME_3;
+    data += 4;
+  }
+  for (; data < end; ++data) {
+    hash ^= static_cast<uint64_t>(*data) * PRIME_5;
+    hash = rotateLeft(hash, 11U) * PRIME_1;
+  }
+  return mix(hash);
+}
+
+uint64_t packTimestamp(const Timestamp& timestamp) {
+  // 62 bits are enough to store every field of a valid timestamp
+  return static_cast<uint64_t>(timestamp.year) << 46U |
+      static_cast<uint64_t>(timestamp.month & 0xFU) << 42U |
+      static_cast<uint64_t>(timestamp.day & 0x1FU) << 37U |
+      static_cast<uint64_t>(timestamp.hours & 0x1FU) << 32U |
+      static_cast<uint64_t>(timestamp.minutes & 0x3FU) << 26U |
+      static_cast<uint64_t>(timestamp.seconds & 0x3FU) << 20U |
+      static_cast<uint64_t>(timestamp.microseconds & 0xFFFFFU);
+}
+// NOLINTEND(readability-magic-numbers)
+
+template <typename T> T normalized(T value) {
+  if (isnan(value)) {
+    return numeric_limits<T>::quiet_NaN();
+  }
+  // turns -0.0 into +0.0
+  return value + T{0};
+}
+
+template <typename T> uint64_t valueBits(T value) {
+  if constexpr (is_floating_point_v<T>) {
+    auto normal = normalized(value);
+    if constexpr (sizeof(T) == sizeof(uint32_t)) {
+      uint32_t bits;
+      memcpy(&bits, &normal, sizeof(bits));
+      return bits;
+    } else {
+      uint64_t bits;
+      memcpy(&bits, &normal, sizeof(bits));
+      return bits;
+    }
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+uint64_t hashRange(const void* data, size_t size, uint64_t seed) {
+  return hashBytes64(static_cast<const uint8_t*>(data),
+      size,
+      seed,
+      [](const uint8_t* word) { return load<uint64_t>(word); });
+}
+
+uint64_t hashArray(const DoubleArray& values, uint64_t seed) {
+  // every word is a whole value, so normalizing them while they are hashed
+  // gives the same hash as hashing a normalized copy, without allocating
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  return hashBytes64(reinterpret_cast<const uint8_t*>(values.data()),
+      values.size() * sizeof(double),
+      seed,
+      [](const uint8_t* word) { return valueBits(load<double>(word)); });
+}
+
+template <typename T> uint64_t hashAlternative(const T& value, uint64_t seed) {
+  if constexpr (is_same_v<T, Timestamp>) {
+    return mix(packTimestamp(value) ^ seed);
+  } else if constexpr (is_same_v<T, DoubleArray>) {
+    return hashArray(value, seed);
+  } else if constexpr (is_same_v<T, string> || is_same_v<T, vector<uint8_t>> ||
+      is_same_v<T, IntegerArray> || is_same_v<T, UnsignedIntegerArray> ||
+      is_same_v<T, Integer16Array>) {
+    return hashRange(
+        value.data(), value.size() * sizeof(typename T::value_type), seed);
+  } else {
+    return mix(valueBits(toNative(value)) ^ seed);
+  }
+}
+
+template <typename T> int compareValues(const T& lhs, const T& rhs) {
+  if constexpr (is_floating_point_v<T>) {
+    bool lhs_nan = isnan(lhs);
+    bool rhs_nan = isnan(rhs);
+    if (lhs_nan || rhs_nan) {
+      return static_cast<int>(lhs_nan) - static_cast<int>(rhs_nan);
+    }
+    return static_cast<int>(lhs > rhs) - static_cast<int>(lhs < rhs);
+  } else if constexpr (is_same_v<T, string>) {
+    auto result = lhs.compare(rhs);
+    return static_cast<int>(result > 0) - static_cast<int>(result < 0);
+  } else if constexpr (is_same_v<T, vector<uint8_t>>) {
+    auto common = min(lhs.size(), rhs.size());
+    auto result = common == 0 ? 0 : memcmp(lhs.data(), rhs.data(), common);
+    if (result != 0) {
+      return static_cast<int>(result > 0) - static_cast<int>(result < 0);
+    }
+    return compareValues(lhs.size(), rhs.size());
+  } else if constexpr (is_same_v<T, IntegerArray> ||
+      is_same_v<T, UnsignedIntegerArray> || is_same_v<T, DoubleArray> ||
+      is_same_v<T, Integer16Array>) {
+    auto common = min(lhs.size(), rhs.size());
+    for (size_t i = 0; i < common; ++i) {
+      if (auto result = compareValues(lhs[i], rhs[i]); result != 0) {
+        return result;
+      }
+    }
+    return compareValues(lhs.size(), rhs.size());
+  } else {
+    return static_cast<int>(lhs > rhs) - static_cast<int>(lhs < rhs);
+  }
+}
+} // namespace
+
+size_t hashBytes(const void* data, size_t size, size_t seed) noexcept {
+  return static_cast<size_t>(hashRange(data, size, seed));
+}
+
+size_t hashValue(const Timestamp& timestamp) noexcept {
+  return static_cast<size_t>(mix(packTimestamp(timestamp)));
+}
+
+size_t hashValue(const DataVariant& variant) noexcept {
+  if (variant.valueless_by_exception()) {
+    return 0;
+  }
+  auto seed = static_cast<uint64_t>(variant.index() + 1) * PRIME_3;
+  return static_cast<size_t>(visit(
+      [seed](const auto& value) { return hashAlternative(value, seed); },
+      variant));
+}
+
+int compare(const DataVariant& lhs, const DataVariant& rhs) noexcept {
+  // valueless variants have npos index and are ordered after any other value
+  if (lhs.index() != rhs.index()) {
+    return lhs.index() < rhs.index() ? -1 : 1;
+  }
+  if (lhs.valueless_by_exception()) {
+    return 0;
+  }
+  return visit(
+      [&rhs](const auto& value) {
+        using Alternative = decay_t<decltype(value)>;
+        return compareValues(
+            toNative(value), toNative(*get_if<Alternative>(&rhs)));
+      },
+      lhs);
+}
+} // namespace Information_Model
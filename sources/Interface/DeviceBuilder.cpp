@@ -0,0 +1,281 @@
+#include "DeviceBuilder.hpp"
+#include "DeviceDefinition.hpp"
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+DeviceBuilder::ReadCallback boxed(const DeviceBuilder::AnyReadCallback& any) {
+  return visit(
+      [](const auto& callback) -> DeviceBuilder::ReadCallback {
+        if (!callback) {
+          return nullptr;
+        }
+        return [callback]() { return DataVariant(callback()); };
+      },
+      any);
+}
+
+template <typename Native>
+DeviceBuilder::WriteCallback boxed(
+    const DeviceBuilder::TypedWriteCallback<Native>& callback) {
+  if (!callback) {
+    return nullptr;
+  }
+  return [callback](
+             const DataVariant& value) { callback(get<Native>(value)); };
+}
+
+DeviceBuilder::WriteCallback boxed(
+    const DeviceBuilder::AnyWriteCallback& any) {
+  return visit([](const auto& callback) { return boxed(callback); }, any);
+}
+
+template <typename Native>
+DeviceBuilder::AnyNotifyCallback unboxed(
+    const DeviceBuilder::NotifyCallback& notify) {
+  return DeviceBuilder::AnyNotifyCallback{
+      in_place_index<VariantIndexOf_v<Native>>,
+      [notify](const Native& value) { notify(DataVariant(value)); }};
+}
+
+DeviceBuilder::NotifyCallback suppressed(
+    const DeviceBuilder::NotifyCallback& notify,
+    const NotificationFilterPtr& filter) {
+  return [notify, filter](const DataVariant& value) {
+    if (filter->admit(value)) {
+      notify(value);
+    }
+  };
+}
+
+/**
+ * @brief Moves a move-only callback into a copyable std::function
+ */
+template <typename Callback, typename Inline>
+Callback shared(Inline&& callback) {
+  if (!callback) {
+    return nullptr;
+  }
+  return [target = make_shared<Inline>(move(callback))](
+             auto&&... args) -> decltype(auto) {
+    return (*target)(forward<decltype(args)>(args)...);
+  };
+}
+
+void checkFilter(const NotificationFilterPtr& filter) {
+  if (!filter) {
+    throw invalid_argument("Notification filter can not be null");
+  }
+}
+} // namespace
+
+pair<string, DeviceBuilder::NotifyCallback> DeviceBuilder::addObservable(
+    const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb,
+    const IsObservingCallback& observe_cb,
+    const NotificationFilterPtr& filter) {
+  checkFilter(filter);
+  auto [id, notify] =
+      addObservable(element_info, data_type, read_cb, observe_cb);
+  return {id, suppressed(notify, filter)};
+}
+
+pair<string, DeviceBuilder::NotifyCallback> DeviceBuilder::addObservable(
+    const string& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    const ReadCallback& read_cb,
+    const IsObservingCallback& observe_cb,
+    const NotificationFilterPtr& filter) {
+  checkFilter(filter);
+  auto [id, notify] =
+      addObservable(parent_id, element_info, data_type, read_cb, observe_cb);
+  return {id, suppressed(notify, filter)};
+}
+
+string DeviceBuilder::addTypedReadable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyReadCallback& read_cb) {
+  auto data_type = dataTypeAt(read_cb.index());
+  if (parent_id.has_value()) {
+    return addReadable(*parent_id, element_info, data_type, boxed(read_cb));
+  }
+  return addReadable(element_info, data_type, boxed(read_cb));
+}
+
+string DeviceBuilder::addTypedWritable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyWriteCallback& write_cb,
+    const AnyReadCallback& read_cb) {
+  if (write_cb.index() != read_cb.index()) {
+    throw invalid_argument(
+        "Write and read callbacks must use the same native value type");
+  }
+  auto data_type = dataTypeAt(write_cb.index());
+  if (parent_id.has_value()) {
+    return addWritable(*parent_id,
+        element_info,
+        data_type,
+        boxed(write_cb),
+        boxed(read_cb));
+  }
+  return addWritable(
+      element_info, data_type, boxed(write_cb), boxed(read_cb));
+}
+
+pair<string, DeviceBuilder::AnyNotifyCallback>
+DeviceBuilder::addTypedObservable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    const AnyReadCallback& read_cb,
+    const IsObservingCallback& observe_cb) {
+  auto data_type = dataTypeAt(read_cb.index());
+  auto [id, notify] = parent_id.has_value()
+      ? addObservable(
+            *parent_id, element_info, data_type, boxed(read_cb), observe_cb)
+      : addObservable(element_info, data_type, boxed(read_cb), observe_cb);
+  auto typed_notify = visitDataType(data_type, [&notify = notify](auto tag) {
+    return unboxed<typename decltype(tag)::type>(notify);
+  });
+  return {id, move(typed_notify)};
+}
+
+string DeviceBuilder::addInlineReadable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb) {
+  auto read = shared<ReadCallback>(move(read_cb));
+  if (parent_id.has_value()) {
+    return addReadable(*parent_id, element_info, data_type, read);
+  }
+  return addReadable(element_info, data_type, read);
+}
+
+string DeviceBuilder::addInlineWritable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineWriteCallback&& write_cb,
+    InlineReadCallback&& read_cb) {
+  auto write = shared<WriteCallback>(move(write_cb));
+  auto read = shared<ReadCallback>(move(read_cb));
+  if (parent_id.has_value()) {
+    return addWritable(*parent_id, element_info, data_type, write, read);
+  }
+  return addWritable(element_info, data_type, write, read);
+}
+
+pair<string, DeviceBuilder::InlineNotifyCallback>
+DeviceBuilder::addInlineObservable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType data_type,
+    InlineReadCallback&& read_cb,
+    InlineIsObservingCallback&& observe_cb) {
+  auto read = shared<ReadCallback>(move(read_cb));
+  auto observe = shared<IsObservingCallback>(move(observe_cb));
+  auto [id, notify] = parent_id.has_value()
+      ? addObservable(*parent_id, element_info, data_type, read, observe)
+      : addObservable(element_info, data_type, read, observe);
+  return {id, InlineNotifyCallback(move(notify))};
+}
+
+string DeviceBuilder::addInlineCallable(const optional<string>& parent_id,
+    const BuildInfo& element_info,
+    DataType result_type,
+    InlineExecuteCallback&& execute_cb,
+    InlineAsyncExecuteCallback&& async_execute_cb,
+    InlineCancelCallback&& cancel_cb,
+    const ParameterTypes& parameter_types) {
+  auto execute = shared<ExecuteCallback>(move(execute_cb));
+  if (result_type == DataType::None && !async_execute_cb && !cancel_cb) {
+    if (parent_id.has_value()) {
+      return addCallable(*parent_id, element_info, execute, parameter_types);
+    }
+    return addCallable(element_info, execute, parameter_types);
+  }
+  auto async_execute = shared<AsyncExecuteCallback>(move(async_execute_cb));
+  auto cancel = shared<CancelCallback>(move(cancel_cb));
+  if (parent_id.has_value()) {
+    return addCallable(*parent_id,
+        element_info,
+        result_type,
+        execute,
+        async_execute,
+        cancel,
+        parameter_types);
+  }
+  return addCallable(element_info,
+      result_type,
+      execute,
+      async_execute,
+      cancel,
+      parameter_types);
+}
+
+BuiltDevice DeviceBuilder::build(
+    const DeviceDefinition& definition, vector<ElementCallbacks> callbacks) {
+  checkDefinition(definition, callbacks);
+  const auto& elements = definition.elements;
+  BuiltDevice built;
+  built.ids.reserve(elements.size());
+  built.notifiers.resize(elements.size());
+  setDeviceInfo(definition.id, definition.info);
+  try {
+    for (size_t row = 0; row < elements.size(); ++row) {
+      const auto& element = elements[row];
+      optional<string> parent;
+      if (element.parent != DEFINITION_ROOT) {
+        parent = built.ids[element.parent];
+      }
+      if (element.type == ElementType::Group) {
+        built.ids.push_back(parent.has_value()
+                ? addGroup(*parent, element.info)
+                : addGroup(element.info));
+        continue;
+      }
+      auto& element_callbacks = callbacks[element.callback];
+      switch (element.type) {
+      case ElementType::Readable:
+        built.ids.push_back(addInlineReadable(parent,
+            element.info,
+            element.data_type,
+            move(element_callbacks.read)));
+        break;
+      case ElementType::Writable:
+        built.ids.push_back(addInlineWritable(parent,
+            element.info,
+            element.data_type,
+            move(element_callbacks.write),
+            move(element_callbacks.read)));
+        break;
+      case ElementType::Observable: {
+        auto [id, notify] = addInlineObservable(parent,
+            element.info,
+            element.data_type,
+            move(element_callbacks.read),
+            move(element_callbacks.observe));
+        built.ids.push_back(move(id));
+        built.notifiers[row] = move(notify);
+        break;
+      }
+      default:
+        built.ids.push_back(addInlineCallable(parent,
+            element.info,
+            element.data_type,
+            move(element_callbacks.execute),
+            move(element_callbacks.async_execute),
+            move(element_callbacks.cancel),
+            element.parameter_types));
+      }
+    }
+    built.device = result();
+  } catch (...) {
+    // a rejected element must not leave the builder stuck mid build
+    abandon();
+    throw;
+  }
+  return built;
+}
+
+void DeviceBuilder::abandon() noexcept {}
+} // namespace Information_Model
@@ -0,0 +1,547 @@
+#include "DeviceDefinition.hpp"
+
+#include <array>
+#include <optional>
+#include <streambuf>
+#include <string_view>
+#include <utility>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+constexpr size_t MAX_SKIPPED_DEPTH = 64;
+
+constexpr array<pair<string_view, ElementType>, 5> ELEMENT_TYPES{{
+    {"Group", ElementType::Group},
+    {"Readable", ElementType::Readable},
+    {"Writable", ElementType::Writable},
+    {"Observable", ElementType::Observable},
+    {"Callable", ElementType::Callable},
+}};
+
+constexpr array<pair<string_view, DataType>, 18> DATA_TYPES{{
+    {"Boolean", DataType::Boolean},
+    {"Integer", DataType::Integer},
+    {"Unsigned_Integer", DataType::Unsigned_Integer},
+    {"Double", DataType::Double},
+    {"Timestamp", DataType::Timestamp},
+    {"Opaque", DataType::Opaque},
+    {"String", DataType::String},
+    {"Integer_Array", DataType::Integer_Array},
+    {"Unsigned_Integer_Array", DataType::Unsigned_Integer_Array},
+    {"Double_Array", DataType::Double_Array},
+    {"Integer_16", DataType::Integer_16},
+    {"Integer_32", DataType::Integer_32},
+    {"Unsigned_Integer_16", DataType::Unsigned_Integer_16},
+    {"Unsigned_Integer_32", DataType::Unsigned_Integer_32},
+    {"Float", DataType::Float},
+    {"Integer_16_Array", DataType::Integer_16_Array},
+    {"None", DataType::None},
+    {"Unknown", DataType::Unknown},
+}};
+
+bool isValueType(DataType type) {
+  return type != DataType::None && type != DataType::Unknown;
+}
+
+/**
+ * @brief Pull reader of a JSON text, that reads values directly from the
+ * stream buffer and keeps no document tree
+ */
+class JsonReader {
+  using Traits = streambuf::traits_type;
+
+public:
+  explicit JsonReader(istream& input) : input_(input.rdbuf()) {
+    if (input_ == nullptr) {
+      throw DefinitionParseError(0, 0, "Input has no stream buffer");
+    }
+  }
+
+  /**
+   * @brief Skips whitespace and returns the next character without
+   * consuming it
+   */
+  int peek() {
+    auto next = input_->sgetc();
+    while (next == ' ' || next == '\t' || next == '\n' || next == '\r') {
+      get();
+      next = input_->sgetc();
+    }
+    return next;
+  }
+
+  bool atEnd() { return Traits::eq_int_type(peek(), Traits::eof()); }
+
+  void expect(char expected) {
+    if (peek() != expected) {
+      fail(string("Expected '") + expected + "'");
+    }
+    get();
+  }
+
+  string readString() {
+    expect('"');
+    string result;
+    while (true) {
+      auto next = get();
+      if (Traits::eq_int_type(next, Traits::eof())) {
+        fail("Unterminated string");
+      }
+      if (next == '"') {
+        return result;
+      }
+      if (next == '\\') {
+        readEscape(result);
+      } else if (next < ' ') {
+        fail("Control character within string");
+      } else {
+        result.push_back(Traits::to_char_type(next));
+      }
+    }
+  }
+
+  uint64_t readUnsigned() {
+    if (peek() < '0' || peek() > '9') {
+      fail("Expected an unsigned integer");
+    }
+    uint64_t result = 0;
+    while (input_->sgetc() >= '0' && input_->sgetc() <= '9') {
+      auto digit = static_cast<uint64_t>(get() - '0');
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      if (result > (UINT64_MAX - digit) / 10) {
+        fail("Integer is out of range");
+      }
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      result = result * 10 + digit;
+    }
+    auto next = input_->sgetc();
+    if (next == '.' || next == 'e' || next == 'E') {
+      fail("Expected an unsigned integer");
+    }
+    return result;
+  }
+
+  bool readBool() {
+    if (peek() == 't') {
+      readLiteral("true");
+      return true;
+    }
+    readLiteral("false");
+    return false;
+  }
+
+  /**
+   * @brief Consumes null and returns true, if the next value is null
+   */
+  bool readNull() {
+    if (peek() != 'n') {
+      return false;
+    }
+    readLiteral("null");
+    return true;
+  }
+
+  void skipValue(size_t depth = 0) {
+    if (depth > MAX_SKIPPED_DEPTH) {
+      fail("Value is nested too deep");
+    }
+    switch (peek()) {
+    case '"':
+      readString();
+      break;
+    case '{':
+      readObject([this, depth](const string&) { skipValue(depth + 1); });
+      break;
+    case '[':
+      readArray([this, depth]() { skipValue(depth + 1); });
+      break;
+    case 't':
+    case 'f':
+      readBool();
+      break;
+    case 'n':
+      readNull();
+      break;
+    default:
+      skipNumber();
+    }
+  }
+
+  /**
+   * @brief Reads an object and calls member with every key. The member
+   * callback must read the value
+   */
+  template <typename Member> void readObject(Member&& member) {
+    expect('{');
+    if (peek() == '}') {
+      get();
+      return;
+    }
+    do {
+      auto key = readString();
+      expect(':');
+      member(key);
+    } while (next('}'));
+  }
+
+  /**
+   * @brief Reads an array and calls item for every value. The item callback
+   * must read the value
+   */
+  template <typename Item> void readArray(Item&& item) {
+    expect('[');
+    if (peek() == ']') {
+      get();
+      return;
+    }
+    do {
+      item();
+    } while (next(']'));
+  }
+
+  [[noreturn]] void fail(const string& reason) const {
+    throw DefinitionParseError(line_, column_, reason);
+  }
+
+private:
+  int get() {
+    auto current = input_->sbumpc();
+    if (current == '\n') {
+      ++line_;
+      column_ = 0;
+    } else {
+      ++column_;
+    }
+    return current;
+  }
+
+  /**
+   * @brief Consumes a separator and returns true, if another value follows
+   */
+  bool next(char closing) {
+    auto separator = peek();
+    if (separator == ',') {
+      get();
+      return true;
+    }
+    if (separator != closing) {
+      fail(string("Expected ',' or '") + closing + "'");
+    }
+    get();
+    return false;
+  }
+
+  void readLiteral(string_view literal) {
+    peek();
+    for (auto expected : literal) {
+      if (get() != expected) {
+        fail("Invalid literal");
+      }
+    }
+  }
+
+  void skipNumber() {
+    string_view allowed = "+-0123456789.eE";
+    if (allowed.find(Traits::to_char_type(peek())) == string_view::npos ||
+        Traits::eq_int_type(peek(), Traits::eof())) {
+      fail("Unexpected character");
+    }
+    while (!Traits::eq_int_type(input_->sgetc(), Traits::eof()) &&
+        allowed.find(Traits::to_char_type(input_->sgetc())) !=
+            string_view::npos) {
+      get();
+    }
+  }
+
+  uint32_t readHex() {
+    uint32_t result = 0;
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    for (int i = 0; i < 4; ++i) {
+      auto digit = get();
+      result <<= 4U;
+      if (digit >= '0' && digit <= '9') {
+        result |= static_cast<uint32_t>(digit - '0');
+      } else if (digit >= 'a' && digit <= 'f') {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        result |= static_cast<uint32_t>(digit - 'a' + 10);
+      } else if (digit >= 'A' && digit <= 'F') {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        result |= static_cast<uint32_t>(digit - 'A' + 10);
+      } else {
+        fail("Invalid unicode escape");
+      }
+    }
+    return result;
+  }
+
+  // NOLINTBEGIN(readability-magic-numbers)
+  void readEscape(string& result) {
+    auto escaped = get();
+    switch (escaped) {
+    case '"':
+    case '\\':
+    case '/':
+      result.push_back(Traits::to_char_type(escaped));
+      return;
+    case 'b':
+      result.push_back('\b');
+      return;
+    case 'f':
+      result.push_back('\f');
+      return;
+    case 'n':
+      result.push_back('\n');
+      return;
+    case 'r':
+      result.push_back('\r');
+      return;
+    case 't':
+      result.push_back('\t');
+      return;
+    case 'u':
+      break;
+    default:
+      fail("Invalid escape sequence");
+    }
+    auto code = readHex();
+    if (code >= 0xD800 && code <= 0xDBFF) {
+      if (get() != '\\' || get() != 'u') {
+        fail("Unpaired surrogate");
+      }
+      auto low = readHex();
+      if (low < 0xDC00 || low > 0xDFFF) {
+        fail("Unpaired surrogate");
+      }
+      code = 0x10000 + ((code - 0xD800) << 10U) + (low - 0xDC00);
+    } else if (code >= 0xDC00 && code <= 0xDFFF) {
+      fail("Unpaired surrogate");
+    }
+    auto append = [&result](uint32_t byte) {
+      result.push_back(static_cast<char>(static_cast<uint8_t>(byte)));
+    };
+    if (code < 0x80) {
+      append(code);
+    } else if (code < 0x800) {
+      append(0xC0 | (code >> 6U));
+      append(0x80 | (code & 0x3FU));
+    } else if (code < 0x10000) {
+      append(0xE0 | (code >> 12U));
+      append(0x80 | ((code >> 6U) & 0x3FU));
+      append(0x80 | (code & 0x3FU));
+    } else {
+      append(0xF0 | (code >> 18U));
+      append(0x80 | ((code >> 12U) & 0x3FU));
+      append(0x80 | ((code >> 6U) & 0x3FU));
+      append(0x80 | (code & 0x3FU));
+    }
+  }
+  // NOLINTEND(readability-magic-numbers)
+
+  streambuf* input_;
+  size_t line_ = 1;
+  size_t column_ = 0;
+};
+
+template <typename Enum, size_t Size>
+Enum enumOf(JsonReader& reader,
+    const array<pair<string_view, Enum>, Size>& names,
+    const char* kind) {
+  auto name = reader.readString();
+  for (const auto& [known, value] : names) {
+    if (known == name) {
+      return value;
+    }
+  }
+  reader.fail("Unknown " + string(kind) + " " + name);
+}
+
+uint32_t readRow(JsonReader& reader) {
+  auto row = reader.readUnsigned();
+  if (row >= DEFINITION_ROOT) {
+    reader.fail("Row index is out of range");
+  }
+  return static_cast<uint32_t>(row);
+}
+
+void readParameter(JsonReader& reader, ParameterTypes& parameter_types) {
+  optional<uintmax_t> position;
+  ParameterType type{DataType::Unknown};
+  reader.readObject([&](const string& key) {
+    if (key == "position") {
+      position = reader.readUnsigned();
+    } else if (key == "type") {
+      type.type = enumOf(reader, DATA_TYPES, "DataType");
+    } else if (key == "mandatory") {
+      type.mandatory = reader.readBool();
+    } else if (key == "allow_widening") {
+      type.allow_widening = reader.readBool();
+    } else {
+      reader.skipValue();
+    }
+  });
+  if (!position.has_value()) {
+    reader.fail("Parameter has no position");
+  }
+  if (!parameter_types.emplace(*position, type).second) {
+    reader.fail("Parameter " + to_string(*position) + " is defined twice");
+  }
+}
+
+ElementDefinition readElement(JsonReader& reader, uint32_t& next_callback) {
+  ElementDefinition element;
+  optional<uint32_t> callback;
+  reader.readObject([&](const string& key) {
+    if (key == "parent") {
+      if (!reader.readNull()) {
+        element.parent = readRow(reader);
+      }
+    } else if (key == "name") {
+      element.info.name = reader.readString();
+    } else if (key == "description") {
+      element.info.description = reader.readString();
+    } else if (key == "type") {
+      element.type = enumOf(reader, ELEMENT_TYPES, "ElementType");
+    } else if (key == "data_type") {
+      element.data_type = enumOf(reader, DATA_TYPES, "DataType");
+    } else if (key == "callback") {
+      callback = readRow(reader);
+    } else if (key == "parameters") {
+      reader.readArray(
+          [&]() { readParameter(reader, element.parameter_types); });
+    } else {
+      reader.skipValue();
+    }
+  });
+  if (element.type != ElementType::Group) {
+    element.callback = callback.value_or(next_callback);
+    ++next_callback;
+  }
+  return element;
+}
+
+void checkCallbacks(size_t row,
+    const ElementDefinition& element,
+    const ElementCallbacks& callbacks) {
+  auto require = [row](bool available, const string& name) {
+    if (!available) {
+      throw InvalidDefinition(row, name + " callback can not be null");
+    }
+  };
+  switch (element.type) {
+  case ElementType::Readable:
+    require(static_cast<bool>(callbacks.read), "Read");
+    break;
+  case ElementType::Writable:
+    require(static_cast<bool>(callbacks.write), "Write");
+    break;
+  case ElementType::Observable:
+    require(static_cast<bool>(callbacks.read), "Read");
+    require(static_cast<bool>(callbacks.observe), "Is observing");
+    break;
+  case ElementType::Callable:
+    require(static_cast<bool>(callbacks.execute), "Execute");
+    if (element.data_type != DataType::None || callbacks.async_execute ||
+        callbacks.cancel) {
+      require(static_cast<bool>(callbacks.async_execute), "Async execute");
+      require(static_cast<bool>(callbacks.cancel), "Cancel");
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * @param callbacks - callback indices are not checked, if nullptr
+ */
+void checkRows(const DeviceDefinition& definition,
+    const vector<ElementCallbacks>* callbacks) {
+  const auto& elements = definition.elements;
+  if (elements.size() >= DEFINITION_ROOT) {
+    throw InvalidDefinition("Device can not hold more elements");
+  }
+  vector<uint32_t> children(elements.size(), 0);
+  vector<bool> used(callbacks != nullptr ? callbacks->size() : 0, false);
+  size_t root_children = 0;
+  for (size_t row = 0; row < elements.size(); ++row) {
+    const auto& element = elements[row];
+    if (element.parent == DEFINITION_ROOT) {
+      ++root_children;
+    } else if (element.parent >= row) {
+      throw InvalidDefinition(row, "Parent row must precede the element");
+    } else if (elements[element.parent].type != ElementType::Group) {
+      throw InvalidDefinition(row, "Parent is not a Group");
+    } else {
+      ++children[element.parent];
+    }
+    if (element.type == ElementType::Group) {
+      continue;
+    }
+    if (element.type > ElementType::Callable) {
+      throw InvalidDefinition(row, "Unknown ElementType");
+    }
+    if (element.type == ElementType::Callable
+            ? element.data_type == DataType::Unknown
+            : !isValueType(element.data_type)) {
+      throw InvalidDefinition(
+          row, "Data type can not be " + toString(element.data_type));
+    }
+    if (callbacks == nullptr) {
+      continue;
+    }
+    if (element.callback >= callbacks->size()) {
+      throw InvalidDefinition(row, "Callback index is out of range");
+    }
+    if (used[element.callback]) {
+      throw InvalidDefinition(row, "Callback index is already used");
+    }
+    used[element.callback] = true;
+    checkCallbacks(row, element, (*callbacks)[element.callback]);
+  }
+  if (root_children == 0) {
+    throw InvalidDefinition("Root group is empty");
+  }
+  for (size_t row = 0; row < elements.size(); ++row) {
+    if (elements[row].type == ElementType::Group && children[row] == 0) {
+      throw InvalidDefinition(row, "Group is empty");
+    }
+  }
+}
+} // namespace
+
+void checkDefinition(const DeviceDefinition& definition) {
+  checkRows(definition, nullptr);
+}
+
+void checkDefinition(const DeviceDefinition& definition,
+    const vector<ElementCallbacks>& callbacks) {
+  checkRows(definition, &callbacks);
+}
+
+DeviceDefinition parseDefinition(istream& input) {
+  JsonReader reader(input);
+  DeviceDefinition definition;
+  uint32_t next_callback = 0;
+  reader.readObject([&](const string& key) {
+    if (key == "id") {
+      definition.id = reader.readString();
+    } else if (key == "name") {
+      definition.info.name = reader.readString();
+    } else if (key == "description") {
+      definition.info.description = reader.readString();
+    } else if (key == "elements") {
+      reader.readArray([&]() {
+        definition.elements.push_back(readElement(reader, next_callback));
+      });
+    } else {
+      reader.skipValue();
+    }
+  });
+  if (!reader.atEnd()) {
+    reader.fail("Unexpected content after the device definition");
+  }
+  return definition;
+}
+} // namespace Information_Model
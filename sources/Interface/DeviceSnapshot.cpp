@@ -0,0 +1,996 @@
+#include "DeviceSnapshot.hpp"
+#include "ObservableHub.hpp"
+#include "StructuralHash.hpp"
+#include "TypedElement.hpp"
+
+#include <Variant_Visitor/Visitor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Information_Model {
+using namespace std;
+
+namespace detail {
+namespace {
+// "IMSN" when read in little endian byte order
+constexpr uint32_t SNAPSHOT_MAGIC = 0x4E534D49;
+constexpr uint32_t SNAPSHOT_VERSION = 2;
+constexpr uint32_t NO_PARENT = UINT32_MAX;
+constexpr uint32_t NOT_FOUND = UINT32_MAX;
+constexpr size_t SECTION_ALIGNMENT = 8;
+constexpr uint8_t WRITE_ONLY = 1;
+
+/**
+ * @brief Position of a string within the snapshot string pool
+ */
+struct Text {
+  uint32_t offset = 0;
+  uint32_t length = 0;
+};
+
+struct HeaderRecord {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t node_count;
+  uint32_t parameter_count;
+  uint32_t text_size;
+  uint32_t reserved;
+  Text device_id;
+  Text name;
+  Text description;
+};
+
+struct NodeRecord {
+  uint8_t type;
+  uint8_t data_type;
+  uint8_t flags;
+  uint8_t reserved;
+  uint32_t parent;
+  uint32_t first_child;
+  uint32_t child_count;
+  uint32_t first_parameter;
+  uint32_t parameter_count;
+  Text id;
+  Text name;
+  Text description;
+  /**
+   * @brief Structural hash of the element and all of its nested elements
+   */
+  uint64_t hash;
+};
+
+struct ParameterRecord {
+  uint64_t position;
+  uint8_t data_type;
+  uint8_t mandatory;
+  uint8_t allow_widening;
+  array<uint8_t, 5> reserved;
+};
+
+static_assert(is_trivially_copyable_v<HeaderRecord> &&
+    is_trivially_copyable_v<NodeRecord> &&
+    is_trivially_copyable_v<ParameterRecord>);
+static_assert(sizeof(NodeRecord) % SECTION_ALIGNMENT == 0 &&
+    sizeof(ParameterRecord) % SECTION_ALIGNMENT == 0);
+
+size_t aligned(size_t size) {
+  return (size + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Section offsets of a snapshot. The id index holds the node indices
+ * of all elements, except the root group, sorted by their ids
+ */
+struct Layout {
+  explicit Layout(const HeaderRecord& header)
+      : nodes(aligned(sizeof(HeaderRecord))),
+        index(nodes + size_t{header.node_count} * sizeof(NodeRecord)),
+        parameters(aligned(index +
+            size_t{header.node_count - 1} * sizeof(uint32_t))),
+        text(parameters +
+            size_t{header.parameter_count} * sizeof(ParameterRecord)),
+        total(text + header.text_size) {}
+
+  size_t nodes;
+  size_t index;
+  size_t parameters;
+  size_t text;
+  size_t total;
+};
+
+template <typename T> T load(const byte* data, size_t offset) {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+HeaderRecord loadHeader(const byte* data, size_t size) {
+  if (data == nullptr || size < sizeof(HeaderRecord)) {
+    throw SnapshotFormatError("Header is truncated");
+  }
+  auto header = load<HeaderRecord>(data, 0);
+  if (header.magic != SNAPSHOT_MAGIC) {
+    throw SnapshotFormatError("Unknown format or byte order");
+  }
+  if (header.version != SNAPSHOT_VERSION) {
+    throw SnapshotFormatError(
+        "Version " + to_string(header.version) + " is not supported");
+  }
+  if (header.node_count == 0) {
+    throw SnapshotFormatError("Root group is missing");
+  }
+  if (Layout(header).total > size) {
+    throw SnapshotFormatError("Sections are truncated");
+  }
+  return header;
+}
+
+/**
+ * @brief Bounds checked accessors of snapshot data
+ */
+struct SnapshotView {
+  SnapshotView(const byte* data, size_t size)
+      : data_(data), header_(loadHeader(data, size)), layout_(header_) {}
+
+  const HeaderRecord& header() const { return header_; }
+
+  string_view view(Text text) const {
+    if (uint64_t{text.offset} + text.length > header_.text_size) {
+      throw SnapshotFormatError("String is out of bounds");
+    }
+    return string_view(
+        reinterpret_cast<const char*>(data_ + layout_.text) + text.offset,
+        text.length);
+  }
+
+  NodeRecord node(uint32_t index) const {
+    if (index >= header_.node_count) {
+      throw SnapshotFormatError(
+          "Element " + to_string(index) + " is out of bounds");
+    }
+    auto node = load<NodeRecord>(
+        data_, layout_.nodes + size_t{index} * sizeof(NodeRecord));
+    if (node.type > static_cast<uint8_t>(ElementType::Callable) ||
+        node.data_type >= data_type_count ||
+        (index != 0 && node.parent >= header_.node_count) ||
+        uint64_t{node.first_child} + node.child_count > header_.node_count ||
+        uint64_t{node.first_parameter} + node.parameter_count >
+            header_.parameter_count) {
+      throw SnapshotFormatError(
+          "Element " + to_string(index) + " is damaged");
+    }
+    return node;
+  }
+
+  ParameterTypes parameterTypes(const NodeRecord& node) const {
+    ParameterTypes result;
+    result.reserve(node.parameter_count);
+    for (uint32_t i = 0; i < node.parameter_count; ++i) {
+      auto parameter = load<ParameterRecord>(data_,
+          layout_.parameters +
+              size_t{node.first_parameter + i} * sizeof(ParameterRecord));
+      if (parameter.data_type >= data_type_count) {
+        throw SnapshotFormatError(
+            "Parameter " + to_string(node.first_parameter + i) +
+            " is damaged");
+      }
+      result.emplace(parameter.position,
+          ParameterType{static_cast<DataType>(parameter.data_type),
+              parameter.mandatory != 0,
+              parameter.allow_widening != 0});
+    }
+    return result;
+  }
+
+  /**
+   * @brief Binary searches the id index
+   *
+   * @return uint32_t - NOT_FOUND if no element has the given id
+   */
+  uint32_t find(string_view ref_id) const {
+    size_t first = 0;
+    size_t count = header_.node_count - 1;
+    while (count > 0) {
+      auto step = count / 2;
+      auto entry = indexEntry(first + step);
+      if (idOf(entry) < ref_id) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    if (first < header_.node_count - 1) {
+      auto entry = indexEntry(first);
+      if (idOf(entry) == ref_id) {
+        return entry;
+      }
+    }
+    return NOT_FOUND;
+  }
+
+private:
+  uint32_t indexEntry(size_t position) const {
+    auto entry = load<uint32_t>(
+        data_, layout_.index + position * sizeof(uint32_t));
+    if (entry == 0 || entry >= header_.node_count) {
+      throw SnapshotFormatError("Id index is damaged");
+    }
+    return entry;
+  }
+
+  string_view idOf(uint32_t index) const {
+    return view(load<Text>(data_,
+        layout_.nodes + size_t{index} * sizeof(NodeRecord) +
+            offsetof(NodeRecord, id)));
+  }
+
+  const byte* data_;
+  HeaderRecord header_;
+  Layout layout_;
+};
+
+struct SnapshotWriter {
+  Text append(const string& value) {
+    if (text.size() + value.size() > UINT32_MAX) {
+      throw length_error("Device string pool exceeds 4 GiB");
+    }
+    Text result{static_cast<uint32_t>(text.size()),
+        static_cast<uint32_t>(value.size())};
+    text += value;
+    return result;
+  }
+
+  string_view view(Text value) const {
+    return string_view(text.data() + value.offset, value.length);
+  }
+
+  NodeRecord record(const Element& element, uint32_t parent) {
+    NodeRecord node{};
+    node.type = static_cast<uint8_t>(element.type());
+    node.parent = parent;
+    node.id = append(element.id());
+    node.name = append(element.name());
+    node.description = append(element.description());
+    Variant_Visitor::match(
+        element.function(),
+        [](const GroupPtr&) {},
+        [&node](const ReadablePtr& readable) {
+          node.data_type = static_cast<uint8_t>(readable->dataType());
+        },
+        [&node](const WritablePtr& writable) {
+          node.data_type = static_cast<uint8_t>(writable->dataType());
+          node.flags = writable->isWriteOnly() ? WRITE_ONLY : 0;
+        },
+        [&node](const ObservablePtr& observable) {
+          node.data_type = static_cast<uint8_t>(observable->dataType());
+        },
+        [this, &node](const CallablePtr& callable) {
+          node.data_type = static_cast<uint8_t>(callable->resultType());
+          addParameters(node, callable->parameterTypes());
+        });
+    // nested elements are combined once the whole device is recorded
+    node.hash = ownStructureHash(element);
+    return node;
+  }
+
+  void addParameters(NodeRecord& node, const ParameterTypes& types) {
+    if (parameters.size() + types.size() > UINT32_MAX) {
+      throw length_error("Device can not hold more parameters");
+    }
+    node.first_parameter = static_cast<uint32_t>(parameters.size());
+    node.parameter_count = static_cast<uint32_t>(types.size());
+    for (const auto& [position, type] : types) {
+      ParameterRecord parameter{};
+      parameter.position = position;
+      parameter.data_type = static_cast<uint8_t>(type.type);
+      parameter.mandatory = type.mandatory ? 1 : 0;
+      parameter.allow_widening = type.allow_widening ? 1 : 0;
+      parameters.push_back(parameter);
+    }
+    // sorted positions keep snapshots of equal devices byte identical
+    sort(parameters.begin() + node.first_parameter,
+        parameters.end(),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.position < rhs.position;
+        });
+  }
+
+  vector<NodeRecord> nodes;
+  vector<ParameterRecord> parameters;
+  string text;
+};
+
+template <typename Callback>
+void checkCallback(const Callback& callback,
+    const string& name,
+    const SnapshotElement& element) {
+  if (!callback) {
+    throw invalid_argument(name + " callback of element " +
+        string(element.id) + " can not be null");
+  }
+}
+
+struct SnapshotModel;
+
+struct SnapshotNode : public Element {
+  SnapshotNode(const SnapshotModel* model,
+      uint32_t index,
+      const NodeRecord& record)
+      : model_(model), index_(index), record_(record) {}
+
+  string id() const final;
+
+  string name() const final;
+
+  string description() const final;
+
+  ElementType type() const final {
+    return static_cast<ElementType>(record_.type);
+  }
+
+  size_t structuralHash() const final {
+    return static_cast<size_t>(record_.hash);
+  }
+
+  uint32_t index() const { return index_; }
+
+  const NodeRecord& record() const { return record_; }
+
+protected:
+  const SnapshotModel* model_;
+  uint32_t index_;
+  NodeRecord record_;
+};
+
+struct SnapshotGroup;
+
+struct SnapshotModel : public enable_shared_from_this<SnapshotModel> {
+  SnapshotModel(shared_ptr<const byte> data,
+      size_t size,
+      CallbackResolver&& resolver)
+      : data_(move(data)), view_(data_.get(), size),
+        resolver_(move(resolver)) {}
+
+  const SnapshotView& view() const { return view_; }
+
+  string toString(Text text) const { return string(view_.view(text)); }
+
+  SnapshotGroup& root() const { return *root_; }
+
+  bool contains(uint32_t group, uint32_t index) const;
+
+  /**
+   * @brief Materializes all groups on the path to a given element
+   */
+  ElementPtr element(uint32_t index) const;
+
+  /**
+   * @brief Creates a single element and binds its callbacks
+   */
+  unique_ptr<SnapshotNode> materialize(uint32_t index, uint32_t parent) const;
+
+  template <typename T> shared_ptr<T> share(T* node) const {
+    return shared_ptr<T>(shared_from_this(), node);
+  }
+
+  shared_ptr<const byte> data_;
+  SnapshotView view_;
+  CallbackResolver resolver_;
+  unique_ptr<SnapshotGroup> root_;
+};
+
+string SnapshotNode::id() const { return model_->toString(record_.id); }
+
+string SnapshotNode::name() const { return model_->toString(record_.name); }
+
+string SnapshotNode::description() const {
+  return model_->toString(record_.description);
+}
+
+struct SnapshotGroup final : public SnapshotNode, public Group {
+  using SnapshotNode::SnapshotNode;
+
+  ElementFunction function() const final {
+    return model_->share<Group>(const_cast<SnapshotGroup*>(this));
+  }
+
+  size_t size() const final { return record_.child_count; }
+
+  /**
+   * @brief Keys are the element ids without the id of this group and the
+   * following separator, if the element ids start with it
+   */
+  unordered_map<string, ElementPtr> asMap() const final {
+    const auto& header = model_->view().header();
+    auto prefix = index_ == 0 ? model_->toString(header.device_id) : id();
+    const auto& nodes = children();
+    auto owner = model_->shared_from_this();
+    unordered_map<string, ElementPtr> result;
+    result.reserve(nodes.size());
+    for (const auto& node : nodes) {
+      auto key = node->id();
+      if (key.size() > prefix.size() &&
+          key.compare(0, prefix.size(), prefix) == 0) {
+        auto separator = key[prefix.size()] == '.' || key[prefix.size()] == ':';
+        key.erase(0, prefix.size() + (separator ? 1 : 0));
+      }
+      result.emplace(move(key), ElementPtr(owner, node.get()));
+    }
+    return result;
+  }
+
+  vector<ElementPtr> asVector() const final {
+    const auto& nodes = children();
+    auto owner = model_->shared_from_this();
+    vector<ElementPtr> result;
+    result.reserve(nodes.size());
+    for (const auto& node : nodes) {
+      result.emplace_back(owner, node.get());
+    }
+    return result;
+  }
+
+  ElementPtr element(const string& ref_id) const final {
+    return tryElement(ref_id).value();
+  }
+
+  Expected<ElementPtr> tryElement(const string& ref_id) const {
+    try {
+      auto index = model_->view().find(ref_id);
+      if (index == index_) {
+        return Error(ErrorCode::ID_Points_This_Group, ref_id);
+      }
+      if (index != NOT_FOUND && model_->contains(index_, index)) {
+        return model_->element(index);
+      }
+    } catch (...) {
+      return toError(current_exception());
+    }
+    return Error(ErrorCode::Element_Not_Found, ref_id);
+  }
+
+  void visit(const Visitor& visitor) const final {
+    const auto& nodes = children();
+    auto owner = model_->shared_from_this();
+    for (const auto& node : nodes) {
+      visitor(ElementPtr(owner, node.get()));
+    }
+  }
+
+  const SnapshotNode& child(uint32_t index) const {
+    auto position = index - record_.first_child;
+    if (index < record_.first_child || position >= record_.child_count) {
+      throw SnapshotFormatError(
+          "Element " + to_string(index) + " is not a child of its parent");
+    }
+    return *children()[position];
+  }
+
+private:
+  const vector<unique_ptr<SnapshotNode>>& children() const {
+    if (!materialized_.load(memory_order_acquire)) {
+      lock_guard lock(mx_);
+      children_.reserve(record_.child_count);
+      // children, that were materialized before a failed resolver call, are
+      // kept, so the resolver is still called only once per element
+      while (children_.size() < record_.child_count) {
+        auto position = static_cast<uint32_t>(children_.size());
+        children_.push_back(
+            model_->materialize(record_.first_child + position, index_));
+      }
+      materialized_.store(true, memory_order_release);
+    }
+    return children_;
+  }
+
+  mutable mutex mx_;
+  mutable atomic<bool> materialized_{false};
+  mutable vector<unique_ptr<SnapshotNode>> children_;
+};
+
+struct SnapshotReadable final : public SnapshotNode, public Readable {
+  SnapshotReadable(const SnapshotModel* model,
+      uint32_t index,
+      const NodeRecord& record,
+      ElementCallbacks&& callbacks)
+      : SnapshotNode(model, index, record), read_(move(callbacks.read)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Readable>(const_cast<SnapshotReadable*>(this));
+  }
+
+  DataType dataType() const final {
+    return static_cast<DataType>(record_.data_type);
+  }
+
+  DataVariant read() const final { return read_(); }
+
+  Expected<DataVariant> tryRead() const final {
+    try {
+      return read_();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+};
+
+struct SnapshotWritable final : public SnapshotNode, public Writable {
+  SnapshotWritable(const SnapshotModel* model,
+      uint32_t index,
+      const NodeRecord& record,
+      ElementCallbacks&& callbacks)
+      : SnapshotNode(model, index, record), read_(move(callbacks.read)),
+        write_(move(callbacks.write)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Writable>(const_cast<SnapshotWritable*>(this));
+  }
+
+  DataType dataType() const final {
+    return static_cast<DataType>(record_.data_type);
+  }
+
+  DataVariant read() const final {
+    if (!read_) {
+      throw NonReadable();
+    }
+    return read_();
+  }
+
+  bool isWriteOnly() const final { return (record_.flags & WRITE_ONLY) != 0; }
+
+  void write(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != dataType()) {
+      throw DataTypeMismatch(id(), dataType(), value_type);
+    }
+    write_(value);
+  }
+
+  Expected<DataVariant> tryRead() const final {
+    if (!read_) {
+      return Error(ErrorCode::Non_Readable);
+    }
+    try {
+      return read_();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+  Expected<void> tryWrite(const DataVariant& value) const final {
+    auto value_type = toDataType(value);
+    if (value_type != dataType()) {
+      return Error(
+          ErrorCode::Data_Type_Mismatch, id(), 0, dataType(), value_type);
+    }
+    try {
+      write_(value);
+      return {};
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+  DeviceBuilder::InlineWriteCallback write_;
+};
+
+struct SnapshotObservable final : public SnapshotNode, public Observable {
+  SnapshotObservable(const SnapshotModel* model,
+      uint32_t index,
+      const NodeRecord& record,
+      ElementCallbacks&& callbacks,
+      shared_ptr<ObservableHub> hub)
+      : SnapshotNode(model, index, record), read_(move(callbacks.read)),
+        hub_(move(hub)) {
+    hub_->bind(move(callbacks.observe));
+  }
+
+  ElementFunction function() const final {
+    return model_->share<Observable>(const_cast<SnapshotObservable*>(this));
+  }
+
+  DataType dataType() const final {
+    return static_cast<DataType>(record_.data_type);
+  }
+
+  DataVariant read() const final { return read_(); }
+
+  ObserverPtr subscribe(const ObserveCallback& observe_cb,
+      const ExceptionHandler& handler) final {
+    return hub_->subscribe(observe_cb, handler);
+  }
+
+private:
+  DeviceBuilder::InlineReadCallback read_;
+  shared_ptr<ObservableHub> hub_;
+};
+
+struct SnapshotCallable final : public SnapshotNode, public Callable {
+  SnapshotCallable(const SnapshotModel* model,
+      uint32_t index,
+      const NodeRecord& record,
+      ElementCallbacks&& callbacks)
+      : SnapshotNode(model, index, record),
+        execute_(move(callbacks.execute)),
+        async_execute_(move(callbacks.async_execute)),
+        cancel_(move(callbacks.cancel)),
+        parameter_types_(model->view().parameterTypes(record)) {}
+
+  ElementFunction function() const final {
+    return model_->share<Callable>(const_cast<SnapshotCallable*>(this));
+  }
+
+  void execute(const Parameters& parameters) const final {
+    checkParameters(parameters, parameter_types_);
+    execute_(parameters);
+  }
+
+  DataVariant call(uintmax_t timeout) const final {
+    return call(Parameters(), timeout);
+  }
+
+  DataVariant call(
+      const Parameters& parameters, uintmax_t timeout) const final {
+    return tryCall(parameters, timeout).value();
+  }
+
+  Expected<DataVariant> tryCall(
+      const Parameters& parameters, uintmax_t timeout) const final {
+    if (!async_execute_) {
+      return Error(ErrorCode::Result_Returning_Not_Supported);
+    }
+    auto checked = tryCheckParameters(parameters, parameter_types_);
+    if (!checked) {
+      return checked.error();
+    }
+    try {
+      auto result = async_execute_(parameters);
+      auto wait = chrono::milliseconds(static_cast<chrono::milliseconds::rep>(
+          min<uintmax_t>(timeout, INT32_MAX)));
+      if (result.waitFor(wait) != future_status::ready) {
+        cancel_(result.id());
+        return Error(ErrorCode::Call_Timedout, name());
+      }
+      return result.get();
+    } catch (...) {
+      return toError(current_exception());
+    }
+  }
+
+  ResultFuture asyncCall(const Parameters& parameters) const final {
+    if (!async_execute_) {
+      throw ResultReturningNotSupported();
+    }
+    checkParameters(parameters, parameter_types_);
+    return async_execute_(parameters);
+  }
+
+  void cancelAsyncCall(uintmax_t call_id) const final {
+    if (!cancel_) {
+      throw ResultReturningNotSupported();
+    }
+    cancel_(call_id);
+  }
+
+  DataType resultType() const final {
+    return static_cast<DataType>(record_.data_type);
+  }
+
+  ParameterTypes parameterTypes() const final { return parameter_types_; }
+
+private:
+  DeviceBuilder::InlineExecuteCallback execute_;
+  DeviceBuilder::InlineAsyncExecuteCallback async_execute_;
+  DeviceBuilder::InlineCancelCallback cancel_;
+  ParameterTypes parameter_types_;
+};
+
+bool SnapshotModel::contains(uint32_t group, uint32_t index) const {
+  // a valid path is never longer than the number of elements
+  for (uint32_t depth = 0; depth < view_.header().node_count; ++depth) {
+    index = view_.node(index).parent;
+    if (index == group) {
+      return true;
+    }
+    if (index == 0) {
+      return false;
+    }
+  }
+  throw SnapshotFormatError("Element parents form a cycle");
+}
+
+ElementPtr SnapshotModel::element(uint32_t index) const {
+  vector<uint32_t> path;
+  for (auto current = index; current != 0;
+       current = view_.node(current).parent) {
+    if (path.size() >= view_.header().node_count) {
+      throw SnapshotFormatError("Element parents form a cycle");
+    }
+    path.push_back(current);
+  }
+  const SnapshotNode* node = root_.get();
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    if (node->type() != ElementType::Group) {
+      throw SnapshotFormatError(
+          "Element " + to_string(*it) + " has no parent group");
+    }
+    node = &static_cast<const SnapshotGroup*>(node)->child(*it);
+  }
+  return share<Element>(const_cast<SnapshotNode*>(node));
+}
+
+unique_ptr<SnapshotNode> SnapshotModel::materialize(
+    uint32_t index, uint32_t parent) const {
+  auto record = view_.node(index);
+  if (record.parent != parent || index == 0) {
+    throw SnapshotFormatError(
+        "Element " + to_string(index) + " is not a child of its parent");
+  }
+  auto type = static_cast<ElementType>(record.type);
+  if (type == ElementType::Group) {
+    return make_unique<SnapshotGroup>(this, index, record);
+  }
+  SnapshotElement element{view_.view(record.id),
+      type,
+      static_cast<DataType>(record.data_type),
+      (record.flags & WRITE_ONLY) != 0};
+  shared_ptr<ObservableHub> hub;
+  DeviceBuilder::InlineNotifyCallback notify;
+  if (type == ElementType::Observable) {
+    hub = make_shared<ObservableHub>(nullptr);
+    notify = Notifier{hub};
+  }
+  auto callbacks = resolver_(element, move(notify));
+  switch (type) {
+  case ElementType::Readable:
+    checkCallback(callbacks.read, "Read", element);
+    return make_unique<SnapshotReadable>(this, index, record, move(callbacks));
+  case ElementType::Writable:
+    checkCallback(callbacks.write, "Write", element);
+    return make_unique<SnapshotWritable>(this, index, record, move(callbacks));
+  case ElementType::Observable:
+    checkCallback(callbacks.read, "Read", element);
+    checkCallback(callbacks.observe, "Is observing", element);
+    return make_unique<SnapshotObservable>(
+        this, index, record, move(callbacks), move(hub));
+  case ElementType::Callable:
+    checkCallback(callbacks.execute, "Execute", element);
+    if (element.data_type != DataType::None) {
+      checkCallback(callbacks.async_execute, "Async execute", element);
+      checkCallback(callbacks.cancel, "Cancel", element);
+    }
+    return make_unique<SnapshotCallable>(this, index, record, move(callbacks));
+  default:
+    throw logic_error("Could not decode ElementType enum value");
+  }
+}
+
+struct SnapshotDevice final : public Device {
+  explicit SnapshotDevice(shared_ptr<const SnapshotModel> model)
+      : model_(move(model)) {}
+
+  string id() const final {
+    return model_->toString(model_->view().header().device_id);
+  }
+
+  string name() const final {
+    return model_->toString(model_->view().header().name);
+  }
+
+  string description() const final {
+    return model_->toString(model_->view().header().description);
+  }
+
+  GroupPtr group() const final { return model_->share<Group>(&model_->root()); }
+
+  size_t size() const final { return model_->root().size(); }
+
+  ElementPtr element(const string& ref_id) const final {
+    return model_->root().element(ref_id);
+  }
+
+  Expected<ElementPtr> tryElement(const string& ref_id) const final {
+    return model_->root().tryElement(ref_id);
+  }
+
+  void visit(const Group::Visitor& visitor) const final {
+    model_->root().visit(visitor);
+  }
+
+  size_t structuralHash() const final {
+    return model_->root().structuralHash();
+  }
+
+private:
+  shared_ptr<const SnapshotModel> model_;
+};
+} // namespace
+} // namespace detail
+
+vector<byte> writeSnapshot(const Device& device) {
+  detail::SnapshotWriter writer;
+  detail::HeaderRecord header{};
+  header.magic = detail::SNAPSHOT_MAGIC;
+  header.version = detail::SNAPSHOT_VERSION;
+  header.device_id = writer.append(device.id());
+  header.name = writer.append(device.name());
+  header.description = writer.append(device.description());
+  detail::NodeRecord root{};
+  root.type = static_cast<uint8_t>(ElementType::Group);
+  root.parent = detail::NO_PARENT;
+  root.name = header.name;
+  root.description = header.description;
+  root.hash = ownStructureHash(device.id() + ":",
+      device.name(),
+      device.description(),
+      ElementType::Group,
+      DataType::None,
+      false,
+      {});
+  writer.nodes.push_back(root);
+
+  // breadth first order keeps the children of every group contiguous
+  vector<pair<GroupPtr, uint32_t>> groups{{device.group(), 0}};
+  for (size_t next = 0; next < groups.size(); ++next) {
+    auto group = move(groups[next].first);
+    auto index = groups[next].second;
+    auto children = group->asVector();
+    if (writer.nodes.size() + children.size() >= detail::NO_PARENT) {
+      throw length_error("Device can not hold more elements");
+    }
+    writer.nodes[index].first_child =
+        static_cast<uint32_t>(writer.nodes.size());
+    writer.nodes[index].child_count = static_cast<uint32_t>(children.size());
+    for (const auto& child : children) {
+      auto child_index = static_cast<uint32_t>(writer.nodes.size());
+      writer.nodes.push_back(writer.record(*child, index));
+      if (child->type() == ElementType::Group) {
+        groups.emplace_back(get<GroupPtr>(child->function()), child_index);
+      }
+    }
+  }
+  // children are always recorded after their groups
+  for (auto it = writer.nodes.rbegin(); it != writer.nodes.rend(); ++it) {
+    auto hash = static_cast<size_t>(it->hash);
+    for (uint32_t child = 0; child < it->child_count; ++child) {
+      const auto& nested = writer.nodes[it->first_child + child];
+      hash = combineStructureHash(hash, static_cast<size_t>(nested.hash));
+    }
+    it->hash = hash;
+  }
+
+  vector<uint32_t> index(writer.nodes.size() - 1);
+  for (uint32_t i = 0; i < index.size(); ++i) {
+    index[i] = i + 1;
+  }
+  sort(index.begin(), index.end(), [&writer](uint32_t lhs, uint32_t rhs) {
+    return writer.view(writer.nodes[lhs].id) <
+        writer.view(writer.nodes[rhs].id);
+  });
+
+  header.node_count = static_cast<uint32_t>(writer.nodes.size());
+  header.parameter_count = static_cast<uint32_t>(writer.parameters.size());
+  header.text_size = static_cast<uint32_t>(writer.text.size());
+  detail::Layout layout(header);
+  vector<byte> buffer(layout.total);
+  memcpy(buffer.data(), &header, sizeof(header));
+  memcpy(buffer.data() + layout.nodes,
+      writer.nodes.data(),
+      writer.nodes.size() * sizeof(detail::NodeRecord));
+  memcpy(buffer.data() + layout.index,
+      index.data(),
+      index.size() * sizeof(uint32_t));
+  memcpy(buffer.data() + layout.parameters,
+      writer.parameters.data(),
+      writer.parameters.size() * sizeof(detail::ParameterRecord));
+  memcpy(buffer.data() + layout.text, writer.text.data(), writer.text.size());
+  return buffer;
+}
+
+void saveSnapshot(const Device& device, const string& path) {
+  auto buffer = writeSnapshot(device);
+  ofstream file(path, ios::binary | ios::trunc);
+  file.write(reinterpret_cast<const char*>(buffer.data()),
+      static_cast<streamsize>(buffer.size()));
+  if (!file) {
+    throw runtime_error("Could not write device snapshot to " + path);
+  }
+}
+
+DeviceSnapshot::DeviceSnapshot(vector<byte> buffer) {
+  auto owner = make_shared<vector<byte>>(move(buffer));
+  data_ = shared_ptr<const byte>(owner, owner->data());
+  size_ = owner->size();
+  detail::loadHeader(data_.get(), size_);
+}
+
+DeviceSnapshot::DeviceSnapshot(shared_ptr<const byte> data, size_t size)
+    : data_(move(data)), size_(size) {
+  detail::loadHeader(data_.get(), size_);
+}
+
+DeviceSnapshot DeviceSnapshot::map(const string& path) {
+#ifdef _WIN32
+  ifstream file(path, ios::binary | ios::ate);
+  if (!file) {
+    throw runtime_error("Could not open device snapshot " + path);
+  }
+  vector<byte> buffer(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(buffer.data()),
+      static_cast<streamsize>(buffer.size()));
+  if (!file) {
+    throw runtime_error("Could not read device snapshot " + path);
+  }
+  return DeviceSnapshot(move(buffer));
+#else
+  auto descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    throw runtime_error("Could not open device snapshot " + path);
+  }
+  struct stat info {};
+  if (::fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+    ::close(descriptor);
+    throw SnapshotFormatError(path + " is empty or not a regular file");
+  }
+  auto size = static_cast<size_t>(info.st_size);
+  auto* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+  ::close(descriptor);
+  if (address == MAP_FAILED) {
+    throw runtime_error("Could not map device snapshot " + path);
+  }
+  shared_ptr<const byte> data(
+      static_cast<const byte*>(address), [size](const byte* mapped) {
+        ::munmap(const_cast<byte*>(mapped), size);
+      });
+  return DeviceSnapshot(move(data), size);
+#endif
+}
+
+string DeviceSnapshot::deviceId() const {
+  detail::SnapshotView view(data_.get(), size_);
+  return string(view.view(view.header().device_id));
+}
+
+size_t DeviceSnapshot::elementCount() const {
+  detail::SnapshotView view(data_.get(), size_);
+  return view.header().node_count - 1;
+}
+
+unique_ptr<Device> DeviceSnapshot::rehydrate(CallbackResolver resolver) const {
+  if (!resolver) {
+    throw invalid_argument("Callback resolver can not be null");
+  }
+  auto model =
+      make_shared<detail::SnapshotModel>(data_, size_, move(resolver));
+  auto root = model->view().node(0);
+  if (root.type != static_cast<uint8_t>(ElementType::Group)) {
+    throw SnapshotFormatError("Root element is not a group");
+  }
+  model->root_ = make_unique<detail::SnapshotGroup>(model.get(), 0, root);
+  return make_unique<detail::SnapshotDevice>(move(model));
+}
+} // namespace Information_Model
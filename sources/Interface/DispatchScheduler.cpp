@@ -0,0 +1,373 @@
+#include "DispatchScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+void checkPolicy(const DeviceDispatchPolicy& policy) {
+  if (policy.rate < 0.0) {
+    throw invalid_argument("Dispatch rate can not be negative");
+  }
+  if (policy.burst < 1.0) {
+    throw invalid_argument("Dispatch burst must allow at least 1 operation");
+  }
+  if (policy.max_in_flight == 0) {
+    throw invalid_argument("Dispatch policy must allow in flight operations");
+  }
+}
+
+size_t indexOf(DispatchPriority priority) {
+  auto index = static_cast<size_t>(priority);
+  if (index >= DISPATCH_PRIORITIES) {
+    throw invalid_argument("Unknown dispatch priority");
+  }
+  return index;
+}
+} // namespace
+
+string toString(DispatchPriority priority) {
+  switch (priority) {
+  case DispatchPriority::Critical:
+    return "Critical";
+  case DispatchPriority::High:
+    return "High";
+  case DispatchPriority::Normal:
+    return "Normal";
+  case DispatchPriority::Bulk:
+    return "Bulk";
+  default:
+    return "Unknown";
+  }
+}
+
+void LatencyHistogram::record(Duration latency) {
+  latency = std::max(latency, Duration{0});
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  auto micros = static_cast<uint64_t>(latency.count() / 1000);
+  size_t bucket = 0;
+  while (micros != 0 && bucket < BUCKETS - 1) {
+    micros >>= 1U;
+    ++bucket;
+  }
+  ++buckets_[bucket];
+  ++count_;
+  total_ += latency;
+  max_ = std::max(max_, latency);
+}
+
+LatencyHistogram::Duration LatencyHistogram::mean() const {
+  return count_ == 0 ? Duration{0} : total_ / static_cast<int64_t>(count_);
+}
+
+LatencyHistogram::Duration LatencyHistogram::percentile(
+    double quantile) const {
+  if (count_ == 0) {
+    return Duration{0};
+  }
+  auto target = static_cast<size_t>(
+      ceil(clamp(quantile, 0.0, 1.0) * static_cast<double>(count_)));
+  target = std::max<size_t>(target, 1);
+  size_t seen = 0;
+  for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+    seen += buckets_[bucket];
+    if (seen >= target) {
+      return bucket == BUCKETS - 1 ? max_ : upperBound(bucket);
+    }
+  }
+  return max_;
+}
+
+LatencyHistogram::Duration LatencyHistogram::upperBound(size_t bucket) {
+  return chrono::microseconds(int64_t{1} << min(bucket, BUCKETS - 1));
+}
+
+template <typename Function>
+invoke_result_t<Function> DispatchScheduler::await(
+    const string& device_id, DispatchPriority priority, Function&& function) {
+  using Result = invoke_result_t<Function>;
+  // discarded operations destroy the task, which fails the future
+  auto task =
+      make_shared<packaged_task<Result()>>(forward<Function>(function));
+  auto result = task->get_future();
+  enqueue(device_id, priority, [task]() { (*task)(); }, false, true);
+  return result.get();
+}
+
+DispatchScheduler::DispatchScheduler(
+    size_t workers, const DeviceDispatchPolicy& default_policy)
+    : worker_count_(workers), default_policy_(default_policy) {
+  if (worker_count_ == 0) {
+    throw invalid_argument("Dispatch scheduler needs at least one worker");
+  }
+  checkPolicy(default_policy_);
+}
+
+DispatchScheduler::~DispatchScheduler() { stop(); }
+
+void DispatchScheduler::setPolicy(
+    const string& device_id, const DeviceDispatchPolicy& policy) {
+  checkPolicy(policy);
+  {
+    lock_guard lock(mx_);
+    auto& device = deviceOf(device_id);
+    device.policy = policy;
+    device.tokens = min(device.tokens, policy.burst);
+    relist(device, Clock::now());
+  }
+  work_.notify_all();
+}
+
+void DispatchScheduler::dispatch(
+    const string& device_id, DispatchPriority priority, Task task) {
+  if (!task) {
+    throw invalid_argument("Dispatched task can not be null");
+  }
+  enqueue(device_id, priority, move(task), true);
+}
+
+DeviceBuilder::ReadCallback DispatchScheduler::routeRead(
+    const string& device_id,
+    DispatchPriority priority,
+    const DeviceBuilder::ReadCallback& callback) {
+  if (!callback) {
+    throw invalid_argument("Routed read callback can not be null");
+  }
+  return [this, device_id, priority, callback]() {
+    return await(device_id, priority, [&callback]() { return callback(); });
+  };
+}
+
+DeviceBuilder::WriteCallback DispatchScheduler::routeWrite(
+    const string& device_id,
+    DispatchPriority priority,
+    const DeviceBuilder::WriteCallback& callback) {
+  if (!callback) {
+    throw invalid_argument("Routed write callback can not be null");
+  }
+  return [this, device_id, priority, callback](const DataVariant& value) {
+    // the caller waits, so the value can be captured by reference
+    await(device_id, priority, [&callback, &value]() { callback(value); });
+  };
+}
+
+DeviceBuilder::ExecuteCallback DispatchScheduler::routeExecute(
+    const string& device_id,
+    DispatchPriority priority,
+    const DeviceBuilder::ExecuteCallback& callback) {
+  if (!callback) {
+    throw invalid_argument("Routed execute callback can not be null");
+  }
+  return [this, device_id, priority, callback](const Parameters& parameters) {
+    dispatch(device_id, priority, [callback, parameters]() {
+      callback(parameters);
+    });
+  };
+}
+
+DeviceBuilder::AsyncExecuteCallback DispatchScheduler::routeAsyncExecute(
+    const string& device_id,
+    DispatchPriority priority,
+    const DeviceBuilder::AsyncExecuteCallback& callback) {
+  if (!callback) {
+    throw invalid_argument("Routed async execute callback can not be null");
+  }
+  return [this, device_id, priority, callback](const Parameters& parameters) {
+    return await(device_id,
+        priority,
+        [&callback, &parameters]() { return callback(parameters); });
+  };
+}
+
+void DispatchScheduler::start() {
+  lock_guard lock(mx_);
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  for (size_t i = 0; i < worker_count_; ++i) {
+    workers_.emplace_back(&DispatchScheduler::workerLoop, this);
+  }
+}
+
+void DispatchScheduler::stop() {
+  {
+    lock_guard lock(mx_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  work_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+
+  lock_guard lock(mx_);
+  for (auto& [device_id, device] : devices_) {
+    for (auto& lane : device.lanes) {
+      lane.clear();
+    }
+    ++device.ticket;
+  }
+  for (auto& ready : ready_) {
+    ready.clear();
+  }
+  throttled_ = decltype(throttled_)();
+  queued_ = 0;
+}
+
+size_t DispatchScheduler::queued() const {
+  lock_guard lock(mx_);
+  return queued_;
+}
+
+LatencyHistogram DispatchScheduler::queueLatency(
+    DispatchPriority priority) const {
+  auto index = indexOf(priority);
+  lock_guard lock(mx_);
+  return latency_[index];
+}
+
+DispatchStatistics DispatchScheduler::statistics() const {
+  lock_guard lock(mx_);
+  return statistics_;
+}
+
+void DispatchScheduler::enqueue(const string& device_id,
+    DispatchPriority priority,
+    Task task,
+    bool detached,
+    bool running_only) {
+  auto index = indexOf(priority);
+  {
+    lock_guard lock(mx_);
+    if (running_only && !running_) {
+      throw DispatchSchedulerStopped();
+    }
+    auto now = Clock::now();
+    auto& device = deviceOf(device_id);
+    device.lanes[index].push_back(Job{move(task), now, detached});
+    ++queued_;
+    ++statistics_.dispatched;
+    relist(device, now);
+  }
+  work_.notify_one();
+}
+
+DispatchScheduler::Device& DispatchScheduler::deviceOf(
+    const string& device_id) {
+  auto [it, inserted] = devices_.try_emplace(device_id);
+  if (inserted) {
+    it->second.policy = default_policy_;
+    it->second.tokens = default_policy_.burst;
+    it->second.refilled = Clock::now();
+  }
+  return it->second;
+}
+
+void DispatchScheduler::relist(Device& device, Clock::time_point now) {
+  ++device.ticket;
+  auto lane = find_if(device.lanes.begin(),
+      device.lanes.end(),
+      [](const auto& jobs) { return !jobs.empty(); });
+  if (lane == device.lanes.end() ||
+      device.in_flight >= device.policy.max_in_flight) {
+    // relisted once work is queued or a running operation completes
+    return;
+  }
+  if (device.policy.rate > 0.0) {
+    auto elapsed = chrono::duration<double>(now - device.refilled).count();
+    device.tokens = min(
+        device.policy.burst, device.tokens + elapsed * device.policy.rate);
+    device.refilled = now;
+    if (device.tokens < 1.0) {
+      auto wait = chrono::duration<double>(
+          (1.0 - device.tokens) / device.policy.rate);
+      if (device.wakeup <= now) {
+        ++statistics_.throttled;
+      }
+      device.wakeup = now + chrono::ceil<Clock::duration>(wait);
+      throttled_.push(Wakeup{device.wakeup, &device, device.ticket});
+      return;
+    }
+  }
+  auto priority = static_cast<size_t>(lane - device.lanes.begin());
+  ready_[priority].push_back(Entry{&device, device.ticket});
+}
+
+bool DispatchScheduler::take(
+    Clock::time_point now, Job& job, Device*& device) {
+  for (size_t priority = 0; priority < DISPATCH_PRIORITIES; ++priority) {
+    auto& ready = ready_[priority];
+    while (!ready.empty()) {
+      auto entry = ready.front();
+      ready.pop_front();
+      if (entry.ticket != entry.device->ticket) {
+        continue;
+      }
+      device = entry.device;
+      auto& lane = device->lanes[priority];
+      job = move(lane.front());
+      lane.pop_front();
+      --queued_;
+      ++device->in_flight;
+      if (device->policy.rate > 0.0) {
+        device->tokens -= 1.0;
+      }
+      latency_[priority].record(
+          chrono::duration_cast<LatencyHistogram::Duration>(now - job.queued));
+      // devices with more work go to the back of their ready queue
+      relist(*device, now);
+      work_.notify_one();
+      return true;
+    }
+  }
+  return false;
+}
+
+void DispatchScheduler::workerLoop() {
+  unique_lock lock(mx_);
+  while (running_) {
+    auto now = Clock::now();
+    while (!throttled_.empty() && throttled_.top().time <= now) {
+      auto wakeup = throttled_.top();
+      throttled_.pop();
+      if (wakeup.ticket == wakeup.device->ticket) {
+        relist(*wakeup.device, now);
+      }
+    }
+    Job job;
+    Device* device = nullptr;
+    if (!take(now, job, device)) {
+      if (throttled_.empty()) {
+        work_.wait(lock);
+      } else {
+        work_.wait_until(lock, throttled_.top().time);
+      }
+      continue;
+    }
+    lock.unlock();
+    bool failed = false;
+    try {
+      job.task();
+    } catch (...) {
+      // exceptions of waited operations are forwarded by their future
+      failed = job.detached;
+    }
+    job.task = nullptr;
+    lock.lock();
+    ++statistics_.completed;
+    if (failed) {
+      ++statistics_.failed;
+    }
+    --device->in_flight;
+    relist(*device, Clock::now());
+    work_.notify_one();
+  }
+}
+} // namespace Information_Model
@@ -0,0 +1,229 @@
+#include "Expected.hpp"
+#include "Device.hpp"
+#include "TypedElement.hpp"
+
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+string toString(ErrorCode code) {
+  switch (code) {
+  case ErrorCode::Element_Not_Found: {
+    return "Element_Not_Found";
+  }
+  case ErrorCode::ID_Points_This_Group: {
+    return "ID_Points_This_Group";
+  }
+  case ErrorCode::Read_Callback_Unavailable: {
+    return "Read_Callback_Unavailable";
+  }
+  case ErrorCode::Non_Readable: {
+    return "Non_Readable";
+  }
+  case ErrorCode::Write_Callback_Unavailable: {
+    return "Write_Callback_Unavailable";
+  }
+  case ErrorCode::Data_Type_Mismatch: {
+    return "Data_Type_Mismatch";
+  }
+  case ErrorCode::Result_Returning_Not_Supported: {
+    return "Result_Returning_Not_Supported";
+  }
+  case ErrorCode::Mandatory_Parameter_Has_No_Value: {
+    return "Mandatory_Parameter_Has_No_Value";
+  }
+  case ErrorCode::Mandatory_Parameter_Missing: {
+    return "Mandatory_Parameter_Missing";
+  }
+  case ErrorCode::Parameter_Type_Mismatch: {
+    return "Parameter_Type_Mismatch";
+  }
+  case ErrorCode::Parameter_Does_Not_Exist: {
+    return "Parameter_Does_Not_Exist";
+  }
+  case ErrorCode::Call_Timedout: {
+    return "Call_Timedout";
+  }
+  case ErrorCode::Call_Canceled: {
+    return "Call_Canceled";
+  }
+  case ErrorCode::Callback_Failed: {
+    return "Callback_Failed";
+  }
+  default: {
+    throw logic_error("Could not decode ErrorCode enum value");
+  }
+  }
+}
+
+Error::Error(ErrorCode code,
+    string subject,
+    uintmax_t position,
+    DataType expected,
+    DataType given)
+    : code_(code), expected_(expected), given_(given), position_(position),
+      subject_(move(subject)) {}
+
+Error::Error(ErrorCode code, exception_ptr exception)
+    : code_(code), expected_(DataType::None), given_(DataType::None),
+      position_(0), exception_(move(exception)) {}
+
+namespace {
+/**
+ * @brief Calls a given handler with the exception, that matches the error
+ */
+template <typename Handler>
+string withException(const Error& error, Handler&& handler) {
+  switch (error.code()) {
+  case ErrorCode::Element_Not_Found: {
+    return handler(ElementNotFound(error.subject()));
+  }
+  case ErrorCode::ID_Points_This_Group: {
+    return handler(IDPointsThisGroup(error.subject()));
+  }
+  case ErrorCode::Read_Callback_Unavailable: {
+    return handler(ReadCallbackUnavailable());
+  }
+  case ErrorCode::Non_Readable: {
+    return handler(NonReadable());
+  }
+  case ErrorCode::Write_Callback_Unavailable: {
+    return handler(WriteCallbackUnavailable());
+  }
+  case ErrorCode::Data_Type_Mismatch: {
+    return handler(
+        DataTypeMismatch(error.subject(), error.expected(), error.given()));
+  }
+  case ErrorCode::Result_Returning_Not_Supported: {
+    return handler(ResultReturningNotSupported());
+  }
+  case ErrorCode::Mandatory_Parameter_Has_No_Value: {
+    return handler(
+        MandatoryParameterHasNoValue(error.position(), error.expected()));
+  }
+  case ErrorCode::Mandatory_Parameter_Missing: {
+    return handler(
+        MandatoryParameterMissing(error.position(), error.expected()));
+  }
+  case ErrorCode::Parameter_Type_Mismatch: {
+    return handler(ParameterTypeMismatch(
+        error.position(), error.expected(), error.given()));
+  }
+  case ErrorCode::Parameter_Does_Not_Exist: {
+    return handler(ParameterDoesNotExist(error.position()));
+  }
+  case ErrorCode::Call_Timedout: {
+    return handler(CallTimedout(error.subject()));
+  }
+  case ErrorCode::Call_Canceled: {
+    return handler(CallCanceled(error.position(), error.subject()));
+  }
+  case ErrorCode::Callback_Failed: {
+    return handler(runtime_error("Element callback failed"));
+  }
+  default: {
+    throw logic_error("Could not decode ErrorCode enum value");
+  }
+  }
+}
+} // namespace
+
+string Error::message() const {
+  if (exception_) {
+    try {
+      rethrow_exception(exception_);
+    } catch (const std::exception& thrown) {
+      return thrown.what();
+    } catch (...) {
+      return "Unknown exception";
+    }
+  }
+  return withException(*this,
+      [](const std::exception& error) -> string { return error.what(); });
+}
+
+void Error::raise() const {
+  if (exception_) {
+    rethrow_exception(exception_);
+  }
+  withException(*this, [](const auto& error) -> string { throw error; });
+  throw logic_error("Error was not raised");
+}
+
+Error toError(const exception_ptr& exception) {
+  try {
+    rethrow_exception(exception);
+  } catch (const ElementNotFound&) {
+    return Error(ErrorCode::Element_Not_Found, exception);
+  } catch (const IDPointsThisGroup&) {
+    return Error(ErrorCode::ID_Points_This_Group, exception);
+  } catch (const ReadCallbackUnavailable&) {
+    return Error(ErrorCode::Read_Callback_Unavailable, exception);
+  } catch (const NonReadable&) {
+    return Error(ErrorCode::Non_Readable, exception);
+  } catch (const WriteCallbackUnavailable&) {
+    return Error(ErrorCode::Write_Callback_Unavailable, exception);
+  } catch (const DataTypeMismatch&) {
+    return Error(ErrorCode::Data_Type_Mismatch, exception);
+  } catch (const ResultReturningNotSupported&) {
+    return Error(ErrorCode::Result_Returning_Not_Supported, exception);
+  } catch (const MandatoryParameterHasNoValue&) {
+    return Error(ErrorCode::Mandatory_Parameter_Has_No_Value, exception);
+  } catch (const MandatoryParameterMissing&) {
+    return Error(ErrorCode::Mandatory_Parameter_Missing, exception);
+  } catch (const ParameterTypeMismatch&) {
+    return Error(ErrorCode::Parameter_Type_Mismatch, exception);
+  } catch (const ParameterDoesNotExist&) {
+    return Error(ErrorCode::Parameter_Does_Not_Exist, exception);
+  } catch (const CallTimedout&) {
+    return Error(ErrorCode::Call_Timedout, exception);
+  } catch (const CallCanceled&) {
+    return Error(ErrorCode::Call_Canceled, exception);
+  } catch (...) {
+    return Error(ErrorCode::Callback_Failed, exception);
+  }
+}
+
+Expected<DataVariant> Readable::tryRead() const {
+  try {
+    return read();
+  } catch (...) {
+    return toError(current_exception());
+  }
+}
+
+Expected<DataVariant> Writable::tryRead() const {
+  try {
+    return read();
+  } catch (...) {
+    return toError(current_exception());
+  }
+}
+
+Expected<void> Writable::tryWrite(const DataVariant& value) const {
+  try {
+    write(value);
+    return {};
+  } catch (...) {
+    return toError(current_exception());
+  }
+}
+
+Expected<DataVariant> Callable::tryCall(
+    const Parameters& parameters, uintmax_t timeout) const {
+  try {
+    return call(parameters, timeout);
+  } catch (...) {
+    return toError(current_exception());
+  }
+}
+
+Expected<ElementPtr> Device::tryElement(const string& ref_id) const {
+  try {
+    return element(ref_id);
+  } catch (...) {
+    return toError(current_exception());
+  }
+}
+} // namespace Information_Model
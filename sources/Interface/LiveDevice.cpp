@@ -0,0 +1,527 @@
+#include "LiveDevice.hpp"
+#include "DeviceBuilder.hpp"
+#include "Expected.hpp"
+#include "StructuralHash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace Information_Model {
+using namespace std;
+
+namespace detail {
+struct LiveGroup;
+
+struct LiveChild {
+  uint32_t position;
+  ElementPtr element;
+  /**
+   * @brief Set for Group elements only
+   */
+  shared_ptr<LiveGroup> group;
+};
+
+using LiveChildren = vector<LiveChild>;
+
+struct LiveElement final : public Element {
+  /**
+   * @param group - set for Group elements, that take their structural hash
+   * from it
+   */
+  LiveElement(string id,
+      string name,
+      string description,
+      ElementType type,
+      ElementFunction function,
+      const LiveGroup* group = nullptr)
+      : id_(move(id)), name_(move(name)), description_(move(description)),
+        type_(type), function_(move(function)), group_(group) {
+    if (group_ == nullptr) {
+      hash_ = ownStructureHash(*this);
+    }
+  }
+
+  string id() const final { return id_; }
+
+  string name() const final { return name_; }
+
+  string description() const final { return description_; }
+
+  ElementType type() const final { return type_; }
+
+  ElementFunction function() const final { return function_; }
+
+  size_t structuralHash() const final;
+
+private:
+  string id_;
+  string name_;
+  string description_;
+  ElementType type_;
+  ElementFunction function_;
+  const LiveGroup* group_;
+  size_t hash_ = 0;
+};
+
+/**
+ * @brief Location of an element and the group, that holds it
+ */
+struct LiveLocation {
+  LiveGroup* parent;
+  LiveChild child;
+};
+
+optional<LiveLocation> find(const LiveGroup& group, string_view ref_id);
+
+/**
+ * @brief Group of a LiveDevice
+ *
+ * Child tables are sorted by position and never modified once they were
+ * published, updates publish a new table instead.
+ */
+struct LiveGroup final : public Group {
+  /**
+   * @param parent - group, that holds this group, nullptr for the root group
+   * @param own_hash - ownStructureHash() of the element, that holds this group
+   */
+  LiveGroup(string id, LiveGroup* parent, size_t own_hash)
+      : parent(parent), id_(move(id)),
+        children_(make_shared<const LiveChildren>()), own_hash_(own_hash),
+        hash_(own_hash) {}
+
+  shared_ptr<const LiveChildren> children() const {
+    return atomic_load(&children_);
+  }
+
+  void publish(shared_ptr<const LiveChildren> children) {
+    atomic_store(&children_, move(children));
+  }
+
+  const string& id() const { return id_; }
+
+  string childId(uint32_t position) const {
+    // root children have no separator after the root group id
+    return id_ + (id_.back() == ':' ? "" : ".") + to_string(position);
+  }
+
+  size_t size() const final { return children()->size(); }
+
+  unordered_map<string, ElementPtr> asMap() const final {
+    auto children = this->children();
+    unordered_map<string, ElementPtr> result;
+    result.reserve(children->size());
+    for (const auto& child : *children) {
+      result.emplace(to_string(child.position), child.element);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Elements are returned in the numeric order of their positions
+   */
+  vector<ElementPtr> asVector() const final {
+    auto children = this->children();
+    vector<ElementPtr> result;
+    result.reserve(children->size());
+    for (const auto& child : *children) {
+      result.push_back(child.element);
+    }
+    return result;
+  }
+
+  ElementPtr element(const string& ref_id) const final {
+    return tryElement(ref_id).value();
+  }
+
+  Expected<ElementPtr> tryElement(const string& ref_id) const {
+    if (ref_id == id_) {
+      return Error(ErrorCode::ID_Points_This_Group, ref_id);
+    }
+    if (auto location = find(*this, ref_id)) {
+      return location->child.element;
+    }
+    return Error(ErrorCode::Element_Not_Found, ref_id);
+  }
+
+  void visit(const Visitor& visitor) const final {
+    auto children = this->children();
+    for (const auto& child : *children) {
+      visitor(child.element);
+    }
+  }
+
+  size_t hash() const { return hash_.load(memory_order_acquire); }
+
+  /**
+   * @brief Recomputes the structural hash from the published child table
+   */
+  void rehash() {
+    auto children = this->children();
+    auto hash = own_hash_;
+    for (const auto& child : *children) {
+      hash = combineStructureHash(hash, child.element->structuralHash());
+    }
+    hash_.store(hash, memory_order_release);
+  }
+
+  /**
+   * @brief Next free position, guarded by the LiveDevice update mutex
+   */
+  uint32_t next_position = 0;
+
+  LiveGroup* const parent;
+
+private:
+  string id_;
+  shared_ptr<const LiveChildren> children_;
+  size_t own_hash_;
+  atomic<size_t> hash_;
+};
+
+size_t LiveElement::structuralHash() const {
+  return group_ == nullptr ? hash_ : group_->hash();
+}
+
+/**
+ * @brief Recomputes the structural hashes of a changed group and all groups,
+ * that hold it
+ */
+void rehashPath(LiveGroup* group) {
+  for (; group != nullptr; group = group->parent) {
+    group->rehash();
+  }
+}
+
+/**
+ * @brief Walks the published child tables along the positions of a given id
+ */
+optional<LiveLocation> find(const LiveGroup& group, string_view ref_id) {
+  const auto& prefix = group.id();
+  if (ref_id.size() <= prefix.size() ||
+      ref_id.compare(0, prefix.size(), prefix) != 0) {
+    return nullopt;
+  }
+  auto position = prefix.size();
+  if (prefix.back() != ':') {
+    if (ref_id[position] != '.') {
+      return nullopt;
+    }
+    ++position;
+  }
+  // only updates modify the returned parent and they hold the update mutex
+  auto* current = const_cast<LiveGroup*>(&group);
+  // the table of the previous level keeps the current group alive, even if
+  // it is removed meanwhile
+  shared_ptr<const LiveChildren> previous;
+  while (true) {
+    uint64_t child = 0;
+    auto first = position;
+    while (position < ref_id.size() && ref_id[position] >= '0' &&
+        ref_id[position] <= '9') {
+      // NOLINTNEXTLINE(readability-magic-numbers)
+      child = child * 10 + static_cast<uint64_t>(ref_id[position] - '0');
+      if (child > UINT32_MAX) {
+        return nullopt;
+      }
+      ++position;
+    }
+    auto digits = position - first;
+    if (digits == 0 || (digits > 1 && ref_id[first] == '0') ||
+        current == nullptr) {
+      return nullopt;
+    }
+    auto children = current->children();
+    auto it = lower_bound(children->begin(),
+        children->end(),
+        child,
+        [](const LiveChild& entry, uint64_t value) {
+          return entry.position < value;
+        });
+    if (it == children->end() || it->position != child) {
+      return nullopt;
+    }
+    if (position == ref_id.size()) {
+      return LiveLocation{current, *it};
+    }
+    if (ref_id[position] != '.' || position + 1 == ref_id.size()) {
+      return nullopt;
+    }
+    ++position;
+    current = it->group.get();
+    previous = move(children);
+  }
+}
+
+/**
+ * @brief Copies the structure of a source element into a new live element
+ */
+LiveChild graft(LiveGroup& parent,
+    uint32_t position,
+    const ElementPtr& source,
+    const string& device_id,
+    vector<string>& added) {
+  auto id = parent.childId(position);
+  added.push_back(id);
+  if (source->type() != ElementType::Group) {
+    return LiveChild{position,
+        make_shared<LiveElement>(id,
+            source->name(),
+            source->description(),
+            source->type(),
+            source->function()),
+        nullptr};
+  }
+  auto elements = get<GroupPtr>(source->function())->asVector();
+  if (elements.empty()) {
+    throw GroupEmpty(device_id, source->id());
+  }
+  auto group = make_shared<LiveGroup>(id,
+      &parent,
+      ownStructureHash(id,
+          source->name(),
+          source->description(),
+          ElementType::Group,
+          DataType::None,
+          false,
+          {}));
+  auto children = make_shared<LiveChildren>();
+  children->reserve(elements.size());
+  for (const auto& element : elements) {
+    children->push_back(
+        graft(*group, group->next_position++, element, device_id, added));
+  }
+  group->publish(move(children));
+  group->rehash();
+  return LiveChild{position,
+      make_shared<LiveElement>(move(id),
+          source->name(),
+          source->description(),
+          ElementType::Group,
+          GroupPtr(group),
+          group.get()),
+      group};
+}
+
+void collectIds(const LiveChild& child, vector<string>& ids) {
+  ids.push_back(child.element->id());
+  if (child.group) {
+    auto children = child.group->children();
+    for (const auto& nested : *children) {
+      collectIds(nested, ids);
+    }
+  }
+}
+
+struct LiveSubscribers : public enable_shared_from_this<LiveSubscribers> {
+  ObserverPtr subscribe(const LiveDevice::ChangeCallback& change_cb,
+      const Observable::ExceptionHandler& handler);
+
+  void unsubscribe(uint64_t token) {
+    lock_guard lock(mx_);
+    subscribers_.erase(remove_if(subscribers_.begin(),
+                           subscribers_.end(),
+                           [token](const auto& subscriber) {
+                             return subscriber->token == token;
+                           }),
+        subscribers_.end());
+  }
+
+  void notify(const StructureChange& change) {
+    vector<shared_ptr<Subscriber>> targets;
+    {
+      lock_guard lock(mx_);
+      targets = subscribers_;
+    }
+    for (const auto& target : targets) {
+      try {
+        target->change(change);
+      } catch (...) {
+        if (target->handler) {
+          target->handler(current_exception());
+        }
+      }
+    }
+  }
+
+private:
+  struct Subscriber {
+    uint64_t token;
+    LiveDevice::ChangeCallback change;
+    Observable::ExceptionHandler handler;
+  };
+
+  mutex mx_;
+  vector<shared_ptr<Subscriber>> subscribers_;
+  uint64_t next_token_ = 0;
+};
+
+namespace {
+struct ChangeObserver final : public Observer {
+  ChangeObserver(weak_ptr<LiveSubscribers> subscribers, uint64_t token)
+      : subscribers_(move(subscribers)), token_(token) {}
+
+  ~ChangeObserver() override {
+    if (auto subscribers = subscribers_.lock()) {
+      subscribers->unsubscribe(token_);
+    }
+  }
+
+private:
+  weak_ptr<LiveSubscribers> subscribers_;
+  uint64_t token_;
+};
+} // namespace
+
+ObserverPtr LiveSubscribers::subscribe(
+    const LiveDevice::ChangeCallback& change_cb,
+    const Observable::ExceptionHandler& handler) {
+  if (!change_cb) {
+    throw invalid_argument("Change callback can not be null");
+  }
+  lock_guard lock(mx_);
+  auto token = next_token_++;
+  subscribers_.push_back(
+      make_shared<Subscriber>(Subscriber{token, change_cb, handler}));
+  return make_shared<ChangeObserver>(weak_from_this(), token);
+}
+} // namespace detail
+
+LiveDevice::LiveDevice(const Device& device)
+    : id_(device.id()), name_(device.name()),
+      description_(device.description()),
+      root_(make_shared<detail::LiveGroup>(id_ + ":",
+          nullptr,
+          ownStructureHash(id_ + ":",
+              name_,
+              description_,
+              ElementType::Group,
+              DataType::None,
+              false,
+              {}))),
+      subscribers_(make_shared<detail::LiveSubscribers>()) {
+  auto elements = device.group()->asVector();
+  if (elements.empty()) {
+    throw GroupEmpty(id_);
+  }
+  auto children = make_shared<detail::LiveChildren>();
+  children->reserve(elements.size());
+  vector<string> added;
+  for (const auto& element : elements) {
+    children->push_back(detail::graft(
+        *root_, root_->next_position++, element, id_, added));
+  }
+  root_->publish(move(children));
+  root_->rehash();
+}
+
+LiveDevice::~LiveDevice() = default;
+
+string LiveDevice::id() const { return id_; }
+
+string LiveDevice::name() const { return name_; }
+
+string LiveDevice::description() const { return description_; }
+
+GroupPtr LiveDevice::group() const { return root_; }
+
+size_t LiveDevice::size() const { return root_->size(); }
+
+ElementPtr LiveDevice::element(const string& ref_id) const {
+  return root_->element(ref_id);
+}
+
+Expected<ElementPtr> LiveDevice::tryElement(const string& ref_id) const {
+  return root_->tryElement(ref_id);
+}
+
+void LiveDevice::visit(const Group::Visitor& visitor) const {
+  root_->visit(visitor);
+}
+
+size_t LiveDevice::structuralHash() const { return root_->hash(); }
+
+uint64_t LiveDevice::version() const {
+  return version_.load(memory_order_acquire);
+}
+
+StructureChange LiveDevice::add(
+    const optional<string>& parent_id, const Device& module) {
+  lock_guard lock(update_mx_);
+  auto* parent = root_.get();
+  if (parent_id.has_value() && *parent_id != root_->id()) {
+    auto location = detail::find(*root_, *parent_id);
+    if (!location || !location->child.group) {
+      throw invalid_argument("Group " + *parent_id + " does not exist");
+    }
+    parent = location->child.group.get();
+  }
+  auto elements = module.group()->asVector();
+  if (elements.empty()) {
+    throw GroupEmpty(module.id());
+  }
+  if (UINT32_MAX - parent->next_position < elements.size()) {
+    throw length_error("Group can not hold more elements");
+  }
+  StructureChange change;
+  auto current = parent->children();
+  auto children = make_shared<detail::LiveChildren>();
+  children->reserve(current->size() + elements.size());
+  children->assign(current->begin(), current->end());
+  // positions are only taken once all elements were grafted
+  auto position = parent->next_position;
+  for (const auto& element : elements) {
+    children->push_back(
+        detail::graft(*parent, position++, element, id_, change.added));
+  }
+  parent->next_position = position;
+  parent->publish(move(children));
+  detail::rehashPath(parent);
+  return publish(move(change));
+}
+
+StructureChange LiveDevice::remove(const string& ref_id) {
+  lock_guard lock(update_mx_);
+  if (ref_id == root_->id()) {
+    throw IDPointsThisGroup(ref_id);
+  }
+  auto location = detail::find(*root_, ref_id);
+  if (!location) {
+    throw ElementNotFound(ref_id);
+  }
+  auto* parent = location->parent;
+  auto current = parent->children();
+  if (current->size() == 1) {
+    if (parent == root_.get()) {
+      throw GroupEmpty(id_);
+    }
+    throw GroupEmpty(id_, parent->id());
+  }
+  auto children = make_shared<detail::LiveChildren>();
+  children->reserve(current->size() - 1);
+  for (const auto& child : *current) {
+    if (child.position != location->child.position) {
+      children->push_back(child);
+    }
+  }
+  StructureChange change;
+  detail::collectIds(location->child, change.removed);
+  parent->publish(move(children));
+  detail::rehashPath(parent);
+  return publish(move(change));
+}
+
+ObserverPtr LiveDevice::subscribe(const ChangeCallback& change_cb,
+    const Observable::ExceptionHandler& handler) {
+  return subscribers_->subscribe(change_cb, handler);
+}
+
+StructureChange LiveDevice::publish(StructureChange&& change) {
+  change.version = version_.fetch_add(1, memory_order_acq_rel) + 1;
+  subscribers_->notify(change);
+  return move(change);
+}
+} // namespace Information_Model
@@ -0,0 +1,142 @@
+#include "NotificationFilter.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+template <typename T>
+constexpr bool is_numeric_v =
+    is_arithmetic_v<NativeTypeOf_t<T>> && !is_same_v<T, bool>;
+
+template <typename T>
+constexpr bool is_sequence_v =
+    !is_arithmetic_v<NativeTypeOf_t<T>> && !is_same_v<T, Timestamp>;
+
+optional<double> toNumber(const DataVariant& value) {
+  return visit(
+      [](const auto& native) -> optional<double> {
+        using Native = decay_t<decltype(native)>;
+        if constexpr (is_numeric_v<Native>) {
+          return static_cast<double>(toNative(native));
+        } else {
+          return nullopt;
+        }
+      },
+      value);
+}
+
+template <typename Sequence> size_t byteSize(const Sequence& sequence) {
+  return sequence.size() * sizeof(typename Sequence::value_type);
+}
+} // namespace
+
+NotificationFilter::NotificationFilter(const SuppressionPolicy& policy)
+    : policy_(policy) {
+  if (policy_.absolute_deadband < 0 || policy_.percent_deadband < 0) {
+    throw invalid_argument("Suppression deadband must not be negative");
+  }
+  if (policy_.min_interval.count() < 0) {
+    throw invalid_argument("Suppression interval must not be negative");
+  }
+}
+
+bool NotificationFilter::admit(const DataVariant& value) {
+  return admit(value, SuppressionPolicy::Clock::now());
+}
+
+bool NotificationFilter::admit(
+    const DataVariant& value, SuppressionPolicy::Clock::time_point now) {
+  lock_guard lock(mx_);
+  if (last_dispatch_.has_value()) {
+    if (now - *last_dispatch_ < policy_.min_interval) {
+      ++counters_.interval;
+      return false;
+    }
+    if (value.index() == last_index_) {
+      if (policy_.suppress_unchanged && unchanged(value)) {
+        ++counters_.unchanged;
+        return false;
+      }
+      if (withinDeadband(value)) {
+        ++counters_.deadband;
+        return false;
+      }
+    }
+  }
+  remember(value);
+  last_dispatch_ = now;
+  ++counters_.dispatched;
+  return true;
+}
+
+SuppressionCounters NotificationFilter::counters() const {
+  lock_guard lock(mx_);
+  return counters_;
+}
+
+void NotificationFilter::reset() {
+  lock_guard lock(mx_);
+  counters_ = SuppressionCounters{};
+  last_dispatch_.reset();
+}
+
+bool NotificationFilter::unchanged(const DataVariant& value) const {
+  return visit(
+      [this, &value](const auto& native) {
+        using Native = decay_t<decltype(native)>;
+        if constexpr (is_sequence_v<Native>) {
+          // sizes differ for most changed payloads, so comparing bytes is
+          // rarely needed to detect a change
+          auto size = byteSize(native);
+          return size == last_payload_.size() &&
+              (size == 0 ||
+                  memcmp(native.data(), last_payload_.data(), size) == 0);
+        } else {
+          return compare(value, last_scalar_) == 0;
+        }
+      },
+      value);
+}
+
+bool NotificationFilter::withinDeadband(const DataVariant& value) const {
+  if (policy_.absolute_deadband == 0 && policy_.percent_deadband == 0) {
+    return false;
+  }
+  auto current = toNumber(value);
+  if (!current.has_value()) {
+    return false;
+  }
+  auto last = *toNumber(last_scalar_);
+  auto change = fabs(*current - last);
+  constexpr double percent = 100.0;
+  // NaN changes are never within a deadband
+  return (policy_.absolute_deadband != 0 &&
+             change <= policy_.absolute_deadband) ||
+      (policy_.percent_deadband != 0 &&
+          change <= fabs(last) * policy_.percent_deadband / percent);
+}
+
+void NotificationFilter::remember(const DataVariant& value) {
+  last_index_ = value.index();
+  visit(
+      [this, &value](const auto& native) {
+        using Native = decay_t<decltype(native)>;
+        if constexpr (is_sequence_v<Native>) {
+          if (!policy_.suppress_unchanged) {
+            return;
+          }
+          const auto* bytes = reinterpret_cast<const byte*>(native.data());
+          last_payload_.assign(bytes, bytes + byteSize(native));
+        } else {
+          last_scalar_ = value;
+        }
+      },
+      value);
+}
+} // namespace Information_Model
@@ -0,0 +1,85 @@
+#include "ObservableHub.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Information_Model::detail {
+using namespace std;
+
+namespace {
+struct HubObserver final : public Observer {
+  HubObserver(weak_ptr<ObservableHub> hub, uint64_t token)
+      : hub_(move(hub)), token_(token) {}
+
+  ~HubObserver() override {
+    if (auto hub = hub_.lock()) {
+      hub->unsubscribe(token_);
+    }
+  }
+
+private:
+  weak_ptr<ObservableHub> hub_;
+  uint64_t token_;
+};
+} // namespace
+
+ObserverPtr ObservableHub::subscribe(
+    const Observable::ObserveCallback& observe_cb,
+    const Observable::ExceptionHandler& handler) {
+  if (!observe_cb) {
+    throw invalid_argument("Observe callback can not be null");
+  }
+  uint64_t token = 0;
+  bool first = false;
+  {
+    lock_guard lock(mx_);
+    token = next_token_++;
+    subscribers_.push_back(
+        make_shared<Subscriber>(Subscriber{token, observe_cb, handler}));
+    first = subscribers_.size() == 1;
+  }
+  if (first) {
+    observing_(true);
+  }
+  return make_shared<HubObserver>(weak_from_this(), token);
+}
+
+void ObservableHub::unsubscribe(uint64_t token) {
+  bool last = false;
+  {
+    lock_guard lock(mx_);
+    auto it = find_if(subscribers_.begin(),
+        subscribers_.end(),
+        [token](const auto& subscriber) { return subscriber->token == token; });
+    if (it == subscribers_.end()) {
+      return;
+    }
+    subscribers_.erase(it);
+    last = subscribers_.empty();
+  }
+  if (last) {
+    observing_(false);
+  }
+}
+
+void ObservableHub::notify(const DataVariant& value) {
+  vector<shared_ptr<Subscriber>> targets;
+  {
+    lock_guard lock(mx_);
+    if (subscribers_.empty()) {
+      return;
+    }
+    targets = subscribers_;
+  }
+  auto shared_value = make_shared<DataVariant>(value);
+  for (const auto& target : targets) {
+    try {
+      target->observe(shared_value);
+    } catch (...) {
+      if (target->handler) {
+        target->handler(current_exception());
+      }
+    }
+  }
+}
+} // namespace Information_Model::detail
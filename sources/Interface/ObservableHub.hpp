@@ -0,0 +1,69 @@
+#ifndef __STAG_INFORMATION_MODEL_OBSERVABLE_HUB_HPP
+#define __STAG_INFORMATION_MODEL_OBSERVABLE_HUB_HPP
+
+#include "DeviceBuilder.hpp"
+#include "Observable.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Information_Model::detail {
+/**
+ * @brief Observer list of a single Observable element, shared by the
+ * reference Device implementations
+ *
+ * Created before the element itself, so the NotifyCallback can be handed out
+ * before the element exists. The IsObservingCallback is called with true when
+ * the first observer subscribes and with false when the last one
+ * unsubscribes.
+ */
+struct ObservableHub : public std::enable_shared_from_this<ObservableHub> {
+  explicit ObservableHub(DeviceBuilder::InlineIsObservingCallback&& observing)
+      : observing_(std::move(observing)) {}
+
+  /**
+   * @brief Replaces the IsObservingCallback, must be called before the first
+   * observer subscribes
+   */
+  void bind(DeviceBuilder::InlineIsObservingCallback&& observing) {
+    observing_ = std::move(observing);
+  }
+
+  ObserverPtr subscribe(const Observable::ObserveCallback& observe_cb,
+      const Observable::ExceptionHandler& handler);
+
+  void unsubscribe(uint64_t token);
+
+  void notify(const DataVariant& value);
+
+private:
+  struct Subscriber {
+    uint64_t token;
+    Observable::ObserveCallback observe;
+    Observable::ExceptionHandler handler;
+  };
+
+  DeviceBuilder::InlineIsObservingCallback observing_;
+  std::mutex mx_;
+  std::vector<std::shared_ptr<Subscriber>> subscribers_;
+  uint64_t next_token_ = 0;
+};
+
+/**
+ * @brief NotifyCallback of an Observable element, does nothing once the
+ * element is destroyed
+ */
+struct Notifier {
+  void operator()(const DataVariant& value) const {
+    if (auto locked = hub.lock()) {
+      locked->notify(value);
+    }
+  }
+
+  std::weak_ptr<ObservableHub> hub;
+};
+} // namespace Information_Model::detail
+
+#endif //__STAG_INFORMATION_MODEL_OBSERVABLE_HUB_HPP
@@ -0,0 +1,142 @@
+#include "PendingCallRegistry.hpp"
+
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+constexpr unsigned SLOT_ID_BITS = 32;
+constexpr size_t MAX_SHARDS = size_t{1} << 16U;
+constexpr uint64_t SLOT_ID_MASK = UINT32_MAX;
+
+unsigned shardBitsOf(size_t shards) {
+  if (shards == 0) {
+    throw invalid_argument("Pending call registry needs at least one shard");
+  }
+  if (shards > MAX_SHARDS) {
+    throw invalid_argument("Pending call registry supports up to " +
+        to_string(MAX_SHARDS) + " shards");
+  }
+  unsigned bits = 0;
+  while ((size_t{1} << bits) < shards) {
+    ++bits;
+  }
+  return bits;
+}
+} // namespace
+
+PendingCallRegistry::PendingCallRegistry(const string& name, size_t shards)
+    : name_(name), shard_bits_(shardBitsOf(shards)) {
+  shard_count_ = size_t{1} << shard_bits_;
+  shards_ = make_unique<Shard[]>(shard_count_);
+}
+
+PendingCallRegistry::~PendingCallRegistry() {
+  for (size_t shard = 0; shard < shard_count_; ++shard) {
+    auto& slots = shards_[shard].slots;
+    for (size_t index = 0; index < slots.size(); ++index) {
+      if (slots[index].result.has_value()) {
+        auto id = (CallId{slots[index].generation} << SLOT_ID_BITS) |
+            (index << shard_bits_) | shard;
+        slots[index].result->set_exception(
+            make_exception_ptr(CallCanceled(id, name_)));
+      }
+    }
+  }
+}
+
+ResultFuture PendingCallRegistry::emplace() {
+  auto shard_index = next_.fetch_add(1, memory_order_relaxed) &
+      (shard_count_ - 1);
+  auto& shard = shards_[shard_index];
+  promise<DataVariant> result;
+  auto future = result.get_future();
+
+  lock_guard lock(shard.mx);
+  uint32_t index = 0;
+  if (shard.free.empty()) {
+    if (shard.slots.size() >= (size_t{1} << (SLOT_ID_BITS - shard_bits_))) {
+      throw length_error("Pending call registry shard has no free slots");
+    }
+    index = static_cast<uint32_t>(shard.slots.size());
+    shard.slots.emplace_back();
+  } else {
+    index = shard.free.back();
+    shard.free.pop_back();
+  }
+  auto& slot = shard.slots[index];
+  slot.result = move(result);
+  ++shard.active;
+  auto id = (CallId{slot.generation} << SLOT_ID_BITS) |
+      (CallId{index} << shard_bits_) | shard_index;
+  return ResultFuture(id, move(future));
+}
+
+bool PendingCallRegistry::complete(CallId id, const DataVariant& result) {
+  promise<DataVariant> pending;
+  if (!release(id, pending)) {
+    return false;
+  }
+  pending.set_value(result);
+  return true;
+}
+
+bool PendingCallRegistry::fail(CallId id, const exception_ptr& error) {
+  promise<DataVariant> pending;
+  if (!release(id, pending)) {
+    return false;
+  }
+  pending.set_exception(error);
+  return true;
+}
+
+bool PendingCallRegistry::cancel(CallId id) {
+  promise<DataVariant> pending;
+  if (!release(id, pending)) {
+    return false;
+  }
+  pending.set_exception(make_exception_ptr(CallCanceled(id, name_)));
+  return true;
+}
+
+bool PendingCallRegistry::contains(CallId id) const {
+  const auto& shard = shards_[id & (shard_count_ - 1)];
+  auto index = (id & SLOT_ID_MASK) >> shard_bits_;
+  lock_guard lock(shard.mx);
+  return index < shard.slots.size() &&
+      shard.slots[index].result.has_value() &&
+      shard.slots[index].generation == (id >> SLOT_ID_BITS);
+}
+
+size_t PendingCallRegistry::size() const {
+  size_t result = 0;
+  for (size_t shard = 0; shard < shard_count_; ++shard) {
+    lock_guard lock(shards_[shard].mx);
+    result += shards_[shard].active;
+  }
+  return result;
+}
+
+bool PendingCallRegistry::release(CallId id, promise<DataVariant>& result) {
+  auto& shard = shards_[id & (shard_count_ - 1)];
+  auto index = (id & SLOT_ID_MASK) >> shard_bits_;
+  lock_guard lock(shard.mx);
+  if (index >= shard.slots.size()) {
+    return false;
+  }
+  auto& slot = shard.slots[index];
+  if (!slot.result.has_value() || slot.generation != (id >> SLOT_ID_BITS)) {
+    return false;
+  }
+  result = move(*slot.result);
+  slot.result.reset();
+  // generation 0 is skipped, so 0 is never a valid caller id
+  if (++slot.generation == 0) {
+    slot.generation = 1;
+  }
+  shard.free.push_back(static_cast<uint32_t>(index));
+  --shard.active;
+  return true;
+}
+} // namespace Information_Model
@@ -0,0 +1,396 @@
+#include "PollingScheduler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+constexpr uint64_t INDEX_MASK = UINT32_MAX;
+constexpr unsigned GENERATION_SHIFT = 32;
+
+uint32_t indexOf(PollingScheduler::PollId id) {
+  return static_cast<uint32_t>(id & INDEX_MASK);
+}
+} // namespace
+
+PollingScheduler::PollingScheduler(
+    const BatchHandler& handler, size_t workers, Clock::duration resolution)
+    : handler_(handler), worker_count_(workers), resolution_(resolution),
+      epoch_(Clock::now()) {
+  if (!handler_) {
+    throw invalid_argument("Batch handler can not be null");
+  }
+  if (resolution_.count() <= 0) {
+    throw invalid_argument("Scheduler resolution must be positive");
+  }
+}
+
+PollingScheduler::~PollingScheduler() { stop(); }
+
+PollingScheduler::PollId PollingScheduler::add(const string& device_id,
+    const ReadablePtr& readable,
+    Clock::duration interval) {
+  return add(device_id, readable, interval, nullptr);
+}
+
+PollingScheduler::PollId PollingScheduler::add(const string& device_id,
+    const ReadablePtr& readable,
+    Clock::duration interval,
+    const ReadHandler& on_read) {
+  if (!readable) {
+    throw invalid_argument("Polled readable can not be null");
+  }
+  auto ticks = ticksOf(interval);
+
+  lock_guard lock(mx_);
+  auto [device, inserted] = device_ids_.try_emplace(
+      device_id, static_cast<uint32_t>(devices_.size()));
+  if (inserted) {
+    devices_.push_back(device_id);
+  }
+  uint32_t index = 0;
+  if (free_.empty()) {
+    index = static_cast<uint32_t>(registrations_.size());
+    registrations_.emplace_back();
+  } else {
+    index = free_.back();
+    free_.pop_back();
+  }
+  auto& registration = registrations_[index];
+  registration.device = device->second;
+  registration.readable = readable;
+  registration.on_read = on_read;
+  registration.interval = ticks;
+  registration.deadline = alignedDeadline(ticks);
+  registration.timer = wheel_.schedule(registration.deadline, index);
+  wakeTimer(registration.deadline);
+  registration.active = true;
+  registration.in_flight = false;
+  ++active_;
+  return (PollId{registration.generation} << GENERATION_SHIFT) | index;
+}
+
+bool PollingScheduler::remove(PollId id) {
+  lock_guard lock(mx_);
+  if (!matches(id)) {
+    return false;
+  }
+  auto index = indexOf(id);
+  auto& registration = registrations_[index];
+  wheel_.cancel(registration.timer);
+  registration.active = false;
+  registration.readable.reset();
+  registration.on_read = nullptr;
+  // a running read of the removed element no longer matches the new
+  // generation, so the slot can be reused right away
+  ++registration.generation;
+  free_.push_back(index);
+  --active_;
+  return true;
+}
+
+bool PollingScheduler::setInterval(PollId id, Clock::duration interval) {
+  auto ticks = ticksOf(interval);
+  lock_guard lock(mx_);
+  if (!matches(id)) {
+    return false;
+  }
+  auto index = indexOf(id);
+  auto& registration = registrations_[index];
+  if (registration.interval != ticks) {
+    wheel_.cancel(registration.timer);
+    registration.interval = ticks;
+    registration.deadline = alignedDeadline(ticks);
+    registration.timer = wheel_.schedule(registration.deadline, index);
+    wakeTimer(registration.deadline);
+  }
+  return true;
+}
+
+optional<PollingScheduler::Clock::duration> PollingScheduler::interval(
+    PollId id) const {
+  lock_guard lock(mx_);
+  if (!matches(id)) {
+    return nullopt;
+  }
+  return resolution_ * static_cast<Clock::rep>(
+                           registrations_[indexOf(id)].interval);
+}
+
+size_t PollingScheduler::size() const {
+  lock_guard lock(mx_);
+  return active_;
+}
+
+void PollingScheduler::start() {
+  lock_guard lock(mx_);
+  if (running_) {
+    return;
+  }
+  // polls missed while stopped are neither read nor counted as overruns
+  auto tick = tickOf(Clock::now());
+  expired_.clear();
+  wheel_.advance(tick, expired_);
+  for (const auto& expiry : expired_) {
+    auto index = static_cast<uint32_t>(expiry.key);
+    auto& registration = registrations_[index];
+    registration.deadline = (tick / registration.interval + 1) *
+        registration.interval;
+    registration.timer = wheel_.schedule(registration.deadline, index);
+  }
+  running_ = true;
+  for (size_t i = 0; i < worker_count_; ++i) {
+    workers_.emplace_back(&PollingScheduler::workerLoop, this);
+  }
+  timer_ = thread(&PollingScheduler::timerLoop, this);
+}
+
+void PollingScheduler::stop() {
+  {
+    lock_guard lock(mx_);
+    if (!running_) {
+      return;
+    }
+    if (onSchedulerThread()) {
+      // joining the calling thread would deadlock
+      throw StopFromSchedulerThread();
+    }
+    running_ = false;
+    for (const auto& task : queue_) {
+      for (const auto& read : task.reads) {
+        if (matches(read.id)) {
+          registrations_[indexOf(read.id)].in_flight = false;
+        }
+      }
+    }
+    queue_.clear();
+  }
+  work_.notify_all();
+  stopped_.notify_all();
+  timer_.join();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void PollingScheduler::poll(Clock::time_point now) {
+  vector<Task> tasks;
+  {
+    lock_guard lock(mx_);
+    collect(tickOf(now), tasks);
+    if (running_ && worker_count_ > 0) {
+      for (auto& task : tasks) {
+        queue_.push_back(move(task));
+      }
+      if (!tasks.empty()) {
+        work_.notify_all();
+      }
+      return;
+    }
+  }
+  for (auto& task : tasks) {
+    execute(task);
+  }
+}
+
+PollingStatistics PollingScheduler::statistics() const {
+  lock_guard lock(mx_);
+  return statistics_;
+}
+
+uint64_t PollingScheduler::ticksOf(Clock::duration interval) const {
+  if (interval < resolution_) {
+    throw invalid_argument(
+        "Polling interval can not be shorter than the scheduler resolution");
+  }
+  return static_cast<uint64_t>(interval / resolution_);
+}
+
+uint64_t PollingScheduler::tickOf(Clock::time_point time) const {
+  if (time <= epoch_) {
+    return 0;
+  }
+  return static_cast<uint64_t>((time - epoch_) / resolution_);
+}
+
+uint64_t PollingScheduler::currentTick() const {
+  // the timer thread only advances the wheel when a timer is due
+  return running_ ? max(wheel_.now(), tickOf(Clock::now())) : wheel_.now();
+}
+
+uint64_t PollingScheduler::alignedDeadline(uint64_t ticks) const {
+  // aligned deadlines let equal intervals of a device share a batch
+  return (currentTick() / ticks + 1) * ticks;
+}
+
+void PollingScheduler::wakeTimer(uint64_t deadline) {
+  if (running_ && deadline < wakeup_) {
+    wakeup_ = deadline;
+    stopped_.notify_all();
+  }
+}
+
+bool PollingScheduler::onSchedulerThread() const {
+  auto current = this_thread::get_id();
+  return current == timer_.get_id() ||
+      any_of(workers_.begin(), workers_.end(), [current](const thread& worker) {
+        return worker.get_id() == current;
+      });
+}
+
+PollingScheduler::Clock::time_point PollingScheduler::timeOf(
+    uint64_t tick) const {
+  return epoch_ + resolution_ * static_cast<Clock::rep>(tick);
+}
+
+bool PollingScheduler::matches(PollId id) const {
+  auto index = indexOf(id);
+  return index < registrations_.size() && registrations_[index].active &&
+      registrations_[index].generation == (id >> GENERATION_SHIFT);
+}
+
+void PollingScheduler::collect(uint64_t tick, vector<Task>& tasks) {
+  expired_.clear();
+  wheel_.advance(tick, expired_);
+  due_.clear();
+  for (const auto& expiry : expired_) {
+    auto index = static_cast<uint32_t>(expiry.key);
+    auto& registration = registrations_[index];
+    auto next = registration.deadline + registration.interval;
+    if (next <= tick) {
+      // deadlines stay phase locked, when the scheduler falls behind
+      auto missed = (tick - next) / registration.interval + 1;
+      statistics_.overruns += missed;
+      next += missed * registration.interval;
+    }
+    registration.deadline = next;
+    registration.timer = wheel_.schedule(next, index);
+    if (registration.in_flight) {
+      ++statistics_.overruns;
+    } else {
+      registration.in_flight = true;
+      due_.emplace_back(index, expiry.deadline);
+    }
+  }
+  sort(due_.begin(),
+      due_.end(),
+      [this](const auto& lhs, const auto& rhs) {
+        // registration order within a batch
+        auto lhs_device = registrations_[lhs.first].device;
+        auto rhs_device = registrations_[rhs.first].device;
+        return tie(lhs_device, lhs.second, lhs.first) <
+            tie(rhs_device, rhs.second, rhs.first);
+      });
+  for (size_t first = 0; first < due_.size();) {
+    auto device = registrations_[due_[first].first].device;
+    auto deadline = due_[first].second;
+    auto last = first;
+    Task task{&devices_[device], deadline, {}};
+    while (last < due_.size() &&
+        registrations_[due_[last].first].device == device &&
+        due_[last].second == deadline) {
+      const auto& registration = registrations_[due_[last].first];
+      auto id = (PollId{registration.generation} << GENERATION_SHIFT) |
+          due_[last].first;
+      task.reads.push_back(
+          Read{id, registration.readable, registration.on_read});
+      ++last;
+    }
+    if (task.reads.size() > 1) {
+      statistics_.coalesced += task.reads.size();
+    }
+    tasks.push_back(move(task));
+    first = last;
+  }
+}
+
+void PollingScheduler::execute(Task& task) {
+  PollBatch batch;
+  batch.device_id = *task.device_id;
+  batch.deadline = timeOf(task.deadline);
+  batch.started = Clock::now();
+  batch.results.reserve(task.reads.size());
+  size_t failures = 0;
+  for (const auto& read : task.reads) {
+    try {
+      batch.results.push_back(
+          PollResult{read.id, read.readable->read(), nullptr});
+    } catch (...) {
+      ++failures;
+      batch.results.push_back(
+          PollResult{read.id, DataVariant(), current_exception()});
+    }
+    if (read.on_read) {
+      try {
+        read.on_read(batch.results.back());
+      } catch (...) {
+        // handler exceptions must not stop the worker
+      }
+    }
+  }
+  try {
+    handler_(batch);
+  } catch (...) {
+    // handler exceptions must not stop the worker
+  }
+
+  lock_guard lock(mx_);
+  for (const auto& read : task.reads) {
+    if (matches(read.id)) {
+      registrations_[indexOf(read.id)].in_flight = false;
+    }
+  }
+  auto jitter = max(chrono::duration_cast<PollingStatistics::Duration>(
+                        batch.started - batch.deadline),
+      PollingStatistics::Duration{0});
+  ++statistics_.batches;
+  statistics_.reads += task.reads.size();
+  statistics_.failures += failures;
+  statistics_.total_jitter += jitter;
+  statistics_.max_jitter = max(statistics_.max_jitter, jitter);
+}
+
+void PollingScheduler::timerLoop() {
+  unique_lock lock(mx_);
+  while (running_) {
+    // sleeps until the next timer is due, wakeTimer() cuts the sleep short
+    // for earlier deadlines
+    auto wakeup = wheel_.nextEvent();
+    wakeup_ = wakeup;
+    auto woken = [this, wakeup]() { return !running_ || wakeup_ != wakeup; };
+    if (wakeup == UINT64_MAX) {
+      stopped_.wait(lock, woken);
+      continue;
+    }
+    auto next = timeOf(wakeup);
+    if (stopped_.wait_until(lock, next, woken)) {
+      continue;
+    }
+    auto now = Clock::now();
+    statistics_.max_drift = max(statistics_.max_drift,
+        chrono::duration_cast<PollingStatistics::Duration>(now - next));
+    lock.unlock();
+    poll(now);
+    lock.lock();
+  }
+}
+
+void PollingScheduler::workerLoop() {
+  unique_lock lock(mx_);
+  while (true) {
+    work_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+    if (!running_) {
+      return;
+    }
+    auto task = move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    execute(task);
+    lock.lock();
+  }
+}
+} // namespace Information_Model
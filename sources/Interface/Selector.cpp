@@ -0,0 +1,225 @@
+#include "Selector.hpp"
+
+#include "BitOperations.hpp"
+
+#include <utility>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+constexpr string_view ANY_LEVELS = "**";
+
+detail::LevelPattern compileLevel(
+    const string& pattern, string_view level, bool allow_any_levels) {
+  detail::LevelPattern compiled;
+  if (level.empty()) {
+    throw InvalidSelector(pattern, "Levels can not be empty");
+  }
+  if (level == ANY_LEVELS && allow_any_levels) {
+    compiled.any_levels = true;
+    return compiled;
+  }
+  if (level.find(ANY_LEVELS) != string_view::npos) {
+    throw InvalidSelector(pattern,
+        "** wildcard can only be used as a whole element path level");
+  }
+  size_t begin = 0;
+  for (auto end = level.find('*'); end != string_view::npos;
+       end = level.find('*', begin)) {
+    compiled.pieces.emplace_back(level.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  compiled.pieces.emplace_back(level.substr(begin));
+  return compiled;
+}
+
+unsigned lowestState(uint64_t states) {
+  return detail::trailingZeros(states);
+}
+} // namespace
+
+namespace detail {
+bool LevelPattern::matches(string_view level) const noexcept {
+  if (any_levels) {
+    return true;
+  }
+  const auto& first = pieces.front();
+  if (pieces.size() == 1) {
+    return level == first;
+  }
+  const auto& last = pieces.back();
+  if (level.size() < first.size() + last.size() ||
+      level.substr(0, first.size()) != first ||
+      level.substr(level.size() - last.size()) != last) {
+    return false;
+  }
+  auto rest = level.substr(
+      first.size(), level.size() - first.size() - last.size());
+  // leftmost matches of the inner pieces leave the most room for the others
+  for (size_t i = 1; i + 1 < pieces.size(); ++i) {
+    auto position = rest.find(pieces[i]);
+    if (position == string_view::npos) {
+      return false;
+    }
+    rest.remove_prefix(position + pieces[i].size());
+  }
+  return true;
+}
+} // namespace detail
+
+Selector::Selector(const string& pattern) : pattern_(pattern) {
+  auto separator = pattern_.find(':');
+  if (separator == string::npos) {
+    throw InvalidSelector(pattern_, "Device id pattern must end with a :");
+  }
+  string_view text = pattern_;
+  device_ = compileLevel(pattern_, text.substr(0, separator), false);
+  auto path = text.substr(separator + 1);
+  if (path.find(':') != string_view::npos) {
+    throw InvalidSelector(pattern_, "Element path can not contain a :");
+  }
+  size_t begin = 0;
+  while (true) {
+    auto end = path.find('.', begin);
+    levels_.push_back(compileLevel(pattern_,
+        path.substr(begin, end == string_view::npos ? end : end - begin),
+        true));
+    if (end == string_view::npos) {
+      break;
+    }
+    begin = end + 1;
+  }
+  if (levels_.size() > MAX_LEVELS) {
+    throw InvalidSelector(pattern_,
+        "Element path can not have more than " + to_string(MAX_LEVELS) +
+            " levels");
+  }
+
+  // state i waits for level i, the state after the last level accepts
+  auto accepting = levels_.size();
+  accepting_ = States{1} << accepting;
+  closures_.resize(accepting + 1);
+  closures_[accepting] = accepting_;
+  for (auto state = accepting; state-- > 0;) {
+    auto own = States{1} << state;
+    closures_[state] = own;
+    if (levels_[state].any_levels) {
+      any_levels_ |= own;
+      closures_[state] |= closures_[state + 1];
+    } else if (levels_[state].literal()) {
+      literals_ |= own;
+    }
+  }
+}
+
+bool Selector::matchesDevice(string_view device_id) const noexcept {
+  return device_.matches(device_id);
+}
+
+bool Selector::matches(string_view ref_id) const noexcept {
+  auto separator = ref_id.find(':');
+  if (separator == string_view::npos ||
+      !matchesDevice(ref_id.substr(0, separator))) {
+    return false;
+  }
+  auto path = ref_id.substr(separator + 1);
+  if (path.empty()) {
+    return false;
+  }
+  auto states = closures_.front();
+  size_t begin = 0;
+  while (states != 0) {
+    auto end = path.find('.', begin);
+    states = step(states,
+        path.substr(begin, end == string_view::npos ? end : end - begin));
+    if (end == string_view::npos) {
+      break;
+    }
+    begin = end + 1;
+  }
+  return (states & accepting_) != 0;
+}
+
+vector<ElementPtr> Selector::select(const Device& device) const {
+  vector<ElementPtr> selected;
+  if (matchesDevice(device.id())) {
+    selectIn(
+        device, device.group(), device.id() + ":", closures_.front(), selected);
+  }
+  return selected;
+}
+
+vector<ElementPtr> Selector::select(const vector<DevicePtr>& devices) const {
+  vector<ElementPtr> selected;
+  for (const auto& device : devices) {
+    if (matchesDevice(device->id())) {
+      selectIn(*device,
+          device->group(),
+          device->id() + ":",
+          closures_.front(),
+          selected);
+    }
+  }
+  return selected;
+}
+
+Selector::States Selector::step(
+    States states, string_view level) const noexcept {
+  States next = 0;
+  for (auto active = states & ~accepting_; active != 0;
+       active &= active - 1) {
+    auto state = lowestState(active);
+    if ((any_levels_ >> state & 1U) != 0) {
+      next |= closures_[state];
+    } else if (levels_[state].matches(level)) {
+      next |= closures_[state + 1];
+    }
+  }
+  return next;
+}
+
+void Selector::selectIn(const Device& device,
+    const GroupPtr& group,
+    const string& prefix,
+    States states,
+    vector<ElementPtr>& selected) const {
+  auto active = states & ~accepting_;
+  // without ** levels only a single state is active at a time, so a literal
+  // level names the only element of this group, that can match
+  if ((active & (active - 1)) == 0 && (active & literals_) != 0) {
+    const auto& level = levels_[lowestState(active)].pieces.front();
+    auto id = prefix + level;
+    auto element = device.tryElement(id);
+    if (element) {
+      selectElement(device, *element, id, level, states, selected);
+    }
+    return;
+  }
+  group->visit([&](const ElementPtr& element) {
+    auto id = element->id();
+    selectElement(device,
+        element,
+        id,
+        string_view(id).substr(prefix.size()),
+        states,
+        selected);
+  });
+}
+
+void Selector::selectElement(const Device& device,
+    const ElementPtr& element,
+    const string& id,
+    string_view level,
+    States states,
+    vector<ElementPtr>& selected) const {
+  auto next = step(states, level);
+  if ((next & accepting_) != 0) {
+    selected.push_back(element);
+  }
+  if ((next & ~accepting_) != 0 && element->type() == ElementType::Group) {
+    selectIn(
+        device, get<GroupPtr>(element->function()), id + ".", next, selected);
+  }
+}
+} // namespace Information_Model
@@ -0,0 +1,305 @@
+#include "SeriesCompression.hpp"
+
+#include "BitOperations.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+using detail::leadingZeros;
+using detail::trailingZeros;
+
+// NOLINTBEGIN(readability-magic-numbers)
+constexpr unsigned WORD_BITS = 64;
+
+constexpr uint64_t lowBits(uint64_t value, unsigned count) {
+  return count >= WORD_BITS ? value : value & ((uint64_t{1} << count) - 1);
+}
+
+constexpr uint64_t zigzag(uint64_t value) {
+  // arithmetic shift of the sign bit, without implementation defined shifts
+  return (value << 1U) ^ (0 - (value >> 63U));
+}
+
+constexpr uint64_t unzigzag(uint64_t value) {
+  return (value >> 1U) ^ (0 - (value & 1U));
+}
+
+uint64_t toBits(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double fromBits(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * @brief Delta-of-delta buckets, selected by a unary prefix. The last bucket
+ * stores the full zigzag encoded value
+ */
+constexpr unsigned DOD_BUCKETS[] = {7, 12, 20, 64};
+// NOLINTEND(readability-magic-numbers)
+} // namespace
+
+namespace detail {
+void BitWriter::write(uint64_t value, unsigned count) {
+  if (count == 0) {
+    return;
+  }
+  value = lowBits(value, count);
+  auto offset = static_cast<unsigned>(bits % WORD_BITS);
+  if (offset == 0) {
+    words.push_back(value);
+  } else {
+    words.back() |= value << offset;
+    if (offset + count > WORD_BITS) {
+      words.push_back(value >> (WORD_BITS - offset));
+    }
+  }
+  bits += count;
+}
+
+uint64_t BitReader::read(unsigned count) {
+  if (count == 0) {
+    return 0;
+  }
+  auto index = bits / WORD_BITS;
+  auto offset = static_cast<unsigned>(bits % WORD_BITS);
+  // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  auto value = words[index] >> offset;
+  if (offset + count > WORD_BITS) {
+    value |= words[index + 1] << (WORD_BITS - offset);
+  }
+  // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  bits += count;
+  return lowBits(value, count);
+}
+
+// NOLINTBEGIN(readability-magic-numbers)
+void XorDoubleCodec::encode(BitWriter& writer, State& state, double value) {
+  auto bits = toBits(value);
+  if (state.first) {
+    writer.write(bits, WORD_BITS);
+    state.previous = bits;
+    state.first = false;
+    return;
+  }
+  auto xored = bits ^ state.previous;
+  state.previous = bits;
+  if (xored == 0) {
+    writer.write(0, 1);
+    return;
+  }
+  writer.write(1, 1);
+  // leading zero count is stored in 5 bits
+  auto leading = min(leadingZeros(xored), 31U);
+  auto trailing = trailingZeros(xored);
+  if (state.has_window && leading >= state.leading &&
+      trailing >= state.trailing) {
+    writer.write(0, 1);
+    writer.write(xored >> state.trailing,
+        WORD_BITS - state.leading - state.trailing);
+    return;
+  }
+  auto meaningful = WORD_BITS - leading - trailing;
+  writer.write(1, 1);
+  writer.write(leading, 5);
+  // 64 meaningful bits are stored as 0
+  writer.write(meaningful, 6);
+  writer.write(xored >> trailing, meaningful);
+  state.leading = leading;
+  state.trailing = trailing;
+  state.has_window = true;
+}
+
+double XorDoubleCodec::decode(BitReader& reader, State& state) {
+  if (state.first) {
+    state.previous = reader.read(WORD_BITS);
+    state.first = false;
+    return fromBits(state.previous);
+  }
+  if (!reader.readBit()) {
+    return fromBits(state.previous);
+  }
+  if (reader.readBit()) {
+    state.leading = static_cast<unsigned>(reader.read(5));
+    auto meaningful = static_cast<unsigned>(reader.read(6));
+    if (meaningful == 0) {
+      meaningful = WORD_BITS;
+    }
+    state.trailing = WORD_BITS - state.leading - meaningful;
+  }
+  auto meaningful = WORD_BITS - state.leading - state.trailing;
+  state.previous ^= reader.read(meaningful) << state.trailing;
+  return fromBits(state.previous);
+}
+
+void DeltaOfDeltaCodec::encode(BitWriter& writer, State& state, int64_t value) {
+  auto current = static_cast<uint64_t>(value);
+  if (state.first) {
+    writer.write(current, WORD_BITS);
+    state.previous = current;
+    state.first = false;
+    return;
+  }
+  // unsigned arithmetic wraps around instead of overflowing
+  auto delta = current - state.previous;
+  auto encoded = zigzag(delta - state.previous_delta);
+  state.previous = current;
+  state.previous_delta = delta;
+  if (encoded == 0) {
+    writer.write(0, 1);
+    return;
+  }
+  unsigned prefix = 0;
+  for (auto bucket : DOD_BUCKETS) {
+    auto is_last = bucket == WORD_BITS;
+    if (is_last || encoded < (uint64_t{1} << bucket)) {
+      // unary prefix of ones, terminated by a zero unless it is the last one
+      writer.write(~uint64_t{0}, prefix + 1);
+      if (!is_last) {
+        writer.write(0, 1);
+      }
+      writer.write(encoded, bucket);
+      return;
+    }
+    ++prefix;
+  }
+}
+
+int64_t DeltaOfDeltaCodec::decode(BitReader& reader, State& state) {
+  if (state.first) {
+    state.previous = reader.read(WORD_BITS);
+    state.first = false;
+    return static_cast<int64_t>(state.previous);
+  }
+  uint64_t encoded = 0;
+  if (reader.readBit()) {
+    for (auto bucket : DOD_BUCKETS) {
+      if (bucket == WORD_BITS || !reader.readBit()) {
+        encoded = reader.read(bucket);
+        break;
+      }
+    }
+  }
+  state.previous_delta += unzigzag(encoded);
+  state.previous += state.previous_delta;
+  return static_cast<int64_t>(state.previous);
+}
+
+void ZigZagVarintCodec::encode(
+    BitWriter& writer, State& state, intmax_t value) {
+  auto current = static_cast<uint64_t>(value);
+  auto encoded = zigzag(current - state.previous);
+  state.previous = current;
+  while (encoded >= 0x80U) {
+    writer.write((encoded & 0x7FU) | 0x80U, 8);
+    encoded >>= 7U;
+  }
+  writer.write(encoded, 8);
+}
+
+intmax_t ZigZagVarintCodec::decode(BitReader& reader, State& state) {
+  uint64_t encoded = 0;
+  unsigned shift = 0;
+  uint64_t group;
+  do {
+    group = reader.read(8);
+    encoded |= (group & 0x7FU) << shift;
+    shift += 7;
+  } while ((group & 0x80U) != 0);
+  state.previous += unzigzag(encoded);
+  return static_cast<intmax_t>(state.previous);
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace detail
+
+template <typename Codec>
+CompressedSeries<Codec>::CompressedSeries(size_t block_size)
+    : block_size_(block_size) {
+  if (block_size == 0) {
+    throw invalid_argument("Compressed series block size must not be 0");
+  }
+}
+
+template <typename Codec> void CompressedSeries<Codec>::append(Value value) {
+  if (size_ % block_size_ == 0) {
+    block_offsets_.push_back(writer_.bitSize());
+    state_ = typename Codec::State{};
+  }
+  Codec::encode(writer_, state_, value);
+  ++size_;
+}
+
+template <typename Codec>
+size_t CompressedSeries<Codec>::compressedSize() const {
+  return writer_.words.size() * sizeof(uint64_t) +
+      block_offsets_.size() * sizeof(size_t);
+}
+
+template <typename Codec>
+typename Codec::Value CompressedSeries<Codec>::at(size_t index) const {
+  if (index >= size_) {
+    throw out_of_range("Compressed value " + to_string(index) +
+        " does not exist. Series has " + to_string(size_) + " values");
+  }
+  Value result{};
+  decode(index, 1, &result);
+  return result;
+}
+
+template <typename Codec>
+size_t CompressedSeries<Codec>::decode(
+    size_t first, size_t count, Value* output) const {
+  if (first >= size_) {
+    return 0;
+  }
+  count = min(count, size_ - first);
+  auto block = first / block_size_;
+  auto index = block * block_size_;
+  detail::BitReader reader(writer_.words, block_offsets_[block]);
+  typename Codec::State state;
+  // skip values before the first requested one
+  for (; index < first; ++index) {
+    if (index % block_size_ == 0) {
+      state = typename Codec::State{};
+    }
+    Codec::decode(reader, state);
+  }
+  for (size_t i = 0; i < count; ++i, ++index) {
+    if (index % block_size_ == 0) {
+      state = typename Codec::State{};
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    output[i] = Codec::decode(reader, state);
+  }
+  return count;
+}
+
+template <typename Codec>
+AlignedVector<typename Codec::Value> CompressedSeries<Codec>::decodeAll()
+    const {
+  AlignedVector<Value> result(size_);
+  decode(0, size_, result.data());
+  return result;
+}
+
+template <typename Codec> void CompressedSeries<Codec>::clear() {
+  size_ = 0;
+  writer_ = detail::BitWriter{};
+  state_ = typename Codec::State{};
+  block_offsets_.clear();
+}
+
+template class CompressedSeries<detail::XorDoubleCodec>;
+template class CompressedSeries<detail::DeltaOfDeltaCodec>;
+template class CompressedSeries<detail::ZigZagVarintCodec>;
+} // namespace Information_Model
@@ -0,0 +1,536 @@
+#include "StreamOperators.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Information_Model {
+using namespace std;
+
+namespace detail {
+/**
+ * @brief Operator or subscription of a StreamPipeline. Parents own their
+ * children, nodes without children, Stream handles and subscriptions are
+ * detached from their parents
+ */
+struct StreamNode {
+  virtual ~StreamNode() = default;
+
+  virtual void process(const StreamSample& sample) = 0;
+
+  void forward(const StreamSample& sample) {
+    struct Forwarding {
+      explicit Forwarding(StreamNode* node) : node_(node) {
+        ++node_->forwarding_;
+      }
+      ~Forwarding() {
+        if (--node_->forwarding_ == 0) {
+          node_->compact();
+        }
+      }
+
+    private:
+      StreamNode* node_;
+    } forwarding(this);
+    // children can be added or removed by subscribers, while the sample is
+    // forwarded, removed children leave an empty slot until forwarding ends
+    for (size_t i = 0; i < children_.size(); ++i) {
+      if (auto child = children_[i]) {
+        child->process(sample);
+      }
+    }
+  }
+
+  void attach(shared_ptr<StreamNode> child) {
+    child->parent_ = this;
+    children_.push_back(move(child));
+    ++live_children_;
+  }
+
+  /**
+   * @brief Detaches this node and every ancestor, that is left without
+   * children and Stream handles. Must be called with the pipeline lock held
+   */
+  void prune() {
+    auto* node = this;
+    while (node->parent_ != nullptr && node->live_children_ == 0 &&
+        node->handles == 0) {
+      auto* parent = exchange(node->parent_, nullptr);
+      // might destroy the node
+      parent->remove(node);
+      node = parent;
+    }
+  }
+
+  /**
+   * @brief Number of Stream handles, that refer to this node
+   */
+  atomic<size_t> handles{0};
+
+private:
+  void remove(StreamNode* child) {
+    for (auto& slot : children_) {
+      if (slot.get() == child) {
+        --live_children_;
+        slot.reset();
+        break;
+      }
+    }
+    if (forwarding_ == 0) {
+      compact();
+    }
+  }
+
+  void compact() {
+    if (live_children_ != children_.size()) {
+      children_.erase(
+          remove_if(children_.begin(), children_.end(), logical_not<>()),
+          children_.end());
+    }
+  }
+
+  StreamNode* parent_ = nullptr;
+  vector<shared_ptr<StreamNode>> children_;
+  size_t live_children_ = 0;
+  size_t forwarding_ = 0;
+};
+
+struct PipelineState {
+  recursive_mutex mx;
+  shared_ptr<StreamNode> source;
+  size_t samples = 0;
+};
+} // namespace detail
+
+namespace {
+struct SourceNode final : public detail::StreamNode {
+  void process(const StreamSample& sample) final { forward(sample); }
+};
+
+struct MapNode final : public detail::StreamNode {
+  explicit MapNode(Stream::Transform transform)
+      : transform_(move(transform)) {}
+
+  void process(const StreamSample& sample) final {
+    forward(StreamSample{sample.time, transform_(sample.value)});
+  }
+
+private:
+  Stream::Transform transform_;
+};
+
+struct FilterNode final : public detail::StreamNode {
+  explicit FilterNode(Stream::Predicate predicate)
+      : predicate_(move(predicate)) {}
+
+  void process(const StreamSample& sample) final {
+    if (predicate_(sample)) {
+      forward(sample);
+    }
+  }
+
+private:
+  Stream::Predicate predicate_;
+};
+
+struct DeadbandNode final : public detail::StreamNode {
+  explicit DeadbandNode(double threshold) : threshold_(threshold) {}
+
+  void process(const StreamSample& sample) final {
+    if (!has_last_ || fabs(sample.value - last_) > threshold_) {
+      has_last_ = true;
+      last_ = sample.value;
+      forward(sample);
+    }
+  }
+
+private:
+  double threshold_;
+  double last_ = 0;
+  bool has_last_ = false;
+};
+
+struct RateLimitNode final : public detail::StreamNode {
+  explicit RateLimitNode(double max_change_per_second)
+      : max_change_(max_change_per_second) {}
+
+  void process(const StreamSample& sample) final {
+    if (has_last_) {
+      constexpr double microseconds_per_second = 1e6;
+      auto elapsed = static_cast<double>(sample.time - last_.time) /
+          microseconds_per_second;
+      auto limit = max_change_ * max(elapsed, 0.0);
+      auto change = clamp(sample.value - last_.value, -limit, limit);
+      last_ = StreamSample{sample.time, last_.value + change};
+    } else {
+      has_last_ = true;
+      last_ = sample;
+    }
+    forward(last_);
+  }
+
+private:
+  double max_change_;
+  StreamSample last_{0, 0};
+  bool has_last_ = false;
+};
+
+/**
+ * @brief Neumaier compensated sum, keeps the running window sum accurate when
+ * values are added and removed over a long time
+ */
+struct CompensatedSum {
+  void add(double value) {
+    auto total = sum + value;
+    if (fabs(sum) >= fabs(value)) {
+      compensation += (sum - total) + value;
+    } else {
+      compensation += (value - total) + sum;
+    }
+    sum = total;
+  }
+
+  double value() const { return sum + compensation; }
+
+  double sum = 0;
+  double compensation = 0;
+};
+
+/**
+ * @brief Incremental window aggregate. Min and max are tracked with monotonic
+ * queues, so adding and removing samples takes amortized constant time
+ */
+struct WindowState {
+  using Entry = pair<uint64_t, double>;
+
+  void add(uint64_t sequence, double value) {
+    ++count;
+    sum.add(value);
+    last = value;
+    while (!minimums.empty() && minimums.back().second >= value) {
+      minimums.pop_back();
+    }
+    minimums.emplace_back(sequence, value);
+    while (!maximums.empty() && maximums.back().second <= value) {
+      maximums.pop_back();
+    }
+    maximums.emplace_back(sequence, value);
+  }
+
+  void remove(uint64_t sequence, double value) {
+    --count;
+    sum.add(-value);
+    if (!minimums.empty() && minimums.front().first == sequence) {
+      minimums.pop_front();
+    }
+    if (!maximums.empty() && maximums.front().first == sequence) {
+      maximums.pop_front();
+    }
+  }
+
+  void reset() {
+    count = 0;
+    sum = CompensatedSum{};
+    minimums.clear();
+    maximums.clear();
+  }
+
+  double result(WindowAggregate aggregate) const {
+    switch (aggregate) {
+    case WindowAggregate::Count:
+      return static_cast<double>(count);
+    case WindowAggregate::Sum:
+      return sum.value();
+    case WindowAggregate::Mean:
+      return sum.value() / static_cast<double>(count);
+    case WindowAggregate::Min:
+      return minimums.front().second;
+    case WindowAggregate::Max:
+      return maximums.front().second;
+    case WindowAggregate::Last:
+    default:
+      return last;
+    }
+  }
+
+  size_t count = 0;
+  CompensatedSum sum;
+  double last = 0;
+  deque<Entry> minimums;
+  deque<Entry> maximums;
+};
+
+struct TumblingWindowNode final : public detail::StreamNode {
+  TumblingWindowNode(size_t size, WindowAggregate aggregate)
+      : size_(size), aggregate_(aggregate) {}
+
+  void process(const StreamSample& sample) final {
+    window_.add(sequence_++, sample.value);
+    if (window_.count == size_) {
+      auto result = window_.result(aggregate_);
+      window_.reset();
+      forward(StreamSample{sample.time, result});
+    }
+  }
+
+private:
+  size_t size_;
+  WindowAggregate aggregate_;
+  WindowState window_;
+  uint64_t sequence_ = 0;
+};
+
+struct SlidingWindowNode final : public detail::StreamNode {
+  SlidingWindowNode(size_t size, WindowAggregate aggregate)
+      : size_(size), aggregate_(aggregate) {}
+
+  void process(const StreamSample& sample) final {
+    window_.add(sequence_, sample.value);
+    samples_.emplace_back(sequence_, sample.value);
+    ++sequence_;
+    if (samples_.size() > size_) {
+      auto [sequence, value] = samples_.front();
+      window_.remove(sequence, value);
+      samples_.pop_front();
+    }
+    forward(StreamSample{sample.time, window_.result(aggregate_)});
+  }
+
+private:
+  size_t size_;
+  WindowAggregate aggregate_;
+  WindowState window_;
+  deque<WindowState::Entry> samples_;
+  uint64_t sequence_ = 0;
+};
+
+struct TimeWindowNode final : public detail::StreamNode {
+  TimeWindowNode(chrono::microseconds duration, WindowAggregate aggregate)
+      : duration_(duration.count()), aggregate_(aggregate) {}
+
+  void process(const StreamSample& sample) final {
+    window_.add(sequence_, sample.value);
+    samples_.push_back(TimedEntry{sequence_, sample});
+    ++sequence_;
+    while (samples_.front().sample.time <= sample.time - duration_) {
+      const auto& oldest = samples_.front();
+      window_.remove(oldest.sequence, oldest.sample.value);
+      samples_.pop_front();
+    }
+    forward(StreamSample{sample.time, window_.result(aggregate_)});
+  }
+
+private:
+  struct TimedEntry {
+    uint64_t sequence;
+    StreamSample sample;
+  };
+
+  int64_t duration_;
+  WindowAggregate aggregate_;
+  WindowState window_;
+  deque<TimedEntry> samples_;
+  uint64_t sequence_ = 0;
+};
+
+struct SinkNode final : public detail::StreamNode {
+  explicit SinkNode(Stream::SampleCallback callback)
+      : callback(make_shared<const Stream::SampleCallback>(move(callback))) {}
+
+  void process(const StreamSample& sample) final {
+    // the subscription can be released from within the callback, the local
+    // copy keeps the running callback alive until it returns
+    if (auto running = callback) {
+      (*running)(sample);
+    }
+  }
+
+  shared_ptr<const Stream::SampleCallback> callback;
+};
+
+struct SinkObserver final : public Observer {
+  SinkObserver(weak_ptr<detail::PipelineState> state, weak_ptr<SinkNode> sink)
+      : state_(move(state)), sink_(move(sink)) {}
+
+  ~SinkObserver() override {
+    if (auto state = state_.lock()) {
+      lock_guard lock(state->mx);
+      if (auto sink = sink_.lock()) {
+        sink->callback.reset();
+        sink->prune();
+      }
+    }
+  }
+
+private:
+  weak_ptr<detail::PipelineState> state_;
+  weak_ptr<SinkNode> sink_;
+};
+
+double toSampleValue(const DataVariant& value) {
+  return visit(
+      [&value](const auto& native) -> double {
+        using Native = decay_t<decltype(native)>;
+        if constexpr (is_arithmetic_v<NativeTypeOf_t<Native>> &&
+            !is_same_v<Native, bool>) {
+          return static_cast<double>(toNative(native));
+        } else {
+          throw ConversionNotSupported(toDataType(value), DataType::Double);
+        }
+      },
+      value);
+}
+
+int64_t now() {
+  return chrono::duration_cast<chrono::microseconds>(
+      chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void pushSample(detail::PipelineState& state, const StreamSample& sample) {
+  lock_guard lock(state.mx);
+  ++state.samples;
+  state.source->process(sample);
+}
+} // namespace
+
+Stream::Stream(shared_ptr<detail::PipelineState> state,
+    shared_ptr<detail::StreamNode> node)
+    : state_(move(state)), node_(move(node)) {
+  ++node_->handles;
+}
+
+Stream::Stream(const Stream& other)
+    : state_(other.state_), node_(other.node_) {
+  if (node_) {
+    ++node_->handles;
+  }
+}
+
+Stream::Stream(Stream&& other) noexcept
+    : state_(move(other.state_)), node_(move(other.node_)) {}
+
+Stream& Stream::operator=(const Stream& other) {
+  if (this != &other) {
+    *this = Stream(other);
+  }
+  return *this;
+}
+
+Stream& Stream::operator=(Stream&& other) noexcept {
+  if (this != &other) {
+    release();
+    state_ = move(other.state_);
+    node_ = move(other.node_);
+  }
+  return *this;
+}
+
+Stream::~Stream() { release(); }
+
+void Stream::release() noexcept {
+  if (node_ && --node_->handles == 0) {
+    lock_guard lock(state_->mx);
+    node_->prune();
+  }
+  node_.reset();
+  state_.reset();
+}
+
+Stream Stream::then(const shared_ptr<detail::StreamNode>& node) const {
+  lock_guard lock(state_->mx);
+  node_->attach(node);
+  return Stream(state_, node);
+}
+
+Stream Stream::map(const Transform& transform) const {
+  return then(make_shared<MapNode>(transform));
+}
+
+Stream Stream::filter(const Predicate& predicate) const {
+  return then(make_shared<FilterNode>(predicate));
+}
+
+Stream Stream::deadband(double threshold) const {
+  if (threshold < 0) {
+    throw invalid_argument("Deadband threshold must not be negative");
+  }
+  return then(make_shared<DeadbandNode>(threshold));
+}
+
+Stream Stream::rateLimit(double max_change_per_second) const {
+  if (max_change_per_second < 0) {
+    throw invalid_argument("Rate of change limit must not be negative");
+  }
+  return then(make_shared<RateLimitNode>(max_change_per_second));
+}
+
+Stream Stream::tumblingWindow(size_t size, WindowAggregate aggregate) const {
+  if (size == 0) {
+    throw invalid_argument("Window size must be greater than 0");
+  }
+  return then(make_shared<TumblingWindowNode>(size, aggregate));
+}
+
+Stream Stream::slidingWindow(size_t size, WindowAggregate aggregate) const {
+  if (size == 0) {
+    throw invalid_argument("Window size must be greater than 0");
+  }
+  return then(make_shared<SlidingWindowNode>(size, aggregate));
+}
+
+Stream Stream::timeWindow(
+    chrono::microseconds duration, WindowAggregate aggregate) const {
+  if (duration.count() <= 0) {
+    throw invalid_argument("Window duration must be positive");
+  }
+  return then(make_shared<TimeWindowNode>(duration, aggregate));
+}
+
+ObserverPtr Stream::subscribe(const SampleCallback& callback) const {
+  auto sink = make_shared<SinkNode>(callback);
+  {
+    lock_guard lock(state_->mx);
+    node_->attach(sink);
+  }
+  return make_shared<SinkObserver>(state_, sink);
+}
+
+StreamPipeline::StreamPipeline()
+    : state_(make_shared<detail::PipelineState>()) {
+  state_->source = make_shared<SourceNode>();
+}
+
+Stream StreamPipeline::source() const { return Stream(state_, state_->source); }
+
+ObserverPtr StreamPipeline::attach(const ObservablePtr& observable,
+    const Observable::ExceptionHandler& handler) {
+  weak_ptr<detail::PipelineState> weak_state = state_;
+  return observable->subscribe(
+      [weak_state](const shared_ptr<DataVariant>& value) {
+        if (auto state = weak_state.lock()) {
+          pushSample(*state, StreamSample{now(), toSampleValue(*value)});
+        }
+      },
+      handler);
+}
+
+void StreamPipeline::push(const DataVariant& value) {
+  push(StreamSample{now(), toSampleValue(value)});
+}
+
+void StreamPipeline::push(const StreamSample& sample) {
+  pushSample(*state_, sample);
+}
+
+size_t StreamPipeline::sampleCount() const {
+  lock_guard lock(state_->mx);
+  return state_->samples;
+}
+} // namespace Information_Model
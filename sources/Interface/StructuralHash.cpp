@@ -0,0 +1,197 @@
+#include "StructuralHash.hpp"
+
+#include <Variant_Visitor/Visitor.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+size_t hashText(string_view text, size_t seed) {
+  return hashBytes(text.data(), text.size(), seed);
+}
+
+/**
+ * @brief Strips the device id and the following colon from a given element
+ * id, ids without a colon are already relative
+ */
+string_view relativeId(string_view id) {
+  auto separator = id.find(':');
+  return separator == string_view::npos ? id : id.substr(separator + 1);
+}
+
+// NOLINTBEGIN(readability-magic-numbers)
+uint64_t packFlags(uint8_t first, uint8_t second, uint8_t third) {
+  return uint64_t{first} | uint64_t{second} << 8U | uint64_t{third} << 16U;
+}
+// NOLINTEND(readability-magic-numbers)
+
+size_t rootHash(const Device& device) {
+  return ownStructureHash(device.id() + ":",
+      device.name(),
+      device.description(),
+      ElementType::Group,
+      DataType::None,
+      false,
+      {});
+}
+
+void diffGroups(
+    const GroupPtr& base, const GroupPtr& compared, StructureDiff& diff);
+
+void diffElements(
+    const ElementPtr& base, const ElementPtr& compared, StructureDiff& diff) {
+  if (base->structuralHash() == compared->structuralHash()) {
+    return;
+  }
+  if (ownStructureHash(*base) != ownStructureHash(*compared)) {
+    diff.changed.push_back(compared->id());
+  }
+  if (base->type() == ElementType::Group &&
+      compared->type() == ElementType::Group) {
+    diffGroups(get<GroupPtr>(base->function()),
+        get<GroupPtr>(compared->function()),
+        diff);
+  }
+}
+
+void diffGroups(
+    const GroupPtr& base, const GroupPtr& compared, StructureDiff& diff) {
+  auto base_elements = base->asVector();
+  auto compared_elements = compared->asVector();
+  // elements at the same position with equal hashes also have equal relative
+  // ids, so only the remaining ones are matched by their relative ids
+  vector<bool> matched(base_elements.size(), false);
+  vector<size_t> pending;
+  for (size_t i = 0; i < compared_elements.size(); ++i) {
+    if (i < base_elements.size() &&
+        base_elements[i]->structuralHash() ==
+            compared_elements[i]->structuralHash()) {
+      matched[i] = true;
+    } else {
+      pending.push_back(i);
+    }
+  }
+  unordered_map<string, size_t> unmatched;
+  for (size_t i = 0; i < base_elements.size(); ++i) {
+    if (!matched[i]) {
+      unmatched.emplace(relativeId(base_elements[i]->id()), i);
+    }
+  }
+  for (auto i : pending) {
+    const auto& element = compared_elements[i];
+    auto it = unmatched.find(string(relativeId(element->id())));
+    if (it == unmatched.end()) {
+      diff.added.push_back(element->id());
+      continue;
+    }
+    diffElements(base_elements[it->second], element, diff);
+    matched[it->second] = true;
+    unmatched.erase(it);
+  }
+  // keeps removed ids in the base group order
+  for (size_t i = 0; i < base_elements.size(); ++i) {
+    if (!matched[i]) {
+      diff.removed.push_back(base_elements[i]->id());
+    }
+  }
+}
+} // namespace
+
+size_t ownStructureHash(string_view id,
+    string_view name,
+    string_view description,
+    ElementType type,
+    DataType data_type,
+    bool write_only,
+    const ParameterTypes& parameter_types) {
+  auto hash = hashText(relativeId(id), 0);
+  hash = hashText(name, hash);
+  hash = hashText(description, hash);
+  auto flags = packFlags(static_cast<uint8_t>(type),
+      static_cast<uint8_t>(data_type),
+      write_only ? 1 : 0);
+  hash = hashBytes(&flags, sizeof(flags), hash);
+  vector<pair<uintmax_t, ParameterType>> parameters(
+      parameter_types.begin(), parameter_types.end());
+  sort(parameters.begin(),
+      parameters.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  for (const auto& [position, parameter] : parameters) {
+    uint64_t record[2] = {static_cast<uint64_t>(position),
+        packFlags(static_cast<uint8_t>(parameter.type),
+            parameter.mandatory ? 1 : 0,
+            parameter.allow_widening ? 1 : 0)};
+    hash = hashBytes(record, sizeof(record), hash);
+  }
+  return hash;
+}
+
+size_t ownStructureHash(const Element& element) {
+  auto data_type = DataType::None;
+  bool write_only = false;
+  ParameterTypes parameter_types;
+  Variant_Visitor::match(
+      element.function(),
+      [](const GroupPtr&) {},
+      [&data_type](const ReadablePtr& readable) {
+        data_type = readable->dataType();
+      },
+      [&data_type, &write_only](const WritablePtr& writable) {
+        data_type = writable->dataType();
+        write_only = writable->isWriteOnly();
+      },
+      [&data_type](const ObservablePtr& observable) {
+        data_type = observable->dataType();
+      },
+      [&data_type, &parameter_types](const CallablePtr& callable) {
+        data_type = callable->resultType();
+        parameter_types = callable->parameterTypes();
+      });
+  return ownStructureHash(element.id(),
+      element.name(),
+      element.description(),
+      element.type(),
+      data_type,
+      write_only,
+      parameter_types);
+}
+
+size_t combineStructureHash(size_t group_hash, size_t element_hash) noexcept {
+  return hashBytes(&element_hash, sizeof(element_hash), group_hash);
+}
+
+size_t Element::structuralHash() const {
+  auto hash = ownStructureHash(*this);
+  if (type() == ElementType::Group) {
+    for (const auto& element : get<GroupPtr>(function())->asVector()) {
+      hash = combineStructureHash(hash, element->structuralHash());
+    }
+  }
+  return hash;
+}
+
+size_t Device::structuralHash() const {
+  auto hash = rootHash(*this);
+  for (const auto& element : group()->asVector()) {
+    hash = combineStructureHash(hash, element->structuralHash());
+  }
+  return hash;
+}
+
+StructureDiff diffStructure(const Device& base, const Device& compared) {
+  StructureDiff diff;
+  if (base.structuralHash() == compared.structuralHash()) {
+    return diff;
+  }
+  if (rootHash(base) != rootHash(compared)) {
+    diff.changed.push_back(compared.id() + ":");
+  }
+  diffGroups(base.group(), compared.group(), diff);
+  return diff;
+}
+} // namespace Information_Model
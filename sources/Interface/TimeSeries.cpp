@@ -0,0 +1,140 @@
+#include "TimeSeries.hpp"
+
+#include <chrono>
+
+namespace Information_Model {
+using namespace std;
+
+int64_t toEpochMicroseconds(const Timestamp& timestamp) {
+  return chrono::duration_cast<chrono::microseconds>(
+      toTimepoint(timestamp).time_since_epoch())
+      .count();
+}
+
+Timestamp fromEpochMicroseconds(int64_t microseconds) {
+  return toTimestamp(chrono::system_clock::time_point(
+      chrono::duration_cast<chrono::system_clock::duration>(
+          chrono::microseconds(microseconds))));
+}
+
+namespace {
+unique_ptr<detail::SeriesColumn> makeColumn(DataType type, size_t capacity) {
+  return visitDataType(
+      type, [type, capacity](auto tag) -> unique_ptr<detail::SeriesColumn> {
+        using Native = typename decltype(tag)::type;
+        if constexpr (is_same_v<Native, IntegerArray> ||
+            is_same_v<Native, UnsignedIntegerArray> ||
+            is_same_v<Native, DoubleArray> ||
+            is_same_v<Native, Integer16Array>) {
+          throw invalid_argument(
+              toString(type) + " values can not be stored in a TimeSeries");
+        } else {
+          using Column = typename detail::SeriesColumnOf<Native>::type;
+          return make_unique<Column>(capacity);
+        }
+      });
+}
+} // namespace
+
+TimeSeries::TimeSeries(DataType type, size_t capacity)
+    : type_(type), capacity_(capacity), times_(capacity) {
+  if (capacity == 0) {
+    throw invalid_argument("TimeSeries capacity must be greater than 0");
+  }
+  column_ = makeColumn(type, capacity);
+}
+
+void TimeSeries::append(int64_t time, const DataVariant& value) {
+  auto value_type = toDataType(value);
+  if (value_type == DataType::Timestamp) {
+    // checked first, so an invalid timestamp does not reserve a slot
+    verifyTimestamp(get<Timestamp>(value));
+  }
+  if (value_type == type_) {
+    column_->set(reserveSlot(time), value);
+  } else if (isLosslesslyConvertible(value_type, type_)) {
+    column_->set(reserveSlot(time), widen(value, type_));
+  } else {
+    throw ConversionNotSupported(value_type, type_);
+  }
+}
+
+void TimeSeries::append(const Timestamp& time, const DataVariant& value) {
+  append(toEpochMicroseconds(time), value);
+}
+
+int64_t TimeSeries::timeAt(size_t index) const {
+  if (index >= size_) {
+    throw out_of_range("TimeSeries sample " + to_string(index) +
+        " does not exist. TimeSeries has " + to_string(size_) + " samples");
+  }
+  return times_[slotOf(index)];
+}
+
+DataVariant TimeSeries::valueAt(size_t index) const {
+  if (index >= size_) {
+    throw out_of_range("TimeSeries sample " + to_string(index) +
+        " does not exist. TimeSeries has " + to_string(size_) + " samples");
+  }
+  return column_->get(slotOf(index));
+}
+
+size_t TimeSeries::lowerBound(int64_t time) const {
+  size_t first = 0;
+  size_t count = size_;
+  while (count > 0) {
+    auto step = count / 2;
+    auto middle = first + step;
+    if (times_[slotOf(middle)] < time) {
+      first = middle + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
+pair<size_t, size_t> TimeSeries::range(int64_t from, int64_t to) const {
+  if (from >= to) {
+    return {0, 0};
+  }
+  return {lowerBound(from), lowerBound(to)};
+}
+
+size_t TimeSeries::reserveSlot(int64_t time) {
+  if (size_ > 0 && time < times_[slotOf(size_ - 1)]) {
+    throw invalid_argument("TimeSeries samples must be appended in time order");
+  }
+  if (size_ == capacity_) {
+    evictOldest();
+  }
+  auto slot = slotOf(size_);
+  times_[slot] = time;
+  ++size_;
+  return slot;
+}
+
+void TimeSeries::evictOldest() {
+  column_->release(head_);
+  head_ = slotOf(1);
+  --size_;
+}
+
+void TimeSeries::evictBefore(int64_t time) {
+  auto count = lowerBound(time);
+  for (size_t i = 0; i < count; ++i) {
+    evictOldest();
+  }
+}
+
+void TimeSeries::clear() {
+  head_ = 0;
+  size_ = 0;
+  column_->clear();
+}
+
+size_t TimeSeries::memoryUsage() const {
+  return times_.capacity() * sizeof(int64_t) + column_->memoryUsage();
+}
+} // namespace Information_Model
@@ -0,0 +1,193 @@
+#include "TimerWheel.hpp"
+
+#include "BitOperations.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Information_Model {
+using namespace std;
+
+namespace {
+using detail::bitWidth;
+using detail::trailingZeros;
+
+constexpr uint64_t SLOT_MASK = TimerWheel::SLOTS - 1;
+
+constexpr unsigned levelShift(size_t level) {
+  return static_cast<unsigned>(level * TimerWheel::SLOT_BITS);
+}
+
+constexpr size_t slotOf(uint64_t tick, size_t level) {
+  return static_cast<size_t>((tick >> levelShift(level)) & SLOT_MASK);
+}
+
+constexpr uint64_t INDEX_MASK = UINT32_MAX;
+constexpr unsigned GENERATION_SHIFT = 32;
+} // namespace
+
+TimerWheel::TimerWheel(uint64_t start_tick) : now_(start_tick) {
+  heads_.fill(NIL);
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint64_t deadline, uint64_t key) {
+  uint32_t index = 0;
+  if (free_.empty()) {
+    if (nodes_.size() >= NIL) {
+      throw length_error("Timer wheel can not hold any more timers");
+    }
+    index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  } else {
+    index = free_.back();
+    free_.pop_back();
+  }
+  auto& node = nodes_[index];
+  node.deadline = deadline;
+  node.key = key;
+  place(index, now_ + 1);
+  ++count_;
+  return (TimerId{node.generation} << GENERATION_SHIFT) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+  auto index = static_cast<uint32_t>(id & INDEX_MASK);
+  auto generation = static_cast<uint32_t>(id >> GENERATION_SHIFT);
+  if (index >= nodes_.size() || nodes_[index].slot == NIL ||
+      nodes_[index].generation != generation) {
+    return false;
+  }
+  unlink(index);
+  release(index);
+  return true;
+}
+
+size_t TimerWheel::advance(uint64_t tick, vector<Expiry>& expired) {
+  auto initial = expired.size();
+  while (now_ < tick) {
+    auto next = nextEvent();
+    if (count_ == 0 || next > tick) {
+      now_ = tick;
+      break;
+    }
+    now_ = next;
+    for (auto level = LEVELS - 1; level > 0; --level) {
+      if ((now_ & ((uint64_t{1} << levelShift(level)) - 1)) == 0) {
+        cascade(level, slotOf(now_, level));
+      }
+    }
+    expire(slotOf(now_, 0), expired);
+  }
+  return expired.size() - initial;
+}
+
+uint64_t TimerWheel::nextEvent() const {
+  auto next = UINT64_MAX;
+  for (size_t level = 0; level < LEVELS; ++level) {
+    auto shift = levelShift(level);
+    auto current = slotOf(now_, level);
+    // timers are placed after the current slot of their level, except for
+    // far timers parked in the top level
+    auto later = current == SLOT_MASK
+        ? 0
+        : occupied_[level] >> (current + 1) << (current + 1);
+    auto rotation = now_ & ~((uint64_t{1} << (shift + SLOT_BITS)) - 1);
+    if (later == 0 && level == LEVELS - 1 && occupied_[level] != 0) {
+      later = occupied_[level];
+      rotation += uint64_t{1} << (shift + SLOT_BITS);
+    }
+    if (later != 0) {
+      next = min(next, rotation + (uint64_t{trailingZeros(later)} << shift));
+    }
+  }
+  return next;
+}
+
+void TimerWheel::place(uint32_t index, uint64_t earliest) {
+  auto deadline = max(nodes_[index].deadline, earliest);
+  auto level = static_cast<size_t>(bitWidth((deadline ^ now_) >> SLOT_BITS) +
+                   SLOT_BITS - 1) /
+      SLOT_BITS;
+  size_t slot = 0;
+  if (level < LEVELS) {
+    slot = slotOf(deadline, level);
+  } else {
+    // parked in the first top level slot, which is cascaded at the start of
+    // every top level rotation and never used by other timers
+    level = LEVELS - 1;
+  }
+  link(index, static_cast<uint32_t>(level * SLOTS + slot));
+}
+
+void TimerWheel::link(uint32_t index, uint32_t slot) {
+  auto& node = nodes_[index];
+  node.slot = slot;
+  node.previous = NIL;
+  node.next = heads_[slot];
+  if (node.next != NIL) {
+    nodes_[node.next].previous = index;
+  }
+  heads_[slot] = index;
+  occupied_[slot / SLOTS] |= uint64_t{1} << (slot % SLOTS);
+}
+
+void TimerWheel::unlink(uint32_t index) {
+  auto& node = nodes_[index];
+  if (node.previous != NIL) {
+    nodes_[node.previous].next = node.next;
+  } else {
+    heads_[node.slot] = node.next;
+    if (node.next == NIL) {
+      occupied_[node.slot / SLOTS] &= ~(uint64_t{1} << (node.slot % SLOTS));
+    }
+  }
+  if (node.next != NIL) {
+    nodes_[node.next].previous = node.previous;
+  }
+}
+
+void TimerWheel::release(uint32_t index) {
+  auto& node = nodes_[index];
+  node.slot = NIL;
+  ++node.generation;
+  free_.push_back(index);
+  --count_;
+}
+
+void TimerWheel::cascade(size_t level, size_t slot) {
+  auto head_slot = level * SLOTS + slot;
+  auto index = heads_[head_slot];
+  heads_[head_slot] = NIL;
+  occupied_[level] &= ~(uint64_t{1} << slot);
+  while (index != NIL) {
+    auto next = nodes_[index].next;
+    // cascades happen before the current tick expires
+    place(index, now_);
+    index = next;
+  }
+}
+
+void TimerWheel::expire(size_t slot, vector<Expiry>& expired) {
+  auto index = heads_[slot];
+  heads_[slot] = NIL;
+  occupied_[0] &= ~(uint64_t{1} << slot);
+  auto first = expired.size();
+  while (index != NIL) {
+    const auto& node = nodes_[index];
+    auto next = node.next;
+    expired.push_back(Expiry{
+        (TimerId{node.generation} << GENERATION_SHIFT) | index,
+        node.key,
+        node.deadline});
+    release(index);
+    index = next;
+  }
+  // timers that were scheduled in the past share the slot with timers, that
+  // are due at this tick
+  stable_sort(expired.begin() + static_cast<ptrdiff_t>(first),
+      expired.end(),
+      [](const Expiry& lhs, const Expiry& rhs) {
+        return lhs.deadline < rhs.deadline;
+      });
+}
+} // namespace Information_Model
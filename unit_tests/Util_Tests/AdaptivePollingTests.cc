@@ -0,0 +1,149 @@
+#include "AdaptivePolling.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct SettableReadable : public Readable {
+  DataType dataType() const final { return DataType::Integer; }
+
+  DataVariant read() const final {
+    ++reads;
+    if (fail) {
+      throw runtime_error("Read failed");
+    }
+    return DataVariant(value.load());
+  }
+
+  atomic<intmax_t> value{0};
+  atomic<bool> fail{false};
+  mutable atomic<size_t> reads{0};
+};
+
+struct AdaptivePollingTests : public ::testing::Test {
+  AdaptivePollingTests()
+      : scheduler(make_shared<PollingScheduler>(
+            [](const PollBatch&) {}, 0, chrono::milliseconds(1))),
+        readable(make_shared<SettableReadable>()),
+        observable(makePolledObservable(scheduler,
+            "device",
+            readable,
+            // NOLINTNEXTLINE(readability-magic-numbers)
+            AdaptivePolicy{10ms, 160ms, 2.0, 2})) {}
+
+  void runUntil(chrono::milliseconds time) {
+    for (; now <= time; ++now) {
+      scheduler->poll(scheduler->epoch() + now);
+    }
+  }
+
+  ObserverPtr subscribe() {
+    return observable->subscribe(
+        [this](const shared_ptr<DataVariant>& value) {
+          values.push_back(get<intmax_t>(*value));
+        },
+        [this](const exception_ptr& error) { errors.push_back(error); });
+  }
+
+  shared_ptr<PollingScheduler> scheduler;
+  shared_ptr<SettableReadable> readable;
+  PolledObservablePtr observable;
+  chrono::milliseconds now{1};
+  vector<intmax_t> values;
+  vector<exception_ptr> errors;
+};
+
+TEST_F(AdaptivePollingTests, backsOffWhileValueIsStable) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto observer = subscribe();
+  runUntil(2s);
+
+  EXPECT_THAT(values, ElementsAre(0));
+  EXPECT_EQ(observable->currentInterval(), chrono::milliseconds(160));
+  // a fixed 10ms interval would read 200 times
+  EXPECT_LT(readable->reads, 30);
+  EXPECT_EQ(observable->statistics().reads, readable->reads);
+  EXPECT_EQ(observable->statistics().changes, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(AdaptivePollingTests, resetsIntervalOnChange) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto observer = subscribe();
+  runUntil(1s);
+  readable->value = 5;
+  runUntil(1200ms);
+
+  EXPECT_THAT(values, ElementsAre(0, 5));
+  EXPECT_EQ(observable->statistics().changes, 1);
+  EXPECT_LT(*observable->currentInterval(), chrono::milliseconds(160));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(AdaptivePollingTests, pollsOnlyWhileObserved) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  runUntil(100ms);
+  EXPECT_EQ(readable->reads, 0);
+  EXPECT_FALSE(observable->currentInterval().has_value());
+
+  auto observer = subscribe();
+  EXPECT_EQ(scheduler->size(), 1);
+  runUntil(200ms);
+  EXPECT_GT(readable->reads, 0);
+
+  observer.reset();
+  EXPECT_EQ(scheduler->size(), 0);
+  auto reads = readable->reads.load();
+  runUntil(400ms);
+  EXPECT_EQ(readable->reads, reads);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(AdaptivePollingTests, dispatchesReadFailures) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  readable->fail = true;
+  auto observer = subscribe();
+  runUntil(10ms);
+
+  ASSERT_EQ(errors.size(), 1);
+  EXPECT_THROW(rethrow_exception(errors[0]), runtime_error);
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(observable->statistics().failures, 1);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(AdaptivePollingTests, rejectsInvalidPolicies) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_THROW(makePolledObservable(
+                   nullptr, "device", readable, AdaptivePolicy{10ms, 20ms}),
+      invalid_argument);
+  EXPECT_THROW(makePolledObservable(
+                   scheduler, "device", nullptr, AdaptivePolicy{10ms, 20ms}),
+      invalid_argument);
+  EXPECT_THROW(makePolledObservable(
+                   scheduler, "device", readable, AdaptivePolicy{100us, 20ms}),
+      invalid_argument);
+  EXPECT_THROW(makePolledObservable(
+                   scheduler, "device", readable, AdaptivePolicy{20ms, 10ms}),
+      invalid_argument);
+  EXPECT_THROW(makePolledObservable(scheduler,
+                   "device",
+                   readable,
+                   AdaptivePolicy{10ms, 20ms, 1.0}),
+      invalid_argument);
+  EXPECT_THROW(makePolledObservable(scheduler,
+                   "device",
+                   readable,
+                   AdaptivePolicy{10ms, 20ms, 2.0, 0}),
+      invalid_argument);
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
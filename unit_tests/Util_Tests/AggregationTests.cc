@@ -0,0 +1,103 @@
+#include "Aggregation.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(AggregationTests, aggregatesDoubles) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  for (size_t count : {1U, 3U, 8U, 13U, 1001U}) {
+    AlignedVector<double> values;
+    for (size_t i = 0; i < count; ++i) {
+      values.push_back(static_cast<double>((i * 7) % 11) - 5.5);
+    }
+    auto tested = aggregate(values);
+
+    EXPECT_EQ(tested.count, count);
+    EXPECT_EQ(tested.min, *min_element(values.begin(), values.end()));
+    EXPECT_EQ(tested.max, *max_element(values.begin(), values.end()));
+    double sum = 0;
+    for (auto value : values) {
+      sum += value;
+    }
+    EXPECT_DOUBLE_EQ(tested.sum, sum);
+    EXPECT_DOUBLE_EQ(tested.mean(), sum / static_cast<double>(count));
+    EXPECT_EQ(tested.last, values.back());
+  }
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(AggregationTests, aggregatesIntegers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  IntegerArray values{5, -3, numeric_limits<intmax_t>::min(), 12, 7, -1, 0};
+  auto tested = aggregate(values);
+
+  EXPECT_EQ(tested.count, 7);
+  EXPECT_EQ(tested.min, numeric_limits<intmax_t>::min());
+  EXPECT_EQ(tested.max, 12);
+  EXPECT_EQ(tested.sum, numeric_limits<intmax_t>::min() + 20);
+  EXPECT_EQ(tested.last, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(AggregationTests, aggregatesUnsignedIntegers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  UnsignedIntegerArray values{
+      3, numeric_limits<uintmax_t>::max(), 1, 9, 2, 8, 4, 6, 5};
+  auto tested = aggregate(values);
+
+  EXPECT_EQ(tested.min, 1);
+  EXPECT_EQ(tested.max, numeric_limits<uintmax_t>::max());
+  // wraps around
+  EXPECT_EQ(tested.sum, 37);
+  EXPECT_EQ(tested.last, 5);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(AggregationTests, returnsEmptyAggregate) {
+  auto tested = aggregate(static_cast<const double*>(nullptr), 0);
+
+  EXPECT_EQ(tested.count, 0);
+  EXPECT_TRUE(isnan(tested.mean()));
+  EXPECT_THAT(aggregationKernel(), AnyOf("AVX2", "Scalar"));
+}
+
+TEST(AggregationTests, aggregatesTimeSeriesSegments) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimeSeries series(DataType::Integer, 5);
+  for (intmax_t i = 0; i < 8; ++i) {
+    series.append<intmax_t>(i, i * 10);
+  }
+  auto tested = aggregate(series.segments<intmax_t>());
+
+  EXPECT_EQ(tested.count, 5);
+  EXPECT_EQ(tested.min, 30);
+  EXPECT_EQ(tested.max, 70);
+  EXPECT_EQ(tested.sum, 250);
+  EXPECT_EQ(tested.last, 70);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(AggregationTests, gathersMatchingValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<DataVariant> variants{
+      1.5, (intmax_t)2, 2.5, string("3"), 3.5, Float32{4.5F}};
+  auto tested = gather<double>(variants);
+
+  EXPECT_THAT(tested.values, ElementsAre(1.5, 2.5, 3.5));
+  EXPECT_EQ(tested.mismatched, 3);
+  EXPECT_TRUE(tested.matched(0));
+  EXPECT_FALSE(tested.matched(1));
+  EXPECT_TRUE(tested.matched(4));
+  EXPECT_FALSE(tested.matched(5));
+  EXPECT_DOUBLE_EQ(aggregate(tested.values).mean(), 2.5);
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
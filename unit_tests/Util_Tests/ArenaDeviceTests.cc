@@ -0,0 +1,565 @@
+#include "ArenaDevice.hpp"
+#include "StructuralHash.hpp"
+#include "TypedElement.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct ArenaDeviceTests : public ::testing::Test {
+  ArenaDeviceTests() { builder.setDeviceInfo("dev", BuildInfo{"Device", ""}); }
+
+  ArenaDeviceBuilder builder;
+};
+
+TEST_F(ArenaDeviceTests, buildsNestedDevice) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto group_id = builder.addGroup(BuildInfo{"Group", "Nested"});
+  auto inner_id = builder.addGroup(group_id, BuildInfo{"Inner"});
+  auto readable_id = builder.addReadable(group_id,
+      BuildInfo{"Reading"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)7); });
+  auto nested_id = builder.addReadable(inner_id,
+      BuildInfo{"Nested"},
+      DataType::Boolean,
+      []() { return DataVariant(true); });
+  auto typed_id =
+      builder.addReadable<double>(BuildInfo{"Typed"}, []() { return 1.5; });
+  auto device = builder.result();
+
+  EXPECT_EQ(group_id, "dev:0");
+  EXPECT_EQ(inner_id, "dev:0.0");
+  EXPECT_EQ(readable_id, "dev:0.1");
+  EXPECT_EQ(nested_id, "dev:0.0.0");
+  EXPECT_EQ(typed_id, "dev:1");
+  EXPECT_EQ(device->id(), "dev");
+  EXPECT_EQ(device->name(), "Device");
+  EXPECT_EQ(device->size(), 2);
+  EXPECT_EQ(dynamic_cast<ArenaDevice&>(*device).elementCount(), 5);
+
+  auto readable = device->element(readable_id);
+  EXPECT_EQ(readable->id(), readable_id);
+  EXPECT_EQ(readable->name(), "Reading");
+  EXPECT_EQ(readable->type(), ElementType::Readable);
+  EXPECT_EQ(get<intmax_t>(get<ReadablePtr>(readable->function())->read()), 7);
+  auto typed = get<ReadablePtr>(device->element(typed_id)->function());
+  EXPECT_EQ(get<double>(typed->read()), 1.5);
+
+  auto group = get<GroupPtr>(device->element(group_id)->function());
+  EXPECT_EQ(group->size(), 2);
+  EXPECT_EQ(group->element(nested_id)->name(), "Nested");
+  vector<string> ids;
+  for (const auto& element : group->asVector()) {
+    ids.push_back(element->id());
+  }
+  EXPECT_THAT(ids, ElementsAre(inner_id, readable_id));
+  auto map = device->group()->asMap();
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at("0")->id(), group_id);
+  EXPECT_EQ(group->asMap().at("1")->id(), readable_id);
+
+  size_t visited = 0;
+  device->visit([&visited](const ElementPtr&) { ++visited; });
+  EXPECT_EQ(visited, 2);
+
+  // elements share the arena ownership
+  device.reset();
+  EXPECT_EQ(readable->name(), "Reading");
+  EXPECT_EQ(group->element(nested_id)->id(), nested_id);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(ArenaDeviceTests, rejectsUnknownIds) {
+  auto group_id = builder.addGroup(BuildInfo{"Group"});
+  builder.addReadable(group_id,
+      BuildInfo{"Reading"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)7); });
+  builder.addReadable(BuildInfo{"Other"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)7); });
+  auto device = builder.result();
+  auto group = get<GroupPtr>(device->element(group_id)->function());
+
+  for (const auto& ref_id : {"dev:5",
+           "dev:0.1",
+           "dev:1.0",
+           "other:0",
+           "dev:00",
+           "dev:0.",
+           "dev:x",
+           "dev",
+           ""}) {
+    EXPECT_THROW(device->element(ref_id), ElementNotFound) << ref_id;
+  }
+  EXPECT_THROW(device->element("dev:"), IDPointsThisGroup);
+  EXPECT_THROW(group->element(group_id), IDPointsThisGroup);
+  EXPECT_THROW(group->element("dev:1"), ElementNotFound);
+}
+
+TEST_F(ArenaDeviceTests, writesValues) {
+  vector<DataVariant> written;
+  auto writable_id = builder.addWritable(BuildInfo{"Writable"},
+      DataType::Boolean,
+      [&written](const DataVariant& value) { written.push_back(value); });
+  auto device = builder.result();
+  auto writable = get<WritablePtr>(device->element(writable_id)->function());
+
+  writable->write(DataVariant(true));
+  EXPECT_EQ(written.size(), 1);
+  EXPECT_TRUE(writable->isWriteOnly());
+  EXPECT_THROW(writable->read(), NonReadable);
+  EXPECT_THROW(writable->write(DataVariant((intmax_t)1)), DataTypeMismatch);
+}
+
+TEST_F(ArenaDeviceTests, notifiesObservers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<bool> observing;
+  auto [observable_id, notify] = builder.addObservable(BuildInfo{"Observable"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)0); },
+      [&observing](bool state) { observing.push_back(state); });
+  auto device = builder.result();
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+  vector<intmax_t> values;
+
+  notify(DataVariant((intmax_t)1));
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<intmax_t>(*value));
+      },
+      nullptr);
+  notify(DataVariant((intmax_t)2));
+  observer.reset();
+  notify(DataVariant((intmax_t)3));
+
+  EXPECT_THAT(values, ElementsAre(2));
+  EXPECT_THAT(observing, ElementsAre(true, false));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(ArenaDeviceTests, callsFunctions) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<Parameters> executed;
+  vector<uintmax_t> canceled;
+  auto execute_id = builder.addCallable(
+      BuildInfo{"Execute"},
+      [&executed](const Parameters& parameters) {
+        executed.push_back(parameters);
+      },
+      ParameterTypes{{1, ParameterType{DataType::Boolean, true}}});
+  auto pending = make_shared<promise<DataVariant>>();
+  auto call_id = builder.addCallable(
+      BuildInfo{"Call"},
+      DataType::Integer,
+      [](const Parameters&) {},
+      [pending](const Parameters& parameters) {
+        if (parameters.empty()) {
+          promise<DataVariant> result;
+          result.set_value(DataVariant((intmax_t)42));
+          return ResultFuture(uintmax_t{1}, result.get_future());
+        }
+        return ResultFuture(uintmax_t{2}, pending->get_future());
+      },
+      [&canceled](uintmax_t call_id) { canceled.push_back(call_id); },
+      ParameterTypes{{1, ParameterType{DataType::Boolean}}});
+  auto device = builder.result();
+  auto execute = get<CallablePtr>(device->element(execute_id)->function());
+  auto call = get<CallablePtr>(device->element(call_id)->function());
+
+  execute->execute(Parameters{{1, DataVariant(true)}});
+  EXPECT_EQ(executed.size(), 1);
+  EXPECT_THROW(execute->execute(), MandatoryParameterMissing);
+  EXPECT_THROW(execute->call(), ResultReturningNotSupported);
+  EXPECT_EQ(execute->resultType(), DataType::None);
+  EXPECT_EQ(get<intmax_t>(call->call()), 42);
+  EXPECT_THROW(call->call(Parameters{{1, DataVariant(true)}}, 1),
+      CallTimedout);
+  EXPECT_THAT(canceled, ElementsAre(2));
+  EXPECT_EQ(call->resultType(), DataType::Integer);
+  EXPECT_EQ(call->parameterTypes().size(), 1);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(ArenaDeviceTests, storesInlineCallbacks) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto value = make_unique<intmax_t>(5);
+  auto readable_id = builder.addInlineReadable(nullopt,
+      BuildInfo{"Readable"},
+      DataType::Integer,
+      [value = move(value)]() { return DataVariant(*value); });
+  vector<bool> observing;
+  auto [observable_id, notify] = builder.addInlineObservable(nullopt,
+      BuildInfo{"Observable"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)0); },
+      [&observing](bool state) { observing.push_back(state); });
+  auto callable_id = builder.addInlineCallable(
+      nullopt, BuildInfo{"Callable"}, DataType::None, [](const Parameters&) {});
+  EXPECT_THROW(builder.addInlineCallable(nullopt,
+                   BuildInfo{},
+                   DataType::Integer,
+                   [](const Parameters&) {}),
+      invalid_argument);
+  auto device = builder.result();
+
+  auto readable = get<ReadablePtr>(device->element(readable_id)->function());
+  EXPECT_EQ(get<intmax_t>(readable->read()), 5);
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+  vector<intmax_t> values;
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<intmax_t>(*value));
+      },
+      nullptr);
+  notify(DataVariant((intmax_t)3));
+  EXPECT_THAT(values, ElementsAre(3));
+  EXPECT_THAT(observing, ElementsAre(true));
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  EXPECT_THROW(callable->call(), ResultReturningNotSupported);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(ArenaDeviceTests, storesTypedCallbacks) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto readable_id =
+      builder.addReadable<double>(BuildInfo{"Readable"}, []() { return 1.5; });
+  intmax_t stored = 2;
+  auto writable_id = builder.addWritable<intmax_t>(
+      BuildInfo{"Writable"},
+      [&stored](const intmax_t& value) { stored = value; },
+      [&stored]() { return stored; });
+  auto [observable_id, notify] = builder.addObservable<string>(
+      BuildInfo{"Observable"}, []() { return string("idle"); }, [](bool) {});
+  EXPECT_THROW(builder.addReadable<bool>(BuildInfo{}, nullptr),
+      invalid_argument);
+  auto device = builder.result();
+
+  // typed views use the arena nodes instead of unboxing wrappers
+  auto readable = toTypedReadable<double>(device->element(readable_id));
+  EXPECT_NE(dynamic_cast<const Element*>(readable.get()), nullptr);
+  EXPECT_EQ(readable->read(), 1.5);
+  auto boxed = get<ReadablePtr>(device->element(readable_id)->function());
+  EXPECT_EQ(boxed->dataType(), DataType::Double);
+  EXPECT_EQ(get<double>(boxed->read()), 1.5);
+
+  auto writable = toTypedWritable<intmax_t>(device->element(writable_id));
+  EXPECT_NE(dynamic_cast<const Element*>(writable.get()), nullptr);
+  writable->write(7);
+  EXPECT_EQ(writable->read(), 7);
+  EXPECT_FALSE(writable->isWriteOnly());
+  auto boxed_writable =
+      get<WritablePtr>(device->element(writable_id)->function());
+  boxed_writable->write(DataVariant((intmax_t)9));
+  EXPECT_EQ(stored, 9);
+  EXPECT_THROW(boxed_writable->write(DataVariant(true)), DataTypeMismatch);
+
+  auto observable =
+      toTypedObservable<string>(device->element(observable_id));
+  EXPECT_NE(dynamic_cast<const Element*>(observable.get()), nullptr);
+  EXPECT_EQ(observable->read(), "idle");
+  vector<string> values;
+  auto observer = observable->subscribe(
+      [&values](const string& value) { values.push_back(value); }, nullptr);
+  notify("busy");
+  EXPECT_THAT(values, ElementsAre("busy"));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(ArenaDeviceTests, rejectsInvalidBuilds) {
+  auto read = []() { return DataVariant(true); };
+  EXPECT_THROW(builder.setDeviceInfo("other", BuildInfo{}),
+      DeviceBuildInProgress);
+  EXPECT_THROW(builder.result(), GroupEmpty);
+  EXPECT_THROW(builder.addReadable(BuildInfo{}, DataType::None, read),
+      invalid_argument);
+  EXPECT_THROW(builder.addReadable(BuildInfo{}, DataType::Boolean, nullptr),
+      invalid_argument);
+  EXPECT_THROW(
+      builder.addReadable("dev:7", BuildInfo{}, DataType::Boolean, read),
+      invalid_argument);
+  builder.addGroup(BuildInfo{"Empty"});
+  EXPECT_THROW(builder.result(), GroupEmpty);
+  builder.abandon();
+  EXPECT_THROW(builder.result(), DeviceInfoNotSet);
+  builder.setDeviceInfo("other", BuildInfo{});
+
+  ArenaDeviceBuilder unset;
+  EXPECT_THROW(unset.addGroup(BuildInfo{}), DeviceInfoNotSet);
+  EXPECT_THROW(unset.result(), DeviceInfoNotSet);
+}
+
+void collectIds(const GroupPtr& group, vector<string>& ids) {
+  for (const auto& element : group->asVector()) {
+    ids.push_back(element->id() + " " + element->name());
+    if (element->type() == ElementType::Group) {
+      collectIds(get<GroupPtr>(element->function()), ids);
+    }
+  }
+}
+
+TEST(ConcurrentArenaDeviceBuilderTests, mergesBranchesDeterministically) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  constexpr size_t THREADS = 4;
+  constexpr size_t BRANCHES = 12;
+  auto fill = [](auto& branch, size_t position) {
+    auto inner = branch.addGroup(BuildInfo{"Inner " + to_string(position)});
+    for (size_t i = 0; i < 3; ++i) {
+      auto value = static_cast<intmax_t>(position * 100 + i);
+      branch.addInlineReadable(inner,
+          BuildInfo{"Reading " + to_string(i)},
+          DataType::Integer,
+          [value]() { return DataVariant(value); });
+    }
+  };
+  ConcurrentArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Device"});
+  vector<thread> threads;
+  for (size_t t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&builder, &fill, t]() {
+      // every thread claims its positions from the highest one down
+      for (auto position = BRANCHES - THREADS + t; position < BRANCHES;
+           position -= THREADS) {
+        auto branch = builder.branch(
+            position, BuildInfo{"Segment " + to_string(position)});
+        fill(branch, position);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto device = builder.result();
+
+  ArenaDeviceBuilder serial;
+  serial.setDeviceInfo("dev", BuildInfo{"Device"});
+  struct SerialBranch {
+    string addGroup(const BuildInfo& info) {
+      return builder->addGroup(group, info);
+    }
+    void addInlineReadable(const string& parent,
+        const BuildInfo& info,
+        DataType data_type,
+        DeviceBuilder::InlineReadCallback&& read_cb) {
+      builder->addInlineReadable(parent, info, data_type, move(read_cb));
+    }
+    ArenaDeviceBuilder* builder;
+    string group;
+  };
+  for (size_t position = 0; position < BRANCHES; ++position) {
+    SerialBranch branch{&serial,
+        serial.addGroup(BuildInfo{"Segment " + to_string(position)})};
+    fill(branch, position);
+  }
+  vector<string> expected;
+  collectIds(serial.result()->group(), expected);
+  vector<string> ids;
+  collectIds(device->group(), ids);
+
+  EXPECT_EQ(ids, expected);
+  EXPECT_EQ(device->size(), BRANCHES);
+  EXPECT_EQ(device->element("dev:7")->name(), "Segment 7");
+  auto readable = get<ReadablePtr>(device->element("dev:7.0.2")->function());
+  EXPECT_EQ(get<intmax_t>(readable->read()), 702);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(ConcurrentArenaDeviceBuilderTests, bindsObservableNotifiers) {
+  ConcurrentArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{});
+  DeviceBuilder::InlineNotifyCallback notify;
+  string id;
+  {
+    auto branch = builder.branch(0, BuildInfo{});
+    tie(id, notify) = branch.addInlineObservable(nullopt,
+        BuildInfo{"Observable"},
+        DataType::Boolean,
+        []() { return DataVariant(false); },
+        [](bool) {});
+    EXPECT_EQ(branch.id(), "dev:0");
+  }
+  auto device = builder.result();
+
+  EXPECT_EQ(id, "dev:0.0");
+  auto observable = get<ObservablePtr>(device->element(id)->function());
+  vector<bool> values;
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<bool>(*value));
+      },
+      nullptr);
+  notify(DataVariant(true));
+  EXPECT_THAT(values, ElementsAre(true));
+}
+
+TEST(ConcurrentArenaDeviceBuilderTests, rejectsInvalidBuilds) {
+  auto read = []() { return DataVariant(true); };
+  ConcurrentArenaDeviceBuilder builder;
+  EXPECT_THROW(builder.branch(0, BuildInfo{}), DeviceInfoNotSet);
+  EXPECT_THROW(builder.result(), DeviceInfoNotSet);
+  builder.setDeviceInfo("dev", BuildInfo{});
+  EXPECT_THROW(builder.setDeviceInfo("dev", BuildInfo{}),
+      DeviceBuildInProgress);
+  EXPECT_THROW(builder.result(), GroupEmpty);
+
+  auto branch = builder.branch(0, BuildInfo{});
+  EXPECT_THROW(builder.branch(0, BuildInfo{}), invalid_argument);
+  EXPECT_THROW(branch.addInlineReadable(
+                   "dev:1", BuildInfo{}, DataType::Boolean, read),
+      invalid_argument);
+  EXPECT_THROW(
+      branch.addInlineReadable(nullopt, BuildInfo{}, DataType::None, read),
+      invalid_argument);
+  EXPECT_THROW(builder.result(), BranchInUse);
+  {
+    auto moved = move(branch);
+    EXPECT_THROW(branch.addGroup(BuildInfo{}), logic_error);
+    moved.addInlineReadable(nullopt, BuildInfo{}, DataType::Boolean, read);
+  }
+  builder.branch(2, BuildInfo{})
+      .addInlineReadable(nullopt, BuildInfo{}, DataType::Boolean, read);
+  EXPECT_THROW(builder.result(), BranchMissing);
+  builder.branch(1, BuildInfo{});
+  EXPECT_THROW(builder.result(), GroupEmpty);
+}
+
+TEST(ConcurrentArenaDeviceBuilderTests, rejectsOutOfRangePositions) {
+  auto read = []() { return DataVariant(true); };
+  ConcurrentArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{});
+  EXPECT_THROW(builder.branch(numeric_limits<size_t>::max(), BuildInfo{}),
+      out_of_range);
+  EXPECT_THROW(builder.branch(UINT32_MAX - 1, BuildInfo{}), out_of_range);
+  // far positions do not allocate the gap, result() reports it as missing
+  builder.branch(UINT32_MAX - 2, BuildInfo{})
+      .addInlineReadable(nullopt, BuildInfo{}, DataType::Boolean, read);
+  EXPECT_THROW(builder.result(), BranchMissing);
+}
+
+// NOLINTBEGIN(readability-magic-numbers)
+DeviceDefinition templateDefinition() {
+  istringstream input(R"({
+    "id": "model", "name": "Model", "description": "Fleet model",
+    "elements": [
+      {"name": "Group", "type": "Group"},
+      {"parent": 0, "name": "Reading", "type": "Readable",
+       "data_type": "Integer"},
+      {"name": "Observable", "type": "Observable", "data_type": "Integer"},
+      {"parent": 0, "name": "Call", "type": "Callable",
+       "parameters": [{"position": 1, "type": "Boolean", "mandatory": true}]}
+    ]
+  })");
+  return parseDefinition(input);
+}
+
+vector<ElementCallbacks> templateCallbacks(intmax_t value, bool& observing) {
+  vector<ElementCallbacks> callbacks(3);
+  callbacks[0].read = [value]() { return DataVariant(value); };
+  callbacks[1].read = [value]() { return DataVariant(value + 1); };
+  callbacks[1].observe = [&observing](bool state) { observing = state; };
+  callbacks[2].execute = [](const Parameters&) {};
+  return callbacks;
+}
+
+TEST(ArenaDeviceTemplateTests, instantiatesSharedStructure) {
+  ArenaDeviceTemplate model(templateDefinition());
+  EXPECT_EQ(model.elementCount(), 4);
+  bool first_observing = false;
+  bool second_observing = false;
+
+  auto first =
+      model.instantiate("first", templateCallbacks(10, first_observing));
+  auto second =
+      model.instantiate("second", templateCallbacks(20, second_observing));
+
+  EXPECT_THAT(
+      first.ids, ElementsAre("first:0", "first:0.0", "first:1", "first:0.1"));
+  EXPECT_THAT(second.ids,
+      ElementsAre("second:0", "second:0.0", "second:1", "second:0.1"));
+  EXPECT_EQ(first.device->id(), "first");
+  EXPECT_EQ(second.device->name(), "Model");
+  EXPECT_EQ(second.device->description(), "Fleet model");
+  auto first_reading = first.device->element("first:0.0");
+  EXPECT_EQ(first_reading->id(), "first:0.0");
+  EXPECT_EQ(first_reading->name(), "Reading");
+  EXPECT_EQ(get<intmax_t>(get<ReadablePtr>(first_reading->function())->read()),
+      10);
+  EXPECT_EQ(get<intmax_t>(get<ReadablePtr>(
+                second.device->element("second:0.0")->function())
+                ->read()),
+      20);
+  EXPECT_EQ(get<GroupPtr>(second.device->element("second:0")->function())
+                ->asMap()
+                .count("1"),
+      1);
+  auto call =
+      get<CallablePtr>(second.device->element("second:0.1")->function());
+  EXPECT_EQ(call->parameterTypes(),
+      (ParameterTypes{{1, ParameterType{DataType::Boolean, true}}}));
+  EXPECT_THROW(call->execute(), MandatoryParameterMissing);
+
+  auto observable =
+      get<ObservablePtr>(second.device->element("second:1")->function());
+  vector<intmax_t> values;
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<intmax_t>(*value));
+      },
+      nullptr);
+  second.notifiers[2](DataVariant((intmax_t)5));
+  EXPECT_THAT(values, ElementsAre(5));
+  EXPECT_TRUE(second_observing);
+  EXPECT_FALSE(first_observing);
+
+  const auto& first_device = dynamic_cast<const ArenaDevice&>(*first.device);
+  EXPECT_EQ(first_device.elementCount(), 4);
+  EXPECT_EQ(first_device.structureBytes(), model.structureBytes());
+  // instances hash like separately built devices, regardless of their ids
+  auto definition = templateDefinition();
+  definition.id = "built";
+  bool observing = false;
+  ArenaDeviceBuilder builder;
+  auto built =
+      builder.build(move(definition), templateCallbacks(10, observing));
+  EXPECT_EQ(first.device->structuralHash(), built.device->structuralHash());
+  EXPECT_EQ(first.device->structuralHash(), second.device->structuralHash());
+  EXPECT_TRUE(diffStructure(*first.device, *second.device).empty());
+}
+
+TEST(ArenaDeviceTemplateTests, rejectsInvalidDefinitions) {
+  auto empty_group = templateDefinition();
+  empty_group.elements[1].parent = DEFINITION_ROOT;
+  empty_group.elements[3].parent = DEFINITION_ROOT;
+  EXPECT_THROW(ArenaDeviceTemplate{empty_group}, InvalidDefinition);
+
+  ArenaDeviceTemplate model(templateDefinition());
+  bool observing = false;
+  auto callbacks = templateCallbacks(0, observing);
+  callbacks[1].observe = nullptr;
+  EXPECT_THROW(model.instantiate("dev", move(callbacks)), InvalidDefinition);
+  callbacks = templateCallbacks(0, observing);
+  callbacks.pop_back();
+  EXPECT_THROW(model.instantiate("dev", move(callbacks)), InvalidDefinition);
+  // the template stays usable
+  EXPECT_EQ(
+      model.instantiate("dev", templateCallbacks(0, observing)).device->size(),
+      2);
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
@@ -0,0 +1,146 @@
+#include "CallDeadlines.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct CallDeadlinesTests : public ::testing::Test {
+  CallDeadlineManager::CancelCallback cancelCallback() {
+    return [this](uintmax_t call_id) {
+      lock_guard lock(mx);
+      canceled.push_back(call_id);
+    };
+  }
+
+  CallDeadlineManager::Clock::time_point after(chrono::milliseconds delay) {
+    return CallDeadlineManager::Clock::now() + delay;
+  }
+
+  mutex mx;
+  vector<uintmax_t> canceled;
+  CallDeadlineManager manager;
+};
+
+TEST_F(CallDeadlinesTests, timesOutPendingCalls) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto first = manager.track(1, "first", 10ms, cancelCallback());
+  auto second = manager.track(2, "second", 1h, cancelCallback());
+
+  EXPECT_EQ(manager.expire(after(20ms)), 1);
+
+  EXPECT_EQ(first.waitFor(0s), future_status::ready);
+  EXPECT_THROW(first.get(), CallTimedout);
+  EXPECT_EQ(second.waitFor(0s), future_status::timeout);
+  EXPECT_THAT(canceled, ElementsAre(1));
+  EXPECT_EQ(manager.pending(), 1);
+  EXPECT_EQ(manager.statistics().timed_out, 1);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, neverTimesOutBeforeDeadline) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto start = CallDeadlineManager::Clock::now();
+  auto result = manager.track(1, "call", 10ms, cancelCallback());
+
+  EXPECT_EQ(manager.expire(start + 9ms), 0);
+  EXPECT_EQ(result.waitFor(0s), future_status::timeout);
+  EXPECT_EQ(manager.expire(after(11ms)), 1);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, resolvesCallsBeforeDeadline) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto completed = manager.track(1, "completed", 10ms, cancelCallback());
+  auto failed = manager.track(2, "failed", 10ms, cancelCallback());
+  auto canceled_call = manager.track(3, "canceled", 10ms, cancelCallback());
+
+  EXPECT_TRUE(manager.complete(1, DataVariant((intmax_t)42)));
+  EXPECT_FALSE(manager.complete(1, DataVariant((intmax_t)43)));
+  EXPECT_TRUE(
+      manager.fail(2, make_exception_ptr(runtime_error("Execution failed"))));
+  EXPECT_TRUE(manager.cancel(3));
+  EXPECT_FALSE(manager.cancel(4));
+  EXPECT_EQ(manager.expire(after(20ms)), 0);
+
+  EXPECT_EQ(get<intmax_t>(completed.get()), 42);
+  EXPECT_THROW(failed.get(), runtime_error);
+  EXPECT_THROW(canceled_call.get(), CallCanceled);
+  EXPECT_TRUE(canceled.empty());
+  auto statistics = manager.statistics();
+  EXPECT_EQ(statistics.completed, 1);
+  EXPECT_EQ(statistics.failed, 1);
+  EXPECT_EQ(statistics.canceled, 1);
+  EXPECT_EQ(manager.pending(), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, reusesResolvedCallIds) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto first = manager.track(1, "call", 10ms, cancelCallback());
+  EXPECT_THROW(auto duplicate = manager.track(1, "call", 10ms, nullptr),
+      CallerIDExists);
+  manager.complete(1, DataVariant(true));
+  auto second = manager.track(1, "call", 1h, cancelCallback());
+
+  // the timer of the first call no longer applies
+  EXPECT_EQ(manager.expire(after(20ms)), 0);
+  EXPECT_EQ(second.waitFor(0s), future_status::timeout);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, rejectsInvalidArguments) {
+  EXPECT_THROW(auto result = manager.track(1, "call", -1ms, nullptr),
+      invalid_argument);
+  EXPECT_THROW(CallDeadlineManager(0ms), invalid_argument);
+}
+
+TEST_F(CallDeadlinesTests, cancelsPendingCallsOnDestruction) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto local = make_unique<CallDeadlineManager>();
+  auto result = local->track(1, "call", 1h, nullptr);
+  local.reset();
+
+  EXPECT_THROW(result.get(), CallCanceled);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, timesOutOnTimerThread) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  manager.start();
+  auto result = manager.track(1, "call", 5ms, cancelCallback());
+
+  ASSERT_EQ(result.waitFor(5s), future_status::ready);
+  EXPECT_THROW(result.get(), CallTimedout);
+  manager.stop();
+  lock_guard lock(mx);
+  EXPECT_THAT(canceled, ElementsAre(1));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(CallDeadlinesTests, wakesTimerThreadForEarlierDeadlines) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  manager.start();
+  auto late = manager.track(1, "late", 1h, cancelCallback());
+  // the timer thread sleeps until the first deadline, tracking an earlier
+  // one must cut that sleep short
+  auto early = manager.track(2, "early", 5ms, cancelCallback());
+
+  ASSERT_EQ(early.waitFor(5s), future_status::ready);
+  EXPECT_THROW(early.get(), CallTimedout);
+  EXPECT_EQ(late.waitFor(0s), future_status::timeout);
+  EXPECT_EQ(manager.pending(), 1);
+  manager.stop();
+  lock_guard lock(mx);
+  EXPECT_THAT(canceled, ElementsAre(2));
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
@@ -50,6 +50,39 @@ TEST_F(CallableParamTests, throwsParameterTypeMismatch) {
       ThrowsMessage<ParameterTypeMismatch>(HasSubstr(exception_msg)));
 }
 
+TEST_F(CallableParamTests, checksArrayParameterTypes) {
+  supported_params.emplace(3, ParameterType{DataType::Double_Array, true});
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  Parameters tested{{1, (uintmax_t)1}, {3, DoubleArray{1.0, 2.0}}};
+
+  EXPECT_NO_THROW(checkParameters(tested, supported_params));
+
+  tested.insert_or_assign(3, IntegerArray{1, 2});
+  string exception_msg = "Parameter 3:" + toString(DataType::Double_Array) +
+      " does not accept " + toString(DataType::Integer_Array);
+  EXPECT_THAT([&]() { checkParameters(tested, supported_params); },
+      ThrowsMessage<ParameterTypeMismatch>(HasSubstr(exception_msg)));
+}
+
+TEST_F(CallableParamTests, widensNarrowParameters) {
+  supported_params.emplace(3, ParameterType{DataType::Integer, false, true});
+  Parameters tested{{1, (uintmax_t)1}};
+
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  addSupportedParameter(
+      tested, supported_params, 3, DataVariant(Integer16{-7}));
+
+  EXPECT_NO_THROW(checkParameters(tested, supported_params));
+  // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+  EXPECT_EQ(tested.at(3).value(), DataVariant((intmax_t)-7));
+  EXPECT_NO_THROW(checkParameters(
+      Parameters{{1, (uintmax_t)1}, {3, Integer32{1}}}, supported_params));
+  // parameter 1 does not allow widening
+  EXPECT_THROW(
+      checkParameters(Parameters{{1, UnsignedInteger16{1}}}, supported_params),
+      ParameterTypeMismatch);
+}
+
 TEST_F(CallableParamTests, throwsParameterDoesNotExist) {
   Parameters tested{};
   string exception_msg = "No parameter exists at position 5";
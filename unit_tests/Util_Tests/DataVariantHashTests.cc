@@ -0,0 +1,167 @@
+#include "DataVariant.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(DataVariantHashTests, equalValuesHashEqually) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<DataVariant> values{true,
+      (intmax_t)-25,
+      (uintmax_t)25,
+      20.5,
+      Timestamp{2025, 9, 11, 18, 9, 23, 521},
+      vector<uint8_t>{0x01, 0x02, 0x03},
+      string("hello world"),
+      IntegerArray{1, -2, 3},
+      UnsignedIntegerArray{1, 2, 3},
+      DoubleArray{1.5, -2.5},
+      Integer16{-16},
+      Integer32{-32},
+      UnsignedInteger16{16},
+      UnsignedInteger32{32},
+      Float32{1.5F}};
+  // NOLINTEND(readability-magic-numbers)
+  for (const auto& value : values) {
+    auto copy = value;
+    EXPECT_EQ(hash<DataVariant>{}(value), hash<DataVariant>{}(copy))
+        << toString(value);
+  }
+}
+
+TEST(DataVariantHashTests, hashDependsOnDataType) {
+  EXPECT_NE(
+      hash<DataVariant>{}((intmax_t)1), hash<DataVariant>{}((uintmax_t)1));
+  EXPECT_NE(
+      hash<DataVariant>{}(Integer16{1}), hash<DataVariant>{}(Integer32{1}));
+  EXPECT_NE(hash<DataVariant>{}(string("")),
+      hash<DataVariant>{}(vector<uint8_t>{}));
+}
+
+TEST(DataVariantHashTests, zeroesAndNaNsHashEqually) {
+  EXPECT_EQ(hash<DataVariant>{}(0.0), hash<DataVariant>{}(-0.0));
+  EXPECT_EQ(hash<DataVariant>{}(Float32{0.0F}),
+      hash<DataVariant>{}(Float32{-0.0F}));
+  EXPECT_EQ(hash<DataVariant>{}(DoubleArray{1.0, 0.0}),
+      hash<DataVariant>{}(DoubleArray{1.0, -0.0}));
+  EXPECT_EQ(hash<DataVariant>{}(numeric_limits<double>::quiet_NaN()),
+      hash<DataVariant>{}(-numeric_limits<double>::quiet_NaN()));
+  // long enough to be hashed in parallel lanes
+  auto nan = numeric_limits<double>::quiet_NaN();
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  DoubleArray values{1.0, -0.0, 2.0, -nan, 3.0, 4.0, -0.0};
+  DoubleArray normal{1.0, 0.0, 2.0, nan, 3.0, 4.0, 0.0};
+  EXPECT_EQ(hash<DataVariant>{}(values), hash<DataVariant>{}(normal));
+}
+
+TEST(DataVariantHashTests, hashesAreWellDistributed) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  constexpr size_t count = 10000;
+  unordered_set<size_t> integer_hashes;
+  unordered_set<size_t> string_hashes;
+  unordered_set<size_t> low_bits;
+  for (size_t i = 0; i < count; ++i) {
+    integer_hashes.insert(hash<DataVariant>{}((intmax_t)i));
+    string_hashes.insert(hash<DataVariant>{}("key_" + to_string(i)));
+    low_bits.insert(hash<DataVariant>{}((intmax_t)i) & 0xFFFU);
+  }
+  EXPECT_EQ(integer_hashes.size(), count);
+  EXPECT_EQ(string_hashes.size(), count);
+  // random hashes would fill ~3740 of 4096 buckets, sequential keys must not
+  // cluster into fewer
+  EXPECT_GT(low_bits.size(), 3650U);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantHashTests, hashesLongByteRanges) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  vector<uint8_t> bytes(1027, 0xAB);
+  auto original = hashBytes(bytes.data(), bytes.size());
+  for (size_t i : {0U, 31U, 32U, 1000U, 1026U}) {
+    auto changed = bytes;
+    changed[i] ^= 1U;
+    EXPECT_NE(hashBytes(changed.data(), changed.size()), original) << i;
+  }
+  EXPECT_NE(hashBytes(bytes.data(), bytes.size(), 1), original);
+  EXPECT_EQ(hashBytes(nullptr, 0), hashBytes(bytes.data(), 0));
+}
+
+TEST(DataVariantHashTests, hashesTimestamps) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  Timestamp time{2025, 9, 11, 18, 9, 23, 521};
+  Timestamp later{2025, 9, 11, 18, 9, 23, 522};
+  // NOLINTEND(readability-magic-numbers)
+  EXPECT_EQ(hash<Timestamp>{}(time), hash<Timestamp>{}(time));
+  EXPECT_NE(hash<Timestamp>{}(time), hash<Timestamp>{}(later));
+
+  unordered_set<Timestamp> timestamps{time, later, time};
+  EXPECT_EQ(timestamps.size(), 2);
+}
+
+TEST(DataVariantCompareTests, ordersByDataTypeFirst) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_LT(compare(true, (intmax_t)-100), 0);
+  EXPECT_LT(compare((uintmax_t)100, 0.5), 0);
+  EXPECT_GT(compare(string("a"), vector<uint8_t>{0xFF}), 0);
+  EXPECT_LT(compare(DoubleArray{}, Integer16{1}), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantCompareTests, ordersValuesOfSameDataType) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_LT(compare(false, true), 0);
+  EXPECT_GT(compare((intmax_t)1, (intmax_t)-1), 0);
+  EXPECT_EQ(compare(UnsignedInteger32{7}, UnsignedInteger32{7}), 0);
+  EXPECT_LT(compare(Timestamp{2025, 9, 11, 18, 9, 23, 521},
+                Timestamp{2025, 9, 11, 18, 9, 24, 0}),
+      0);
+  EXPECT_LT(compare(string("abc"), string("abd")), 0);
+  EXPECT_LT(compare(string("ab"), string("abc")), 0);
+  EXPECT_GT(compare(string("\xFF"), string("a")), 0);
+  EXPECT_LT(compare(vector<uint8_t>{}, vector<uint8_t>{0x00}), 0);
+  EXPECT_LT(compare(IntegerArray{1, -2}, IntegerArray{1, 2}), 0);
+  EXPECT_GT(compare(IntegerArray{1, 2, 0}, IntegerArray{1, 2}), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantCompareTests, ordersFloatingPointTotally) {
+  auto nan = numeric_limits<double>::quiet_NaN();
+  auto inf = numeric_limits<double>::infinity();
+  EXPECT_EQ(compare(0.0, -0.0), 0);
+  EXPECT_EQ(compare(nan, nan), 0);
+  EXPECT_GT(compare(nan, inf), 0);
+  EXPECT_LT(compare(-inf, nan), 0);
+  EXPECT_EQ(compare(numeric_limits<float>::quiet_NaN(),
+                numeric_limits<float>::quiet_NaN()),
+      0);
+  EXPECT_GT(compare(DoubleArray{nan}, DoubleArray{inf}), 0);
+}
+
+TEST(DataVariantCompareTests, canSortWithNaNs) {
+  auto nan = numeric_limits<double>::quiet_NaN();
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  vector<DataVariant> values{nan, 2.0, (intmax_t)3, nan, -1.0, true};
+  sort(values.begin(), values.end(), DataVariantLess{});
+
+  EXPECT_EQ(values[0], DataVariant(true));
+  EXPECT_EQ(values[1], DataVariant((intmax_t)3));
+  EXPECT_EQ(values[2], DataVariant(-1.0));
+  EXPECT_EQ(values[3], DataVariant(2.0));
+  EXPECT_TRUE(isnan(get<double>(values[4])));
+  EXPECT_TRUE(isnan(get<double>(values[5])));
+
+  set<DataVariant, DataVariantLess> unique{nan, nan, 0.0, -0.0};
+  EXPECT_EQ(unique.size(), 2);
+}
+} // namespace Information_Model::testing
@@ -3,6 +3,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <limits>
+
 namespace Information_Model::testing {
 using namespace std;
 using namespace ::testing;
@@ -15,6 +17,21 @@ TEST(DataVariantTests, returnsCorrectSanitizedString) {
   EXPECT_EQ(toSanitizedString(DataType::Timestamp), "Timestamp");
   EXPECT_EQ(toSanitizedString(DataType::Opaque), "OpaqueByteArray");
   EXPECT_EQ(toSanitizedString(DataType::String), "String");
+  EXPECT_EQ(
+      toSanitizedString(DataType::Integer_Array), "SignedIntegerArray");
+  EXPECT_EQ(toSanitizedString(DataType::Unsigned_Integer_Array),
+      "UnsignedIntegerArray");
+  EXPECT_EQ(toSanitizedString(DataType::Double_Array),
+      "DoubleFloatingPointArray");
+  EXPECT_EQ(toSanitizedString(DataType::Integer_16), "Signed16BitInteger");
+  EXPECT_EQ(toSanitizedString(DataType::Integer_32), "Signed32BitInteger");
+  EXPECT_EQ(toSanitizedString(DataType::Unsigned_Integer_16),
+      "Unsigned16BitInteger");
+  EXPECT_EQ(toSanitizedString(DataType::Unsigned_Integer_32),
+      "Unsigned32BitInteger");
+  EXPECT_EQ(toSanitizedString(DataType::Float), "SingleFloatingPoint");
+  EXPECT_EQ(toSanitizedString(DataType::Integer_16_Array),
+      "Signed16BitIntegerArray");
   EXPECT_EQ(toSanitizedString(DataType::None), "None");
   EXPECT_EQ(toSanitizedString(DataType::Unknown), "Unknown");
 }
@@ -31,7 +48,222 @@ TEST(DataVariantTests, returnsCorrectSize) {
   EXPECT_EQ(
       size_of(setVariant(DataType::Opaque).value()), vector<uint8_t>{}.size());
   EXPECT_EQ(size_of(setVariant(DataType::String).value()), string().size());
+  EXPECT_EQ(size_of(setVariant(DataType::Integer_Array).value()), 0);
+  EXPECT_EQ(size_of(setVariant(DataType::Unsigned_Integer_Array).value()), 0);
+  EXPECT_EQ(size_of(setVariant(DataType::Double_Array).value()), 0);
+  EXPECT_EQ(size_of(setVariant(DataType::Integer_16).value()), sizeof(int16_t));
+  EXPECT_EQ(size_of(setVariant(DataType::Integer_32).value()), sizeof(int32_t));
+  EXPECT_EQ(size_of(setVariant(DataType::Unsigned_Integer_16).value()),
+      sizeof(uint16_t));
+  EXPECT_EQ(size_of(setVariant(DataType::Unsigned_Integer_32).value()),
+      sizeof(uint32_t));
+  EXPECT_EQ(size_of(setVariant(DataType::Float).value()), sizeof(float));
   // NOLINTEND(bugprone-unchecked-optional-access)
+  EXPECT_EQ(size_of(DoubleArray{1.0, 2.0, 3.0}), 3 * sizeof(double));
+  EXPECT_EQ(size_of(IntegerArray{1, 2}), 2 * sizeof(intmax_t));
+  EXPECT_EQ(size_of(Integer16Array{1, 2, 3}), 3 * sizeof(int16_t));
 }
 
+TEST(DataVariantTests, keepsPersistedDataTypeValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  static_assert(static_cast<uint8_t>(DataType::String) == 6);
+  static_assert(static_cast<uint8_t>(DataType::None) == 7);
+  static_assert(static_cast<uint8_t>(DataType::Unknown) == 8);
+  static_assert(static_cast<uint8_t>(DataType::Integer_16_Array) == 17);
+  // NOLINTEND(readability-magic-numbers)
+  EXPECT_EQ(variantIndexOf(DataType::Integer_16_Array),
+      VariantIndexOf_v<Integer16Array>);
+}
+
+TEST(DataVariantTests, storesArraysInAlignedMemory) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  for (size_t size : {1U, 3U, 1000U}) {
+    auto values = DoubleArray(size, 0.5);
+    auto address = reinterpret_cast<uintptr_t>(values.data());
+    EXPECT_EQ(address % CACHE_LINE_ALIGNMENT, 0);
+  }
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantTests, printsArrays) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_EQ(toString(IntegerArray{1, -2, 3}), "[1, -2, 3]");
+  EXPECT_EQ(toString(UnsignedIntegerArray{}), "[]");
+  EXPECT_EQ(toString(DoubleArray{0.5}), "[0.500000]");
+  EXPECT_EQ(toSanitizedString(IntegerArray{1, -2, 3}), "1_Neg2_3");
+  EXPECT_EQ(toSanitizedString(DoubleArray{-0.5, 1.25}),
+      "Neg0P500000_1P250000");
+  EXPECT_EQ(toSanitizedString(UnsignedIntegerArray{}), "NullArray");
+  EXPECT_EQ(toString(Integer16Array{-7, 8}), "[-7, 8]");
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantTests, mapsTypesToDataTypes) {
+  static_assert(DataTypeOf_v<bool> == DataType::Boolean);
+  static_assert(DataTypeOf_v<intmax_t> == DataType::Integer);
+  static_assert(DataTypeOf_v<uintmax_t> == DataType::Unsigned_Integer);
+  static_assert(DataTypeOf_v<double> == DataType::Double);
+  static_assert(DataTypeOf_v<Timestamp> == DataType::Timestamp);
+  static_assert(DataTypeOf_v<vector<uint8_t>> == DataType::Opaque);
+  static_assert(DataTypeOf_v<string> == DataType::String);
+
+  static_assert(is_same_v<TypeOf_t<DataType::Boolean>, bool>);
+  static_assert(is_same_v<TypeOf_t<DataType::Integer>, intmax_t>);
+  static_assert(is_same_v<TypeOf_t<DataType::Unsigned_Integer>, uintmax_t>);
+  static_assert(is_same_v<TypeOf_t<DataType::Double>, double>);
+  static_assert(is_same_v<TypeOf_t<DataType::Timestamp>, Timestamp>);
+  static_assert(is_same_v<TypeOf_t<DataType::Opaque>, vector<uint8_t>>);
+  static_assert(is_same_v<TypeOf_t<DataType::String>, string>);
+
+  EXPECT_EQ(variantIndexOf(DataType::None), variant_npos);
+  EXPECT_EQ(variantIndexOf(DataType::Unknown), variant_npos);
+  EXPECT_EQ(dataTypeAt(variant_npos), DataType::Unknown);
+}
+
+TEST(DataVariantTests, returnsCorrectDataType) {
+  for (auto index = 0U; index < variant_size_v<DataVariant>; ++index) {
+    auto type = dataTypeAt(index);
+    // NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+    auto variant = setVariant(type).value();
+
+    EXPECT_EQ(toDataType(variant), type);
+    EXPECT_EQ(variantIndexOf(type), variant.index());
+    EXPECT_TRUE(matchVariantType(variant, type));
+    EXPECT_FALSE(matchVariantType(variant, DataType::None));
+    EXPECT_FALSE(matchVariantType(variant, DataType::Unknown));
+  }
+}
+
+TEST(DataVariantTests, visitsDataType) {
+  for (auto index = 0U; index < variant_size_v<DataVariant>; ++index) {
+    auto type = dataTypeAt(index);
+    auto visited = visitDataType(type, [](auto tag) {
+      using Type = typename decltype(tag)::type;
+      EXPECT_EQ(DataTypeOf_v<Type>, decltype(tag)::value);
+      return decltype(tag)::value;
+    });
+    EXPECT_EQ(visited, type);
+  }
+
+  EXPECT_THROW(visitDataType(DataType::None, [](auto) {}), logic_error);
+  EXPECT_THROW(visitDataType(DataType::Unknown, [](auto) {}), logic_error);
+}
+
+TEST(DataVariantTests, printsNarrowValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_EQ(toString(DataVariant(Integer16{-16})), "-16");
+  EXPECT_EQ(toString(DataVariant(UnsignedInteger32{32})), "32");
+  EXPECT_EQ(toSanitizedString(DataVariant(Integer32{-32})), "Neg32");
+  EXPECT_EQ(toSanitizedString(DataVariant(Float32{-1.5F})), "Neg1P500000");
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantTests, checksLosslessConversions) {
+  EXPECT_TRUE(isLosslesslyConvertible(DataType::Integer_16, DataType::Integer));
+  EXPECT_TRUE(
+      isLosslesslyConvertible(DataType::Integer_16, DataType::Integer_32));
+  EXPECT_TRUE(isLosslesslyConvertible(DataType::Integer_32, DataType::Double));
+  EXPECT_TRUE(isLosslesslyConvertible(DataType::Integer_16, DataType::Float));
+  EXPECT_TRUE(isLosslesslyConvertible(
+      DataType::Unsigned_Integer_16, DataType::Integer_32));
+  EXPECT_TRUE(isLosslesslyConvertible(
+      DataType::Unsigned_Integer_32, DataType::Unsigned_Integer));
+  EXPECT_TRUE(isLosslesslyConvertible(DataType::Float, DataType::Double));
+  EXPECT_TRUE(isLosslesslyConvertible(DataType::Integer, DataType::Integer));
+
+  EXPECT_FALSE(isLosslesslyConvertible(
+      DataType::Integer_16, DataType::Unsigned_Integer_32));
+  EXPECT_FALSE(isLosslesslyConvertible(
+      DataType::Unsigned_Integer_32, DataType::Integer_32));
+  EXPECT_FALSE(isLosslesslyConvertible(DataType::Integer_32, DataType::Float));
+  EXPECT_FALSE(isLosslesslyConvertible(DataType::Integer, DataType::Double));
+  EXPECT_FALSE(isLosslesslyConvertible(DataType::Double, DataType::Float));
+  EXPECT_FALSE(
+      isLosslesslyConvertible(DataType::Boolean, DataType::Integer_16));
+  EXPECT_FALSE(isLosslesslyConvertible(DataType::String, DataType::String));
+  EXPECT_FALSE(isLosslesslyConvertible(DataType::None, DataType::Integer));
+}
+
+TEST(DataVariantTests, canWidenValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_EQ(widen(DataVariant(Integer16{-5}), DataType::Integer),
+      DataVariant((intmax_t)-5));
+  EXPECT_EQ(
+      widen(DataVariant(UnsignedInteger16{65535}), DataType::Integer_32),
+      DataVariant(Integer32{65535}));
+  EXPECT_EQ(
+      widen(DataVariant(Float32{0.5F}), DataType::Double), DataVariant(0.5));
+
+  EXPECT_THROW(widen(DataVariant((intmax_t)1), DataType::Integer_16),
+      ConversionNotSupported);
+  EXPECT_THROW(
+      widen(DataVariant(string("1")), DataType::Integer), ConversionNotSupported);
+  EXPECT_THROW(widen(DataVariant(1.0), DataType::None), ConversionNotSupported);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantTests, canNarrowValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_EQ(narrow(DataVariant((intmax_t)-32768), DataType::Integer_16),
+      DataVariant(Integer16{-32768}));
+  EXPECT_EQ(narrow(DataVariant((uintmax_t)65535), DataType::Unsigned_Integer_16),
+      DataVariant(UnsignedInteger16{65535}));
+  EXPECT_EQ(narrow(DataVariant(12.0), DataType::Integer_32),
+      DataVariant(Integer32{12}));
+  EXPECT_EQ(
+      narrow(DataVariant(0.5), DataType::Float), DataVariant(Float32{0.5F}));
+  EXPECT_EQ(narrow(DataVariant(12.0), DataType::Unsigned_Integer),
+      DataVariant((uintmax_t)12));
+  EXPECT_EQ(narrow(DataVariant(-12.0), DataType::Integer),
+      DataVariant((intmax_t)-12));
+  // largest doubles below 2^64 and 2^63, and -2^63
+  EXPECT_EQ(narrow(DataVariant(18446744073709549568.0),
+                DataType::Unsigned_Integer),
+      DataVariant((uintmax_t)18446744073709549568U));
+  EXPECT_EQ(narrow(DataVariant(9223372036854774784.0), DataType::Integer),
+      DataVariant((intmax_t)9223372036854774784));
+  EXPECT_EQ(narrow(DataVariant(-9223372036854775808.0), DataType::Integer),
+      DataVariant(numeric_limits<intmax_t>::min()));
+
+  EXPECT_THROW(narrow(DataVariant(18446744073709551616.0),
+                   DataType::Unsigned_Integer),
+      ValueOutOfRange);
+  EXPECT_THROW(
+      narrow(DataVariant(-1.0), DataType::Unsigned_Integer), ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant(9223372036854775808.0), DataType::Integer),
+      ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant(-9223372036854777856.0), DataType::Integer),
+      ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant((intmax_t)-32769), DataType::Integer_16),
+      ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant((intmax_t)-1), DataType::Unsigned_Integer),
+      ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant((uintmax_t)-1), DataType::Integer),
+      ValueOutOfRange);
+  EXPECT_THROW(
+      narrow(DataVariant(12.5), DataType::Integer_32), ValueOutOfRange);
+  EXPECT_THROW(
+      narrow(DataVariant(4294967296.0), DataType::Unsigned_Integer_32),
+      ValueOutOfRange);
+  EXPECT_THROW(narrow(DataVariant(1e300), DataType::Float), ValueOutOfRange);
+  EXPECT_THROW(
+      narrow(DataVariant(true), DataType::Integer_16), ConversionNotSupported);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(DataVariantTests, storesPlainNumbersAsWideDataTypes) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_EQ(toDataType(DataVariant(5)), DataType::Integer);
+  EXPECT_EQ(toDataType(DataVariant((short)5)), DataType::Integer);
+  EXPECT_EQ(toDataType(DataVariant(1.5F)), DataType::Double);
+  EXPECT_EQ(toDataType(DataVariant((uintmax_t)5)), DataType::Unsigned_Integer);
+  EXPECT_EQ(toDataType(DataVariant(Integer16{5})), DataType::Integer_16);
+  EXPECT_EQ(toDataType(DataVariant(Integer32{5})), DataType::Integer_32);
+  EXPECT_EQ(toDataType(DataVariant(UnsignedInteger16{5})),
+      DataType::Unsigned_Integer_16);
+  EXPECT_EQ(toDataType(DataVariant(UnsignedInteger32{5})),
+      DataType::Unsigned_Integer_32);
+  EXPECT_EQ(toDataType(DataVariant(Float32{1.5F})), DataType::Float);
+  // NOLINTEND(readability-magic-numbers)
+}
 } // namespace Information_Model::testing
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef __STAG_INFORMATION_MODEL_DEVICE_BUILDER_MOCK_HPP
+#define __STAG_INFORMATION_MODEL_DEVICE_BUILDER_MOCK_HPP
+
+#include "DeviceBuilder.hpp"
+
+#include <gmock/gmock.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace Information_Model::testing {
+/**
+ * @brief DeviceBuilder with mocked pure virtual methods, for testing the
+ * default implementations and non-virtual overloads
+ */
+struct DeviceBuilderMock : public DeviceBuilder {
+  using DeviceBuilder::addObservable;
+  using DeviceBuilder::addReadable;
+  using DeviceBuilder::addWritable;
+
+  MOCK_METHOD(void,
+      setDeviceInfo,
+      (const std::string&, const BuildInfo&),
+      (override));
+  MOCK_METHOD(std::string, addGroup, (const BuildInfo&), (override));
+  MOCK_METHOD(std::string,
+      addGroup,
+      (const std::string&, const BuildInfo&),
+      (override));
+  MOCK_METHOD(std::string,
+      addReadable,
+      (const BuildInfo&, DataType, const ReadCallback&),
+      (override));
+  MOCK_METHOD(std::string,
+      addReadable,
+      (const std::string&, const BuildInfo&, DataType, const ReadCallback&),
+      (override));
+  MOCK_METHOD(std::string,
+      addWritable,
+      (const BuildInfo&, DataType, const WriteCallback&, const ReadCallback&),
+      (override));
+  MOCK_METHOD(std::string,
+      addWritable,
+      (const std::string&,
+          const BuildInfo&,
+          DataType,
+          const WriteCallback&,
+          const ReadCallback&),
+      (override));
+  MOCK_METHOD((std::pair<std::string, NotifyCallback>),
+      addObservable,
+      (const BuildInfo&,
+          DataType,
+          const ReadCallback&,
+          const IsObservingCallback&),
+      (override));
+  MOCK_METHOD((std::pair<std::string, NotifyCallback>),
+      addObservable,
+      (const std::string&,
+          const BuildInfo&,
+          DataType,
+          const ReadCallback&,
+          const IsObservingCallback&),
+      (override));
+  MOCK_METHOD(std::string,
+      addCallable,
+      (const BuildInfo&, const ExecuteCallback&, const ParameterTypes&),
+      (override));
+  MOCK_METHOD(std::string,
+      addCallable,
+      (const std::string&,
+          const BuildInfo&,
+          const ExecuteCallback&,
+          const ParameterTypes&),
+      (override));
+  MOCK_METHOD(std::string,
+      addCallable,
+      (const BuildInfo&,
+          DataType,
+          const ExecuteCallback&,
+          const AsyncExecuteCallback&,
+          const CancelCallback&,
+          const ParameterTypes&),
+      (override));
+  MOCK_METHOD(std::string,
+      addCallable,
+      (const std::string&,
+          const BuildInfo&,
+          DataType,
+          const ExecuteCallback&,
+          const AsyncExecuteCallback&,
+          const CancelCallback&,
+          const ParameterTypes&),
+      (override));
+  MOCK_METHOD(std::unique_ptr<Device>, result, (), (override));
+  MOCK_METHOD(void, abandon, (), (noexcept, override));
+};
+} // namespace Information_Model::testing
+
+#endif //__STAG_INFORMATION_MODEL_DEVICE_BUILDER_MOCK_HPP
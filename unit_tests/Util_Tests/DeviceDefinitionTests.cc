@@ -0,0 +1,277 @@
+#include "ArenaDevice.hpp"
+#include "DeviceBuilderMock.hpp"
+#include "DeviceDefinition.hpp"
+#include "TypedElement.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+DeviceDefinition parse(const string& text) {
+  istringstream input(text);
+  return parseDefinition(input);
+}
+
+ElementCallbacks readCallbacks(intmax_t value) {
+  ElementCallbacks callbacks;
+  callbacks.read = [value]() { return DataVariant(value); };
+  return callbacks;
+}
+
+TEST(DeviceDefinitionTests, parsesDefinition) {
+  auto definition = parse(R"({
+    "id": "dev",
+    "name": "Device \"A\"",
+    "description": "café 😀",
+    "vendor": {"ignored": [1, 2.5e3, -3, true, null, "x"]},
+    "elements": [
+      {"name": "Group", "type": "Group", "parent": null},
+      {"parent": 0, "name": "Reading", "type": "Readable",
+       "data_type": "Unsigned_Integer"},
+      {"parent": 0, "type": "Writable", "data_type": "Boolean",
+       "callback": 7},
+      {"type": "Callable", "data_type": "None", "parameters": [
+        {"position": 1, "type": "Integer", "mandatory": true},
+        {"position": 2, "type": "Double", "allow_widening": true}
+      ]}
+    ]
+  })");
+
+  EXPECT_EQ(definition.id, "dev");
+  EXPECT_EQ(definition.info.name, "Device \"A\"");
+  EXPECT_EQ(definition.info.description, "caf\xC3\xA9 \xF0\x9F\x98\x80");
+  ASSERT_EQ(definition.elements.size(), 4);
+  const auto& group = definition.elements[0];
+  EXPECT_EQ(group.parent, DEFINITION_ROOT);
+  EXPECT_EQ(group.type, ElementType::Group);
+  const auto& reading = definition.elements[1];
+  EXPECT_EQ(reading.parent, 0);
+  EXPECT_EQ(reading.info.name, "Reading");
+  EXPECT_EQ(reading.type, ElementType::Readable);
+  EXPECT_EQ(reading.data_type, DataType::Unsigned_Integer);
+  EXPECT_EQ(reading.callback, 0);
+  EXPECT_EQ(definition.elements[2].callback, 7);
+  const auto& callable = definition.elements[3];
+  EXPECT_EQ(callable.parent, DEFINITION_ROOT);
+  EXPECT_EQ(callable.callback, 2);
+  EXPECT_EQ(callable.parameter_types,
+      (ParameterTypes{{1, ParameterType{DataType::Integer, true}},
+          {2, ParameterType{DataType::Double, false, true}}}));
+}
+
+TEST(DeviceDefinitionTests, rejectsMalformedInput) {
+  for (const auto& text : {"",
+           "[]",
+           R"({"id": "dev")",
+           R"({"id": "dev",})",
+           R"({"id": dev})",
+           R"({"id": "dev"} {})",
+           R"({"id": "d\x"})",
+           R"({"id": "\ud83d"})",
+           R"({"elements": [{"type": "Sensor"}]})",
+           R"({"elements": [{"data_type": "Integer_64"}]})",
+           R"({"elements": [{"parent": -1}]})",
+           R"({"elements": [{"parent": 1.5}]})",
+           R"({"elements": [{"parent": 4294967295}]})",
+           R"({"elements": [{"parameters": [{"type": "Boolean"}]}]})",
+           R"({"elements": [{"parameters": [{"position": 1},
+               {"position": 1}]}]})",
+           R"({"elements": [{"name": tru}]})"}) {
+    EXPECT_THROW(parse(text), DefinitionParseError) << text;
+  }
+}
+
+TEST(DeviceDefinitionTests, buildsArenaDevice) {
+  auto definition = parse(R"({
+    "id": "dev", "name": "Device",
+    "elements": [
+      {"name": "Group", "type": "Group"},
+      {"parent": 0, "name": "Reading", "type": "Readable",
+       "data_type": "Integer", "callback": 1},
+      {"name": "Observable", "type": "Observable", "data_type": "Integer",
+       "callback": 0},
+      {"parent": 0, "name": "Inner", "type": "Group"},
+      {"parent": 3, "name": "Call", "type": "Callable",
+       "data_type": "Integer", "callback": 2,
+       "parameters": [{"position": 1, "type": "Boolean", "mandatory": true}]}
+    ]
+  })");
+  vector<ElementCallbacks> callbacks;
+  vector<bool> observing;
+  callbacks.push_back(readCallbacks(0));
+  callbacks.back().observe = [&observing](bool state) {
+    observing.push_back(state);
+  };
+  callbacks.push_back(readCallbacks(7));
+  ElementCallbacks call;
+  call.execute = [](const Parameters&) {};
+  call.async_execute = [](const Parameters&) {
+    promise<DataVariant> result;
+    result.set_value(DataVariant((intmax_t)42));
+    return ResultFuture(uintmax_t{1}, result.get_future());
+  };
+  call.cancel = [](uintmax_t) {};
+  callbacks.push_back(move(call));
+
+  ArenaDeviceBuilder builder;
+  auto built = builder.build(move(definition), move(callbacks));
+
+  EXPECT_THAT(built.ids,
+      ElementsAre("dev:0", "dev:0.0", "dev:1", "dev:0.1", "dev:0.1.0"));
+  EXPECT_EQ(built.device->name(), "Device");
+  EXPECT_EQ(built.device->size(), 2);
+  EXPECT_EQ(built.device->element("dev:0.0")->name(), "Reading");
+  auto reading = get<ReadablePtr>(built.device->element("dev:0.0")->function());
+  EXPECT_EQ(get<intmax_t>(reading->read()), 7);
+  auto callable =
+      get<CallablePtr>(built.device->element("dev:0.1.0")->function());
+  EXPECT_EQ(get<intmax_t>(callable->call(Parameters{{1, DataVariant(true)}})),
+      42);
+  EXPECT_THROW(callable->call(), MandatoryParameterMissing);
+
+  auto observable =
+      get<ObservablePtr>(built.device->element("dev:1")->function());
+  vector<intmax_t> values;
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<intmax_t>(*value));
+      },
+      nullptr);
+  EXPECT_FALSE(built.notifiers[0]);
+  built.notifiers[2](DataVariant((intmax_t)5));
+  EXPECT_THAT(values, ElementsAre(5));
+  EXPECT_THAT(observing, ElementsAre(true));
+
+  // the builder is ready for the next device
+  builder.setDeviceInfo("next", BuildInfo{});
+}
+
+TEST(DeviceDefinitionTests, rejectsInvalidDefinitions) {
+  auto readable = [](uint32_t parent, uint32_t callback) {
+    ElementDefinition element;
+    element.parent = parent;
+    element.type = ElementType::Readable;
+    element.data_type = DataType::Integer;
+    element.callback = callback;
+    return element;
+  };
+  ElementDefinition group;
+  auto callbacks = [](size_t count) {
+    vector<ElementCallbacks> result;
+    for (size_t i = 0; i < count; ++i) {
+      result.push_back(readCallbacks(0));
+    }
+    return result;
+  };
+
+  vector<vector<ElementDefinition>> invalid{{},
+      {group},
+      {readable(1, 0), group},
+      {readable(DEFINITION_ROOT, 0), readable(0, 1)},
+      {readable(DEFINITION_ROOT, 2)},
+      {readable(DEFINITION_ROOT, 0), readable(DEFINITION_ROOT, 0)}};
+  auto none = readable(DEFINITION_ROOT, 0);
+  none.data_type = DataType::None;
+  invalid.push_back({none});
+  auto writable = readable(DEFINITION_ROOT, 0);
+  writable.type = ElementType::Writable;
+  invalid.push_back({writable});
+  for (size_t i = 0; i < invalid.size(); ++i) {
+    ArenaDeviceBuilder builder;
+    EXPECT_THROW(builder.build(DeviceDefinition{"dev", {}, invalid[i]},
+                     callbacks(2)),
+        InvalidDefinition)
+        << i;
+    // nothing was recorded
+    EXPECT_THROW(builder.result(), DeviceInfoNotSet);
+  }
+
+  ArenaDeviceBuilder in_progress;
+  in_progress.setDeviceInfo("dev", BuildInfo{});
+  EXPECT_THROW(in_progress.build(DeviceDefinition{"dev",
+                                     {},
+                                     {readable(DEFINITION_ROOT, 0)}},
+                   callbacks(1)),
+      DeviceBuildInProgress);
+}
+
+TEST(DeviceDefinitionTests, defaultBuildReplaysCalls) {
+  DeviceBuilderMock builder;
+  InSequence sequence;
+  EXPECT_CALL(builder, setDeviceInfo("fake", _));
+  EXPECT_CALL(builder, addGroup(_)).WillOnce(Return("fake:0"));
+  EXPECT_CALL(builder, addReadable("fake:0", _, DataType::Integer, _))
+      .WillOnce(Return("fake:0.0"));
+  EXPECT_CALL(builder, addReadable(_, DataType::Boolean, _))
+      .WillOnce(Return("fake:1"));
+  EXPECT_CALL(builder, result()).WillOnce(Return(ByMove(nullptr)));
+
+  DeviceDefinition definition{"fake", BuildInfo{}, {}};
+  definition.elements.emplace_back();
+  definition.elements.push_back(ElementDefinition{
+      0, BuildInfo{}, ElementType::Readable, DataType::Integer, {}, 0});
+  definition.elements.push_back(ElementDefinition{DEFINITION_ROOT,
+      BuildInfo{},
+      ElementType::Readable,
+      DataType::Boolean,
+      {},
+      1});
+  vector<ElementCallbacks> callbacks;
+  callbacks.push_back(readCallbacks(0));
+  callbacks.push_back(readCallbacks(1));
+  auto built = builder.build(move(definition), move(callbacks));
+
+  EXPECT_THAT(built.ids, ElementsAre("fake:0", "fake:0.0", "fake:1"));
+}
+
+TEST(DeviceDefinitionTests, defaultBuildAbandonsRejectedBuild) {
+  DeviceBuilderMock builder;
+  InSequence sequence;
+  EXPECT_CALL(builder, setDeviceInfo("fake", _));
+  EXPECT_CALL(builder, addGroup(_)).WillOnce(Return("fake:0"));
+  EXPECT_CALL(builder, addReadable("fake:0", _, DataType::Integer, _))
+      .WillOnce(Throw(invalid_argument("rejected")));
+  EXPECT_CALL(builder, abandon());
+  EXPECT_CALL(builder, result()).Times(0);
+
+  DeviceDefinition definition{"fake", BuildInfo{}, {}};
+  definition.elements.emplace_back();
+  definition.elements.push_back(ElementDefinition{
+      0, BuildInfo{}, ElementType::Readable, DataType::Integer, {}, 0});
+  vector<ElementCallbacks> callbacks;
+  callbacks.push_back(readCallbacks(0));
+  EXPECT_THROW(
+      builder.build(move(definition), move(callbacks)), invalid_argument);
+}
+
+TEST(DeviceDefinitionTests, defaultBuildKeepsBuildInProgress) {
+  DeviceBuilderMock builder;
+  EXPECT_CALL(builder, setDeviceInfo("fake", _))
+      .WillOnce(Throw(DeviceBuildInProgress()));
+  EXPECT_CALL(builder, abandon()).Times(0);
+
+  DeviceDefinition definition{"fake", BuildInfo{}, {}};
+  definition.elements.push_back(ElementDefinition{DEFINITION_ROOT,
+      BuildInfo{},
+      ElementType::Readable,
+      DataType::Integer,
+      {},
+      0});
+  vector<ElementCallbacks> callbacks;
+  callbacks.push_back(readCallbacks(0));
+  EXPECT_THROW(builder.build(move(definition), move(callbacks)),
+      DeviceBuildInProgress);
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
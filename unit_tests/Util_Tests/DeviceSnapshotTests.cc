@@ -0,0 +1,266 @@
+#include "ArenaDevice.hpp"
+#include "DeviceSnapshot.hpp"
+#include "TypedElement.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+struct DeviceSnapshotTests : public ::testing::Test {
+  DeviceSnapshotTests() {
+    ArenaDeviceBuilder builder;
+    builder.setDeviceInfo("dev", BuildInfo{"Device", "Snapshot source"});
+    group_id = builder.addGroup(BuildInfo{"Group", "Nested"});
+    inner_id = builder.addGroup(group_id, BuildInfo{"Inner"});
+    readable_id = builder.addReadable(inner_id,
+        BuildInfo{"Readable", "Reading"},
+        DataType::Integer,
+        []() { return DataVariant((intmax_t)0); });
+    writable_id = builder.addWritable(group_id,
+        BuildInfo{"Writable"},
+        DataType::Boolean,
+        [](const DataVariant&) {});
+    observable_id = builder
+                        .addObservable(BuildInfo{"Observable"},
+                            DataType::Double,
+                            []() { return DataVariant(0.0); },
+                            [](bool) {})
+                        .first;
+    callable_id = builder.addCallable(
+        BuildInfo{"Callable"},
+        DataType::Integer,
+        [](const Parameters&) {},
+        [](const Parameters&) {
+          promise<DataVariant> result;
+          result.set_value(DataVariant((intmax_t)0));
+          return ResultFuture(uintmax_t{1}, result.get_future());
+        },
+        [](uintmax_t) {},
+        ParameterTypes{{1, ParameterType{DataType::Boolean, true}},
+            {2, ParameterType{DataType::Integer, false, true}}});
+    source = builder.result();
+  }
+
+  CallbackResolver resolver() {
+    return [this](const SnapshotElement& element,
+               DeviceBuilder::InlineNotifyCallback&& notify_cb) {
+      resolved.emplace_back(element.id);
+      ElementCallbacks callbacks;
+      auto value = static_cast<intmax_t>(resolved.size());
+      callbacks.read = [value]() { return DataVariant(value); };
+      callbacks.write = [this](const DataVariant& value) {
+        written.push_back(value);
+      };
+      callbacks.observe = [this](bool state) { observing.push_back(state); };
+      callbacks.execute = [](const Parameters&) {};
+      callbacks.async_execute = [](const Parameters&) {
+        promise<DataVariant> result;
+        result.set_value(DataVariant((intmax_t)42));
+        return ResultFuture(uintmax_t{1}, result.get_future());
+      };
+      callbacks.cancel = [](uintmax_t) {};
+      if (notify_cb) {
+        notify = move(notify_cb);
+      }
+      return callbacks;
+    };
+  }
+
+  string group_id;
+  string inner_id;
+  string readable_id;
+  string writable_id;
+  string observable_id;
+  string callable_id;
+  unique_ptr<Device> source;
+  vector<string> resolved;
+  vector<DataVariant> written;
+  vector<bool> observing;
+  DeviceBuilder::InlineNotifyCallback notify;
+};
+
+TEST_F(DeviceSnapshotTests, keepsStructure) {
+  DeviceSnapshot snapshot(writeSnapshot(*source));
+  EXPECT_EQ(snapshot.deviceId(), "dev");
+  EXPECT_EQ(snapshot.elementCount(), 6);
+  EXPECT_EQ(writeSnapshot(*source), writeSnapshot(*source));
+
+  auto device = snapshot.rehydrate(resolver());
+  EXPECT_EQ(device->id(), "dev");
+  EXPECT_EQ(device->name(), "Device");
+  EXPECT_EQ(device->description(), "Snapshot source");
+  EXPECT_EQ(device->size(), 3);
+
+  auto readable = device->element(readable_id);
+  EXPECT_EQ(readable->id(), readable_id);
+  EXPECT_EQ(readable->name(), "Readable");
+  EXPECT_EQ(readable->description(), "Reading");
+  EXPECT_EQ(readable->type(), ElementType::Readable);
+  EXPECT_EQ(get<ReadablePtr>(readable->function())->dataType(),
+      DataType::Integer);
+  auto writable = get<WritablePtr>(device->element(writable_id)->function());
+  EXPECT_EQ(writable->dataType(), DataType::Boolean);
+  EXPECT_TRUE(writable->isWriteOnly());
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+  EXPECT_EQ(observable->dataType(), DataType::Double);
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  EXPECT_EQ(callable->resultType(), DataType::Integer);
+  EXPECT_EQ(callable->parameterTypes(),
+      (ParameterTypes{{1, ParameterType{DataType::Boolean, true}},
+          {2, ParameterType{DataType::Integer, false, true}}}));
+
+  auto group = get<GroupPtr>(device->element(group_id)->function());
+  vector<string> ids;
+  for (const auto& element : group->asVector()) {
+    ids.push_back(element->id());
+  }
+  EXPECT_THAT(ids, ElementsAre(inner_id, writable_id));
+  EXPECT_EQ(group->asMap().at("1")->id(), writable_id);
+  EXPECT_EQ(device->group()->asMap().at("2")->id(), callable_id);
+  EXPECT_EQ(group->element(readable_id)->id(), readable_id);
+  size_t visited = 0;
+  device->visit([&visited](const ElementPtr&) { ++visited; });
+  EXPECT_EQ(visited, 3);
+
+  // elements share the snapshot ownership
+  device.reset();
+  EXPECT_EQ(readable->name(), "Readable");
+}
+
+TEST_F(DeviceSnapshotTests, rehydratesLazily) {
+  DeviceSnapshot snapshot(writeSnapshot(*source));
+  auto device = snapshot.rehydrate(resolver());
+  EXPECT_THAT(resolved, IsEmpty());
+
+  // only the groups on the path to the element are materialized
+  device->element(readable_id);
+  EXPECT_THAT(resolved,
+      ElementsAre(observable_id, callable_id, writable_id, readable_id));
+  device->element(writable_id);
+  device->element(readable_id);
+  EXPECT_EQ(resolved.size(), 4);
+}
+
+TEST_F(DeviceSnapshotTests, bindsCallbacks) {
+  DeviceSnapshot snapshot(writeSnapshot(*source));
+  auto device = snapshot.rehydrate(resolver());
+
+  auto readable = get<ReadablePtr>(device->element(readable_id)->function());
+  auto writable = get<WritablePtr>(device->element(writable_id)->function());
+  auto observable =
+      get<ObservablePtr>(device->element(observable_id)->function());
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  EXPECT_EQ(get<intmax_t>(readable->read()), 4);
+  writable->write(DataVariant(true));
+  EXPECT_THAT(written, ElementsAre(DataVariant(true)));
+  EXPECT_THROW(writable->write(DataVariant(1.0)), DataTypeMismatch);
+  EXPECT_EQ(get<intmax_t>(callable->call(Parameters{{1, DataVariant(true)}})),
+      42);
+  EXPECT_THROW(callable->call(), MandatoryParameterMissing);
+
+  vector<double> values;
+  auto observer = observable->subscribe(
+      [&values](const shared_ptr<DataVariant>& value) {
+        values.push_back(get<double>(*value));
+      },
+      nullptr);
+  notify(DataVariant(1.5));
+  observer.reset();
+  notify(DataVariant(2.5));
+  EXPECT_THAT(values, ElementsAre(1.5));
+  EXPECT_THAT(observing, ElementsAre(true, false));
+}
+
+TEST_F(DeviceSnapshotTests, mapsFiles) {
+  auto path =
+      (filesystem::temp_directory_path() / "DeviceSnapshotTests.snapshot")
+          .string();
+  saveSnapshot(*source, path);
+  auto snapshot = DeviceSnapshot::map(path);
+  remove(path.c_str());
+
+  EXPECT_EQ(snapshot.size(), writeSnapshot(*source).size());
+  auto device = snapshot.rehydrate(resolver());
+  EXPECT_EQ(device->element(readable_id)->name(), "Readable");
+  EXPECT_THROW(DeviceSnapshot::map(path), runtime_error);
+}
+
+TEST_F(DeviceSnapshotTests, rejectsUnknownIds) {
+  DeviceSnapshot snapshot(writeSnapshot(*source));
+  auto device = snapshot.rehydrate(resolver());
+  auto group = get<GroupPtr>(device->element(group_id)->function());
+
+  for (const auto& ref_id : {"dev:9", "dev:0.2", "other:0", "dev", ""}) {
+    EXPECT_THROW(device->element(ref_id), ElementNotFound) << ref_id;
+    EXPECT_EQ(device->tryElement(ref_id).error().code(),
+        ErrorCode::Element_Not_Found);
+  }
+  EXPECT_THROW(group->element(group_id), IDPointsThisGroup);
+  EXPECT_THROW(group->element(callable_id), ElementNotFound);
+}
+
+TEST_F(DeviceSnapshotTests, rejectsInvalidSnapshots) {
+  auto buffer = writeSnapshot(*source);
+  EXPECT_THROW(DeviceSnapshot(vector<byte>(buffer.begin(), buffer.end() - 1)),
+      SnapshotFormatError);
+  EXPECT_THROW(DeviceSnapshot(vector<byte>(4)), SnapshotFormatError);
+  auto damaged = buffer;
+  damaged[0] = byte{0};
+  EXPECT_THROW(DeviceSnapshot(move(damaged)), SnapshotFormatError);
+
+  DeviceSnapshot snapshot(move(buffer));
+  EXPECT_THROW(snapshot.rehydrate(nullptr), invalid_argument);
+  auto device = snapshot.rehydrate(
+      [](const SnapshotElement&, DeviceBuilder::InlineNotifyCallback&&) {
+        return ElementCallbacks{};
+      });
+  EXPECT_THROW(device->element(readable_id), invalid_argument);
+  EXPECT_EQ(device->tryElement(readable_id).error().code(),
+      ErrorCode::Callback_Failed);
+}
+
+TEST_F(DeviceSnapshotTests, rejectsUnknownDataTypes) {
+  auto buffer = writeSnapshot(*source);
+  // the header holds 12 words, the root record starts with its type byte
+  // followed by its data type byte
+  constexpr size_t root_data_type = 12 * sizeof(uint32_t) + 1;
+  buffer[root_data_type] = byte{0xFF};
+  DeviceSnapshot snapshot(move(buffer));
+
+  EXPECT_THROW(snapshot.rehydrate(resolver()), SnapshotFormatError);
+}
+
+TEST_F(DeviceSnapshotTests, resolvesElementsOnceAfterFailures) {
+  DeviceSnapshot snapshot(writeSnapshot(*source));
+  auto resolve = resolver();
+  auto failed = false;
+  auto device = snapshot.rehydrate(
+      [this, &resolve, &failed](const SnapshotElement& element,
+          DeviceBuilder::InlineNotifyCallback&& notify_cb) {
+        if (element.id == callable_id && !failed) {
+          failed = true;
+          throw runtime_error("Not ready");
+        }
+        return resolve(element, move(notify_cb));
+      });
+
+  EXPECT_THROW(device->group()->asVector(), runtime_error);
+  EXPECT_THAT(resolved, ElementsAre(observable_id));
+  EXPECT_EQ(device->group()->asVector().size(), 3);
+  EXPECT_THAT(resolved, ElementsAre(observable_id, callable_id));
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
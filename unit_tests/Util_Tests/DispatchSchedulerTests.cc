@@ -0,0 +1,232 @@
+#include "DispatchScheduler.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct DispatchSchedulerTests : public ::testing::Test {
+  /**
+   * @brief Occupies the only in flight slot of a device until released
+   */
+  future<void> block(DispatchScheduler& scheduler, const string& device_id) {
+    promise<void> started;
+    auto running = started.get_future();
+    auto done = scheduler.submit(device_id,
+        DispatchPriority::Bulk,
+        [&started, released = gate.get_future().share()]() {
+          started.set_value();
+          released.wait();
+        });
+    running.wait();
+    return done;
+  }
+
+  function<void()> record(const string& name) {
+    return [this, name]() {
+      lock_guard lock(mx);
+      order.push_back(name);
+    };
+  }
+
+  promise<void> gate;
+  mutex mx;
+  vector<string> order;
+};
+
+TEST_F(DispatchSchedulerTests, dispatchesByPriority) {
+  DispatchScheduler scheduler(1);
+  scheduler.start();
+  auto blocker = block(scheduler, "device");
+
+  scheduler.dispatch("device", DispatchPriority::Bulk, record("bulk"));
+  scheduler.dispatch("device", DispatchPriority::Normal, record("normal"));
+  auto last = scheduler.submit(
+      "device", DispatchPriority::Bulk, [this]() { record("last")(); });
+  scheduler.dispatch("device", DispatchPriority::Critical, record("critical"));
+  EXPECT_EQ(scheduler.queued(), 4);
+  gate.set_value();
+  blocker.get();
+  last.get();
+
+  EXPECT_THAT(order, ElementsAre("critical", "normal", "bulk", "last"));
+  EXPECT_EQ(scheduler.queueLatency(DispatchPriority::Critical).count(), 1);
+  EXPECT_EQ(scheduler.queueLatency(DispatchPriority::Bulk).count(), 3);
+  EXPECT_EQ(scheduler.statistics().dispatched, 5);
+}
+
+TEST_F(DispatchSchedulerTests, limitsInFlightOperations) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  DispatchScheduler scheduler(4);
+  scheduler.setPolicy("device", DeviceDispatchPolicy{0.0, 1.0, 2});
+  scheduler.start();
+  atomic<size_t> running{0};
+  atomic<size_t> max_running{0};
+  vector<future<void>> results;
+  for (int i = 0; i < 8; ++i) {
+    results.push_back(scheduler.submit(
+        "device", DispatchPriority::Normal, [&running, &max_running]() {
+          auto current = ++running;
+          auto seen = max_running.load();
+          while (current > seen &&
+              !max_running.compare_exchange_weak(seen, current)) {
+          }
+          this_thread::sleep_for(2ms);
+          --running;
+        }));
+  }
+  for (auto& result : results) {
+    result.get();
+  }
+
+  EXPECT_LE(max_running, 2);
+  EXPECT_EQ(scheduler.statistics().dispatched, 8);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(DispatchSchedulerTests, rateLimitsDevices) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  DispatchScheduler scheduler(2);
+  scheduler.setPolicy("limited", DeviceDispatchPolicy{200.0, 1.0, 4});
+  scheduler.start();
+  auto start = DispatchScheduler::Clock::now();
+  vector<future<void>> results;
+  for (int i = 0; i < 5; ++i) {
+    results.push_back(
+        scheduler.submit("limited", DispatchPriority::Normal, []() {}));
+  }
+  // other devices are not throttled
+  scheduler.submit("other", DispatchPriority::Normal, []() {}).get();
+  auto other_done = DispatchScheduler::Clock::now();
+  for (auto& result : results) {
+    result.get();
+  }
+  auto limited_done = DispatchScheduler::Clock::now();
+
+  // one burst token, then 4 tokens at 5 ms each
+  EXPECT_GE(limited_done - start, 18ms);
+  EXPECT_LT(other_done - start, limited_done - start);
+  EXPECT_GT(scheduler.statistics().throttled, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(DispatchSchedulerTests, routesElementCallbacks) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  DispatchScheduler scheduler(2);
+  scheduler.start();
+  auto read = scheduler.routeRead("device",
+      DispatchPriority::Bulk,
+      []() { return DataVariant((intmax_t)42); });
+  auto write = scheduler.routeWrite("device",
+      DispatchPriority::Normal,
+      [](const DataVariant&) { throw runtime_error("Write failed"); });
+  promise<Parameters> executed;
+  auto execute = scheduler.routeExecute("device",
+      DispatchPriority::Critical,
+      [&executed](const Parameters& parameters) {
+        executed.set_value(parameters);
+      });
+  auto async_execute = scheduler.routeAsyncExecute("device",
+      DispatchPriority::High,
+      [](const Parameters&) {
+        promise<DataVariant> result;
+        result.set_value(DataVariant(true));
+        return ResultFuture(uintmax_t{7}, result.get_future());
+      });
+
+  EXPECT_EQ(get<intmax_t>(read()), 42);
+  EXPECT_THROW(write(DataVariant(true)), runtime_error);
+  execute(Parameters{{1, DataVariant(true)}});
+  EXPECT_EQ(executed.get_future().get().size(), 1);
+  auto result = async_execute(Parameters{});
+  EXPECT_EQ(result.id(), 7);
+  EXPECT_TRUE(get<bool>(result.get()));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(DispatchSchedulerTests, countsDetachedFailures) {
+  DispatchScheduler scheduler(1);
+  scheduler.start();
+  scheduler.dispatch("device",
+      DispatchPriority::Normal,
+      []() { throw runtime_error("Execution failed"); });
+  scheduler.submit("device", DispatchPriority::Normal, []() {}).get();
+
+  EXPECT_EQ(scheduler.statistics().failed, 1);
+}
+
+TEST_F(DispatchSchedulerTests, discardsQueuedOperations) {
+  auto scheduler = make_unique<DispatchScheduler>(1);
+  auto result = scheduler->submit("device", DispatchPriority::Normal, []() {});
+  scheduler.reset();
+
+  EXPECT_THROW(result.get(), future_error);
+}
+
+TEST_F(DispatchSchedulerTests, rejectsRoutedCallsWhileStopped) {
+  DispatchScheduler scheduler(1);
+  auto read = scheduler.routeRead("device",
+      DispatchPriority::Normal,
+      []() { return DataVariant(true); });
+  auto write = scheduler.routeWrite(
+      "device", DispatchPriority::Normal, [](const DataVariant&) {});
+
+  EXPECT_THROW(read(), DispatchSchedulerStopped);
+  scheduler.start();
+  EXPECT_TRUE(get<bool>(read()));
+  scheduler.stop();
+  EXPECT_THROW(read(), DispatchSchedulerStopped);
+  EXPECT_THROW(write(DataVariant(true)), DispatchSchedulerStopped);
+  EXPECT_EQ(scheduler.queued(), 0);
+}
+
+TEST_F(DispatchSchedulerTests, rejectsInvalidArguments) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_THROW(DispatchScheduler(0), invalid_argument);
+  DispatchScheduler scheduler(1);
+  EXPECT_THROW(scheduler.setPolicy("device", DeviceDispatchPolicy{-1.0}),
+      invalid_argument);
+  EXPECT_THROW(scheduler.setPolicy("device", DeviceDispatchPolicy{1.0, 0.5}),
+      invalid_argument);
+  EXPECT_THROW(
+      scheduler.setPolicy("device", DeviceDispatchPolicy{1.0, 1.0, 0}),
+      invalid_argument);
+  EXPECT_THROW(scheduler.dispatch("device", DispatchPriority::Normal, nullptr),
+      invalid_argument);
+  EXPECT_THROW(
+      scheduler.routeRead("device", DispatchPriority::Normal, nullptr),
+      invalid_argument);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(LatencyHistogramTests, recordsLogarithmicBuckets) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentile(0.5), 0ns);
+  histogram.record(500ns);
+  histogram.record(3us);
+  histogram.record(3us);
+  histogram.record(100ms);
+
+  EXPECT_EQ(histogram.count(), 4);
+  EXPECT_EQ(histogram.buckets()[0], 1);
+  EXPECT_EQ(histogram.buckets()[2], 2);
+  EXPECT_EQ(histogram.percentile(0.25), 1us);
+  EXPECT_EQ(histogram.percentile(0.5), 4us);
+  EXPECT_EQ(histogram.percentile(1.0), 131072us);
+  EXPECT_EQ(histogram.max(), 100ms);
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
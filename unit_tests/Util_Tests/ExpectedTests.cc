@@ -0,0 +1,182 @@
+#include "ArenaDevice.hpp"
+#include "Expected.hpp"
+#include "TypedElement.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+struct FailingReadable : public Readable {
+  DataType dataType() const override { return DataType::Boolean; }
+
+  DataVariant read() const override { throw ReadCallbackUnavailable(); }
+};
+
+template <typename Exception>
+void expectMatches(const Error& error, const Exception& expected) {
+  EXPECT_EQ(error.message(), expected.what());
+  EXPECT_THROW(error.raise(), Exception);
+}
+
+TEST(ExpectedTests, formatsExceptionMessages) {
+  expectMatches(Error(ErrorCode::Element_Not_Found, "dev:1"),
+      ElementNotFound("dev:1"));
+  expectMatches(Error(ErrorCode::Data_Type_Mismatch,
+                    "dev:2",
+                    0,
+                    DataType::Boolean,
+                    DataType::Double),
+      DataTypeMismatch("dev:2", DataType::Boolean, DataType::Double));
+  expectMatches(Error(ErrorCode::Parameter_Type_Mismatch,
+                    {},
+                    3,
+                    DataType::Integer,
+                    DataType::String),
+      ParameterTypeMismatch(3, DataType::Integer, DataType::String));
+  expectMatches(
+      Error(ErrorCode::Mandatory_Parameter_Missing, {}, 1, DataType::Integer),
+      MandatoryParameterMissing(1, DataType::Integer));
+  expectMatches(Error(ErrorCode::Call_Timedout, "Call"), CallTimedout("Call"));
+  expectMatches(
+      Error(ErrorCode::Call_Canceled, "Call", 4), CallCanceled(4, "Call"));
+  expectMatches(Error(ErrorCode::Non_Readable), NonReadable());
+  EXPECT_EQ(toString(ErrorCode::Callback_Failed), "Callback_Failed");
+}
+
+TEST(ExpectedTests, convertsThrownExceptions) {
+  auto known = toError(make_exception_ptr(NonReadable()));
+  auto unknown = toError(make_exception_ptr(out_of_range("range")));
+
+  EXPECT_EQ(known.code(), ErrorCode::Non_Readable);
+  EXPECT_EQ(unknown.code(), ErrorCode::Callback_Failed);
+  EXPECT_EQ(unknown.message(), "range");
+  EXPECT_THROW(unknown.raise(), out_of_range);
+}
+
+TEST(ExpectedTests, holdsValueOrError) {
+  Expected<int> value = 5;
+  Expected<int> error = Error(ErrorCode::Element_Not_Found, "dev:0");
+  Expected<void> success;
+  Expected<void> failure = Error(ErrorCode::Non_Readable);
+
+  EXPECT_TRUE(value);
+  EXPECT_EQ(value.value(), 5);
+  EXPECT_EQ(*value, 5);
+  EXPECT_FALSE(error);
+  EXPECT_EQ(error.valueOr(7), 7);
+  EXPECT_EQ(error.error().subject(), "dev:0");
+  EXPECT_THROW(error.value(), ElementNotFound);
+  EXPECT_TRUE(success);
+  EXPECT_NO_THROW(success.value());
+  EXPECT_FALSE(failure);
+  EXPECT_THROW(failure.value(), NonReadable);
+}
+
+TEST(ExpectedTests, checksParametersWithoutThrowing) {
+  ParameterTypes supported{{1, ParameterType{DataType::Integer, true}},
+      {2, ParameterType{DataType::Integer, false, true}}};
+  Parameters parameters;
+
+  auto missing = tryCheckParameters(parameters, supported);
+  ASSERT_FALSE(missing);
+  EXPECT_EQ(missing.error().code(), ErrorCode::Mandatory_Parameter_Missing);
+  EXPECT_EQ(missing.error().position(), 1);
+
+  auto mismatch = tryAddSupportedParameter(
+      parameters, supported, 1, DataVariant(string("text")));
+  ASSERT_FALSE(mismatch);
+  EXPECT_EQ(mismatch.error().code(), ErrorCode::Parameter_Type_Mismatch);
+  EXPECT_EQ(mismatch.error().given(), DataType::String);
+  EXPECT_TRUE(parameters.empty());
+
+  auto unknown =
+      tryAddSupportedParameter(parameters, supported, 3, DataVariant(true));
+  ASSERT_FALSE(unknown);
+  EXPECT_EQ(unknown.error().code(), ErrorCode::Parameter_Does_Not_Exist);
+
+  EXPECT_TRUE(tryAddSupportedParameter(
+      parameters, supported, 1, DataVariant((intmax_t)1)));
+  EXPECT_TRUE(tryAddSupportedParameter(
+      parameters, supported, 2, DataVariant(Integer32{2})));
+  EXPECT_EQ(parameters.at(2), DataVariant((intmax_t)2));
+  EXPECT_TRUE(tryCheckParameters(parameters, supported));
+  EXPECT_THROW(
+      addSupportedParameter(parameters, supported, 3, nullopt),
+      ParameterDoesNotExist);
+}
+
+TEST(ExpectedTests, defaultImplementationsConvertExceptions) {
+  FailingReadable readable;
+
+  auto result = readable.tryRead();
+
+  ASSERT_FALSE(result);
+  EXPECT_EQ(result.error().code(), ErrorCode::Read_Callback_Unavailable);
+  EXPECT_THROW(result.error().raise(), ReadCallbackUnavailable);
+}
+
+TEST(ExpectedTests, arenaElementsReportErrors) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Device"});
+  auto writable_id = builder.addWritable(
+      BuildInfo{"Writable"}, DataType::Boolean, [](const DataVariant&) {});
+  auto failing_id = builder.addReadable(
+      BuildInfo{"Failing"}, DataType::Boolean, []() -> DataVariant {
+        throw ReadCallbackUnavailable();
+      });
+  auto pending = make_shared<promise<DataVariant>>();
+  auto callable_id = builder.addCallable(
+      BuildInfo{"Call"},
+      DataType::Integer,
+      [](const Parameters&) {},
+      [pending](const Parameters&) {
+        return ResultFuture(uintmax_t{1}, pending->get_future());
+      },
+      [](uintmax_t) {},
+      ParameterTypes{{1, ParameterType{DataType::Boolean, true}}});
+  auto device = builder.result();
+
+  auto missing = device->tryElement("dev:9");
+  ASSERT_FALSE(missing);
+  EXPECT_EQ(missing.error().code(), ErrorCode::Element_Not_Found);
+  EXPECT_EQ(missing.error().message(), ElementNotFound("dev:9").what());
+  auto self = device->tryElement("dev:");
+  ASSERT_FALSE(self);
+  EXPECT_EQ(self.error().code(), ErrorCode::ID_Points_This_Group);
+  auto found = device->tryElement(writable_id);
+  ASSERT_TRUE(found);
+  EXPECT_EQ(found.value()->id(), writable_id);
+
+  auto writable = get<WritablePtr>(found.value()->function());
+  EXPECT_EQ(writable->tryRead().error().code(), ErrorCode::Non_Readable);
+  auto mismatch = writable->tryWrite(DataVariant(1.0));
+  ASSERT_FALSE(mismatch);
+  EXPECT_EQ(mismatch.error().code(), ErrorCode::Data_Type_Mismatch);
+  EXPECT_EQ(mismatch.error().message(),
+      DataTypeMismatch(writable_id, DataType::Boolean, DataType::Double)
+          .what());
+  EXPECT_TRUE(writable->tryWrite(DataVariant(true)));
+
+  auto failing = get<ReadablePtr>(device->element(failing_id)->function());
+  EXPECT_EQ(failing->tryRead().error().code(),
+      ErrorCode::Read_Callback_Unavailable);
+
+  auto callable = get<CallablePtr>(device->element(callable_id)->function());
+  EXPECT_EQ(callable->tryCall().error().code(),
+      ErrorCode::Mandatory_Parameter_Missing);
+  auto timeout = callable->tryCall(Parameters{{1, DataVariant(true)}}, 1);
+  ASSERT_FALSE(timeout);
+  EXPECT_EQ(timeout.error().code(), ErrorCode::Call_Timedout);
+  EXPECT_EQ(timeout.error().subject(), "Call");
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
@@ -0,0 +1,152 @@
+#include "DeviceBuilderMock.hpp"
+#include "InplaceFunction.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+int twice(int value) { return value * 2; }
+
+TEST(InplaceFunctionTests, isEmptyByDefault) {
+  InplaceFunction<int(int)> empty;
+  InplaceFunction<int(int)> null = nullptr;
+  int (*null_pointer)(int) = nullptr;
+  InplaceFunction<int(int)> from_null_pointer = null_pointer;
+  InplaceFunction<int(int)> from_empty_function = function<int(int)>();
+
+  EXPECT_FALSE(empty);
+  EXPECT_FALSE(null);
+  EXPECT_FALSE(from_null_pointer);
+  EXPECT_FALSE(from_empty_function);
+  EXPECT_THROW(empty(1), bad_function_call);
+}
+
+TEST(InplaceFunctionTests, invokesTargets) {
+  InplaceFunction<int(int)> pointer = &twice;
+  int offset = 3;
+  InplaceFunction<int(int)> lambda = [offset](int value) {
+    return value + offset;
+  };
+  InplaceFunction<int(int)> wrapped = function<int(int)>(&twice);
+  InplaceFunction<void(int)> discarding = &twice;
+
+  EXPECT_EQ(pointer(2), 4);
+  EXPECT_EQ(lambda(2), 5);
+  EXPECT_EQ(wrapped(5), 10);
+  EXPECT_NO_THROW(discarding(1));
+  EXPECT_GE(INPLACE_FUNCTION_CAPACITY, sizeof(function<int(int)>));
+}
+
+TEST(InplaceFunctionTests, invokesMutableTargets) {
+  const InplaceFunction<int()> counter = [count = 0]() mutable {
+    return ++count;
+  };
+
+  EXPECT_EQ(counter(), 1);
+  EXPECT_EQ(counter(), 2);
+}
+
+TEST(InplaceFunctionTests, movesMoveOnlyTargets) {
+  auto value = make_unique<string>("moved");
+  InplaceFunction<string()> source = [value = move(value)]() {
+    return *value;
+  };
+  InplaceFunction<string()> target = move(source);
+  InplaceFunction<string()> assigned;
+  assigned = move(target);
+
+  // NOLINTBEGIN(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+  EXPECT_FALSE(source);
+  EXPECT_FALSE(target);
+  // NOLINTEND(bugprone-use-after-move,clang-analyzer-cplusplus.Move)
+  EXPECT_EQ(assigned(), "moved");
+}
+
+TEST(InplaceFunctionTests, destroysTargetsOnce) {
+  auto owner = make_shared<int>(1);
+  {
+    InplaceFunction<int()> first = [owner]() { return *owner; };
+    EXPECT_EQ(owner.use_count(), 2);
+    InplaceFunction<int()> second = move(first);
+    EXPECT_EQ(owner.use_count(), 2);
+    second = nullptr;
+    EXPECT_EQ(owner.use_count(), 1);
+    second = [owner]() { return *owner; };
+    EXPECT_EQ(owner.use_count(), 2);
+  }
+  EXPECT_EQ(owner.use_count(), 1);
+}
+
+TEST(InplaceFunctionTests, supportsCustomCapacity) {
+  array<uintmax_t, 8> ids{1, 2, 3, 4, 5, 6, 7, 8};
+  InplaceFunction<uintmax_t(size_t), sizeof(ids)> lookup =
+      [ids](size_t index) { return ids.at(index); };
+
+  EXPECT_EQ(lookup(7), 8);
+  EXPECT_EQ(decltype(lookup)::CAPACITY, sizeof(ids));
+}
+
+TEST(InplaceFunctionTests, builderSharesInlineCallbacks) {
+  DeviceBuilderMock builder;
+  DeviceBuilder::ReadCallback read_cb;
+  DeviceBuilder::WriteCallback write_cb;
+  DeviceBuilder::ReadCallback writable_read_cb;
+  EXPECT_CALL(builder, addReadable("fake:0", _, DataType::Integer, _))
+      .WillOnce(DoAll(SaveArg<3>(&read_cb), Return("fake:0.0")));
+  EXPECT_CALL(builder, addWritable(_, DataType::Boolean, _, _))
+      .WillOnce(DoAll(SaveArg<2>(&write_cb),
+          SaveArg<3>(&writable_read_cb),
+          Return("fake:1")));
+  EXPECT_CALL(builder, addCallable(_, _, ParameterTypes{}))
+      .WillOnce(Return("fake:2"));
+
+  auto value = make_unique<intmax_t>(-2);
+  auto readable_id = builder.addInlineReadable("fake:0",
+      BuildInfo{},
+      DataType::Integer,
+      [value = move(value)]() { return DataVariant(*value); });
+  bool written = false;
+  auto writable_id = builder.addInlineWritable(nullopt,
+      BuildInfo{},
+      DataType::Boolean,
+      [&written](const DataVariant& value) { written = get<bool>(value); });
+  auto callable_id = builder.addInlineCallable(
+      nullopt, BuildInfo{}, DataType::None, [](const Parameters&) {});
+
+  EXPECT_EQ(readable_id, "fake:0.0");
+  EXPECT_EQ(writable_id, "fake:1");
+  EXPECT_EQ(callable_id, "fake:2");
+  EXPECT_EQ(read_cb(), DataVariant((intmax_t)-2));
+  write_cb(DataVariant(true));
+  EXPECT_TRUE(written);
+  EXPECT_FALSE(writable_read_cb);
+}
+
+TEST(InplaceFunctionTests, builderWrapsNotifyCallback) {
+  DeviceBuilderMock builder;
+  DataVariant notified;
+  EXPECT_CALL(builder, addObservable(_, DataType::Double, _, _))
+      .WillOnce(Return(pair<string, DeviceBuilder::NotifyCallback>{"fake:3",
+          [&notified](const DataVariant& value) { notified = value; }}));
+
+  auto [id, notify] = builder.addInlineObservable(nullopt,
+      BuildInfo{},
+      DataType::Double,
+      []() { return DataVariant(0.0); },
+      [](bool) {});
+  notify(DataVariant(1.5));
+
+  EXPECT_EQ(id, "fake:3");
+  EXPECT_EQ(notified, DataVariant(1.5));
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
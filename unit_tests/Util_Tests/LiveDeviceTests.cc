@@ -0,0 +1,184 @@
+#include "ArenaDevice.hpp"
+#include "LiveDevice.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+DeviceBuilder::InlineReadCallback reads(intmax_t value) {
+  return [value]() { return DataVariant(value); };
+}
+
+intmax_t readValue(const ElementPtr& element) {
+  return get<intmax_t>(get<ReadablePtr>(element->function())->read());
+}
+
+unique_ptr<Device> buildDevice() {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Device", "Live"});
+  auto group_id = builder.addGroup(BuildInfo{"Slots"});
+  builder.addInlineReadable(
+      group_id, BuildInfo{"Slot 0"}, DataType::Integer, reads(0));
+  builder.addInlineReadable(
+      group_id, BuildInfo{"Slot 1"}, DataType::Integer, reads(1));
+  builder.addInlineReadable(
+      nullopt, BuildInfo{"Status"}, DataType::Integer, reads(2));
+  return builder.result();
+}
+
+unique_ptr<Device> buildModule(intmax_t value) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("module", BuildInfo{"Module"});
+  builder.addInlineReadable(
+      nullopt, BuildInfo{"Input"}, DataType::Integer, reads(value));
+  auto group_id = builder.addGroup(BuildInfo{"Channels"});
+  builder.addInlineReadable(
+      group_id, BuildInfo{"Channel"}, DataType::Integer, reads(value + 1));
+  return builder.result();
+}
+
+TEST(LiveDeviceTests, addsElementsAndKeepsIdentity) {
+  auto device = buildDevice();
+  LiveDevice live(*device);
+  EXPECT_EQ(live.id(), "dev");
+  EXPECT_EQ(live.name(), "Device");
+  EXPECT_EQ(live.description(), "Live");
+  EXPECT_EQ(live.size(), 2);
+  EXPECT_EQ(live.version(), 0);
+  auto slot = live.element("dev:0.1");
+  EXPECT_EQ(slot->name(), "Slot 1");
+  EXPECT_EQ(readValue(slot), 1);
+  auto slots = get<GroupPtr>(live.element("dev:0")->function());
+
+  auto change = live.add("dev:0", *buildModule(10));
+
+  EXPECT_EQ(change.version, 1);
+  EXPECT_EQ(live.version(), 1);
+  EXPECT_THAT(change.added, ElementsAre("dev:0.2", "dev:0.3", "dev:0.3.0"));
+  EXPECT_THAT(change.removed, IsEmpty());
+  EXPECT_EQ(live.element("dev:0.1").get(), slot.get());
+  EXPECT_EQ(slots->size(), 4);
+  EXPECT_EQ(readValue(live.element("dev:0.3.0")), 11);
+  EXPECT_EQ(readValue(slots->element("dev:0.2")), 10);
+  EXPECT_EQ(get<GroupPtr>(live.element("dev:0")->function()).get(),
+      slots.get());
+  EXPECT_EQ(slots->asMap().count("3"), 1);
+  EXPECT_EQ(live.element("dev:0.3")->name(), "Channels");
+
+  change = live.add(nullopt, *buildModule(20));
+  EXPECT_THAT(change.added, ElementsAre("dev:2", "dev:3", "dev:3.0"));
+  EXPECT_EQ(live.size(), 4);
+}
+
+TEST(LiveDeviceTests, removesElementsWithoutReusingPositions) {
+  LiveDevice live(*buildDevice());
+  auto kept = live.element("dev:0.1");
+  auto removed = live.element("dev:0.0");
+
+  auto change = live.remove("dev:0.0");
+
+  EXPECT_THAT(change.removed, ElementsAre("dev:0.0"));
+  EXPECT_THAT(change.added, IsEmpty());
+  EXPECT_THROW(live.element("dev:0.0"), ElementNotFound);
+  EXPECT_EQ(live.element("dev:0.1").get(), kept.get());
+  EXPECT_EQ(readValue(removed), 0);
+
+  change = live.add("dev:0", *buildModule(5));
+  EXPECT_THAT(change.added, ElementsAre("dev:0.2", "dev:0.3", "dev:0.3.0"));
+  auto nested = live.element("dev:0.3.0");
+  change = live.remove("dev:0");
+  EXPECT_THAT(change.removed,
+      ElementsAre("dev:0", "dev:0.1", "dev:0.2", "dev:0.3", "dev:0.3.0"));
+  EXPECT_EQ(change.version, 3);
+  EXPECT_EQ(readValue(nested), 6);
+  EXPECT_EQ(live.size(), 1);
+}
+
+TEST(LiveDeviceTests, rejectsInvalidUpdates) {
+  LiveDevice live(*buildDevice());
+  auto module = buildModule(0);
+
+  EXPECT_THROW(live.add("dev:1", *module), invalid_argument);
+  EXPECT_THROW(live.add("dev:7", *module), invalid_argument);
+  EXPECT_THROW(live.remove("dev:"), IDPointsThisGroup);
+  EXPECT_THROW(live.remove("dev:0.7"), ElementNotFound);
+  EXPECT_THROW(live.remove("dev:00"), ElementNotFound);
+  EXPECT_THROW(live.remove("other:0"), ElementNotFound);
+  live.remove("dev:0.0");
+  EXPECT_THROW(live.remove("dev:0.1"), GroupEmpty);
+  live.remove("dev:0");
+  EXPECT_THROW(live.remove("dev:1"), GroupEmpty);
+  EXPECT_EQ(live.version(), 2);
+  EXPECT_THROW(live.element("dev:"), IDPointsThisGroup);
+  EXPECT_FALSE(live.tryElement("dev:1.0"));
+}
+
+TEST(LiveDeviceTests, publishesChanges) {
+  LiveDevice live(*buildDevice());
+  vector<uint64_t> versions;
+  vector<string> added;
+  auto observer = live.subscribe([&](const StructureChange& change) {
+    versions.push_back(change.version);
+    added.insert(added.end(), change.added.begin(), change.added.end());
+  });
+  size_t failures = 0;
+  auto failing = live.subscribe(
+      [](const StructureChange&) { throw runtime_error("Consumer failed"); },
+      [&failures](const exception_ptr&) { ++failures; });
+  EXPECT_THROW(live.subscribe(nullptr), invalid_argument);
+
+  live.add(nullopt, *buildModule(0));
+  live.remove("dev:2");
+  observer.reset();
+  live.remove("dev:1");
+
+  EXPECT_THAT(versions, ElementsAre(1, 2));
+  EXPECT_THAT(added, ElementsAre("dev:2", "dev:3", "dev:3.0"));
+  EXPECT_EQ(failures, 3);
+}
+
+TEST(LiveDeviceTests, readsDuringUpdates) {
+  LiveDevice live(*buildDevice());
+  auto status = live.element("dev:1");
+  auto module = buildModule(0);
+  atomic<bool> done{false};
+  atomic<size_t> mismatches{0};
+  vector<thread> readers;
+  for (size_t i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!done.load()) {
+        if (live.element("dev:1").get() != status.get() ||
+            live.element("dev:0.1")->name() != "Slot 1") {
+          ++mismatches;
+        }
+        live.visit([](const ElementPtr& element) { element->id(); });
+      }
+    });
+  }
+  for (size_t update = 0; update < 200; ++update) {
+    auto change = live.add("dev:0", *module);
+    live.remove(change.added.front());
+    live.remove(change.added[1]);
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_EQ(live.version(), 600);
+  EXPECT_EQ(get<GroupPtr>(live.element("dev:0")->function())->size(), 2);
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
@@ -0,0 +1,181 @@
+#include "DeviceBuilderMock.hpp"
+#include "NotificationFilter.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+vector<bool> admitAll(
+    NotificationFilter& filter, const vector<DataVariant>& values) {
+  vector<bool> result;
+  auto now = SuppressionPolicy::Clock::now();
+  for (const auto& value : values) {
+    result.push_back(filter.admit(value, now));
+  }
+  return result;
+}
+
+TEST(NotificationFilterTests, dispatchesEverythingByDefault) {
+  NotificationFilter filter(SuppressionPolicy{});
+
+  EXPECT_THAT(
+      admitAll(filter, {1.0, 1.0, 1.0}), ElementsAre(true, true, true));
+  EXPECT_EQ(filter.counters().dispatched, 3);
+  EXPECT_EQ(filter.counters().suppressed(), 0);
+}
+
+TEST(NotificationFilterTests, suppressesUnchangedScalars) {
+  SuppressionPolicy policy;
+  policy.suppress_unchanged = true;
+  NotificationFilter filter(policy);
+
+  EXPECT_THAT(admitAll(filter,
+                  {DataVariant((intmax_t)1),
+                      DataVariant((intmax_t)1),
+                      DataVariant((intmax_t)2),
+                      DataVariant((intmax_t)1),
+                      DataVariant(-0.0),
+                      DataVariant(0.0)}),
+      ElementsAre(true, false, true, true, true, false));
+  EXPECT_EQ(filter.counters().unchanged, 2);
+}
+
+TEST(NotificationFilterTests, suppressesUnchangedOpaquePayloads) {
+  SuppressionPolicy policy;
+  policy.suppress_unchanged = true;
+  NotificationFilter filter(policy);
+  vector<uint8_t> payload(1 << 20, 0xAB);
+  auto changed = payload;
+  changed[payload.size() / 2] = 0;
+  auto longer = payload;
+  longer.push_back(0xAB);
+
+  EXPECT_THAT(admitAll(filter,
+                  {payload,
+                      payload,
+                      changed,
+                      changed,
+                      longer,
+                      string("text"),
+                      string("text")}),
+      ElementsAre(true, false, true, false, true, true, false));
+  EXPECT_EQ(filter.counters().unchanged, 3);
+}
+
+TEST(NotificationFilterTests, comparesEqualSizedPayloadsExactly) {
+  SuppressionPolicy policy;
+  policy.suppress_unchanged = true;
+  NotificationFilter filter(policy);
+  // NOLINTBEGIN(readability-magic-numbers)
+  DoubleArray samples{1.0, 2.0, 3.0};
+  auto last_changed = samples;
+  last_changed.back() = -3.0;
+
+  EXPECT_THAT(admitAll(filter,
+                  {samples, samples, last_changed, samples, DoubleArray{}}),
+      ElementsAre(true, false, true, true, true));
+  // NOLINTEND(readability-magic-numbers)
+  EXPECT_EQ(filter.counters().unchanged, 1);
+}
+
+TEST(NotificationFilterTests, suppressesWithinAbsoluteDeadband) {
+  SuppressionPolicy policy;
+  policy.absolute_deadband = 0.5;
+  NotificationFilter filter(policy);
+
+  EXPECT_THAT(admitAll(filter, {10.0, 10.4, 9.6, 10.6, 10.2}),
+      ElementsAre(true, false, false, true, false));
+  EXPECT_THAT(admitAll(filter,
+                  {numeric_limits<double>::quiet_NaN(),
+                      DataVariant((intmax_t)11),
+                      DataVariant((intmax_t)11)}),
+      ElementsAre(true, true, false));
+  EXPECT_EQ(filter.counters().deadband, 4);
+}
+
+TEST(NotificationFilterTests, suppressesWithinPercentDeadband) {
+  SuppressionPolicy policy;
+  policy.percent_deadband = 10;
+  NotificationFilter filter(policy);
+
+  EXPECT_THAT(admitAll(filter,
+                  {DataVariant(Float32{200.0F}),
+                      DataVariant(Float32{215.0F}),
+                      DataVariant(Float32{225.0F}),
+                      DataVariant(Float32{245.0F}),
+                      DataVariant(Float32{250.0F})}),
+      ElementsAre(true, false, true, false, true));
+  EXPECT_EQ(filter.counters().deadband, 2);
+}
+
+TEST(NotificationFilterTests, suppressesWithinMinimumInterval) {
+  SuppressionPolicy policy;
+  policy.min_interval = 100ms;
+  NotificationFilter filter(policy);
+  auto start = SuppressionPolicy::Clock::now();
+
+  EXPECT_TRUE(filter.admit(1.0, start));
+  EXPECT_FALSE(filter.admit(2.0, start + 50ms));
+  EXPECT_TRUE(filter.admit(3.0, start + 100ms));
+  EXPECT_FALSE(filter.admit(4.0, start + 199ms));
+  EXPECT_EQ(filter.counters().interval, 2);
+
+  filter.reset();
+  EXPECT_TRUE(filter.admit(5.0, start + 150ms));
+  EXPECT_EQ(filter.counters().dispatched, 1);
+}
+
+TEST(NotificationFilterTests, rejectsNegativePolicies) {
+  SuppressionPolicy deadband;
+  deadband.absolute_deadband = -1;
+  SuppressionPolicy interval;
+  interval.min_interval = -1ms;
+
+  EXPECT_THROW(NotificationFilter{deadband}, invalid_argument);
+  EXPECT_THROW(NotificationFilter{interval}, invalid_argument);
+}
+
+TEST(NotificationFilterTests, builderSuppressesNotifications) {
+  DeviceBuilderMock builder;
+  vector<DataVariant> notified;
+  EXPECT_CALL(builder, addObservable("fake:0", _, DataType::Integer, _, _))
+      .WillOnce(Return(pair<string, DeviceBuilder::NotifyCallback>{"fake:0.1",
+          [&notified](const DataVariant& value) {
+            notified.push_back(value);
+          }}));
+  SuppressionPolicy policy;
+  policy.suppress_unchanged = true;
+  auto filter = make_shared<NotificationFilter>(policy);
+
+  auto [id, notify] = builder.addObservable("fake:0",
+      BuildInfo{},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)0); },
+      [](bool) {},
+      filter);
+  notify(DataVariant((intmax_t)3));
+  notify(DataVariant((intmax_t)3));
+  notify(DataVariant((intmax_t)4));
+
+  EXPECT_EQ(id, "fake:0.1");
+  EXPECT_THAT(notified,
+      ElementsAre(DataVariant((intmax_t)3), DataVariant((intmax_t)4)));
+  EXPECT_EQ(filter->counters().unchanged, 1);
+  EXPECT_THROW(builder.addObservable(BuildInfo{},
+                   DataType::Integer,
+                   []() { return DataVariant((intmax_t)0); },
+                   [](bool) {},
+                   nullptr),
+      invalid_argument);
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
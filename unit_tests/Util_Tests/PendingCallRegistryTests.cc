@@ -0,0 +1,120 @@
+#include "PendingCallRegistry.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(PendingCallRegistryTests, resolvesPendingCalls) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  PendingCallRegistry registry("callable", 4);
+  auto completed = registry.emplace();
+  auto failed = registry.emplace();
+  auto canceled = registry.emplace();
+
+  EXPECT_EQ(registry.shards(), 4);
+  EXPECT_EQ(registry.size(), 3);
+  EXPECT_TRUE(registry.contains(completed.id()));
+  EXPECT_TRUE(registry.complete(completed.id(), DataVariant((intmax_t)42)));
+  EXPECT_TRUE(registry.fail(
+      failed.id(), make_exception_ptr(runtime_error("Execution failed"))));
+  EXPECT_TRUE(registry.cancel(canceled.id()));
+
+  EXPECT_EQ(get<intmax_t>(completed.get()), 42);
+  EXPECT_THROW(failed.get(), runtime_error);
+  EXPECT_THROW(canceled.get(), CallCanceled);
+  EXPECT_EQ(registry.size(), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(PendingCallRegistryTests, rejectsStaleIds) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  PendingCallRegistry registry("callable", 1);
+  auto first = registry.emplace();
+  auto first_id = first.id();
+  EXPECT_TRUE(registry.complete(first_id, DataVariant(true)));
+  EXPECT_FALSE(registry.complete(first_id, DataVariant(true)));
+
+  // reuses the slot of the first call with a new id
+  auto second = registry.emplace();
+  EXPECT_NE(second.id(), first_id);
+  EXPECT_FALSE(registry.contains(first_id));
+  EXPECT_FALSE(registry.cancel(first_id));
+  EXPECT_FALSE(registry.cancel(0));
+  EXPECT_FALSE(registry.cancel(12345));
+  EXPECT_TRUE(registry.contains(second.id()));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(PendingCallRegistryTests, allocatesUniqueIds) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  PendingCallRegistry registry("callable", 3);
+  vector<ResultFuture> results;
+  set<uintmax_t> ids;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(registry.emplace());
+    ids.insert(results.back().id());
+  }
+
+  EXPECT_EQ(registry.shards(), 4);
+  EXPECT_EQ(ids.size(), 100);
+  EXPECT_EQ(registry.size(), 100);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(PendingCallRegistryTests, cancelsPendingCallsOnDestruction) {
+  auto registry = make_unique<PendingCallRegistry>("callable");
+  auto result = registry->emplace();
+  registry.reset();
+
+  EXPECT_THROW(result.get(), CallCanceled);
+}
+
+TEST(PendingCallRegistryTests, rejectsInvalidShardCounts) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  EXPECT_THROW(PendingCallRegistry("callable", 0), invalid_argument);
+  EXPECT_THROW(PendingCallRegistry("callable", (size_t{1} << 16U) + 1),
+      invalid_argument);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(PendingCallRegistryTests, resolvesCallsConcurrently) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  PendingCallRegistry registry("callable", 8);
+  vector<thread> threads;
+  atomic<size_t> resolved{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&registry, &resolved]() {
+      for (int i = 0; i < 1000; ++i) {
+        auto result = registry.emplace();
+        if (i % 2 == 0) {
+          registry.complete(result.id(), DataVariant((intmax_t)i));
+          resolved += get<intmax_t>(result.get()) == i ? 1 : 0;
+        } else {
+          registry.cancel(result.id());
+          try {
+            result.get();
+          } catch (const CallCanceled&) {
+            ++resolved;
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(resolved, 4000);
+  EXPECT_EQ(registry.size(), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,235 @@
+#include "PollingScheduler.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct CountingReadable : public Readable {
+  explicit CountingReadable(bool fail = false) : fail_(fail) {}
+
+  DataType dataType() const final { return DataType::Integer; }
+
+  DataVariant read() const final {
+    auto count = ++reads;
+    if (fail_) {
+      throw runtime_error("Read failed");
+    }
+    return DataVariant((intmax_t)count);
+  }
+
+  mutable atomic<intmax_t> reads{0};
+
+private:
+  bool fail_;
+};
+
+struct PollingSchedulerTests : public ::testing::Test {
+  PollingSchedulerTests()
+      : scheduler(
+            [this](const PollBatch& batch) {
+              lock_guard lock(mx);
+              batches.push_back(batch);
+              received.notify_all();
+            },
+            2) {}
+
+  void pollAt(chrono::milliseconds time) {
+    scheduler.poll(scheduler.epoch() + time);
+  }
+
+  mutex mx;
+  condition_variable received;
+  vector<PollBatch> batches;
+  PollingScheduler scheduler;
+};
+
+TEST_F(PollingSchedulerTests, coalescesDueReadsPerDevice) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto first = make_shared<CountingReadable>();
+  auto second = make_shared<CountingReadable>();
+  auto other = make_shared<CountingReadable>();
+  auto first_id = scheduler.add("device", first, 10ms);
+  auto second_id = scheduler.add("device", second, 10ms);
+  scheduler.add("other", other, 20ms);
+
+  pollAt(9ms);
+  EXPECT_TRUE(batches.empty());
+  pollAt(10ms);
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].device_id, "device");
+  EXPECT_EQ(batches[0].deadline, scheduler.epoch() + 10ms);
+  EXPECT_THAT(batches[0].results,
+      ElementsAre(Field(&PollResult::id, first_id),
+          Field(&PollResult::id, second_id)));
+
+  pollAt(20ms);
+  ASSERT_EQ(batches.size(), 3);
+  EXPECT_EQ(batches[1].device_id, "device");
+  EXPECT_EQ(batches[2].device_id, "other");
+  EXPECT_EQ(batches[2].results[0].value, DataVariant((intmax_t)1));
+
+  auto statistics = scheduler.statistics();
+  EXPECT_EQ(statistics.batches, 3);
+  EXPECT_EQ(statistics.reads, 5);
+  EXPECT_EQ(statistics.coalesced, 4);
+  EXPECT_EQ(statistics.overruns, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, keepsDeadlinesPhaseLocked) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto readable = make_shared<CountingReadable>();
+  scheduler.add("device", readable, 10ms);
+
+  pollAt(35ms);
+  pollAt(40ms);
+
+  ASSERT_EQ(batches.size(), 2);
+  EXPECT_EQ(batches[0].deadline, scheduler.epoch() + 10ms);
+  EXPECT_EQ(batches[1].deadline, scheduler.epoch() + 40ms);
+  // 20ms and 30ms polls were missed
+  EXPECT_EQ(scheduler.statistics().overruns, 2);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, reportsReadFailures) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto id = scheduler.add("device", make_shared<CountingReadable>(true), 5ms);
+
+  pollAt(5ms);
+
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].results[0].id, id);
+  EXPECT_THROW(
+      rethrow_exception(batches[0].results[0].error), runtime_error);
+  EXPECT_EQ(scheduler.statistics().failures, 1);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, removesRegistrations) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto readable = make_shared<CountingReadable>();
+  auto id = scheduler.add("device", readable, 5ms);
+
+  EXPECT_EQ(scheduler.size(), 1);
+  EXPECT_TRUE(scheduler.remove(id));
+  EXPECT_FALSE(scheduler.remove(id));
+  pollAt(50ms);
+
+  EXPECT_TRUE(batches.empty());
+  EXPECT_EQ(scheduler.size(), 0);
+  auto reused = scheduler.add("device", readable, 5ms);
+  EXPECT_NE(reused, id);
+  EXPECT_FALSE(scheduler.remove(id));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, changesIntervals) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<PollResult> reads;
+  auto id = scheduler.add("device",
+      make_shared<CountingReadable>(),
+      5ms,
+      [&reads](const PollResult& result) { reads.push_back(result); });
+
+  pollAt(5ms);
+  EXPECT_TRUE(scheduler.setInterval(id, 20ms));
+  EXPECT_EQ(scheduler.interval(id), chrono::milliseconds(20));
+  pollAt(15ms);
+  pollAt(20ms);
+
+  ASSERT_EQ(batches.size(), 2);
+  EXPECT_EQ(batches[1].deadline, scheduler.epoch() + 20ms);
+  ASSERT_EQ(reads.size(), 2);
+  EXPECT_EQ(reads[1].id, id);
+  EXPECT_EQ(get<intmax_t>(reads[1].value), 2);
+  EXPECT_THROW(scheduler.setInterval(id, 100us), invalid_argument);
+  scheduler.remove(id);
+  EXPECT_FALSE(scheduler.setInterval(id, 20ms));
+  EXPECT_FALSE(scheduler.interval(id).has_value());
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, rejectsInvalidRegistrations) {
+  EXPECT_THROW(scheduler.add("device", nullptr, 1s), invalid_argument);
+  EXPECT_THROW(
+      scheduler.add("device", make_shared<CountingReadable>(), 100us),
+      invalid_argument);
+  EXPECT_THROW(PollingScheduler(nullptr), invalid_argument);
+}
+
+TEST_F(PollingSchedulerTests, pollsOnWorkerThreads) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto readable = make_shared<CountingReadable>();
+  scheduler.add("device", readable, 2ms);
+  scheduler.start();
+  {
+    unique_lock lock(mx);
+    EXPECT_TRUE(received.wait_for(
+        lock, 5s, [this]() { return batches.size() >= 3; }));
+  }
+  scheduler.stop();
+
+  EXPECT_GE(readable->reads, 3);
+  EXPECT_GE(scheduler.statistics().batches, 3);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST_F(PollingSchedulerTests, skipsPollsMissedBeforeStart) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  auto readable = make_shared<CountingReadable>();
+  scheduler.add("device", readable, 20ms);
+  this_thread::sleep_for(100ms);
+  scheduler.start();
+  {
+    unique_lock lock(mx);
+    EXPECT_TRUE(received.wait_for(
+        lock, 5s, [this]() { return batches.size() >= 2; }));
+  }
+  scheduler.stop();
+
+  EXPECT_EQ(scheduler.statistics().overruns, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(PollingSchedulerThreadTests, rejectsStopFromHandler) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  mutex mx;
+  condition_variable rejected;
+  bool stop_rejected = false;
+  PollingScheduler* running = nullptr;
+  PollingScheduler scheduler(
+      [&](const PollBatch&) {
+        lock_guard lock(mx);
+        try {
+          running->stop();
+        } catch (const StopFromSchedulerThread&) {
+          stop_rejected = true;
+          rejected.notify_all();
+        }
+      },
+      0);
+  running = &scheduler;
+  scheduler.add("device", make_shared<CountingReadable>(), 2ms);
+  scheduler.start();
+  {
+    unique_lock lock(mx);
+    EXPECT_TRUE(rejected.wait_for(
+        lock, 5s, [&stop_rejected]() { return stop_rejected; }));
+  }
+  scheduler.stop();
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,135 @@
+#include "ArenaDevice.hpp"
+#include "LiveDevice.hpp"
+#include "Selector.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+unique_ptr<Device> buildSelectable(const string& device_id) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo(device_id, BuildInfo{"Device"});
+  auto group_id = builder.addGroup(BuildInfo{"Sensors"});
+  builder.addInlineReadable(group_id,
+      BuildInfo{"Temperature"},
+      DataType::Double,
+      []() { return DataVariant(21.5); });
+  auto nested_id = builder.addGroup(group_id, BuildInfo{"Nested"});
+  builder.addInlineReadable(nested_id,
+      BuildInfo{"Pressure"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)1); });
+  builder.addInlineWritable(nullopt,
+      BuildInfo{"Setpoint"},
+      DataType::Integer,
+      [](const DataVariant&) {});
+  builder.addInlineReadable(nullopt,
+      BuildInfo{"Status"},
+      DataType::Boolean,
+      []() { return DataVariant(true); });
+  return builder.result();
+}
+
+vector<string> idsOf(const vector<ElementPtr>& elements) {
+  vector<string> ids;
+  for (const auto& element : elements) {
+    ids.push_back(element->id());
+  }
+  return ids;
+}
+
+TEST(SelectorTests, rejectsInvalidPatterns) {
+  EXPECT_NO_THROW(Selector("*:power.phase_*.voltage"));
+  EXPECT_NO_THROW(Selector("dev42:**"));
+
+  for (const auto& pattern : {"dev",
+           "dev:",
+           ":0",
+           "dev:0..1",
+           "dev:0.",
+           "dev:0.**1",
+           "dev:***",
+           "**:0",
+           "dev:0:1"}) {
+    EXPECT_THROW(Selector{pattern}, InvalidSelector) << pattern;
+  }
+  string path = "0";
+  for (size_t i = 1; i < Selector::MAX_LEVELS; ++i) {
+    path += ".*";
+  }
+  EXPECT_NO_THROW(Selector("dev:" + path));
+  EXPECT_THROW(Selector("dev:" + path + ".*"), InvalidSelector);
+}
+
+TEST(SelectorTests, matchesReferenceIds) {
+  Selector phases("*:power.phase_*.voltage");
+  EXPECT_TRUE(phases.matches("dev42:power.phase_1.voltage"));
+  EXPECT_TRUE(phases.matches("meter:power.phase_.voltage"));
+  EXPECT_FALSE(phases.matches("dev42:power.phase_1.current"));
+  EXPECT_FALSE(phases.matches("dev42:power.phase_1"));
+  EXPECT_FALSE(phases.matches("dev42:power.voltage"));
+  EXPECT_FALSE(phases.matches("dev42:power.phase_1.voltage.raw"));
+
+  Selector device("dev42:**");
+  EXPECT_TRUE(device.matches("dev42:power"));
+  EXPECT_TRUE(device.matches("dev42:power.phase_1.voltage"));
+  EXPECT_FALSE(device.matches("dev42:"));
+  EXPECT_FALSE(device.matches("dev4:power"));
+  EXPECT_FALSE(device.matches("dev42"));
+
+  Selector nested("*:power.**.voltage");
+  EXPECT_TRUE(nested.matches("dev:power.voltage"));
+  EXPECT_TRUE(nested.matches("dev:power.phase_1.raw.voltage"));
+  EXPECT_FALSE(nested.matches("dev:power.phase_1"));
+  EXPECT_FALSE(nested.matches("dev:meter.power.voltage"));
+
+  Selector globs("d*v:*_*_*");
+  EXPECT_TRUE(globs.matches("dv:__"));
+  EXPECT_TRUE(globs.matches("dev:a_b_c_d"));
+  EXPECT_FALSE(globs.matches("dev:a_b"));
+  EXPECT_FALSE(globs.matches("devs:a_b_c"));
+}
+
+TEST(SelectorTests, selectsElementsOfDevice) {
+  auto device = buildSelectable("dev");
+
+  EXPECT_THAT(idsOf(Selector("dev:**").select(*device)),
+      UnorderedElementsAre(
+          "dev:0", "dev:0.0", "dev:0.1", "dev:0.1.0", "dev:1", "dev:2"));
+  EXPECT_THAT(idsOf(Selector("*:*").select(*device)),
+      UnorderedElementsAre("dev:0", "dev:1", "dev:2"));
+  EXPECT_THAT(idsOf(Selector("dev:0.*").select(*device)),
+      UnorderedElementsAre("dev:0.0", "dev:0.1"));
+  EXPECT_THAT(idsOf(Selector("dev:**.0").select(*device)),
+      UnorderedElementsAre("dev:0", "dev:0.0", "dev:0.1.0"));
+  EXPECT_THAT(idsOf(Selector("dev:0.**.0").select(*device)),
+      UnorderedElementsAre("dev:0.0", "dev:0.1.0"));
+  EXPECT_THAT(idsOf(Selector("dev:0.1.0").select(*device)),
+      ElementsAre("dev:0.1.0"));
+  // literal levels below non group elements or out of range select nothing
+  EXPECT_THAT(Selector("dev:1.0").select(*device), IsEmpty());
+  EXPECT_THAT(Selector("dev:0.5").select(*device), IsEmpty());
+  EXPECT_THAT(Selector("other:**").select(*device), IsEmpty());
+}
+
+TEST(SelectorTests, selectsAcrossDevices) {
+  vector<DevicePtr> devices{buildSelectable("dev"),
+      buildSelectable("pump"),
+      make_shared<LiveDevice>(*buildSelectable("drive"))};
+
+  EXPECT_THAT(idsOf(Selector("*:0.1.*").select(devices)),
+      ElementsAre("dev:0.1.0", "pump:0.1.0", "drive:0.1.0"));
+  EXPECT_THAT(idsOf(Selector("d*:2").select(devices)),
+      ElementsAre("dev:2", "drive:2"));
+  EXPECT_THAT(idsOf(Selector("pump:**").select(devices)), SizeIs(6));
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
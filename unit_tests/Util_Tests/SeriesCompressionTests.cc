@@ -0,0 +1,148 @@
+#include "SeriesCompression.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+template <typename Series, typename Value>
+void expectRoundTrip(const vector<Value>& values, size_t block_size) {
+  Series tested(block_size);
+  for (auto value : values) {
+    tested.append(value);
+  }
+  ASSERT_EQ(tested.size(), values.size());
+  auto decoded = tested.decodeAll();
+  ASSERT_EQ(decoded.size(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    if constexpr (is_floating_point_v<Value>) {
+      if (isnan(values[i])) {
+        EXPECT_TRUE(isnan(decoded[i])) << i;
+        continue;
+      }
+      EXPECT_EQ(signbit(decoded[i]), signbit(values[i])) << i;
+    }
+    EXPECT_EQ(decoded[i], values[i]) << i;
+  }
+}
+
+TEST(SeriesCompressionTests, roundTripsDoubles) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<double> values{20.5,
+      20.5,
+      20.51,
+      -0.0,
+      0.0,
+      numeric_limits<double>::quiet_NaN(),
+      numeric_limits<double>::infinity(),
+      -numeric_limits<double>::infinity(),
+      numeric_limits<double>::denorm_min(),
+      numeric_limits<double>::max(),
+      1e-300,
+      12.25};
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(20.0 + sin(i * 0.01) + (i % 7) * 0.01);
+  }
+  for (size_t block_size : {1U, 3U, 64U, 10000U}) {
+    expectRoundTrip<CompressedDoubles>(values, block_size);
+  }
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(SeriesCompressionTests, roundTripsTimestamps) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<int64_t> values{1757614163000521,
+      1757614164000521,
+      1757614165000521,
+      1757614165000522,
+      1757614166000000,
+      1757614166000000,
+      0,
+      numeric_limits<int64_t>::max(),
+      numeric_limits<int64_t>::min(),
+      -1};
+  int64_t time = 1757614163000000;
+  for (int i = 0; i < 1000; ++i) {
+    time += 1000000 + (i % 10 == 0 ? i * 37 : 0) - (i % 25 == 0 ? 4096 : 0);
+    values.push_back(time);
+  }
+  for (size_t block_size : {1U, 7U, 128U}) {
+    expectRoundTrip<CompressedTimestamps>(values, block_size);
+  }
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(SeriesCompressionTests, roundTripsIntegers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  vector<intmax_t> values{0,
+      1,
+      -1,
+      127,
+      -128,
+      300,
+      numeric_limits<intmax_t>::max(),
+      numeric_limits<intmax_t>::min(),
+      0};
+  for (intmax_t i = 0; i < 1000; ++i) {
+    values.push_back(i * i - 500);
+  }
+  for (size_t block_size : {1U, 5U, 256U}) {
+    expectRoundTrip<CompressedIntegers>(values, block_size);
+  }
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(SeriesCompressionTests, compressesRegularSeries) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  CompressedTimestamps timestamps;
+  CompressedDoubles constant;
+  CompressedIntegers counter;
+  for (int64_t i = 0; i < 10000; ++i) {
+    timestamps.append(1757614163000000 + i * 1000000);
+    constant.append(21.5);
+    counter.append(i);
+  }
+  // about 1 bit per periodic timestamp and repeated value, 1 byte per counter
+  EXPECT_LT(timestamps.compressedSize(), 10000 / 8 + 512);
+  EXPECT_LT(constant.compressedSize(), 10000 / 8 + 512);
+  EXPECT_LT(counter.compressedSize(), 10000 + 512);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(SeriesCompressionTests, decodesRandomAccessRanges) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  CompressedIntegers tested(16);
+  for (intmax_t i = 0; i < 100; ++i) {
+    tested.append(i * 3);
+  }
+  EXPECT_EQ(tested.blockCount(), 7);
+  EXPECT_EQ(tested.at(0), 0);
+  EXPECT_EQ(tested.at(47), 141);
+  EXPECT_EQ(tested.at(99), 297);
+  EXPECT_THROW(tested.at(100), out_of_range);
+
+  vector<intmax_t> range(10);
+  EXPECT_EQ(tested.decode(30, 10, range.data()), 10);
+  EXPECT_THAT(range, ElementsAre(90, 93, 96, 99, 102, 105, 108, 111, 114, 117));
+  EXPECT_EQ(tested.decode(95, 10, range.data()), 5);
+  EXPECT_EQ(range[4], 297);
+  EXPECT_EQ(tested.decode(100, 10, range.data()), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(SeriesCompressionTests, canBeCleared) {
+  CompressedDoubles tested;
+  tested.append(1.0);
+  tested.clear();
+  EXPECT_TRUE(tested.empty());
+  tested.append(2.0);
+  EXPECT_EQ(tested.at(0), 2.0);
+  EXPECT_THROW(CompressedDoubles(0), invalid_argument);
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,249 @@
+#include "StreamOperators.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct FakeObservable : public Observable {
+  DataType dataType() const final { return DataType::Double; }
+
+  DataVariant read() const final { return 0.0; }
+
+  ObserverPtr subscribe(
+      const ObserveCallback& observe_cb, const ExceptionHandler&) final {
+    ++subscriptions;
+    callback = observe_cb;
+    return make_shared<Observer>();
+  }
+
+  void notify(const DataVariant& value) {
+    callback(make_shared<DataVariant>(value));
+  }
+
+  size_t subscriptions = 0;
+  ObserveCallback callback;
+};
+
+struct StreamOperatorsTests : public ::testing::Test {
+  void push(const vector<double>& values) {
+    for (auto value : values) {
+      pipeline.push(StreamSample{time, value});
+      time += 1'000'000; // NOLINT(readability-magic-numbers)
+    }
+  }
+
+  ObserverPtr collect(const Stream& stream, vector<double>& values) {
+    return stream.subscribe(
+        [&values](const StreamSample& sample) {
+          values.push_back(sample.value);
+        });
+  }
+
+  StreamPipeline pipeline;
+  int64_t time = 0;
+};
+
+TEST_F(StreamOperatorsTests, mapsAndFilters) {
+  vector<double> received;
+  auto observer = collect(pipeline.source()
+                              .map([](double value) { return value * 2; })
+                              .filter([](const StreamSample& sample) {
+                                return sample.value > 4;
+                              }),
+      received);
+
+  push({1, 2, 3, 4});
+
+  EXPECT_THAT(received, ElementsAre(6, 8));
+  EXPECT_EQ(pipeline.sampleCount(), 4);
+}
+
+TEST_F(StreamOperatorsTests, appliesDeadband) {
+  vector<double> received;
+  auto observer = collect(pipeline.source().deadband(1.0), received);
+
+  push({10, 10.5, 11, 11.2, 9.9, 8.9});
+
+  EXPECT_THAT(received, ElementsAre(10, 11.2, 9.9));
+  EXPECT_THROW(auto _ = pipeline.source().deadband(-1), invalid_argument);
+}
+
+TEST_F(StreamOperatorsTests, limitsRateOfChange) {
+  vector<double> received;
+  auto observer = collect(pipeline.source().rateLimit(2.0), received);
+
+  push({0, 10, 10, 1});
+
+  EXPECT_THAT(received, ElementsAre(0, 2, 4, 2));
+}
+
+TEST_F(StreamOperatorsTests, aggregatesTumblingWindows) {
+  vector<double> sums;
+  vector<double> maximums;
+  auto sum_observer = collect(
+      pipeline.source().tumblingWindow(3, WindowAggregate::Sum), sums);
+  auto max_observer = collect(
+      pipeline.source().tumblingWindow(2, WindowAggregate::Max), maximums);
+
+  push({1, 5, 3, 2, 4, 6, 7});
+
+  EXPECT_THAT(sums, ElementsAre(9, 12));
+  EXPECT_THAT(maximums, ElementsAre(5, 3, 6));
+  EXPECT_THROW(auto _ = pipeline.source().tumblingWindow(0,
+                   WindowAggregate::Sum),
+      invalid_argument);
+}
+
+TEST_F(StreamOperatorsTests, aggregatesSlidingWindows) {
+  vector<double> means;
+  vector<double> minimums;
+  vector<double> counts;
+  auto mean_observer = collect(
+      pipeline.source().slidingWindow(3, WindowAggregate::Mean), means);
+  auto min_observer = collect(
+      pipeline.source().slidingWindow(2, WindowAggregate::Min), minimums);
+  auto count_observer = collect(
+      pipeline.source().slidingWindow(2, WindowAggregate::Count), counts);
+
+  push({3, 6, 9, 0, 12});
+
+  EXPECT_THAT(means, ElementsAre(3, 4.5, 6, 5, 7));
+  EXPECT_THAT(minimums, ElementsAre(3, 3, 6, 0, 0));
+  EXPECT_THAT(counts, ElementsAre(1, 2, 2, 2, 2));
+}
+
+TEST_F(StreamOperatorsTests, aggregatesTimeWindows) {
+  vector<double> maximums;
+  vector<double> lasts;
+  auto max_observer = collect(
+      pipeline.source().timeWindow(2s, WindowAggregate::Max), maximums);
+  auto last_observer = collect(
+      pipeline.source().timeWindow(2s, WindowAggregate::Last), lasts);
+
+  push({5, 1, 2, 4, 3});
+
+  EXPECT_THAT(maximums, ElementsAre(5, 5, 2, 4, 4));
+  EXPECT_THAT(lasts, ElementsAre(5, 1, 2, 4, 3));
+  EXPECT_THROW(
+      auto _ = pipeline.source().timeWindow(0s, WindowAggregate::Max),
+      invalid_argument);
+}
+
+TEST_F(StreamOperatorsTests, sharesDerivedStreams) {
+  size_t mapped = 0;
+  auto shared = pipeline.source().map([&mapped](double value) {
+    ++mapped;
+    return value + 1;
+  });
+  vector<double> first;
+  vector<double> second;
+  auto first_observer = collect(shared, first);
+  auto second_observer =
+      collect(shared.tumblingWindow(2, WindowAggregate::Mean), second);
+
+  push({1, 2, 3});
+
+  EXPECT_EQ(mapped, 3);
+  EXPECT_THAT(first, ElementsAre(2, 3, 4));
+  EXPECT_THAT(second, ElementsAre(2.5));
+}
+
+TEST_F(StreamOperatorsTests, detachesDestroyedSubscriptions) {
+  vector<double> received;
+  auto observer = collect(pipeline.source(), received);
+
+  push({1});
+  observer.reset();
+  push({2});
+
+  EXPECT_THAT(received, ElementsAre(1));
+}
+
+TEST_F(StreamOperatorsTests, unsubscribesFromWithinCallback) {
+  vector<double> received;
+  ObserverPtr observer;
+  observer = pipeline.source().subscribe(
+      [&observer, received = make_shared<vector<double>>(), &all = received](
+          const StreamSample& sample) {
+        observer.reset();
+        // captured state must outlive the released subscription
+        received->push_back(sample.value);
+        all = *received;
+      });
+
+  push({1, 2});
+
+  EXPECT_EQ(observer, nullptr);
+  EXPECT_THAT(received, ElementsAre(1));
+}
+
+TEST_F(StreamOperatorsTests, prunesUnsubscribedOperators) {
+  size_t mapped = 0;
+  auto map = [&mapped](double value) {
+    ++mapped;
+    return value;
+  };
+  vector<double> received;
+  for (size_t i = 0; i < 3; ++i) {
+    auto observer = collect(pipeline.source().map(map).tumblingWindow(
+                                1, WindowAggregate::Last),
+        received);
+    push({1});
+  }
+  push({2});
+
+  EXPECT_EQ(mapped, 3);
+  EXPECT_THAT(received, ElementsAre(1, 1, 1));
+}
+
+TEST_F(StreamOperatorsTests, keepsOperatorsOfLiveStreams) {
+  size_t mapped = 0;
+  auto shared = pipeline.source().map([&mapped](double value) {
+    ++mapped;
+    return value;
+  });
+  vector<double> received;
+  auto observer = collect(shared, received);
+
+  push({1});
+  observer.reset();
+  push({2});
+  observer = collect(shared, received);
+  push({3});
+  observer.reset();
+  shared = pipeline.source();
+  push({4});
+
+  EXPECT_EQ(mapped, 3);
+  EXPECT_THAT(received, ElementsAre(1, 3));
+}
+
+TEST_F(StreamOperatorsTests, subscribesOnceToObservable) {
+  auto observable = make_shared<FakeObservable>();
+  auto upstream = pipeline.attach(observable, [](const exception_ptr&) {});
+  vector<double> raw;
+  vector<double> filtered;
+  auto raw_observer = collect(pipeline.source(), raw);
+  auto filtered_observer = collect(pipeline.source().deadband(5), filtered);
+
+  observable->notify(1.5);
+  observable->notify(DataVariant((intmax_t)10));
+  observable->notify(DataVariant(UnsignedInteger16{12}));
+
+  EXPECT_EQ(observable->subscriptions, 1);
+  EXPECT_THAT(raw, ElementsAre(1.5, 10, 12));
+  EXPECT_THAT(filtered, ElementsAre(1.5, 10));
+}
+
+TEST_F(StreamOperatorsTests, rejectsNonNumericValues) {
+  EXPECT_THROW(pipeline.push(DataVariant(true)), ConversionNotSupported);
+  EXPECT_THROW(pipeline.push(DataVariant(string("1"))), ConversionNotSupported);
+  EXPECT_EQ(pipeline.sampleCount(), 0);
+}
+} // namespace Information_Model::testing
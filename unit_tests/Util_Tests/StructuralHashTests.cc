@@ -0,0 +1,239 @@
+#include "ArenaDevice.hpp"
+#include "DeviceSnapshot.hpp"
+#include "LiveDevice.hpp"
+#include "StructuralHash.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+// NOLINTBEGIN(readability-magic-numbers)
+struct ModelOptions {
+  string status_name = "Status";
+  bool readable_setpoint = true;
+  DataType parameter_type = DataType::Integer;
+  bool with_alarm = false;
+};
+
+unique_ptr<Device> buildModel(const ModelOptions& options = {}) {
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Device", "Hashed"});
+  auto group_id = builder.addGroup(BuildInfo{"Sensors"});
+  builder.addInlineReadable(group_id,
+      BuildInfo{"Temperature"},
+      DataType::Double,
+      []() { return DataVariant(21.5); });
+  auto nested_id = builder.addGroup(group_id, BuildInfo{"Nested"});
+  builder.addInlineObservable(
+      nested_id,
+      BuildInfo{"Pressure"},
+      DataType::Integer,
+      []() { return DataVariant((intmax_t)1); },
+      [](bool) {});
+  builder.addInlineWritable(
+      nullopt,
+      BuildInfo{"Setpoint"},
+      DataType::Integer,
+      [](const DataVariant&) {},
+      options.readable_setpoint
+          ? DeviceBuilder::InlineReadCallback(
+                []() { return DataVariant((intmax_t)0); })
+          : nullptr);
+  builder.addInlineCallable(nullopt,
+      BuildInfo{"Reset"},
+      DataType::None,
+      [](const Parameters&) {},
+      nullptr,
+      nullptr,
+      ParameterTypes{{1, ParameterType{options.parameter_type, true}},
+          {2, ParameterType{DataType::Boolean}}});
+  builder.addInlineReadable(nullopt,
+      BuildInfo{options.status_name},
+      DataType::Boolean,
+      []() { return DataVariant(true); });
+  if (options.with_alarm) {
+    builder.addInlineReadable(group_id,
+        BuildInfo{"Alarm"},
+        DataType::Boolean,
+        []() { return DataVariant(false); });
+  }
+  return builder.result();
+}
+
+/**
+ * @brief Forwards everything but structuralHash(), so the default
+ * implementations are used
+ */
+struct ForwardingElement final : public Element {
+  explicit ForwardingElement(ElementPtr element) : element_(move(element)) {}
+
+  string id() const final { return element_->id(); }
+
+  string name() const final { return element_->name(); }
+
+  string description() const final { return element_->description(); }
+
+  ElementType type() const final { return element_->type(); }
+
+  ElementFunction function() const final { return element_->function(); }
+
+private:
+  ElementPtr element_;
+};
+
+struct ForwardingDevice final : public Device {
+  explicit ForwardingDevice(const Device& device) : device_(device) {}
+
+  string id() const final { return device_.id(); }
+
+  string name() const final { return device_.name(); }
+
+  string description() const final { return device_.description(); }
+
+  GroupPtr group() const final { return device_.group(); }
+
+  size_t size() const final { return device_.size(); }
+
+  ElementPtr element(const string& ref_id) const final {
+    return device_.element(ref_id);
+  }
+
+  Expected<ElementPtr> tryElement(const string& ref_id) const final {
+    return device_.tryElement(ref_id);
+  }
+
+  void visit(const Group::Visitor& visitor) const final {
+    device_.visit(visitor);
+  }
+
+private:
+  const Device& device_;
+};
+
+CallbackResolver resolveAll() {
+  return [](const SnapshotElement&, DeviceBuilder::InlineNotifyCallback&&) {
+    ElementCallbacks callbacks;
+    callbacks.read = []() { return DataVariant(true); };
+    callbacks.write = [](const DataVariant&) {};
+    callbacks.observe = [](bool) {};
+    callbacks.execute = [](const Parameters&) {};
+    return callbacks;
+  };
+}
+
+TEST(StructuralHashTests, equalStructuresHashEqually) {
+  auto device = buildModel();
+  auto same = buildModel();
+  EXPECT_EQ(device->structuralHash(), same->structuralHash());
+  EXPECT_EQ(device->element("dev:0")->structuralHash(),
+      same->element("dev:0")->structuralHash());
+
+  EXPECT_NE(device->structuralHash(),
+      buildModel(ModelOptions{"State"})->structuralHash());
+  EXPECT_NE(device->structuralHash(),
+      buildModel(ModelOptions{"Status", false})->structuralHash());
+  EXPECT_NE(device->structuralHash(),
+      buildModel(ModelOptions{"Status", true, DataType::Double})
+          ->structuralHash());
+  // a change deep inside a group changes the hashes of all its groups
+  auto alarm =
+      buildModel(ModelOptions{"Status", true, DataType::Integer, true});
+  EXPECT_NE(device->element("dev:0")->structuralHash(),
+      alarm->element("dev:0")->structuralHash());
+  EXPECT_EQ(device->element("dev:0.1")->structuralHash(),
+      alarm->element("dev:0.1")->structuralHash());
+}
+
+TEST(StructuralHashTests, implementationsAgree) {
+  auto device = buildModel();
+  auto hash = device->structuralHash();
+
+  EXPECT_EQ(ForwardingDevice(*device).structuralHash(), hash);
+  for (const auto& id : {"dev:0", "dev:0.1.0", "dev:1", "dev:2"}) {
+    auto element = device->element(id);
+    EXPECT_EQ(ForwardingElement(element).structuralHash(),
+        element->structuralHash())
+        << id;
+  }
+
+  DeviceSnapshot snapshot(writeSnapshot(*device));
+  auto rehydrated = snapshot.rehydrate(resolveAll());
+  EXPECT_EQ(rehydrated->structuralHash(), hash);
+  EXPECT_EQ(rehydrated->element("dev:0.1")->structuralHash(),
+      device->element("dev:0.1")->structuralHash());
+
+  LiveDevice live(*device);
+  EXPECT_EQ(live.structuralHash(), hash);
+  EXPECT_EQ(live.element("dev:0")->structuralHash(),
+      device->element("dev:0")->structuralHash());
+}
+
+TEST(StructuralHashTests, liveDeviceTracksChanges) {
+  auto device = buildModel();
+  LiveDevice live(*device);
+  auto hash = live.structuralHash();
+  auto group_hash = live.element("dev:0")->structuralHash();
+
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("module", BuildInfo{"Module"});
+  builder.addInlineReadable(nullopt,
+      BuildInfo{"Humidity"},
+      DataType::Double,
+      []() { return DataVariant(0.5); });
+  auto change = live.add("dev:0.1", *builder.result());
+  EXPECT_THAT(change.added, ElementsAre("dev:0.1.1"));
+  EXPECT_NE(live.structuralHash(), hash);
+  EXPECT_NE(live.element("dev:0")->structuralHash(), group_hash);
+  EXPECT_EQ(live.structuralHash(), ForwardingDevice(live).structuralHash());
+
+  live.remove("dev:0.1.1");
+  EXPECT_EQ(live.structuralHash(), hash);
+  EXPECT_EQ(live.element("dev:0")->structuralHash(), group_hash);
+}
+
+TEST(StructuralHashTests, diffsStructures) {
+  auto device = buildModel();
+  EXPECT_TRUE(diffStructure(*device, *buildModel()).empty());
+
+  auto changed = buildModel(ModelOptions{"State", false});
+  auto diff = diffStructure(*device, *changed);
+  EXPECT_THAT(diff.changed, ElementsAre("dev:1", "dev:3"));
+  EXPECT_THAT(diff.added, IsEmpty());
+  EXPECT_THAT(diff.removed, IsEmpty());
+
+  auto alarm =
+      buildModel(ModelOptions{"Status", true, DataType::Integer, true});
+  diff = diffStructure(*device, *alarm);
+  EXPECT_THAT(diff.added, ElementsAre("dev:0.2"));
+  EXPECT_THAT(diff.changed, IsEmpty());
+  diff = diffStructure(*alarm, *device);
+  EXPECT_THAT(diff.removed, ElementsAre("dev:0.2"));
+  EXPECT_THAT(diff.added, IsEmpty());
+
+  LiveDevice live(*device);
+  live.remove("dev:0.1");
+  live.add(nullopt, *buildModel());
+  diff = diffStructure(*device, live);
+  EXPECT_THAT(diff.removed, ElementsAre("dev:0.1"));
+  EXPECT_THAT(diff.added, ElementsAre("dev:4", "dev:5", "dev:6", "dev:7"));
+  EXPECT_THAT(diff.changed, IsEmpty());
+
+  ArenaDeviceBuilder builder;
+  builder.setDeviceInfo("dev", BuildInfo{"Renamed", "Hashed"});
+  builder.addInlineReadable(nullopt,
+      BuildInfo{"Temperature"},
+      DataType::Double,
+      []() { return DataVariant(21.5); });
+  auto renamed = builder.result();
+  diff = diffStructure(*device, *renamed);
+  EXPECT_THAT(diff.changed, ElementsAre("dev:", "dev:0"));
+  EXPECT_THAT(diff.removed, ElementsAre("dev:1", "dev:2", "dev:3"));
+}
+// NOLINTEND(readability-magic-numbers)
+} // namespace Information_Model::testing
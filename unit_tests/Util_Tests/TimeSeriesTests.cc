@@ -0,0 +1,172 @@
+#include "TimeSeries.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+TEST(TimeSeriesTests, convertsEpochMicroseconds) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  Timestamp time{2025, 9, 11, 18, 9, 23, 521};
+  auto microseconds = toEpochMicroseconds(time);
+
+  EXPECT_EQ(microseconds, 1757614163000521);
+  EXPECT_EQ(fromEpochMicroseconds(microseconds), time);
+  EXPECT_EQ(toEpochMicroseconds(Timestamp{1970, 1, 1, 0, 0, 0, 0}), 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimeSeriesTests, appendsAndEvictsOldestSamples) {
+  TimeSeries tested(DataType::Double, 3);
+  for (int64_t i = 0; i < 5; ++i) {
+    tested.append(i, DataVariant(static_cast<double>(i) * 1.5));
+  }
+
+  EXPECT_EQ(tested.size(), 3);
+  EXPECT_EQ(tested.timeAt(0), 2);
+  EXPECT_EQ(tested.valueAt(0), DataVariant(3.0));
+  EXPECT_EQ(tested.valueAt(2), DataVariant(6.0));
+  EXPECT_THROW(tested.valueAt(3), out_of_range);
+}
+
+TEST(TimeSeriesTests, widensNarrowValues) {
+  TimeSeries tested(DataType::Integer, 2);
+  tested.append(0, DataVariant(Integer16{-3}));
+
+  EXPECT_EQ(tested.valueAt(0), DataVariant((intmax_t)-3));
+  EXPECT_THROW(tested.append(1, DataVariant(1.5)), ConversionNotSupported);
+  EXPECT_THROW(tested.append<double>(1, 1.5), ConversionNotSupported);
+  EXPECT_EQ(tested.size(), 1);
+}
+
+TEST(TimeSeriesTests, rejectsOutOfOrderSamples) {
+  TimeSeries tested(DataType::Boolean, 2);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  tested.append<bool>(10, true);
+
+  EXPECT_THROW(tested.append<bool>(9, false), invalid_argument);
+  EXPECT_NO_THROW(tested.append<bool>(10, false));
+}
+
+TEST(TimeSeriesTests, rejectsArrayTypes) {
+  EXPECT_THROW(TimeSeries(DataType::Double_Array, 1), invalid_argument);
+  EXPECT_THROW(TimeSeries(DataType::Double, 0), invalid_argument);
+}
+
+TEST(TimeSeriesTests, slicesByTime) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimeSeries tested(DataType::Integer_32, 4);
+  for (int32_t i = 0; i < 6; ++i) {
+    tested.append<Integer32>(i * 10, {i});
+  }
+
+  vector<int32_t> values;
+  tested.forEach<Integer32>(
+      [&values](int64_t, int32_t value) { values.push_back(value); }, 25, 50);
+  EXPECT_THAT(values, ElementsAre(3, 4));
+  EXPECT_EQ(tested.lowerBound(0), 0);
+  EXPECT_EQ(tested.lowerBound(41), 3);
+  EXPECT_EQ(tested.lowerBound(100), 4);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimeSeriesTests, returnsWrappedSegments) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimeSeries tested(DataType::Double, 4);
+  for (int64_t i = 0; i < 6; ++i) {
+    tested.append<double>(i, static_cast<double>(i));
+  }
+
+  auto segments = tested.segments<double>();
+  EXPECT_EQ(segments[0].size, 2);
+  EXPECT_EQ(segments[1].size, 2);
+  vector<double> values;
+  for (const auto& segment : segments) {
+    values.insert(
+        values.end(), segment.values, segment.values + segment.size);
+  }
+  EXPECT_THAT(values, ElementsAre(2.0, 3.0, 4.0, 5.0));
+
+  auto empty = tested.segments<double>(100, 200);
+  EXPECT_EQ(empty[0].size + empty[1].size, 0);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimeSeriesTests, storesBooleanBits) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  TimeSeries tested(DataType::Boolean, 100);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (int64_t i = 0; i < 130; ++i) {
+    tested.append<bool>(i, i % 3 == 0);
+  }
+
+  size_t count = 0;
+  tested.forEach<bool>([&count](int64_t time, bool value) {
+    EXPECT_EQ(value, time % 3 == 0);
+    ++count;
+  });
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  EXPECT_EQ(count, 100);
+}
+
+TEST(TimeSeriesTests, storesStringsInArena) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  TimeSeries tested(DataType::String, 8);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  for (int64_t i = 0; i < 5000; ++i) {
+    tested.append<string>(i, "sample_" + to_string(i));
+  }
+
+  vector<string> values;
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  tested.forEach<string>([&values](int64_t, string_view value) {
+    values.emplace_back(value);
+  });
+  ASSERT_EQ(values.size(), 8);
+  EXPECT_EQ(values.front(), "sample_4992");
+  EXPECT_EQ(values.back(), "sample_4999");
+  EXPECT_EQ(tested.valueAt(7), DataVariant(string("sample_4999")));
+  // arena compaction keeps memory bounded
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  EXPECT_LT(tested.memoryUsage(), 16 * 1024);
+}
+
+TEST(TimeSeriesTests, storesTimestampsAndOpaqueValues) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  Timestamp time{2025, 9, 11, 18, 9, 23, 521};
+  TimeSeries timestamps(DataType::Timestamp, 2);
+  timestamps.append(time, DataVariant(time));
+  EXPECT_EQ(timestamps.valueAt(0), DataVariant(time));
+  EXPECT_EQ(timestamps.segments<Timestamp>()[0].values[0],
+      toEpochMicroseconds(time));
+
+  TimeSeries opaque(DataType::Opaque, 2);
+  opaque.append(0, DataVariant(vector<uint8_t>{0x01, 0x02}));
+  opaque.forEach<vector<uint8_t>>([](int64_t, OpaqueView value) {
+    ASSERT_EQ(value.size, 2);
+    EXPECT_EQ(value.data[1], 0x02);
+  });
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimeSeriesTests, evictsBeforeTime) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimeSeries tested(DataType::Unsigned_Integer, 10);
+  for (uintmax_t i = 0; i < 10; ++i) {
+    tested.append<uintmax_t>(static_cast<int64_t>(i), i);
+  }
+  tested.evictBefore(7);
+
+  EXPECT_EQ(tested.size(), 3);
+  EXPECT_EQ(tested.valueAt(0), DataVariant((uintmax_t)7));
+  tested.clear();
+  EXPECT_TRUE(tested.empty());
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,129 @@
+#include "TimerWheel.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+vector<uint64_t> keys(const vector<TimerWheel::Expiry>& expired) {
+  vector<uint64_t> result;
+  for (const auto& expiry : expired) {
+    result.push_back(expiry.key);
+  }
+  return result;
+}
+
+TEST(TimerWheelTests, expiresTimersAtDeadline) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimerWheel wheel;
+  wheel.schedule(5, 1);
+  wheel.schedule(3, 2);
+  wheel.schedule(64, 3);
+  wheel.schedule(5000, 4);
+  vector<TimerWheel::Expiry> expired;
+
+  EXPECT_EQ(wheel.advance(2, expired), 0);
+  EXPECT_EQ(wheel.advance(5, expired), 2);
+  EXPECT_THAT(keys(expired), ElementsAre(2, 1));
+  expired.clear();
+  EXPECT_EQ(wheel.advance(4999, expired), 1);
+  EXPECT_EQ(expired.front().deadline, 64);
+  expired.clear();
+  EXPECT_EQ(wheel.advance(5000, expired), 1);
+  EXPECT_EQ(expired.front().key, 4);
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.now(), 5000);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimerWheelTests, cancelsTimers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimerWheel wheel(100);
+  auto first = wheel.schedule(110, 1);
+  auto second = wheel.schedule(110, 2);
+  vector<TimerWheel::Expiry> expired;
+
+  EXPECT_TRUE(wheel.cancel(first));
+  EXPECT_FALSE(wheel.cancel(first));
+  EXPECT_EQ(wheel.size(), 1);
+  wheel.advance(200, expired);
+  EXPECT_THAT(keys(expired), ElementsAre(2));
+  EXPECT_FALSE(wheel.cancel(second));
+
+  // reused node gets a new id
+  auto third = wheel.schedule(300, 3);
+  EXPECT_NE(third, first);
+  EXPECT_FALSE(wheel.cancel(second));
+  EXPECT_TRUE(wheel.cancel(third));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimerWheelTests, expiresPastDeadlinesOnNextTick) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimerWheel wheel(1000);
+  wheel.schedule(10, 1);
+  wheel.schedule(1001, 2);
+  vector<TimerWheel::Expiry> expired;
+
+  wheel.advance(1001, expired);
+  ASSERT_THAT(keys(expired), ElementsAre(1, 2));
+  EXPECT_EQ(expired[0].deadline, 10);
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimerWheelTests, expiresFarTimers) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  TimerWheel wheel;
+  auto far = uint64_t{1} << 40U;
+  wheel.schedule(far, 1);
+  wheel.schedule(far + 1, 2);
+  vector<TimerWheel::Expiry> expired;
+
+  wheel.advance(far - 1, expired);
+  EXPECT_TRUE(expired.empty());
+  wheel.advance(far, expired);
+  EXPECT_THAT(keys(expired), ElementsAre(1));
+  wheel.advance(far + 1, expired);
+  EXPECT_THAT(keys(expired), ElementsAre(1, 2));
+  // NOLINTEND(readability-magic-numbers)
+}
+
+TEST(TimerWheelTests, matchesReferenceOrder) {
+  // NOLINTBEGIN(readability-magic-numbers)
+  mt19937_64 random(7);
+  uniform_int_distribution<uint64_t> delays(1, 300'000);
+  TimerWheel wheel;
+  vector<uint64_t> deadlines;
+  for (uint64_t i = 0; i < 2000; ++i) {
+    deadlines.push_back(delays(random));
+    wheel.schedule(deadlines.back(), i);
+  }
+  vector<TimerWheel::Expiry> expired;
+  uint64_t tick = 0;
+  while (!wheel.empty()) {
+    // alternates single ticks with skipped spans
+    auto previous = tick;
+    tick += (tick / 1000) % 2 == 0 ? 1 : 997;
+    auto first = expired.size();
+    wheel.advance(tick, expired);
+    for (auto i = first; i < expired.size(); ++i) {
+      EXPECT_EQ(expired[i].deadline, deadlines[expired[i].key]);
+      EXPECT_LE(expired[i].deadline, tick);
+      EXPECT_GT(expired[i].deadline, previous);
+    }
+  }
+
+  EXPECT_EQ(expired.size(), deadlines.size());
+  EXPECT_TRUE(is_sorted(expired.begin(),
+      expired.end(),
+      [](const auto& lhs, const auto& rhs) {
+        return lhs.deadline < rhs.deadline;
+      }));
+  // NOLINTEND(readability-magic-numbers)
+}
+} // namespace Information_Model::testing
@@ -0,0 +1,151 @@
+#include "DeviceBuilderMock.hpp"
+#include "TypedElement.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace Information_Model::testing {
+using namespace std;
+using namespace ::testing;
+
+struct FakeReadable : public Readable {
+  explicit FakeReadable(DataVariant value) : value_(move(value)) {}
+
+  DataType dataType() const override { return toDataType(value_); }
+
+  DataVariant read() const override { return value_; }
+
+private:
+  DataVariant value_;
+};
+
+struct FakeWritable : public Writable {
+  explicit FakeWritable(DataVariant value) : value_(move(value)) {}
+
+  DataType dataType() const override { return toDataType(value_); }
+
+  DataVariant read() const override { return value_; }
+
+  bool isWriteOnly() const override { return false; }
+
+  void write(const DataVariant& value) const override { value_ = value; }
+
+private:
+  mutable DataVariant value_;
+};
+
+struct FakeElement : public Element {
+  FakeElement(ElementType type, ElementFunction function)
+      : type_(type), function_(move(function)) {}
+
+  string id() const override { return "fake:0"; }
+
+  string name() const override { return "Fake"; }
+
+  string description() const override { return "Fake element"; }
+
+  ElementType type() const override { return type_; }
+
+  ElementFunction function() const override { return function_; }
+
+private:
+  ElementType type_;
+  ElementFunction function_;
+};
+
+struct NativeElement : public FakeElement, public TypedReadable<double> {
+  NativeElement()
+      : FakeElement(ElementType::Readable,
+            make_shared<FakeReadable>(DataVariant(1.0))) {}
+
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  double read() const override { return 42.0; }
+};
+
+TEST(TypedElementTests, canReadTypedValues) {
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  auto readable = make_shared<FakeReadable>(DataVariant(20.5));
+  auto element = make_shared<FakeElement>(ElementType::Readable, readable);
+
+  auto tested = toTypedReadable<double>(element);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  EXPECT_EQ(tested->read(), 20.5);
+}
+
+TEST(TypedElementTests, canWriteTypedValues) {
+  auto writable = make_shared<FakeWritable>(DataVariant(string("hello")));
+  auto element = make_shared<FakeElement>(ElementType::Writable, writable);
+
+  auto tested = toTypedWritable<string>(element);
+  tested->write("world");
+  EXPECT_EQ(tested->read(), "world");
+  EXPECT_EQ(toTypedReadable<string>(element)->read(), "world");
+}
+
+TEST(TypedElementTests, usesNativeImplementation) {
+  auto element = make_shared<NativeElement>();
+
+  auto tested = toTypedReadable<double>(element);
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  EXPECT_EQ(tested->read(), 42.0);
+}
+
+TEST(TypedElementTests, throwsDataTypeMismatch) {
+  auto readable = make_shared<FakeReadable>(DataVariant(true));
+  auto element = make_shared<FakeElement>(ElementType::Readable, readable);
+
+  EXPECT_THAT([&]() { auto _ = toTypedReadable<double>(element); },
+      ThrowsMessage<DataTypeMismatch>(HasSubstr(
+          "models Boolean values, not " + toString(DataType::Double))));
+}
+
+TEST(TypedElementTests, throwsElementTypeMismatch) {
+  auto readable = make_shared<FakeReadable>(DataVariant(true));
+  auto element = make_shared<FakeElement>(ElementType::Readable, readable);
+
+  EXPECT_THROW(
+      { auto _ = toTypedWritable<bool>(element); }, ElementTypeMismatch);
+  EXPECT_THROW(
+      { auto _ = toTypedObservable<bool>(element); }, ElementTypeMismatch);
+}
+
+TEST(TypedElementTests, builderWrapsTypedCallbacks) {
+  DeviceBuilderMock builder;
+  DeviceBuilder::ReadCallback read_cb;
+  DeviceBuilder::WriteCallback write_cb;
+  EXPECT_CALL(builder, addReadable("fake:0", _, DataType::Integer, _))
+      .WillOnce(DoAll(SaveArg<3>(&read_cb), Return("fake:0.0")));
+  EXPECT_CALL(builder, addWritable(_, DataType::String, _, IsNull()))
+      .WillOnce(DoAll(SaveArg<2>(&write_cb), Return("fake:1")));
+
+  auto readable_id = builder.addReadable<intmax_t>(
+      "fake:0", BuildInfo{}, []() { return (intmax_t)-2; });
+  string written;
+  auto writable_id = builder.addWritable<string>(
+      BuildInfo{}, [&written](const string& value) { written = value; });
+
+  EXPECT_EQ(readable_id, "fake:0.0");
+  EXPECT_EQ(writable_id, "fake:1");
+  EXPECT_EQ(read_cb(), DataVariant((intmax_t)-2));
+  write_cb(DataVariant(string("hello")));
+  EXPECT_EQ(written, "hello");
+}
+
+TEST(TypedElementTests, builderUnwrapsNotifyCallback) {
+  DeviceBuilderMock builder;
+  DataVariant notified;
+  EXPECT_CALL(builder, addObservable(_, DataType::Double, _, _))
+      .WillOnce(Return(pair<string, DeviceBuilder::NotifyCallback>{"fake:2",
+          [&notified](const DataVariant& value) { notified = value; }}));
+
+  auto [id, notify] = builder.addObservable<double>(
+      BuildInfo{}, []() { return 0.0; }, [](bool) {});
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  notify(1.5);
+
+  EXPECT_EQ(id, "fake:2");
+  // NOLINTNEXTLINE(readability-magic-numbers)
+  EXPECT_EQ(notified, DataVariant(1.5));
+}
+} // namespace Information_Model::testing